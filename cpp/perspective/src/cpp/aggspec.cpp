@@ -436,6 +436,31 @@ t_aggspec::is_non_delta() const {
     return false;
 }
 
+bool
+t_aggspec::supports_order_index() const {
+    switch (m_agg) {
+        case AGGTYPE_MEDIAN:
+        case AGGTYPE_MIN:
+        case AGGTYPE_MAX:
+        case AGGTYPE_HIGH_MINUS_LOW:
+        case AGGTYPE_DISTINCT_COUNT: {
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void
+t_aggspec::set_order_index(bool enabled) {
+    m_order_index = enabled && supports_order_index();
+}
+
+bool
+t_aggspec::has_order_index() const {
+    return m_order_index;
+}
+
 std::string
 t_aggspec::get_first_depname() const {
     if (m_dependencies.empty()) {
@@ -10,6 +10,7 @@
 // ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
+#include <charconv>
 #include <chrono>
 #include <perspective/base.h>
 #include <perspective/arrow_csv.h>
@@ -126,34 +127,20 @@ ParseYYYY_D_M(const char* s, arrow_vendored::date::year_month_day* out) {
     return out->ok();
 }
 
-static inline std::string
-extract_string(const char* ch, int start_idx, int number_of_chars) {
-    std::string out;
-    for (int i = start_idx; i < start_idx + number_of_chars; i++) {
-        out += ch[i];
-    }
-    return out;
-}
-
 static inline bool
 ParseAM_PM(const char* s, std::chrono::seconds& seconds, int length) {
-    int hour = 0;
+    uint8_t hour = 0;
     int twelve_hours = 12;
-    std::string am_pm;
-    std::string hour_string;
+    std::string_view am_pm;
 
     if (length == 21) {
-        am_pm = extract_string(s, 19, 2);
-        hour_string = extract_string(s, 10, 2);
-        hour = atoi(hour_string.c_str());
-        if (hour == 0) {
+        am_pm = std::string_view(s + 19, 2);
+        if (!arrow::internal::ParseUnsigned(s + 10, 2, &hour) || hour == 0) {
             return false;
         }
     } else if (length == 23) {
-        am_pm = extract_string(s, 21, 2);
-        hour_string = extract_string(s, 12, 2);
-        hour = atoi(hour_string.c_str());
-        if (hour == 0) {
+        am_pm = std::string_view(s + 21, 2);
+        if (!arrow::internal::ParseUnsigned(s + 12, 2, &hour) || hour == 0) {
             return false;
         }
     }
@@ -181,10 +168,9 @@ public:
         int64_t* out,
         bool* out_zone_offset_present = NULLPTR
     ) const override {
-        size_t endptr;
-        std::string val(s, s + length);
-        int64_t value = std::stoll(static_cast<std::string>(val), &endptr, 10);
-        if (endptr != length) {
+        int64_t value = 0;
+        auto [ptr, ec] = std::from_chars(s, s + length, value);
+        if (ec != std::errc() || ptr != s + length) {
             return false;
         }
         (*out) = value;
@@ -584,15 +570,83 @@ std::vector<std::shared_ptr<arrow::TimestampParser>> DATE_READERS{
     arrow::TimestampParser::MakeStrptime("%H:%M:%S.%f")
 };
 
-std::optional<int64_t>
-parseAsArrowTimestamp(const std::string& input) {
-    for (const auto& candidate : DATE_PARSERS) {
-        int64_t datetime;
-        if (candidate->operator()(
-                input.c_str(), input.size(), arrow::TimeUnit::MILLI, &datetime
+/**
+ * @brief Tries a list of timestamp parsers in order, as Arrow does for
+ * `ConvertOptions::timestamp_parsers`, but starts with whichever parser
+ * read the last value. Arrow decodes a column in runs of values on one
+ * thread, and a column's values almost always share a format, so this
+ * skips re-trying (and failing) the earlier formats - `strptime` ones in
+ * particular - on every cell. Where the formats in `DATE_PARSERS` and
+ * `DATE_READERS` overlap they agree, so the parser tried first does not
+ * change the result.
+ */
+class CachedFormatTimestampParser : public arrow::TimestampParser {
+public:
+    explicit CachedFormatTimestampParser(
+        std::vector<std::shared_ptr<arrow::TimestampParser>> parsers
+    ) :
+        m_parsers(std::move(parsers)) {}
+
+    bool
+    operator()(
+        const char* s,
+        size_t length,
+        arrow::TimeUnit::type unit,
+        int64_t* out,
+        bool* out_zone_offset_present = NULLPTR
+    ) const override {
+        thread_local const CachedFormatTimestampParser* last_parser = nullptr;
+        thread_local size_t last_format = 0;
+        bool has_last = last_parser == this;
+        if (has_last
+            && (*m_parsers[last_format])(
+                s, length, unit, out, out_zone_offset_present
             )) {
-            return datetime;
+            return true;
         }
+
+        for (size_t format = 0; format < m_parsers.size(); ++format) {
+            if (has_last && format == last_format) {
+                continue;
+            }
+
+            if ((*m_parsers[format])(
+                    s, length, unit, out, out_zone_offset_present
+                )) {
+                last_parser = this;
+                last_format = format;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    [[nodiscard]]
+    const char*
+    kind() const override {
+        return "cached_format";
+    }
+
+private:
+    std::vector<std::shared_ptr<arrow::TimestampParser>> m_parsers;
+};
+
+std::vector<std::shared_ptr<arrow::TimestampParser>> CACHED_DATE_PARSERS{
+    std::make_shared<CachedFormatTimestampParser>(DATE_PARSERS)
+};
+
+std::vector<std::shared_ptr<arrow::TimestampParser>> CACHED_DATE_READERS{
+    std::make_shared<CachedFormatTimestampParser>(DATE_READERS)
+};
+
+std::optional<int64_t>
+parseAsArrowTimestamp(std::string_view input) {
+    int64_t datetime;
+    if ((*CACHED_DATE_PARSERS[0])(
+            input.data(), input.size(), arrow::TimeUnit::MILLI, &datetime
+        )) {
+        return datetime;
     }
 
     return std::nullopt;
@@ -618,9 +672,9 @@ csvToTable(
 
     if (is_update) {
         convert_options.column_types = std::move(schema);
-        convert_options.timestamp_parsers = DATE_READERS;
+        convert_options.timestamp_parsers = CACHED_DATE_READERS;
     } else {
-        convert_options.timestamp_parsers = DATE_PARSERS;
+        convert_options.timestamp_parsers = CACHED_DATE_PARSERS;
     }
 
     auto maybe_reader = arrow::csv::TableReader::Make(
@@ -214,6 +214,22 @@ ArrowLoader::initialize(const std::uint8_t* ptr, const uint32_t length) {
     }
 }
 
+void
+ArrowLoader::initialize(std::shared_ptr<const std::string> data) {
+    initialize(
+        reinterpret_cast<const std::uint8_t*>(data->data()), data->size()
+    );
+
+    // IPC buffers may be slices of `data` or (if compressed) owned by
+    // `m_table`, so borrowed columns keep both alive.
+    struct t_owner {
+        std::shared_ptr<const std::string> m_data;
+        std::shared_ptr<arrow::Table> m_table;
+    };
+
+    m_owner = std::make_shared<t_owner>(t_owner{std::move(data), m_table});
+}
+
 void
 ArrowLoader::init_csv(
     const std::string_view& csv,
@@ -222,6 +238,9 @@ ArrowLoader::init_csv(
         psp_schema
 ) {
     m_table = deduplicate_table(csvToTable(csv, is_update, psp_schema));
+
+    // The CSV reader allocates its own buffers.
+    m_owner = m_table;
     std::shared_ptr<arrow::Schema> schema = m_table->schema();
     std::vector<std::shared_ptr<arrow::Field>> fields = schema->fields();
     for (const auto& field : fields) {
@@ -312,6 +331,23 @@ iter_col_copy(
     }
 }
 
+// Copy dictionary indices into a string column as vocabulary ids, at the
+// column's id width; validity is filled in by the caller.
+template <typename T>
+void
+iter_vocab_copy(
+    const std::shared_ptr<t_column>& dest,
+    std::shared_ptr<arrow::Array> src,
+    const int64_t offset,
+    const int64_t len
+) {
+    std::shared_ptr<T> scol = std::static_pointer_cast<T>(src);
+    const typename T::value_type* vals = scol->raw_values();
+    for (uint32_t i = 0; i < len; i++) {
+        dest->set_vocab_index(offset + i, static_cast<t_uindex>(vals[i]));
+    }
+}
+
 void
 copy_string_list(
     std::shared_ptr<arrow::ListArray>& list,
@@ -499,42 +535,42 @@ copy_array(
             auto indices = scol->indices();
             switch (indices->type()->id()) {
                 case arrow::Int8Type::type_id: {
-                    iter_col_copy<::arrow::Int8Array, t_uindex>(
+                    iter_vocab_copy<::arrow::Int8Array>(
                         dest, indices, offset, len
                     );
                 } break;
                 case ::arrow::UInt8Type::type_id: {
-                    iter_col_copy<::arrow::UInt8Array, t_uindex>(
+                    iter_vocab_copy<::arrow::UInt8Array>(
                         dest, indices, offset, len
                     );
                 } break;
                 case ::arrow::Int16Type::type_id: {
-                    iter_col_copy<::arrow::Int16Array, t_uindex>(
+                    iter_vocab_copy<::arrow::Int16Array>(
                         dest, indices, offset, len
                     );
                 } break;
                 case ::arrow::UInt16Type::type_id: {
-                    iter_col_copy<::arrow::UInt16Array, t_uindex>(
+                    iter_vocab_copy<::arrow::UInt16Array>(
                         dest, indices, offset, len
                     );
                 } break;
                 case ::arrow::Int32Type::type_id: {
-                    iter_col_copy<::arrow::Int32Array, t_uindex>(
+                    iter_vocab_copy<::arrow::Int32Array>(
                         dest, indices, offset, len
                     );
                 } break;
                 case ::arrow::UInt32Type::type_id: {
-                    iter_col_copy<::arrow::UInt32Array, t_uindex>(
+                    iter_vocab_copy<::arrow::UInt32Array>(
                         dest, indices, offset, len
                     );
                 } break;
                 case ::arrow::Int64Type::type_id: {
-                    iter_col_copy<::arrow::Int64Array, t_uindex>(
+                    iter_vocab_copy<::arrow::Int64Array>(
                         dest, indices, offset, len
                     );
                 } break;
                 case ::arrow::UInt64Type::type_id: {
-                    iter_col_copy<::arrow::UInt64Array, t_uindex>(
+                    iter_vocab_copy<::arrow::UInt64Array>(
                         dest, indices, offset, len
                     );
                 } break;
@@ -762,6 +798,80 @@ copy_array(
     }
 }
 
+bool
+borrow_array(
+    const std::shared_ptr<t_column>& dest,
+    const std::shared_ptr<arrow::Array>& src,
+    const std::shared_ptr<const void>& owner
+) {
+    // Null slots would be written on load, undoing the borrow.
+    if (owner == nullptr || src->null_count() != 0
+        || static_cast<t_uindex>(src->length()) != dest->size()) {
+        return false;
+    }
+
+    const void* values = nullptr;
+    switch (src->type()->id()) {
+        case arrow::Int8Type::type_id: {
+            values = std::static_pointer_cast<arrow::Int8Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::UInt8Type::type_id: {
+            values = std::static_pointer_cast<arrow::UInt8Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::Int16Type::type_id: {
+            values = std::static_pointer_cast<arrow::Int16Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::UInt16Type::type_id: {
+            values = std::static_pointer_cast<arrow::UInt16Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::Int32Type::type_id: {
+            values = std::static_pointer_cast<arrow::Int32Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::UInt32Type::type_id: {
+            values = std::static_pointer_cast<arrow::UInt32Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::Int64Type::type_id: {
+            values = std::static_pointer_cast<arrow::Int64Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::UInt64Type::type_id: {
+            values = std::static_pointer_cast<arrow::UInt64Array>(src)
+                         ->raw_values();
+        } break;
+        case arrow::FloatType::type_id: {
+            values = std::static_pointer_cast<arrow::FloatArray>(src)
+                         ->raw_values();
+        } break;
+        case arrow::DoubleType::type_id: {
+            values = std::static_pointer_cast<arrow::DoubleArray>(src)
+                         ->raw_values();
+        } break;
+        case arrow::TimestampType::type_id: {
+            // Only millisecond timestamps share `DTYPE_TIME`'s layout, and
+            // `t_date` is packed differently from both Arrow date types.
+            auto tunit =
+                std::static_pointer_cast<arrow::TimestampType>(src->type());
+            if (tunit->unit() != arrow::TimeUnit::MILLI) {
+                return false;
+            }
+
+            values = std::static_pointer_cast<arrow::TimestampArray>(src)
+                         ->raw_values();
+        } break;
+        default: {
+            return false;
+        }
+    }
+
+    return dest->borrow_data(owner, values, src->length());
+}
+
 // Defines the full matrix of type interactions between arrow arrays and
 // schema-defined tables.
 #define FILL_COLUMN_ITER(ARRAY_TYPE)                                           \
@@ -879,7 +989,8 @@ ArrowLoader::fill_column(
                     PSP_COMPLAIN_AND_ABORT(ss.str());
                 };
             }
-        } else {
+        } else if (carray->num_chunks() != 1
+                   || !borrow_array(col, array, m_owner)) {
             copy_array(col, array, offset, len);
         }
 
@@ -887,7 +998,7 @@ ArrowLoader::fill_column(
         std::int64_t null_count = array->null_count();
 
         if (null_count == 0) {
-            col->valid_raw_fill();
+            col->set_validity(nullptr, 0, offset, len, STATUS_INVALID);
         } else {
             const uint8_t* null_bitmap = array->null_bitmap_data();
 
@@ -897,19 +1008,17 @@ ArrowLoader::fill_column(
             if (null_bitmap == nullptr) {
                 col->invalid_raw_fill();
             } else {
-                // Read the null bitmap and set the correct rows
-                // as valid
+                // The column's validity has the same layout as Arrow's, so
+                // copy the bitmap across, then zero the null rows' data.
+                t_status invalid_status =
+                    is_update ? STATUS_CLEAR : STATUS_INVALID;
+                col->set_validity(
+                    null_bitmap, array->offset(), offset, len, invalid_status
+                );
+
                 for (uint32_t i = 0; i < len; ++i) {
-                    std::uint8_t elem = null_bitmap[i / 8];
-                    bool v = (elem & (1 << (i % 8))) != 0;
-                    if (!v) {
-                        if (is_update) {
-                            col->unset(offset + i);
-                        } else {
-                            col->clear(offset + i);
-                        }
-                    } else {
-                        col->set_valid(offset + i, v);
+                    if (!col->is_valid(offset + i)) {
+                        col->clear(offset + i, invalid_status);
                     }
                 }
             }
@@ -11,6 +11,7 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 #include <perspective/arrow_writer.h>
+#include <tsl/hopscotch_map.h>
 
 namespace perspective::apachearrow {
 using namespace perspective;
@@ -78,4 +79,248 @@ get_scalar<bool>(t_tscalar& t) {
 //     return (ridx - extents.m_srow) * stride + (cidx - extents.m_scol);
 // }
 
+std::int32_t
+get_days_since_epoch(t_date val) {
+    // years are signed, while month/days are unsigned
+    date::year year{val.year()};
+    // Increment month by 1, as date::month is [1-12] but
+    // t_date::month() is [0-11]
+    date::month month{static_cast<std::uint32_t>(val.month() + 1)};
+    date::day day{static_cast<std::uint32_t>(val.day())};
+    date::year_month_day ymd(year, month, day);
+    date::sys_days days_since_epoch = ymd;
+    auto count = days_since_epoch.time_since_epoch().count();
+    return static_cast<std::int32_t>(count);
+}
+
+namespace {
+
+    bool
+    is_gathered_valid(const t_column& column, const t_rlookup& row) {
+        return row.m_exists
+            && (!column.is_status_enabled() || column.is_valid(row.m_idx));
+    }
+
+    template <typename ArrowDataType, typename T, typename F>
+    std::shared_ptr<arrow::Array>
+    gather_to_array(
+        const t_column& column,
+        const std::vector<t_rlookup>& rows,
+        const std::shared_ptr<arrow::DataType>& type,
+        F convert
+    ) {
+        typename arrow::TypeTraits<ArrowDataType>::BuilderType array_builder(
+            type, arrow::default_memory_pool()
+        );
+        auto reserve_status = array_builder.Reserve(rows.size());
+        if (!reserve_status.ok()) {
+            std::stringstream ss;
+            ss << "Failed to allocate buffer for column: "
+               << reserve_status.message() << "\n";
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+
+        for (const auto& row : rows) {
+            if (is_gathered_valid(column, row)) {
+                array_builder.UnsafeAppend(
+                    convert(*(column.get_nth<T>(row.m_idx)))
+                );
+            } else {
+                array_builder.UnsafeAppendNull();
+            }
+        }
+
+        std::shared_ptr<arrow::Array> array;
+        arrow::Status status = array_builder.Finish(&array);
+        if (!status.ok()) {
+            PSP_COMPLAIN_AND_ABORT(
+                "Could not serialize column: " + status.message()
+            );
+        }
+        return array;
+    }
+
+    template <typename ArrowDataType, typename T>
+    std::shared_ptr<arrow::Array>
+    gather_to_array(
+        const t_column& column, const std::vector<t_rlookup>& rows
+    ) {
+        return gather_to_array<ArrowDataType, T>(
+            column,
+            rows,
+            arrow::TypeTraits<ArrowDataType>::type_singleton(),
+            [](T val) { return val; }
+        );
+    }
+
+    std::shared_ptr<arrow::Array>
+    gather_to_dictionary_array(
+        const t_column& column, const std::vector<t_rlookup>& rows
+    ) {
+        arrow::Int32Builder indices_builder;
+        arrow::StringBuilder values_builder;
+        auto reserve_status = indices_builder.Reserve(rows.size());
+        if (!reserve_status.ok()) {
+            std::stringstream ss;
+            ss << "Failed to allocate buffer for column: "
+               << reserve_status.message() << "\n";
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+
+        // Renumber the column's vocabulary ids densely, in the order they
+        // are first seen, so the dictionary only holds strings in `rows`.
+        tsl::hopscotch_map<t_uindex, std::int32_t> remap;
+        std::vector<t_uindex> dictionary;
+        column.visit_vocab_indices([&](const auto* indices) {
+            for (const auto& row : rows) {
+                if (!is_gathered_valid(column, row)) {
+                    indices_builder.UnsafeAppendNull();
+                    continue;
+                }
+
+                t_uindex vidx = indices[row.m_idx];
+                auto [iter, inserted] = remap.try_emplace(
+                    vidx, static_cast<std::int32_t>(dictionary.size())
+                );
+                if (inserted) {
+                    dictionary.push_back(vidx);
+                }
+
+                indices_builder.UnsafeAppend(iter->second);
+            }
+        });
+
+        for (t_uindex vidx : dictionary) {
+            const char* str = column.unintern_c(vidx);
+            arrow::Status s = values_builder.Append(str, strlen(str));
+            if (!s.ok()) {
+                std::stringstream ss;
+                ss << "Could not append string to dictionary array: "
+                   << s.message() << "\n";
+                PSP_COMPLAIN_AND_ABORT(ss.str());
+            }
+        }
+
+        std::shared_ptr<arrow::Array> indices_array;
+        arrow::Status indices_status = indices_builder.Finish(&indices_array);
+        if (!indices_status.ok()) {
+            std::stringstream ss;
+            ss << "Could not write indices for dictionary array: "
+               << indices_status.message() << "\n";
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+
+        std::shared_ptr<arrow::Array> values_array;
+        arrow::Status values_status = values_builder.Finish(&values_array);
+        if (!values_status.ok()) {
+            std::stringstream ss;
+            ss << "Could not write values for dictionary array: "
+               << values_status.message() << "\n";
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+
+        arrow::Result<std::shared_ptr<arrow::Array>> result =
+            arrow::DictionaryArray::FromArrays(
+                arrow::dictionary(arrow::int32(), arrow::utf8()),
+                indices_array,
+                values_array
+            );
+
+        if (!result.ok()) {
+            std::stringstream ss;
+            ss << "Could not write values for dictionary array: "
+               << result.status().message() << "\n";
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+
+        return *result;
+    }
+
+} // namespace
+
+std::shared_ptr<arrow::Array>
+column_to_array(const t_column& column, const std::vector<t_rlookup>& rows) {
+    switch (column.get_dtype()) {
+        case DTYPE_INT8: {
+            return gather_to_array<arrow::Int8Type, std::int8_t>(column, rows);
+        }
+        case DTYPE_UINT8: {
+            return gather_to_array<arrow::UInt8Type, std::uint8_t>(
+                column, rows
+            );
+        }
+        case DTYPE_INT16: {
+            return gather_to_array<arrow::Int16Type, std::int16_t>(
+                column, rows
+            );
+        }
+        case DTYPE_UINT16: {
+            return gather_to_array<arrow::UInt16Type, std::uint16_t>(
+                column, rows
+            );
+        }
+        case DTYPE_INT32: {
+            return gather_to_array<arrow::Int32Type, std::int32_t>(
+                column, rows
+            );
+        }
+        case DTYPE_UINT32: {
+            return gather_to_array<arrow::UInt32Type, std::uint32_t>(
+                column, rows
+            );
+        }
+        case DTYPE_INT64: {
+            return gather_to_array<arrow::Int64Type, std::int64_t>(
+                column, rows
+            );
+        }
+        case DTYPE_UINT64: {
+            return gather_to_array<arrow::UInt64Type, std::uint64_t>(
+                column, rows
+            );
+        }
+        case DTYPE_FLOAT32: {
+            return gather_to_array<arrow::FloatType, float>(column, rows);
+        }
+        case DTYPE_FLOAT64: {
+            return gather_to_array<arrow::DoubleType, double>(column, rows);
+        }
+        case DTYPE_BOOL: {
+            return gather_to_array<arrow::BooleanType, bool>(column, rows);
+        }
+        case DTYPE_DATE: {
+            return gather_to_array<arrow::Date32Type, t_date::t_rawtype>(
+                column,
+                rows,
+                arrow::date32(),
+                [](t_date::t_rawtype val) {
+                    return get_days_since_epoch(t_date(val));
+                }
+            );
+        }
+        case DTYPE_TIME: {
+            return gather_to_array<arrow::TimestampType, t_time::t_rawtype>(
+                column,
+                rows,
+                arrow::timestamp(arrow::TimeUnit::MILLI),
+                [](t_time::t_rawtype val) {
+                    return static_cast<std::int64_t>(val);
+                }
+            );
+        }
+        case DTYPE_STR: {
+            return gather_to_dictionary_array(column, rows);
+        }
+        default: {
+            std::stringstream ss;
+            ss << "Cannot serialize column of type `"
+               << get_dtype_descr(column.get_dtype()) << "` to Arrow format."
+               << std::endl;
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+    }
+
+    return nullptr;
+}
+
 } // namespace perspective::apachearrow
\ No newline at end of file
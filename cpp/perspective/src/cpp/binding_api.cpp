@@ -13,8 +13,14 @@
 #include "perspective/exports.h"
 #include "perspective/server.h"
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <tsl/hopscotch_map.h>
 
@@ -67,6 +73,24 @@ psp_new_server() {
     return new ProtoServer;
 }
 
+/**
+ * Create a server whose requests run on `num_workers` worker threads, one
+ * execution lane per table. `psp_handle_request` and `psp_poll` still block
+ * until their responses are ready, so hosts which call them from several
+ * threads get concurrency across tables.
+ */
+PERSPECTIVE_EXPORT
+ProtoServer*
+psp_new_server_with_workers(std::uint32_t num_workers) {
+    return new ProtoServer(num_workers);
+}
+
+PERSPECTIVE_EXPORT
+std::uint32_t
+psp_num_workers(ProtoServer* server) {
+    return server->num_workers();
+}
+
 PERSPECTIVE_EXPORT
 EncodedApiEntries*
 psp_handle_request(
@@ -76,17 +100,98 @@ psp_handle_request(
     std::size_t msg_len
 ) {
     std::string msg(msg_ptr, msg_len);
-    auto msgs = server->handle_request(client_id, msg);
-    return encode_api_responses(msgs);
+    if (server->num_workers() == 0) {
+        auto msgs = server->handle_request(client_id, msg);
+        return encode_api_responses(msgs);
+    }
+
+    std::promise<std::vector<ProtoServerResp<std::string>>> done;
+    auto result = done.get_future();
+    server->dispatch_request(
+        client_id,
+        std::move(msg),
+        [&done](std::vector<ProtoServerResp<std::string>> msgs) {
+            done.set_value(std::move(msgs));
+        }
+    );
+
+    return encode_api_responses(result.get());
 }
 
 PERSPECTIVE_EXPORT
 EncodedApiEntries*
 psp_poll(ProtoServer* server) {
-    auto responses = server->poll();
+    if (server->num_workers() == 0) {
+        auto responses = server->poll();
+        return encode_api_responses(responses);
+    }
+
+    // Collect each dirty table's notifications from its lane.
+    std::mutex lock;
+    std::condition_variable cv;
+    std::size_t num_done = 0;
+    std::vector<ProtoServerResp<std::string>> responses;
+    auto num_tables = server->dispatch_poll(
+        [&](std::vector<ProtoServerResp<std::string>> msgs) {
+            std::lock_guard<std::mutex> guard(lock);
+            std::move(msgs.begin(), msgs.end(), std::back_inserter(responses));
+            ++num_done;
+            cv.notify_one();
+        }
+    );
+
+    std::unique_lock<std::mutex> guard(lock);
+    cv.wait(guard, [&]() { return num_done == num_tables; });
     return encode_api_responses(responses);
 }
 
+/**
+ * Coalesce updates to the table hosted as `table_id`, see
+ * `ProtoServer::set_table_update_policy`.
+ */
+PERSPECTIVE_EXPORT
+void
+psp_set_table_update_policy(
+    ProtoServer* server,
+    char* table_id_ptr,
+    std::size_t table_id_len,
+    std::uint32_t max_latency_ms,
+    std::uint32_t max_batch_rows
+) {
+    TableUpdatePolicy policy;
+    policy.max_latency = std::chrono::milliseconds(max_latency_ms);
+    policy.max_batch_rows = max_batch_rows;
+    server->set_table_update_policy(
+        std::string(table_id_ptr, table_id_len), policy
+    );
+}
+
+PERSPECTIVE_EXPORT
+void
+psp_clear_table_update_policy(
+    ProtoServer* server, char* table_id_ptr, std::size_t table_id_len
+) {
+    server->clear_table_update_policy(std::string(table_id_ptr, table_id_len));
+}
+
+/**
+ * Milliseconds until `psp_poll` next has deferred updates or throttled
+ * notifications to deliver, or -1 if it has none. Hosts call `psp_poll`
+ * again after this delay, as no request may arrive to trigger it.
+ */
+PERSPECTIVE_EXPORT
+std::int32_t
+psp_get_poll_delay(ProtoServer* server) {
+    auto delay = server->get_poll_delay();
+    if (!delay.has_value()) {
+        return -1;
+    }
+
+    return static_cast<std::int32_t>(std::min<std::int64_t>(
+        delay->count(), std::numeric_limits<std::int32_t>::max()
+    ));
+}
+
 PERSPECTIVE_EXPORT
 std::uint32_t
 psp_new_session(ProtoServer* server) {
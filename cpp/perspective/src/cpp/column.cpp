@@ -19,14 +19,129 @@ SUPPRESS_WARNINGS_VC(4505)
 #include <perspective/sym_table.h>
 #include <tsl/hopscotch_set.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include <utility>
 
 namespace perspective {
+
+namespace {
+
+    /**
+     * @brief Read `nbits` (at most 64) bits of `src` starting at bit `bit`,
+     * in Arrow's LSB-first order.
+     */
+    inline std::uint64_t
+    load_bits(const std::uint8_t* src, t_uindex bit, t_uindex nbits) {
+        const std::uint8_t* base = src + bit / 8;
+        t_uindex shift = bit % 8;
+        t_uindex nbytes = (shift + nbits + 7) / 8;
+
+        std::uint64_t word = 0;
+        std::memcpy(&word, base, size_t(std::min<t_uindex>(nbytes, 8)));
+        std::uint64_t rval = word >> shift;
+        if (nbytes > 8) {
+            rval |= std::uint64_t(base[8]) << (64 - shift);
+        }
+
+        if (nbits < 64) {
+            rval &= (std::uint64_t(1) << nbits) - 1;
+        }
+
+        return rval;
+    }
+
+    /**
+     * @brief Overwrite `nbits` (at most 64) bits of `dst` starting at bit
+     * `bit` with the low bits of `value`.
+     */
+    inline void
+    store_bits(
+        std::uint64_t* dst, t_uindex bit, std::uint64_t value, t_uindex nbits
+    ) {
+        std::uint64_t mask =
+            nbits < 64 ? (std::uint64_t(1) << nbits) - 1 : ~std::uint64_t(0);
+        t_uindex widx = bit / 64;
+        t_uindex shift = bit % 64;
+
+        dst[widx] = (dst[widx] & ~(mask << shift)) | (value << shift);
+        if (shift + nbits > 64) {
+            t_uindex spill = 64 - shift;
+            dst[widx + 1] =
+                (dst[widx + 1] & ~(mask >> spill)) | (value >> spill);
+        }
+    }
+
+    void
+    copy_bits(
+        const std::uint8_t* src,
+        t_uindex src_offset,
+        std::uint64_t* dst,
+        t_uindex dst_offset,
+        t_uindex size
+    ) {
+        for (t_uindex done = 0; done < size; done += 64) {
+            t_uindex nbits = std::min<t_uindex>(64, size - done);
+            store_bits(
+                dst,
+                dst_offset + done,
+                load_bits(src, src_offset + done, nbits),
+                nbits
+            );
+        }
+    }
+
+    inline t_uindex
+    load_vocab_index(
+        const unsigned char* base, t_uindex idx, std::uint32_t width
+    ) {
+        switch (width) {
+            case 1: {
+                return base[idx];
+            }
+            case 2: {
+                return reinterpret_cast<const std::uint16_t*>(base)[idx];
+            }
+            case 4: {
+                return reinterpret_cast<const std::uint32_t*>(base)[idx];
+            }
+            default: {
+                return reinterpret_cast<const std::uint64_t*>(base)[idx];
+            }
+        }
+    }
+
+    inline void
+    store_vocab_index(
+        unsigned char* base, t_uindex idx, std::uint32_t width, t_uindex vidx
+    ) {
+        switch (width) {
+            case 1: {
+                base[idx] = static_cast<std::uint8_t>(vidx);
+            } break;
+            case 2: {
+                reinterpret_cast<std::uint16_t*>(base)[idx] =
+                    static_cast<std::uint16_t>(vidx);
+            } break;
+            case 4: {
+                reinterpret_cast<std::uint32_t*>(base)[idx] =
+                    static_cast<std::uint32_t>(vidx);
+            } break;
+            default: {
+                reinterpret_cast<std::uint64_t*>(base)[idx] = vidx;
+            }
+        }
+    }
+
+} // namespace
 // TODO : move to delegated constructors in C++11
 
-t_column_recipe::t_column_recipe() : m_vlenidx(0), m_size(0) {}
+t_column_recipe::t_column_recipe() :
+    m_vlenidx(0),
+    m_size(0),
+    m_elemsize(0) {}
 
 t_column::t_column() :
     m_dtype(DTYPE_NONE),
@@ -35,9 +150,12 @@ t_column::t_column() :
     m_data(nullptr),
     m_vocab(nullptr),
     m_status(nullptr),
+    m_cleared(nullptr),
+    m_status_size(0),
     m_size(0),
     m_status_enabled(false),
-    m_from_recipe(false)
+    m_from_recipe(false),
+    m_elemsize(0)
 
 {
     LOG_CONSTRUCTOR("t_column");
@@ -46,9 +164,14 @@ t_column::t_column() :
 t_column::t_column(const t_column_recipe& recipe) :
     m_dtype(recipe.m_dtype),
     m_init(false),
+    m_status_size(recipe.m_size),
     m_size(recipe.m_size),
     m_status_enabled(recipe.m_status_enabled),
-    m_from_recipe(true)
+    m_from_recipe(true),
+    m_elemsize(
+        recipe.m_elemsize != 0 ? recipe.m_elemsize
+                               : get_initial_elemsize(recipe.m_dtype)
+    )
 
 {
     LOG_CONSTRUCTOR("t_column");
@@ -63,8 +186,10 @@ t_column::t_column(const t_column_recipe& recipe) :
 
     if (m_status_enabled) {
         m_status = std::make_shared<t_lstore>(recipe.m_status);
+        m_cleared = std::make_shared<t_lstore>(recipe.m_cleared);
     } else {
         m_status = std::make_shared<t_lstore>();
+        m_cleared = std::make_shared<t_lstore>();
     }
 }
 
@@ -79,10 +204,13 @@ t_column::column_copy_helper(const t_column& other) {
         other.m_vocab->get_extents()->get_recipe()
     );
     m_status = std::make_shared<t_lstore>(other.m_status->get_recipe());
+    m_cleared = std::make_shared<t_lstore>(other.m_cleared->get_recipe());
+    m_status_size = other.m_status_size;
 
     m_size = other.m_size;
     m_status_enabled = other.m_status_enabled;
     m_from_recipe = false;
+    m_elemsize = other.m_elemsize;
 }
 
 t_column::t_column(const t_column& c) {
@@ -112,9 +240,11 @@ t_column::t_column(
 ) :
     m_dtype(dtype),
     m_init(false),
+    m_status_size(0),
     m_size(0),
     m_status_enabled(missing_enabled),
-    m_from_recipe(false) {
+    m_from_recipe(false),
+    m_elemsize(get_initial_elemsize(dtype)) {
 
     m_data = std::make_shared<t_lstore>(a);
     // TODO make sure that capacity from a
@@ -140,12 +270,17 @@ t_column::t_column(
 
     if (is_status_enabled()) {
         t_lstore_recipe missing_args(a);
-        missing_args.m_capacity = row_capacity;
+        missing_args.m_capacity = get_status_bytes(row_capacity);
+
+        t_lstore_recipe cleared_args(missing_args);
 
         missing_args.m_colname = a.m_colname + std::string("_missing");
+        cleared_args.m_colname = a.m_colname + std::string("_cleared");
         m_status = std::make_shared<t_lstore>(missing_args);
+        m_cleared = std::make_shared<t_lstore>(cleared_args);
     } else {
         m_status = std::make_shared<t_lstore>();
+        m_cleared = std::make_shared<t_lstore>();
     }
 }
 
@@ -166,11 +301,9 @@ t_column::init() {
 
     if (is_status_enabled()) {
         m_status->init();
+        m_cleared->init();
     }
 
-    if (is_deterministic_sized(m_dtype)) {
-        m_elemsize = get_dtype_size(m_dtype);
-    }
     m_init = true;
     COLUMN_CHECK_VALUES();
 }
@@ -185,27 +318,33 @@ t_column::get_dtype() const {
 // extend based on dtype size
 void
 t_column::extend_dtype(t_uindex idx) {
-    t_uindex new_extents = idx * get_dtype_size(m_dtype);
+    t_uindex new_extents = idx * m_elemsize;
     m_data->reserve(new_extents);
     m_data->set_size(new_extents);
-    m_size = m_data->size() / get_dtype_size(m_dtype);
+    m_size = m_data->size() / m_elemsize;
 
     if (is_status_enabled()) {
-        t_uindex sz = idx * get_dtype_size(DTYPE_UINT8);
-        m_status->reserve(sz);
-        m_status->set_size(sz);
+        resize_status(idx);
     }
 }
 
 t_uindex
 t_column::get_interned(const std::string& s) {
-    COLUMN_CHECK_STRCOL();
-    return m_vocab->get_interned(s);
+    return get_interned(s.c_str());
 }
 t_uindex
 t_column::get_interned(const char* s) {
     COLUMN_CHECK_STRCOL();
-    return m_vocab->get_interned(s);
+    // Callers compare the id against this column's data, so it must fit.
+    t_uindex vidx = m_vocab->get_interned(s);
+    fit_vocab_index(vidx);
+    return vidx;
+}
+
+bool
+t_column::string_exists(const char* s, t_uindex& interned) const {
+    COLUMN_CHECK_STRCOL();
+    return m_vocab->string_exists(s, interned);
 }
 
 template <>
@@ -213,12 +352,11 @@ void
 t_column::push_back<const char*>(const char* elem) {
     COLUMN_CHECK_STRCOL();
     if (elem == nullptr) {
-        m_data->push_back(static_cast<t_uindex>(0));
+        push_back_vocab_index(0);
         return;
     }
 
-    t_uindex idx = m_vocab->get_interned(elem);
-    m_data->push_back(idx);
+    push_back_vocab_index(m_vocab->get_interned(elem));
     ++m_size;
 }
 
@@ -226,8 +364,7 @@ template <>
 void
 t_column::push_back<char*>(char* elem) {
     COLUMN_CHECK_STRCOL();
-    t_uindex idx = m_vocab->get_interned(elem);
-    m_data->push_back(idx);
+    push_back_vocab_index(m_vocab->get_interned(elem));
     ++m_size;
 }
 
@@ -244,7 +381,7 @@ void
 t_column::push_back<const char*>(const char* elem, t_status status) {
     COLUMN_CHECK_STRCOL();
     push_back(elem);
-    m_status->push_back(status);
+    push_back_status(status);
     ++m_size;
 }
 
@@ -253,7 +390,7 @@ void
 t_column::push_back<char*>(char* elem, t_status status) {
     COLUMN_CHECK_STRCOL();
     push_back(elem);
-    m_status->push_back(status);
+    push_back_status(status);
     ++m_size;
 }
 
@@ -262,7 +399,7 @@ void
 t_column::push_back<std::string>(std::string elem, t_status status) {
     COLUMN_CHECK_STRCOL();
     push_back(std::move(elem));
-    m_status->push_back(status);
+    push_back_status(status);
     ++m_size;
 }
 
@@ -341,7 +478,7 @@ void
 t_column::set_size(t_uindex size) {
 #ifdef PSP_COLUMN_VERIFY
     PSP_VERBOSE_ASSERT(
-        size * get_dtype_size(m_dtype) <= m_data->capacity(),
+        size * m_elemsize <= m_data->capacity(),
         "Not enough space reserved for column"
     );
 #endif
@@ -349,16 +486,65 @@ t_column::set_size(t_uindex size) {
     m_data->set_size(m_elemsize * size);
 
     if (is_status_enabled()) {
-        m_status->set_size(get_dtype_size(DTYPE_UINT8) * size);
+        resize_status(size);
     }
 }
 
 void
 t_column::reserve(t_uindex size) {
-    m_data->reserve(get_dtype_size(m_dtype) * size);
+    m_data->reserve(m_elemsize * size);
     if (is_status_enabled()) {
-        m_status->reserve(get_dtype_size(DTYPE_UINT8) * size);
+        m_status->reserve(get_status_bytes(size));
+        m_cleared->reserve(get_status_bytes(size));
+    }
+}
+
+t_uindex
+t_column::get_status_bytes(t_uindex size) {
+    return (size + 63) / 64 * sizeof(std::uint64_t);
+}
+
+void
+t_column::push_back_status(t_status status) {
+    if (m_status_size % 64 == 0) {
+        *(m_status->extend<std::uint64_t>()) = 0;
+        *(m_cleared->extend<std::uint64_t>()) = 0;
     }
+
+    store_status(m_status_size, status);
+    ++m_status_size;
+}
+
+void
+t_column::resize_status(t_uindex size) {
+    t_uindex nbytes = get_status_bytes(size);
+    m_status->reserve(nbytes);
+    m_status->set_size(nbytes);
+    m_cleared->reserve(nbytes);
+    m_cleared->set_size(nbytes);
+    m_status_size = size;
+}
+
+void
+t_column::append_status(const t_column& other) {
+    t_uindex offset = m_status_size;
+    t_uindex size = other.m_status_size;
+    resize_status(offset + size);
+
+    copy_bits(
+        reinterpret_cast<const std::uint8_t*>(other.get_validity_words()),
+        0,
+        m_status->get_nth<std::uint64_t>(0),
+        offset,
+        size
+    );
+    copy_bits(
+        reinterpret_cast<const std::uint8_t*>(other.get_cleared_words()),
+        0,
+        m_cleared->get_nth<std::uint64_t>(0),
+        offset,
+        size
+    );
 }
 
 // object storage, specialize only for std::uint64_t
@@ -400,6 +586,8 @@ t_column::get_vlenidx() const {
 t_tscalar
 t_column::get_scalar(t_uindex idx) const {
     COLUMN_CHECK_ACCESS(idx);
+    // Read through a const store so lookups never detach borrowed data.
+    const t_lstore& data = *m_data;
     t_tscalar rv;
     rv.clear();
 
@@ -407,63 +595,60 @@ t_column::get_scalar(t_uindex idx) const {
         case DTYPE_NONE: {
         } break;
         case DTYPE_INT64: {
-            rv.set(*(m_data->get_nth<std::int64_t>(idx)));
+            rv.set(*(data.get_nth<std::int64_t>(idx)));
         } break;
         case DTYPE_INT32: {
-            rv.set(*(m_data->get_nth<std::int32_t>(idx)));
+            rv.set(*(data.get_nth<std::int32_t>(idx)));
         } break;
         case DTYPE_INT16: {
-            rv.set(*(m_data->get_nth<std::int16_t>(idx)));
+            rv.set(*(data.get_nth<std::int16_t>(idx)));
         } break;
         case DTYPE_INT8: {
-            rv.set(*(m_data->get_nth<std::int8_t>(idx)));
+            rv.set(*(data.get_nth<std::int8_t>(idx)));
         } break;
 
         case DTYPE_UINT64: {
-            rv.set(*(m_data->get_nth<std::uint64_t>(idx)));
+            rv.set(*(data.get_nth<std::uint64_t>(idx)));
         } break;
         case DTYPE_UINT32: {
-            rv.set(*(m_data->get_nth<std::uint32_t>(idx)));
+            rv.set(*(data.get_nth<std::uint32_t>(idx)));
         } break;
         case DTYPE_UINT16: {
-            rv.set(*(m_data->get_nth<std::uint16_t>(idx)));
+            rv.set(*(data.get_nth<std::uint16_t>(idx)));
         } break;
         case DTYPE_UINT8: {
-            rv.set(*(m_data->get_nth<std::uint8_t>(idx)));
+            rv.set(*(data.get_nth<std::uint8_t>(idx)));
         } break;
 
         case DTYPE_FLOAT64: {
-            rv.set(*(m_data->get_nth<double>(idx)));
+            rv.set(*(data.get_nth<double>(idx)));
         } break;
         case DTYPE_FLOAT32: {
-            rv.set(*(m_data->get_nth<float>(idx)));
+            rv.set(*(data.get_nth<float>(idx)));
         } break;
         case DTYPE_BOOL: {
-            rv.set(*(m_data->get_nth<bool>(idx)));
+            rv.set(*(data.get_nth<bool>(idx)));
         } break;
         case DTYPE_TIME: {
-            const t_time::t_rawtype* v =
-                m_data->get_nth<t_time::t_rawtype>(idx);
+            const t_time::t_rawtype* v = data.get_nth<t_time::t_rawtype>(idx);
             rv.set(t_time(*v));
         } break;
         case DTYPE_DATE: {
-            const t_date::t_rawtype* v =
-                m_data->get_nth<t_date::t_rawtype>(idx);
+            const t_date::t_rawtype* v = data.get_nth<t_date::t_rawtype>(idx);
             rv.set(t_date(*v));
         } break;
         case DTYPE_STR: {
             COLUMN_CHECK_STRCOL();
-            const t_uindex* sidx = m_data->get_nth<t_uindex>(idx);
-            rv.set(m_vocab->unintern_c(*sidx));
+            rv.set(m_vocab->unintern_c(get_vocab_index(idx)));
         } break;
         case DTYPE_F64PAIR: {
             const std::pair<double, double>* pair =
-                m_data->get_nth<std::pair<double, double>>(idx);
+                data.get_nth<std::pair<double, double>>(idx);
             rv.set(pair->first / pair->second);
         } break;
         case DTYPE_OBJECT: {
             // set as uint64_t
-            rv.set(*(m_data->get_nth<std::uint64_t>(idx)));
+            rv.set(*(data.get_nth<std::uint64_t>(idx)));
 
             // Maintain DTYPE info
             rv.m_type = DTYPE_OBJECT;
@@ -474,7 +659,7 @@ t_column::get_scalar(t_uindex idx) const {
     }
 
     if (is_status_enabled()) {
-        rv.m_status = *get_nth_status(idx);
+        rv.m_status = get_nth_status(idx);
     }
     return rv;
 }
@@ -493,8 +678,10 @@ void
 t_column::clear(t_uindex idx, t_status status) {
     switch (m_dtype) {
         case DTYPE_STR: {
-            t_uindex v = 0;
-            set_nth<t_uindex>(idx, v, status);
+            set_vocab_index(idx, 0);
+            if (is_status_enabled()) {
+                store_status(idx, status);
+            }
         } break;
         case DTYPE_TIME:
         case DTYPE_FLOAT64:
@@ -545,33 +732,77 @@ const char*
 t_column::get_nth<const char>(t_uindex idx) const {
     COLUMN_CHECK_ACCESS(idx);
     COLUMN_CHECK_STRCOL();
-    const auto* sidx = get_nth<t_uindex>(idx);
-    return m_vocab->unintern_c(*sidx);
+    return m_vocab->unintern_c(get_vocab_index(idx));
 }
 
 // idx is in items
-const t_status*
+t_status
 t_column::get_nth_status(t_uindex idx) const {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
     COLUMN_CHECK_ACCESS(idx);
-    auto* status = m_status->get_nth<t_status>(idx);
-    return status;
+    if (test_bit(get_validity_words(), idx)) {
+        return STATUS_VALID;
+    }
+
+    return test_bit(get_cleared_words(), idx) ? STATUS_CLEAR : STATUS_INVALID;
 }
 
 bool
 t_column::is_valid(t_uindex idx) const {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
     COLUMN_CHECK_ACCESS(idx);
-    t_status status = *m_status->get_nth<t_status>(idx);
-    return status == STATUS_VALID;
+    return test_bit(get_validity_words(), idx);
 }
 
 bool
 t_column::is_cleared(t_uindex idx) const {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
     COLUMN_CHECK_ACCESS(idx);
-    t_status status = *m_status->get_nth<t_status>(idx);
-    return status == STATUS_CLEAR;
+    return test_bit(get_cleared_words(), idx);
+}
+
+const std::uint64_t*
+t_column::get_validity_words() const {
+    return static_cast<const t_lstore&>(*m_status).get_nth<std::uint64_t>(0);
+}
+
+const std::uint64_t*
+t_column::get_cleared_words() const {
+    return static_cast<const t_lstore&>(*m_cleared).get_nth<std::uint64_t>(0);
+}
+
+void
+t_column::set_validity(
+    const std::uint8_t* bitmap,
+    t_uindex bit_offset,
+    t_uindex offset,
+    t_uindex size,
+    t_status invalid_status
+) {
+    PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
+    PSP_VERBOSE_ASSERT(
+        offset + size <= m_status_size, "Not enough space reserved for column"
+    );
+
+    auto* valid = m_status->get_nth<std::uint64_t>(0);
+    auto* cleared = m_cleared->get_nth<std::uint64_t>(0);
+
+    for (t_uindex done = 0; done < size; done += 64) {
+        t_uindex nbits = std::min<t_uindex>(64, size - done);
+        std::uint64_t mask =
+            nbits < 64 ? (std::uint64_t(1) << nbits) - 1 : ~std::uint64_t(0);
+        std::uint64_t bits = bitmap == nullptr
+            ? mask
+            : load_bits(bitmap, bit_offset + done, nbits);
+
+        store_bits(valid, offset + done, bits, nbits);
+        store_bits(
+            cleared,
+            offset + done,
+            invalid_status == STATUS_CLEAR ? (~bits & mask) : 0,
+            nbits
+        );
+    }
 }
 
 template <>
@@ -614,7 +845,7 @@ t_column::set_valid(t_uindex idx, bool valid) {
 void
 t_column::set_status(t_uindex idx, t_status status) {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
-    m_status->set_nth<t_status>(idx, status);
+    store_status(idx, status);
 }
 
 void
@@ -713,10 +944,12 @@ t_column::append(const t_column& other) {
     if (is_vlen()) {
         if (size() == 0) {
 
+            m_elemsize = other.m_elemsize;
             m_data->fill(*other.m_data);
 
             if (other.is_status_enabled()) {
                 m_status->fill(*other.m_status);
+                m_cleared->fill(*other.m_cleared);
             }
 
             m_vocab->fill(
@@ -735,19 +968,78 @@ t_column::append(const t_column& other) {
             }
 
             if (is_status_enabled()) {
-                m_status->append(*other.m_status);
+                append_status(other);
             }
         }
     } else {
         m_data->append(*other.m_data);
 
         if (is_status_enabled()) {
-            m_status->append(*other.m_status);
+            append_status(other);
         }
     }
     COLUMN_CHECK_VALUES();
 }
 
+bool
+t_column::borrow_data(
+    std::shared_ptr<const void> owner, const void* base, t_uindex size
+) {
+    if (is_vlen()) {
+        return false;
+    }
+
+    return m_data->borrow(std::move(owner), base, size * m_elemsize);
+}
+
+bool
+t_column::borrow_data(const t_column& other) {
+    PSP_VERBOSE_ASSERT(m_dtype == other.m_dtype, "Mismatched dtypes detected");
+    if (is_vlen() || !other.m_data->is_borrowed()
+        || is_status_enabled() != other.is_status_enabled()) {
+        return false;
+    }
+
+    if (other.is_status_enabled()) {
+        // A row is `STATUS_INVALID` when neither its valid nor its cleared
+        // bit is set.
+        const std::uint64_t* valid = other.get_validity_words();
+        const std::uint64_t* cleared = other.get_cleared_words();
+        t_uindex nrows = other.size();
+        for (t_uindex widx = 0; widx * 64 < nrows; ++widx) {
+            t_uindex nbits = std::min<t_uindex>(64, nrows - widx * 64);
+            std::uint64_t mask = nbits < 64 ? (std::uint64_t(1) << nbits) - 1
+                                            : ~std::uint64_t(0);
+            if (((valid[widx] | cleared[widx]) & mask) != mask) {
+                return false;
+            }
+        }
+    }
+
+    if (!m_data->borrow(*other.m_data)) {
+        return false;
+    }
+
+    if (is_status_enabled()) {
+        m_status->fill(*other.m_status);
+        m_cleared->fill(*other.m_cleared);
+        m_status_size = other.m_status_size;
+    }
+
+    m_size = other.size();
+    return true;
+}
+
+void
+t_column::detach_data() {
+    m_data->detach();
+}
+
+bool
+t_column::is_data_borrowed() const {
+    return m_data->is_borrowed();
+}
+
 void
 t_column::clear() {
     // clear out the data store
@@ -757,6 +1049,8 @@ t_column::clear() {
     }
     if (is_status_enabled()) {
         m_status->clear();
+        m_cleared->clear();
+        m_status_size = 0;
     }
     m_size = 0;
 }
@@ -790,10 +1084,12 @@ t_column::get_recipe() const {
     rval.m_status_enabled = m_status_enabled;
     if (m_status_enabled) {
         rval.m_status = m_status->get_recipe();
+        rval.m_cleared = m_cleared->get_recipe();
     }
 
     rval.m_vlenidx = get_vlenidx();
     rval.m_size = m_size;
+    rval.m_elemsize = m_elemsize;
     return rval;
 }
 
@@ -824,6 +1120,7 @@ t_column::clone() const {
 
     if (rval->is_status_enabled()) {
         rval->m_status->fill(*m_status);
+        rval->m_cleared->fill(*m_cleared);
     }
 
     if (is_vlen_dtype(get_dtype())) {
@@ -846,10 +1143,17 @@ t_column::clone(const t_mask& mask) const {
     rval->init();
     rval->set_size(mask.size());
 
-    rval->m_data->fill(*m_data, mask, get_dtype_size(get_dtype()));
+    rval->m_data->fill(*m_data, mask, m_elemsize);
 
     if (rval->is_status_enabled()) {
-        rval->m_status->fill(*m_status, mask, sizeof(t_status));
+        t_uindex count = 0;
+        for (t_uindex idx = 0, loop_end = mask.size(); idx < loop_end; ++idx) {
+            if (mask.get(idx)) {
+                rval->store_status(count, get_nth_status(idx));
+                ++count;
+            }
+        }
+        rval->resize_status(count);
     }
 
     if (is_vlen_dtype(get_dtype())) {
@@ -863,12 +1167,14 @@ t_column::clone(const t_mask& mask) const {
 
 void
 t_column::valid_raw_fill() {
-    m_status->raw_fill(STATUS_VALID);
+    m_status->raw_fill(~std::uint64_t(0));
+    m_cleared->raw_fill(std::uint64_t(0));
 }
 
 void
 t_column::invalid_raw_fill() {
-    m_status->raw_fill(STATUS_INVALID);
+    m_status->raw_fill(std::uint64_t(0));
+    m_cleared->raw_fill(std::uint64_t(0));
 }
 
 void
@@ -981,18 +1287,18 @@ t_column::verify_size(t_uindex idx) const {
     }
 
     PSP_VERBOSE_ASSERT(
-        idx * get_dtype_size(m_dtype) <= m_data->capacity(),
+        idx * m_elemsize <= m_data->capacity(),
         "Not enough space reserved for column"
     );
 
     PSP_VERBOSE_ASSERT(
-        idx * get_dtype_size(m_dtype) <= m_data->capacity(),
+        idx * m_elemsize <= m_data->capacity(),
         "Not enough space reserved for column"
     );
 
     if (is_status_enabled()) {
         PSP_VERBOSE_ASSERT(
-            idx * get_dtype_size(DTYPE_UINT8) <= m_status->capacity(),
+            get_status_bytes(idx) <= m_status->capacity(),
             "Not enough space reserved for column"
         );
     }
@@ -1022,4 +1328,138 @@ t_column::borrow_vocabulary(const t_column& o) {
     m_vocab = const_cast<t_column&>(o).m_vocab;
 }
 
+std::uint32_t
+t_column::get_initial_elemsize(t_dtype dtype) {
+    if (dtype == DTYPE_STR) {
+        return sizeof(std::uint8_t);
+    }
+
+    return is_deterministic_sized(dtype) ? get_dtype_size(dtype) : 0;
+}
+
+std::uint32_t
+t_column::get_vocab_index_width() const {
+    return m_elemsize;
+}
+
+void
+t_column::set_vocab_index_width(std::uint32_t width) {
+    COLUMN_CHECK_STRCOL();
+    std::uint32_t owidth = m_elemsize;
+    if (width == owidth) {
+        return;
+    }
+
+    // Re-encode every id in place, across the full capacity so that rows
+    // written ahead of `set_size` survive. Widening walks back to front and
+    // narrowing front to back, so no id is overwritten before it is read.
+    t_uindex nrows = m_data->size() / owidth;
+    t_uindex capacity = m_data->capacity() / owidth;
+
+    if (width > owidth) {
+        m_data->reserve(capacity * width);
+        auto* base = m_data->get_nth<unsigned char>(0);
+        for (t_uindex idx = capacity; idx-- > 0;) {
+            store_vocab_index(
+                base, idx, width, load_vocab_index(base, idx, owidth)
+            );
+        }
+    } else {
+        auto* base = m_data->get_nth<unsigned char>(0);
+        for (t_uindex idx = 0; idx < capacity; ++idx) {
+            store_vocab_index(
+                base, idx, width, load_vocab_index(base, idx, owidth)
+            );
+        }
+    }
+
+    m_data->set_size(nrows * width);
+    if (width < owidth) {
+        m_data->shrink(capacity * width);
+    }
+
+    m_elemsize = width;
+}
+
+void
+t_column::push_back_vocab_index(t_uindex vidx) {
+    fit_vocab_index(vidx);
+    switch (m_elemsize) {
+        case 1: {
+            m_data->push_back(static_cast<std::uint8_t>(vidx));
+        } break;
+        case 2: {
+            m_data->push_back(static_cast<std::uint16_t>(vidx));
+        } break;
+        case 4: {
+            m_data->push_back(static_cast<std::uint32_t>(vidx));
+        } break;
+        default: {
+            m_data->push_back(static_cast<std::uint64_t>(vidx));
+        }
+    }
+}
+
+void
+t_column::push_back_vocab_index(t_uindex vidx, t_status status) {
+    COLUMN_CHECK_STRCOL();
+    push_back_vocab_index(vidx);
+    push_back_status(status);
+    ++m_size;
+}
+
+std::vector<bool>
+t_column::get_live_vocabulary(const t_mask& live_rows) const {
+    std::vector<bool> live(m_vocab->get_vlenidx(), false);
+    t_uindex nrows = std::min(size(), live_rows.size());
+
+    visit_vocab_indices([&](const auto* data) {
+        for (t_uindex idx = 0; idx < nrows; ++idx) {
+            if (live_rows.get(idx)) {
+                live[data[idx]] = true;
+            }
+        }
+    });
+
+    return live;
+}
+
+std::vector<t_uindex>
+t_column::compact_vocabulary(const t_mask& live_rows) {
+    PSP_VERBOSE_ASSERT(
+        m_dtype == DTYPE_STR, "Only string columns have a vocabulary"
+    );
+
+    std::vector<t_uindex> remap =
+        m_vocab->compact(get_live_vocabulary(live_rows));
+
+    visit_vocab_indices([&](auto* data) {
+        typedef std::remove_pointer_t<decltype(data)> t_index_type;
+        for (t_uindex idx = 0, loop_end = size(); idx < loop_end; ++idx) {
+            data[idx] = idx < live_rows.size() && live_rows.get(idx)
+                ? static_cast<t_index_type>(remap[data[idx]])
+                : 0;
+        }
+    });
+
+    // Ids only shrink, so the column may now fit in a narrower width.
+    std::uint32_t width = sizeof(std::uint8_t);
+    t_uindex max_vidx = get_vlenidx() > 0 ? get_vlenidx() - 1 : 0;
+    while (width < m_elemsize && (max_vidx >> (8 * width)) != 0) {
+        width *= 2;
+    }
+
+    set_vocab_index_width(width);
+    return remap;
+}
+
+t_uindex
+t_column::get_reclaimable_vocab_bytes(const t_mask& live_rows) const {
+    PSP_VERBOSE_ASSERT(
+        m_dtype == DTYPE_STR, "Only string columns have a vocabulary"
+    );
+
+    return m_vocab->reclaimable_bytes(get_live_vocabulary(live_rows));
+}
+
 } // end namespace perspective
@@ -11,6 +11,9 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 #include <perspective/computed_expression.h>
+#include <perspective/env_vars.h>
+#include <perspective/pyutils.h>
+#include <perspective/parallel_for.h>
 
 #include <utility>
 
@@ -34,6 +37,8 @@ std::shared_ptr<exprtk::parser<t_tscalar>>
             t_computed_expression_parser::PARSER_COMPILE_OPTIONS
         );
 
+std::shared_mutex t_computed_expression_parser::PARSER_LOCK;
+
 computed_function::bucket t_computed_expression_parser::BUCKET_FN =
     computed_function::bucket();
 
@@ -112,7 +117,9 @@ t_computed_expression::t_computed_expression(
     m_expression_string(std::move(expression_string)),
     m_parsed_expression_string(std::move(parsed_expression_string)),
     m_column_ids(column_ids),
-    m_dtype(dtype) {}
+    m_dtype(dtype) {
+    m_bytecode.compile(m_parsed_expression_string, m_column_ids);
+}
 
 void
 t_computed_expression::compute(
@@ -122,6 +129,17 @@ t_computed_expression::compute(
     t_expression_vocab& vocab,
     t_regex_mapping& regex_mapping
 ) const {
+    // Bytecode results are always `DTYPE_FLOAT64`, so it can only stand in
+    // for ExprTk when that is the type the expression validated to.
+    if (m_dtype == DTYPE_FLOAT64 && !t_env::backout_expression_bytecode()
+        && m_bytecode.can_evaluate(*source_table)) {
+        auto output_column = destination_table->add_column_sptr(
+            m_expression_alias, m_dtype, true
+        );
+        m_bytecode.evaluate(*source_table, *output_column);
+        return;
+    }
+
     // TODO: share symtables across pre/re/compute
     exprtk::symbol_table<t_tscalar> sym_table;
 
@@ -160,15 +178,19 @@ t_computed_expression::compute(
 
     expr_definition.register_symbol_table(sym_table);
 
-    if (!t_computed_expression_parser::PARSER->compile(
-            m_parsed_expression_string, expr_definition
-        )) {
-        std::stringstream ss;
-        ss << "[t_computed_expression::compute] Failed to parse expression: `"
-           << m_parsed_expression_string << "`, failed with error: "
-           << t_computed_expression_parser::PARSER->error() << '\n';
-
-        PSP_COMPLAIN_AND_ABORT(ss.str());
+    {
+        PSP_WRITE_LOCK(t_computed_expression_parser::PARSER_LOCK);
+        if (!t_computed_expression_parser::PARSER->compile(
+                m_parsed_expression_string, expr_definition
+            )) {
+            std::stringstream ss;
+            ss << "[t_computed_expression::compute] Failed to parse "
+                  "expression: `"
+               << m_parsed_expression_string << "`, failed with error: "
+               << t_computed_expression_parser::PARSER->error() << '\n';
+
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
     }
 
     // create or get output column using m_expression_alias
@@ -197,6 +219,38 @@ t_computed_expression::compute(
     function_store.clear_computed_function_state();
 };
 
+void
+t_computed_expression::compute_all(
+    const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+    const std::shared_ptr<t_data_table>& source_table,
+    const t_gstate::t_mapping& pkey_map,
+    const std::shared_ptr<t_data_table>& destination_table,
+    t_expression_vocab& vocab,
+    t_regex_mapping& regex_mapping
+) {
+    // Adding a column mutates the destination table's schema, so it must
+    // happen before the parallel section.
+    for (const auto& expr : expressions) {
+        destination_table->add_column_sptr(
+            expr->get_expression_alias(), expr->get_dtype(), true
+        );
+    }
+
+    parallel_for(
+        int(expressions.size()),
+        [&expressions,
+         &source_table,
+         &pkey_map,
+         &destination_table,
+         &vocab,
+         &regex_mapping](int idx) {
+            expressions[idx]->compute(
+                source_table, pkey_map, destination_table, vocab, regex_mapping
+            );
+        }
+    );
+}
+
 const std::string&
 t_computed_expression::get_expression_alias() const {
     return m_expression_alias;
@@ -229,6 +283,7 @@ t_computed_expression::get_dtype() const {
 
 void
 t_computed_expression_parser::init() {
+    PSP_WRITE_LOCK(t_computed_expression_parser::PARSER_LOCK);
     t_computed_expression_parser::PARSER->settings()
         .disable_control_structure(
             exprtk::parser<t_tscalar>::settings_store::e_ctrl_repeat_loop
@@ -299,6 +354,7 @@ t_computed_expression_parser::precompute(
     exprtk::expression<t_tscalar> expr_definition;
     expr_definition.register_symbol_table(sym_table);
 
+    PSP_WRITE_LOCK(t_computed_expression_parser::PARSER_LOCK);
     if (!t_computed_expression_parser::PARSER->compile(
             parsed_expression_string, expr_definition
         )) {
@@ -391,6 +447,7 @@ t_computed_expression_parser::get_dtype(
     exprtk::expression<t_tscalar> expr_definition;
     expr_definition.register_symbol_table(sym_table);
 
+    PSP_WRITE_LOCK(t_computed_expression_parser::PARSER_LOCK);
     if (!t_computed_expression_parser::PARSER->compile(
             parsed_expression_string, expr_definition
         )) {
@@ -50,9 +50,9 @@ t_ctx_grouped_pkey::init() {
     m_tree->init();
     m_traversal = std::make_shared<t_traversal>(m_tree);
 
-    // Each context stores its own expression columns in separate
-    // `t_data_table`s so that each context's expressions are isolated
-    // and do not affect other contexts when they are calculated.
+    // Each context stores its expression columns in separate `t_data_table`s
+    // under its own aliases. The columns are computed by the gnode, which
+    // shares them between contexts that use the same expression.
     const auto& expressions = m_config.get_expressions();
     m_expression_tables = std::make_shared<t_expression_tables>(expressions);
 
@@ -714,117 +714,6 @@ t_ctx_grouped_pkey::get_column_dtype(t_uindex idx) const {
     return aggtable->get_const_column(idx - 1)->get_dtype();
 }
 
-void
-t_ctx_grouped_pkey::compute_expressions(
-    const std::shared_ptr<t_data_table>& master,
-    const t_gstate::t_mapping& pkey_map,
-    t_expression_vocab& expression_vocab,
-    t_regex_mapping& regex_mapping
-) {
-    // Clear the transitional expression tables on the context so they are
-    // ready for the next update.
-    m_expression_tables->clear_transitional_tables();
-
-    std::shared_ptr<t_data_table> master_expression_table =
-        m_expression_tables->m_master;
-
-    // Set the master table to the right size.
-    t_uindex num_rows = master->size();
-    master_expression_table->reserve(num_rows);
-    master_expression_table->set_size(num_rows);
-
-    const auto& expressions = m_config.get_expressions();
-    for (const auto& expr : expressions) {
-        // Compute the expressions on the master table.
-        expr->compute(
-            master,
-            pkey_map,
-            master_expression_table,
-            expression_vocab,
-            regex_mapping
-        );
-    }
-}
-
-void
-t_ctx_grouped_pkey::compute_expressions(
-    const std::shared_ptr<t_data_table>& master,
-    const t_gstate::t_mapping& pkey_map,
-    const std::shared_ptr<t_data_table>& flattened,
-    const std::shared_ptr<t_data_table>& delta,
-    const std::shared_ptr<t_data_table>& prev,
-    const std::shared_ptr<t_data_table>& current,
-    const std::shared_ptr<t_data_table>& transitions,
-    const std::shared_ptr<t_data_table>& existed,
-    t_expression_vocab& expression_vocab,
-    t_regex_mapping& regex_mapping
-) {
-    // Clear the tables so they are ready for this round of updates
-    m_expression_tables->clear_transitional_tables();
-
-    // All tables are the same size
-    t_uindex flattened_num_rows = flattened->size();
-    m_expression_tables->reserve_transitional_table_size(flattened_num_rows);
-    m_expression_tables->set_transitional_table_size(flattened_num_rows);
-
-    // Update the master expression table's size
-    t_uindex master_num_rows = master->size();
-    m_expression_tables->m_master->reserve(master_num_rows);
-    m_expression_tables->m_master->set_size(master_num_rows);
-
-    const auto& expressions = m_config.get_expressions();
-    for (const auto& expr : expressions) {
-        // master: compute based on latest state of the gnode state table
-        expr->compute(
-            master,
-            pkey_map,
-            m_expression_tables->m_master,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // flattened: compute based on the latest update dataset
-        expr->compute(
-            flattened,
-            pkey_map,
-            m_expression_tables->m_flattened,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // delta: for each numerical column, the numerical delta between the
-        // previous value and the current value in the row.
-        expr->compute(
-            delta,
-            pkey_map,
-            m_expression_tables->m_delta,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // prev: the values of the updated rows before this update was applied
-        expr->compute(
-            prev,
-            pkey_map,
-            m_expression_tables->m_prev,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // current: the current values of the updated rows
-        expr->compute(
-            current,
-            pkey_map,
-            m_expression_tables->m_current,
-            expression_vocab,
-            regex_mapping
-        );
-    }
-
-    // Calculate the transitions now that the intermediate tables are computed
-    m_expression_tables->calculate_transitions(existed);
-}
-
 t_uindex
 t_ctx_grouped_pkey::num_expressions() const {
     const auto& expressions = m_config.get_expressions();
@@ -19,6 +19,9 @@
 
 #include <perspective/traversal.h>
 
+#include <perspective/env_vars.h>
+#include <perspective/parallel_for.h>
+#include <chrono>
 #include <utility>
 
 namespace perspective {
@@ -27,14 +30,16 @@ t_ctx2::t_ctx2() :
     m_row_depth(0),
     m_row_depth_set(false),
     m_column_depth(0),
-    m_column_depth_set(false) {}
+    m_column_depth_set(false),
+    m_lazy_row_trees(t_env::ctx2_lazy_row_trees()) {}
 
 t_ctx2::t_ctx2(const t_schema& schema, const t_config& pivot_config) :
     t_ctxbase<t_ctx2>(schema, pivot_config),
     m_row_depth(0),
     m_row_depth_set(false),
     m_column_depth(0),
-    m_column_depth_set(false) {}
+    m_column_depth_set(false),
+    m_lazy_row_trees(t_env::ctx2_lazy_row_trees()) {}
 
 t_ctx2::~t_ctx2() = default;
 
@@ -57,35 +62,21 @@ t_ctx2::init() {
     for (t_uindex treeidx = 0, tree_loop_end = m_trees.size();
          treeidx < tree_loop_end;
          ++treeidx) {
-        std::vector<t_pivot> pivots;
-        if (treeidx > 0) {
-            pivots.insert(
-                pivots.end(),
-                m_config.get_row_pivots().begin(),
-                m_config.get_row_pivots().begin() + treeidx
-            );
-        }
-
-        pivots.insert(
-            pivots.end(),
-            m_config.get_column_pivots().begin(),
-            m_config.get_column_pivots().end()
-        );
-
-        m_trees[treeidx] = std::make_shared<t_stree>(
-            pivots, m_config.get_aggregates(), m_schema, m_config
-        );
-
-        m_trees[treeidx]->init();
+        m_trees[treeidx] = make_tree(treeidx);
     }
 
+    // Without lazy row trees every tree is always materialized.
+    m_tree_materialized = std::vector<bool>(m_trees.size(), !m_lazy_row_trees);
+    m_tree_materialized.front() = true;
+    m_tree_materialized.back() = true;
+
     m_rtraversal = std::make_shared<t_traversal>(rtree());
 
     m_ctraversal = std::make_shared<t_traversal>(ctree());
 
-    // Each context stores its own expression columns in separate
-    // `t_data_table`s so that each context's expressions are isolated
-    // and do not affect other contexts when they are calculated.
+    // Each context stores its expression columns in separate `t_data_table`s
+    // under its own aliases. The columns are computed by the gnode, which
+    // shares them between contexts that use the same expression.
     const auto& expressions = m_config.get_expressions();
     m_expression_tables = std::make_shared<t_expression_tables>(expressions);
 
@@ -144,6 +135,7 @@ t_ctx2::open(t_header header, t_index idx) {
             retval = m_rtraversal->expand_node(m_sortby, idx);
         }
         m_rows_changed = (retval > 0);
+        update_row_trees();
     } else {
         if (!m_ctraversal->is_valid_idx(idx)) {
             return 0;
@@ -170,6 +162,7 @@ t_ctx2::close(t_header header, t_index idx) {
             m_row_depth = 0;
             retval = m_rtraversal->collapse_node(idx);
             m_rows_changed = (retval > 0);
+            update_row_trees();
         } break;
         case HEADER_COLUMN: {
             if (!m_ctraversal->is_valid_idx(idx)) {
@@ -519,6 +512,9 @@ t_ctx2::sort_by(const std::vector<t_sortspec>& sortby) {
     if (m_sortby.empty()) {
         return;
     }
+
+    // Sorting by a column path reads the cells of every visible row.
+    update_row_trees();
     m_rtraversal->sort_by(m_config, sortby, *(rtree()), this);
 }
 
@@ -531,49 +527,27 @@ t_ctx2::reset_sortby() {
 
 void
 t_ctx2::notify(const t_data_table& flattened) {
-    for (t_uindex tree_idx = 0, loop_end = m_trees.size(); tree_idx < loop_end;
-         ++tree_idx) {
-        if (is_rtree_idx(tree_idx) != 0U) {
-            notify_sparse_tree(
-                rtree(),
-                m_rtraversal,
-                true,
-                m_config.get_aggregates(),
-                m_config.get_sortby_pairs(),
-                m_sortby,
-                flattened,
-                m_config,
-                *m_gstate,
-                *(m_expression_tables->m_master)
-            );
-        } else if (is_ctree_idx(tree_idx) != 0U) {
-            notify_sparse_tree(
-                ctree(),
-                m_ctraversal,
-                true,
-                m_config.get_aggregates(),
-                m_config.get_sortby_pairs(),
-                m_column_sortby,
-                flattened,
-                m_config,
-                *m_gstate,
-                *(m_expression_tables->m_master)
-            );
-        } else {
-            notify_sparse_tree(
-                m_trees[tree_idx],
-                std::shared_ptr<t_traversal>(nullptr),
-                false,
-                m_config.get_aggregates(),
-                m_config.get_sortby_pairs(),
-                std::vector<t_sortspec>(),
-                flattened,
-                m_config,
-                *m_gstate,
-                *(m_expression_tables->m_master)
-            );
-        }
-    }
+    notify_trees([&](const std::shared_ptr<t_stree>& tree,
+                     const std::shared_ptr<t_traversal>& traversal,
+                     bool process_traversal,
+                     const std::vector<t_sortspec>& sortby) {
+        notify_sparse_tree(
+            tree,
+            traversal,
+            process_traversal,
+            m_config.get_aggregates(),
+            m_config.get_sortby_pairs(),
+            sortby,
+            flattened,
+            m_config,
+            *m_gstate,
+            *(m_expression_tables->m_master)
+        );
+    });
+
+    // New rows may have been added under expanded nodes.
+    update_row_trees();
+
     if (!m_sortby.empty()) {
         sort_by(m_sortby);
     }
@@ -588,68 +562,169 @@ t_ctx2::notify(
     const t_data_table& transitions,
     const t_data_table& existed
 ) {
+    notify_trees([&](const std::shared_ptr<t_stree>& tree,
+                     const std::shared_ptr<t_traversal>& traversal,
+                     bool process_traversal,
+                     const std::vector<t_sortspec>& sortby) {
+        notify_sparse_tree(
+            tree,
+            traversal,
+            process_traversal,
+            m_config.get_aggregates(),
+            m_config.get_sortby_pairs(),
+            sortby,
+            flattened,
+            delta,
+            prev,
+            current,
+            transitions,
+            existed,
+            m_config,
+            *m_gstate,
+            *(m_expression_tables->m_master)
+        );
+    });
+
+    // New rows may have been added under expanded nodes.
+    update_row_trees();
+
+    if (!m_sortby.empty()) {
+        sort_by(m_sortby);
+    }
+}
+
+void
+t_ctx2::notify_trees(const t_notify_tree_fn& notify_tree) {
+    t_uindex num_trees = m_trees.size();
+    m_tree_notify_times.assign(num_trees, 0);
+
+    // Each task only writes to its own tree, and the row and column trees to
+    // their own traversal - the gstate, expression tables and update tables
+    // are only read.
+    parallel_for(int(num_trees), [this, &notify_tree](int tree_idx) {
+        auto start = std::chrono::steady_clock::now();
 
-    for (t_uindex tree_idx = 0, loop_end = m_trees.size(); tree_idx < loop_end;
-         ++tree_idx) {
         if (is_rtree_idx(tree_idx) != 0U) {
-            notify_sparse_tree(
-                rtree(),
-                m_rtraversal,
-                true,
-                m_config.get_aggregates(),
-                m_config.get_sortby_pairs(),
-                m_sortby,
-                flattened,
-                delta,
-                prev,
-                current,
-                transitions,
-                existed,
-                m_config,
-                *m_gstate,
-                *(m_expression_tables->m_master)
-            );
+            notify_tree(rtree(), m_rtraversal, true, m_sortby);
         } else if (is_ctree_idx(tree_idx) != 0U) {
-            notify_sparse_tree(
-                ctree(),
-                m_ctraversal,
-                true,
-                m_config.get_aggregates(),
-                m_config.get_sortby_pairs(),
-                m_column_sortby,
-                flattened,
-                delta,
-                prev,
-                current,
-                transitions,
-                existed,
-                m_config,
-                *m_gstate,
-                *(m_expression_tables->m_master)
+            notify_tree(ctree(), m_ctraversal, true, m_column_sortby);
+        } else if (is_tree_materialized(tree_idx)) {
+            notify_tree(
+                m_trees[tree_idx],
+                std::shared_ptr<t_traversal>(nullptr),
+                false,
+                std::vector<t_sortspec>()
             );
-        } else {
+        }
+
+        m_tree_notify_times[tree_idx] =
+            std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start
+            )
+                .count();
+    });
+
+    if (t_env::log_time_ctx_notify()) {
+        for (t_uindex tree_idx = 0; tree_idx < num_trees; ++tree_idx) {
+            std::cout << repr() << " notify tree " << tree_idx << " (depth "
+                      << m_trees[tree_idx]->get_pivots().size()
+                      << " pivots) took " << m_tree_notify_times[tree_idx]
+                      << "ms" << '\n';
+        }
+    }
+}
+
+const std::vector<double>&
+t_ctx2::get_tree_notify_times() const {
+    return m_tree_notify_times;
+}
+
+std::shared_ptr<t_stree>
+t_ctx2::make_tree(t_uindex treeidx) const {
+    std::vector<t_pivot> pivots;
+    if (treeidx > 0) {
+        pivots.insert(
+            pivots.end(),
+            m_config.get_row_pivots().begin(),
+            m_config.get_row_pivots().begin() + treeidx
+        );
+    }
+
+    pivots.insert(
+        pivots.end(),
+        m_config.get_column_pivots().begin(),
+        m_config.get_column_pivots().end()
+    );
+
+    auto tree = std::make_shared<t_stree>(
+        pivots, m_config.get_aggregates(), m_schema, m_config
+    );
+    tree->init();
+    return tree;
+}
+
+bool
+t_ctx2::is_tree_materialized(t_uindex treeidx) const {
+    return m_tree_materialized[treeidx];
+}
+
+void
+t_ctx2::update_row_trees() {
+    if (!m_lazy_row_trees || m_gstate == nullptr) {
+        return;
+    }
+
+    t_depth row_depth = 0;
+    for (t_uindex idx = 0, loop_end = m_rtraversal->size(); idx < loop_end;
+         ++idx) {
+        row_depth = std::max(row_depth, m_rtraversal->get_depth(idx));
+    }
+
+    // Rows at depth `d` are read from the tree at index `d`, so the trees
+    // for depths 1 to `row_depth` must hold data.
+    std::shared_ptr<t_data_table> flattened;
+    for (t_uindex treeidx = 1, loop_end = m_trees.size() - 1;
+         treeidx < loop_end;
+         ++treeidx) {
+        bool required = static_cast<t_depth>(treeidx) <= row_depth;
+        if (required == m_tree_materialized[treeidx]) {
+            continue;
+        }
+
+        auto tree = make_tree(treeidx);
+        tree->set_alerts_enabled(get_feature_state(CTX_FEAT_ALERT));
+        tree->set_deltas_enabled(get_feature_state(CTX_FEAT_DELTA));
+
+        if (required) {
+            if (flattened == nullptr) {
+                flattened = m_gstate->get_pkeyed_table();
+                if (num_expressions() > 0) {
+                    flattened = flattened->join(m_gstate->get_pkeyed_table(
+                        m_expression_tables->m_master->get_schema(),
+                        m_expression_tables->m_master
+                    ));
+                }
+            }
+
             notify_sparse_tree(
-                m_trees[tree_idx],
+                tree,
                 std::shared_ptr<t_traversal>(nullptr),
                 false,
                 m_config.get_aggregates(),
                 m_config.get_sortby_pairs(),
                 std::vector<t_sortspec>(),
-                flattened,
-                delta,
-                prev,
-                current,
-                transitions,
-                existed,
+                *flattened,
                 m_config,
                 *m_gstate,
                 *(m_expression_tables->m_master)
             );
+
+            // The cells a tree is built with are not updates.
+            tree->clear_deltas();
         }
-    }
 
-    if (!m_sortby.empty()) {
-        sort_by(m_sortby);
+        m_trees[treeidx] = tree;
+        m_tree_materialized[treeidx] = required;
     }
 }
 
@@ -909,6 +984,7 @@ t_ctx2::set_depth(t_header header, t_depth depth) {
             m_rtraversal->set_depth(m_sortby, new_depth);
             m_row_depth = new_depth;
             m_row_depth_set = true;
+            update_row_trees();
         } break;
         case HEADER_COLUMN: {
             if (m_config.get_num_cpivots() == 0) {
@@ -1056,28 +1132,14 @@ t_ctx2::reset(bool reset_expressions) {
     for (t_uindex treeidx = 0, tree_loop_end = m_trees.size();
          treeidx < tree_loop_end;
          ++treeidx) {
-        std::vector<t_pivot> pivots;
-        if (treeidx > 0) {
-            pivots.insert(
-                pivots.end(),
-                m_config.get_row_pivots().begin(),
-                m_config.get_row_pivots().begin() + treeidx
-            );
-        }
-
-        pivots.insert(
-            pivots.end(),
-            m_config.get_column_pivots().begin(),
-            m_config.get_column_pivots().end()
-        );
-
-        m_trees[treeidx] = std::make_shared<t_stree>(
-            pivots, m_config.get_aggregates(), m_schema, m_config
-        );
-        m_trees[treeidx]->init();
+        m_trees[treeidx] = make_tree(treeidx);
         m_trees[treeidx]->set_deltas_enabled(get_feature_state(CTX_FEAT_DELTA));
     }
 
+    m_tree_materialized = std::vector<bool>(m_trees.size(), !m_lazy_row_trees);
+    m_tree_materialized.front() = true;
+    m_tree_materialized.back() = true;
+
     m_rtraversal = std::make_shared<t_traversal>(rtree());
     m_ctraversal = std::make_shared<t_traversal>(ctree());
 
@@ -1162,117 +1224,6 @@ t_ctx2::get_column_dtype(t_uindex idx) const {
         ->get_dtype();
 }
 
-void
-t_ctx2::compute_expressions(
-    const std::shared_ptr<t_data_table>& master,
-    const t_gstate::t_mapping& pkey_map,
-    t_expression_vocab& expression_vocab,
-    t_regex_mapping& regex_mapping
-) {
-    // Clear the transitional expression tables on the context so they are
-    // ready for the next update.
-    m_expression_tables->clear_transitional_tables();
-
-    std::shared_ptr<t_data_table> master_expression_table =
-        m_expression_tables->m_master;
-
-    // Set the master table to the right size.
-    t_uindex num_rows = master->size();
-    master_expression_table->reserve(num_rows);
-    master_expression_table->set_size(num_rows);
-
-    const auto& expressions = m_config.get_expressions();
-    for (const auto& expr : expressions) {
-        // Compute the expressions on the master table.
-        expr->compute(
-            master,
-            pkey_map,
-            master_expression_table,
-            expression_vocab,
-            regex_mapping
-        );
-    }
-}
-
-void
-t_ctx2::compute_expressions(
-    const std::shared_ptr<t_data_table>& master,
-    const t_gstate::t_mapping& pkey_map,
-    const std::shared_ptr<t_data_table>& flattened,
-    const std::shared_ptr<t_data_table>& delta,
-    const std::shared_ptr<t_data_table>& prev,
-    const std::shared_ptr<t_data_table>& current,
-    const std::shared_ptr<t_data_table>& transitions,
-    const std::shared_ptr<t_data_table>& existed,
-    t_expression_vocab& expression_vocab,
-    t_regex_mapping& regex_mapping
-) {
-    // Clear the tables so they are ready for this round of updates
-    m_expression_tables->clear_transitional_tables();
-
-    // All tables are the same size
-    t_uindex flattened_num_rows = flattened->size();
-    m_expression_tables->reserve_transitional_table_size(flattened_num_rows);
-    m_expression_tables->set_transitional_table_size(flattened_num_rows);
-
-    // Update the master expression table's size
-    t_uindex master_num_rows = master->size();
-    m_expression_tables->m_master->reserve(master_num_rows);
-    m_expression_tables->m_master->set_size(master_num_rows);
-
-    const auto& expressions = m_config.get_expressions();
-    for (const auto& expr : expressions) {
-        // master: compute based on latest state of the gnode state table
-        expr->compute(
-            master,
-            pkey_map,
-            m_expression_tables->m_master,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // flattened: compute based on the latest update dataset
-        expr->compute(
-            flattened,
-            pkey_map,
-            m_expression_tables->m_flattened,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // delta: for each numerical column, the numerical delta between the
-        // previous value and the current value in the row.
-        expr->compute(
-            delta,
-            pkey_map,
-            m_expression_tables->m_delta,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // prev: the values of the updated rows before this update was applied
-        expr->compute(
-            prev,
-            pkey_map,
-            m_expression_tables->m_prev,
-            expression_vocab,
-            regex_mapping
-        );
-
-        // current: the current values of the updated rows
-        expr->compute(
-            current,
-            pkey_map,
-            m_expression_tables->m_current,
-            expression_vocab,
-            regex_mapping
-        );
-    }
-
-    // Calculate the transitions now that the intermediate tables are computed
-    m_expression_tables->calculate_transitions(existed);
-}
-
 bool
 t_ctx2::is_expression_column(const std::string& colname) const {
     const t_schema& schema = m_expression_tables->m_master->get_schema();
@@ -382,6 +382,23 @@ t_ctxunit::sidedness() const {
     return 0;
 }
 
+void
+t_ctxunit::get_master_rows(
+    t_index start_row, t_index end_row, std::vector<t_rlookup>& out
+) const {
+    // View rows are master table rows in a unit context.
+    out.clear();
+    out.reserve(std::max(end_row - start_row, t_index(0)));
+    for (t_index ridx = start_row; ridx < end_row; ++ridx) {
+        out.emplace_back(ridx, true);
+    }
+}
+
+std::shared_ptr<const t_column>
+t_ctxunit::get_master_column(t_uindex idx) const {
+    return m_gstate->get_table()->get_const_column(m_config.col_at(idx));
+}
+
 t_index
 t_ctxunit::get_row_count() const {
     return m_gstate->num_rows();
@@ -15,11 +15,13 @@
 #include <perspective/raw_types.h>
 #include <perspective/data_table.h>
 #include <perspective/column.h>
+#include <perspective/filter_kernel.h>
 #include <perspective/storage.h>
 #include <perspective/scalar.h>
 #include <perspective/tracing.h>
 #include <perspective/utils.h>
 
+#include <limits>
 #include <sstream>
 #include <utility>
 namespace perspective {
@@ -137,7 +139,7 @@ t_data_table::make_column(
     t_lstore_recipe a(
         m_dirname,
         m_name + std::string("_") + colname,
-        m_capacity * get_dtype_size(dtype),
+        m_capacity * t_column::get_initial_elemsize(dtype),
         m_backing_store
     );
     return std::make_shared<t_column>(dtype, status_enabled, a, m_capacity);
@@ -479,83 +481,30 @@ t_mask
 t_data_table::filter_cpp(
     t_filter_op combiner, const std::vector<t_fterm>& fterms_
 ) const {
-    auto* self = const_cast<t_data_table*>(this);
     auto fterms = fterms_;
 
-    t_mask mask(size());
     t_uindex fterm_size = fterms.size();
-    std::vector<t_uindex> indices(fterm_size);
     std::vector<const t_column*> columns(fterm_size);
 
     for (t_uindex idx = 0; idx < fterm_size; ++idx) {
-        indices[idx] = m_schema.get_colidx(fterms[idx].m_colname);
         columns[idx] = get_const_column(fterms[idx].m_colname).get();
         fterms[idx].coerce_numeric(columns[idx]->get_dtype());
         if (fterms[idx].m_use_interned) {
+            // Contexts filter shared tables concurrently, so the threshold
+            // is looked up rather than interned, which could widen the ids
+            // under another reader. A string missing from the vocabulary
+            // gets an id no row holds.
             t_tscalar& thr = fterms[idx].m_threshold;
-            auto col = self->get_column(fterms[idx].m_colname);
-            auto interned = col->get_interned(thr.get_char_ptr());
+            t_uindex interned;
+            if (!columns[idx]->string_exists(thr.get_char_ptr(), interned)) {
+                interned = std::numeric_limits<t_uindex>::max();
+            }
+
             thr.set(interned);
         }
     }
 
-    switch (combiner) {
-        case FILTER_OP_AND: {
-            t_tscalar cell_val;
-
-            for (t_uindex ridx = 0, rloop_end = size(); ridx < rloop_end;
-                 ++ridx) {
-                bool pass = true;
-
-                for (t_uindex cidx = 0; cidx < fterm_size; ++cidx) {
-                    if (!pass) {
-                        break;
-                    }
-
-                    // TODO we can make this faster by not constructing these on
-                    // every iteration?
-
-                    const auto& ft = fterms[cidx];
-                    bool tval;
-
-                    if (ft.m_use_interned) {
-                        cell_val.set(*(columns[cidx]->get_nth<t_uindex>(ridx)));
-                        cell_val.set_status(*(columns[cidx]->get_nth_status(ridx
-                        )));
-                    } else {
-                        cell_val = columns[cidx]->get_scalar(ridx);
-                    }
-
-                    tval = ft(cell_val);
-                    if (!tval) {
-                        pass = false;
-                        break;
-                    }
-                }
-
-                mask.set(ridx, pass);
-            }
-        } break;
-        case FILTER_OP_OR: {
-            for (t_uindex ridx = 0, rloop_end = size(); ridx < rloop_end;
-                 ++ridx) {
-                bool pass = false;
-                for (t_uindex cidx = 0; cidx < fterm_size; ++cidx) {
-                    t_tscalar cell_val = columns[cidx]->get_scalar(ridx);
-                    if (fterms[cidx](cell_val)) {
-                        pass = true;
-                        break;
-                    }
-                }
-                mask.set(ridx, pass);
-            }
-        } break;
-        default: {
-            PSP_COMPLAIN_AND_ABORT("Unknown filter op");
-        } break;
-    }
-
-    return mask;
+    return filter_columns(combiner, fterms, columns, size());
 }
 
 t_uindex
@@ -0,0 +1,511 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/expression_bytecode.h>
+#include <tsl/hopscotch_map.h>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+namespace perspective {
+
+namespace {
+
+    // Rows are evaluated in blocks of this size, so that each instruction is
+    // a tight loop over a buffer that stays in cache.
+    const t_uindex BYTECODE_BLOCK_SIZE = 1024;
+
+    /**
+     * @brief A recursive descent parser for the subset of the ExprTk grammar
+     * that `t_expression_bytecode` supports, which emits postfix bytecode.
+     * Operator precedence and associativity match ExprTk's.
+     */
+    class t_bytecode_parser {
+    public:
+        t_bytecode_parser(
+            const std::string& expression,
+            const tsl::hopscotch_map<std::string, t_uindex>& column_index,
+            std::vector<t_expression_bytecode::t_instruction>& program
+        ) :
+            m_expression(expression),
+            m_column_index(column_index),
+            m_program(program),
+            m_pos(0),
+            m_depth(0),
+            m_max_depth(0) {}
+
+        bool
+        parse() {
+            if (!parse_sum()) {
+                return false;
+            }
+            skip_whitespace();
+            return m_pos == m_expression.size();
+        }
+
+        t_uindex
+        get_max_depth() const {
+            return m_max_depth;
+        }
+
+    private:
+        char
+        peek() {
+            skip_whitespace();
+            return m_pos < m_expression.size() ? m_expression[m_pos] : '\0';
+        }
+
+        void
+        skip_whitespace() {
+            while (m_pos < m_expression.size()
+                   && std::isspace(
+                       static_cast<unsigned char>(m_expression[m_pos])
+                   )) {
+                ++m_pos;
+            }
+        }
+
+        static bool
+        is_identifier_char(char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        void
+        emit(
+            t_expression_bytecode::t_opcode opcode,
+            t_uindex column = 0,
+            double constant = 0
+        ) {
+            switch (opcode) {
+                case t_expression_bytecode::OPCODE_COLUMN:
+                case t_expression_bytecode::OPCODE_CONSTANT: {
+                    ++m_depth;
+                    m_max_depth = std::max(m_max_depth, m_depth);
+                } break;
+                case t_expression_bytecode::OPCODE_NEGATE: {
+                } break;
+                default: {
+                    --m_depth;
+                } break;
+            }
+
+            m_program.push_back({opcode, column, constant});
+        }
+
+        bool
+        parse_sum() {
+            if (!parse_product()) {
+                return false;
+            }
+
+            for (;;) {
+                char c = peek();
+                if (c != '+' && c != '-') {
+                    return true;
+                }
+                ++m_pos;
+                if (!parse_product()) {
+                    return false;
+                }
+                emit(
+                    c == '+' ? t_expression_bytecode::OPCODE_ADD
+                             : t_expression_bytecode::OPCODE_SUBTRACT
+                );
+            }
+        }
+
+        bool
+        parse_product() {
+            if (!parse_unary()) {
+                return false;
+            }
+
+            for (;;) {
+                char c = peek();
+                t_expression_bytecode::t_opcode opcode;
+                switch (c) {
+                    case '*': {
+                        opcode = t_expression_bytecode::OPCODE_MULTIPLY;
+                    } break;
+                    case '/': {
+                        opcode = t_expression_bytecode::OPCODE_DIVIDE;
+                    } break;
+                    case '%': {
+                        opcode = t_expression_bytecode::OPCODE_MODULUS;
+                    } break;
+                    default: {
+                        return true;
+                    }
+                }
+
+                ++m_pos;
+
+                // `//` and `/*` begin comments, which are not supported.
+                if (c == '/' && m_pos < m_expression.size()
+                    && (m_expression[m_pos] == '/'
+                        || m_expression[m_pos] == '*')) {
+                    return false;
+                }
+
+                if (!parse_unary()) {
+                    return false;
+                }
+                emit(opcode);
+            }
+        }
+
+        bool
+        parse_unary() {
+            char c = peek();
+            if (c == '-') {
+                ++m_pos;
+                if (!parse_unary()) {
+                    return false;
+                }
+                emit(t_expression_bytecode::OPCODE_NEGATE);
+                return true;
+            }
+
+            if (c == '+') {
+                ++m_pos;
+                return parse_unary();
+            }
+
+            return parse_primary();
+        }
+
+        bool
+        parse_primary() {
+            char c = peek();
+
+            if (c == '(') {
+                ++m_pos;
+                if (!parse_sum() || peek() != ')') {
+                    return false;
+                }
+                ++m_pos;
+                return true;
+            }
+
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+                return parse_number();
+            }
+
+            if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                t_uindex begin = m_pos;
+                while (m_pos < m_expression.size()
+                       && is_identifier_char(m_expression[m_pos])) {
+                    ++m_pos;
+                }
+
+                auto iter = m_column_index.find(
+                    m_expression.substr(begin, m_pos - begin)
+                );
+
+                // Anything other than a column - a function, variable or
+                // constant - is left to ExprTk.
+                if (iter == m_column_index.end()) {
+                    return false;
+                }
+
+                emit(t_expression_bytecode::OPCODE_COLUMN, iter->second);
+                return true;
+            }
+
+            return false;
+        }
+
+        bool
+        parse_number() {
+            const char* begin = m_expression.c_str() + m_pos;
+            char* end = nullptr;
+            double value = std::strtod(begin, &end);
+
+            // `strtod` also accepts hex, which ExprTk does not.
+            for (const char* c = begin; c < end; ++c) {
+                if (*c == 'x' || *c == 'X') {
+                    return false;
+                }
+            }
+
+            if (end == begin) {
+                return false;
+            }
+
+            m_pos += end - begin;
+
+            // Reject `2COLUMN0` and friends rather than guess at ExprTk's
+            // implicit multiplication.
+            if (m_pos < m_expression.size()
+                && is_identifier_char(m_expression[m_pos])) {
+                return false;
+            }
+
+            emit(t_expression_bytecode::OPCODE_CONSTANT, 0, value);
+            return true;
+        }
+
+        const std::string& m_expression;
+        const tsl::hopscotch_map<std::string, t_uindex>& m_column_index;
+        std::vector<t_expression_bytecode::t_instruction>& m_program;
+        t_uindex m_pos;
+        t_uindex m_depth;
+        t_uindex m_max_depth;
+    };
+
+    template <typename T>
+    void
+    load_column(
+        const t_column& column, t_uindex bidx, t_uindex size, double* out
+    ) {
+        const T* data = column.get_nth<T>(bidx);
+        for (t_uindex idx = 0; idx < size; ++idx) {
+            out[idx] = static_cast<double>(data[idx]);
+        }
+    }
+
+    bool
+    is_loadable_dtype(t_dtype dtype) {
+        switch (dtype) {
+            case DTYPE_INT64:
+            case DTYPE_INT32:
+            case DTYPE_INT16:
+            case DTYPE_INT8:
+            case DTYPE_FLOAT64:
+            case DTYPE_FLOAT32:
+                return true;
+            default:
+                // Unsigned columns are excluded as `t_tscalar` negation
+                // wraps them, and booleans as they are not numeric.
+                return false;
+        }
+    }
+
+} // namespace
+
+t_expression_bytecode::t_expression_bytecode() : m_stack_size(0) {}
+
+bool
+t_expression_bytecode::compile(
+    const std::string& parsed_expression_string,
+    const std::vector<std::pair<std::string, std::string>>& column_ids
+) {
+    m_program.clear();
+    m_column_names.clear();
+    m_stack_size = 0;
+
+    tsl::hopscotch_map<std::string, t_uindex> column_index;
+    for (const auto& column_id : column_ids) {
+        column_index[column_id.first] = m_column_names.size();
+        m_column_names.push_back(column_id.second);
+    }
+
+    std::vector<t_instruction> program;
+    t_bytecode_parser parser(parsed_expression_string, column_index, program);
+    if (!parser.parse() || program.empty()) {
+        m_column_names.clear();
+        return false;
+    }
+
+    m_program = std::move(program);
+    m_stack_size = parser.get_max_depth();
+    return true;
+}
+
+bool
+t_expression_bytecode::is_compiled() const {
+    return !m_program.empty();
+}
+
+bool
+t_expression_bytecode::can_evaluate(const t_data_table& source_table) const {
+    if (!is_compiled()) {
+        return false;
+    }
+
+    const t_schema& schema = source_table.get_schema();
+    for (const auto& instruction : m_program) {
+        if (instruction.m_opcode != OPCODE_COLUMN) {
+            continue;
+        }
+
+        const std::string& name = m_column_names[instruction.m_column];
+        if (!schema.has_column(name)
+            || !is_loadable_dtype(schema.get_dtype(name))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+t_expression_bytecode::evaluate(
+    const t_data_table& source_table, t_column& output
+) const {
+    std::vector<const t_column*> columns(m_column_names.size(), nullptr);
+    for (const auto& instruction : m_program) {
+        if (instruction.m_opcode == OPCODE_COLUMN) {
+            const std::string& name = m_column_names[instruction.m_column];
+            columns[instruction.m_column] =
+                source_table.get_const_column(name).get();
+        }
+    }
+
+    // One block-sized register per stack slot.
+    std::vector<double> values(m_stack_size * BYTECODE_BLOCK_SIZE);
+    std::vector<std::uint8_t> valid(m_stack_size * BYTECODE_BLOCK_SIZE);
+
+    t_uindex num_rows = source_table.size();
+    output.reserve(num_rows);
+
+    for (t_uindex bidx = 0; bidx < num_rows; bidx += BYTECODE_BLOCK_SIZE) {
+        t_uindex eidx = std::min(bidx + BYTECODE_BLOCK_SIZE, num_rows);
+        evaluate_block(columns, bidx, eidx, output, values, valid);
+    }
+}
+
+void
+t_expression_bytecode::evaluate_block(
+    const std::vector<const t_column*>& columns,
+    t_uindex bidx,
+    t_uindex eidx,
+    t_column& output,
+    std::vector<double>& values,
+    std::vector<std::uint8_t>& valid
+) const {
+    t_uindex size = eidx - bidx;
+    t_uindex top = 0;
+
+    for (const auto& instruction : m_program) {
+        switch (instruction.m_opcode) {
+            case OPCODE_COLUMN: {
+                const t_column& column = *columns[instruction.m_column];
+                double* out = &values[top * BYTECODE_BLOCK_SIZE];
+                std::uint8_t* out_valid = &valid[top * BYTECODE_BLOCK_SIZE];
+
+                switch (column.get_dtype()) {
+                    case DTYPE_INT64: {
+                        load_column<std::int64_t>(column, bidx, size, out);
+                    } break;
+                    case DTYPE_INT32: {
+                        load_column<std::int32_t>(column, bidx, size, out);
+                    } break;
+                    case DTYPE_INT16: {
+                        load_column<std::int16_t>(column, bidx, size, out);
+                    } break;
+                    case DTYPE_INT8: {
+                        load_column<std::int8_t>(column, bidx, size, out);
+                    } break;
+                    case DTYPE_FLOAT64: {
+                        load_column<double>(column, bidx, size, out);
+                    } break;
+                    case DTYPE_FLOAT32: {
+                        load_column<float>(column, bidx, size, out);
+                    } break;
+                    default: {
+                        PSP_COMPLAIN_AND_ABORT(
+                            "Unexpected column dtype in expression bytecode"
+                        );
+                    } break;
+                }
+
+                if (column.is_status_enabled()) {
+                    const std::uint64_t* validity =
+                        column.get_validity_words();
+                    for (t_uindex idx = 0; idx < size; ++idx) {
+                        out_valid[idx] =
+                            t_column::test_bit(validity, bidx + idx) ? 1 : 0;
+                    }
+                } else {
+                    std::fill(out_valid, out_valid + size, 1);
+                }
+
+                ++top;
+            } break;
+            case OPCODE_CONSTANT: {
+                double* out = &values[top * BYTECODE_BLOCK_SIZE];
+                std::uint8_t* out_valid = &valid[top * BYTECODE_BLOCK_SIZE];
+                std::fill(out, out + size, instruction.m_constant);
+                std::fill(out_valid, out_valid + size, 1);
+                ++top;
+            } break;
+            case OPCODE_NEGATE: {
+                double* a = &values[(top - 1) * BYTECODE_BLOCK_SIZE];
+                for (t_uindex idx = 0; idx < size; ++idx) {
+                    a[idx] = -a[idx];
+                }
+            } break;
+            default: {
+                // Binary operators pop `b` and write `a OP b` over `a`.
+                double* a = &values[(top - 2) * BYTECODE_BLOCK_SIZE];
+                double* b = &values[(top - 1) * BYTECODE_BLOCK_SIZE];
+                std::uint8_t* a_valid = &valid[(top - 2) * BYTECODE_BLOCK_SIZE];
+                std::uint8_t* b_valid = &valid[(top - 1) * BYTECODE_BLOCK_SIZE];
+
+                for (t_uindex idx = 0; idx < size; ++idx) {
+                    a_valid[idx] &= b_valid[idx];
+                }
+
+                switch (instruction.m_opcode) {
+                    case OPCODE_ADD: {
+                        for (t_uindex idx = 0; idx < size; ++idx) {
+                            a[idx] += b[idx];
+                        }
+                    } break;
+                    case OPCODE_SUBTRACT: {
+                        for (t_uindex idx = 0; idx < size; ++idx) {
+                            a[idx] -= b[idx];
+                        }
+                    } break;
+                    case OPCODE_MULTIPLY: {
+                        for (t_uindex idx = 0; idx < size; ++idx) {
+                            a[idx] *= b[idx];
+                        }
+                    } break;
+                    case OPCODE_DIVIDE: {
+                        for (t_uindex idx = 0; idx < size; ++idx) {
+                            a_valid[idx] &= b[idx] != 0;
+                            a[idx] /= b[idx];
+                        }
+                    } break;
+                    case OPCODE_MODULUS: {
+                        for (t_uindex idx = 0; idx < size; ++idx) {
+                            a_valid[idx] &= b[idx] != 0;
+                            a[idx] = std::fmod(a[idx], b[idx]);
+                        }
+                    } break;
+                    default: {
+                        PSP_COMPLAIN_AND_ABORT("Unknown expression opcode");
+                    } break;
+                }
+
+                --top;
+            } break;
+        }
+    }
+
+    const double* result = values.data();
+    const std::uint8_t* result_valid = valid.data();
+    for (t_uindex idx = 0; idx < size; ++idx) {
+        if (result_valid[idx]) {
+            output.set_nth<double>(bidx + idx, result[idx]);
+        } else {
+            output.clear(bidx + idx);
+        }
+    }
+}
+
+} // end namespace perspective
@@ -168,12 +168,289 @@ t_expression_tables::clear_transitional_tables() const {
 
 void
 t_expression_tables::reset() const {
-    m_master->reset();
-    m_flattened->reset();
-    m_prev->reset();
-    m_current->reset();
-    m_delta->reset();
-    m_transitions->reset();
+    // Columns may be borrowed from the gnode's `t_expression_cache`, so
+    // replace them with new columns rather than clearing them in place.
+    auto detach = [](const std::shared_ptr<t_data_table>& table) {
+        table->set_table_size(0);
+        table->set_capacity(DEFAULT_EMPTY_CAPACITY);
+        table->init();
+    };
+
+    detach(m_master);
+    detach(m_flattened);
+    detach(m_prev);
+    detach(m_current);
+    detach(m_delta);
+    detach(m_transitions);
+}
+
+/******************************************************************************
+ *
+ * t_expression_cache
+ */
+
+t_expression_cache::t_expression_cache() :
+    m_next_column_id(0) {
+    m_tables = std::make_shared<t_expression_tables>(m_expressions);
+}
+
+std::vector<std::shared_ptr<t_computed_expression>>
+t_expression_cache::acquire(
+    const std::vector<std::shared_ptr<t_computed_expression>>& expressions
+) {
+    std::vector<std::shared_ptr<t_computed_expression>> added;
+
+    for (const auto& expr : expressions) {
+        std::string key = get_key(*expr);
+        auto it = m_entries.find(key);
+
+        if (it != m_entries.end()) {
+            it->second.m_refcount++;
+            continue;
+        }
+
+        auto cached = std::make_shared<t_computed_expression>(
+            "psp_expression_" + std::to_string(m_next_column_id++),
+            expr->get_expression_string(),
+            expr->get_parsed_expression_string(),
+            expr->get_column_ids(),
+            expr->get_dtype()
+        );
+
+        m_entries.insert({std::move(key), t_entry{cached, 1}});
+        added.push_back(std::move(cached));
+    }
+
+    if (!added.empty()) {
+        rebuild_tables();
+    }
+
+    return added;
+}
+
+void
+t_expression_cache::release(
+    const std::vector<std::shared_ptr<t_computed_expression>>& expressions
+) {
+    bool removed = false;
+
+    for (const auto& expr : expressions) {
+        auto it = m_entries.find(get_key(*expr));
+
+        if (it == m_entries.end()) {
+            continue;
+        }
+
+        if (--it->second.m_refcount == 0) {
+            m_entries.erase(it);
+            removed = true;
+        }
+    }
+
+    if (removed) {
+        rebuild_tables();
+    }
+}
+
+void
+t_expression_cache::compute(
+    const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+    const std::shared_ptr<t_data_table>& master,
+    const t_gstate::t_mapping& pkey_map,
+    t_expression_vocab& expression_vocab,
+    t_regex_mapping& regex_mapping
+) const {
+    t_uindex num_rows = master->size();
+    m_tables->m_master->reserve(num_rows);
+    m_tables->m_master->set_size(num_rows);
+
+    t_computed_expression::compute_all(
+        expressions,
+        master,
+        pkey_map,
+        m_tables->m_master,
+        expression_vocab,
+        regex_mapping
+    );
+}
+
+void
+t_expression_cache::compute(
+    const std::shared_ptr<t_data_table>& master,
+    const t_gstate::t_mapping& pkey_map,
+    const std::shared_ptr<t_data_table>& flattened,
+    const std::shared_ptr<t_data_table>& delta,
+    const std::shared_ptr<t_data_table>& prev,
+    const std::shared_ptr<t_data_table>& current,
+    const std::shared_ptr<t_data_table>& existed,
+    t_expression_vocab& expression_vocab,
+    t_regex_mapping& regex_mapping
+) const {
+    // Clear the tables so they are ready for this round of updates
+    m_tables->clear_transitional_tables();
+
+    // All transitional tables are the same size
+    t_uindex flattened_num_rows = flattened->size();
+    m_tables->reserve_transitional_table_size(flattened_num_rows);
+    m_tables->set_transitional_table_size(flattened_num_rows);
+
+    // master: compute based on latest state of the gnode state table
+    compute(m_expressions, master, pkey_map, expression_vocab, regex_mapping);
+
+    // flattened: compute based on the latest update dataset. delta: for
+    // each numerical column, the numerical delta between the previous value
+    // and the current value in the row. prev: the values of the updated rows
+    // before this update was applied. current: the current values of the
+    // updated rows.
+    std::pair<const std::shared_ptr<t_data_table>*,
+              const std::shared_ptr<t_data_table>*>
+        sources[] = {
+            {&flattened, &m_tables->m_flattened},
+            {&delta, &m_tables->m_delta},
+            {&prev, &m_tables->m_prev},
+            {&current, &m_tables->m_current},
+        };
+
+    for (const auto& [source, destination] : sources) {
+        t_computed_expression::compute_all(
+            m_expressions,
+            *source,
+            pkey_map,
+            *destination,
+            expression_vocab,
+            regex_mapping
+        );
+    }
+
+    // Calculate the transitions now that the intermediate tables are computed
+    m_tables->calculate_transitions(existed);
+}
+
+void
+t_expression_cache::share_master(
+    const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+    const t_expression_tables& tables
+) const {
+    for (const auto& expr : expressions) {
+        tables.m_master->set_column(
+            expr->get_expression_alias(),
+            m_tables->m_master->get_column(get_column_name(*expr))
+        );
+    }
+
+    tables.m_master->set_table_size(m_tables->m_master->size());
+}
+
+void
+t_expression_cache::share(
+    const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+    const t_expression_tables& tables
+) const {
+    std::pair<const t_data_table*, t_data_table*> transitional[] = {
+        {m_tables->m_flattened.get(), tables.m_flattened.get()},
+        {m_tables->m_prev.get(), tables.m_prev.get()},
+        {m_tables->m_current.get(), tables.m_current.get()},
+        {m_tables->m_delta.get(), tables.m_delta.get()},
+        {m_tables->m_transitions.get(), tables.m_transitions.get()},
+    };
+
+    for (const auto& expr : expressions) {
+        const std::string& alias = expr->get_expression_alias();
+        const std::string& column_name = get_column_name(*expr);
+        for (const auto& [source, destination] : transitional) {
+            destination->set_column(alias, source->get_column(column_name));
+        }
+    }
+
+    for (const auto& [source, destination] : transitional) {
+        destination->set_table_size(source->size());
+    }
+
+    share_master(expressions, tables);
+}
+
+void
+t_expression_cache::reset() const {
+    m_tables->reset();
+}
+
+bool
+t_expression_cache::empty() const {
+    return m_entries.empty();
+}
+
+const std::vector<std::shared_ptr<t_computed_expression>>&
+t_expression_cache::get_expressions() const {
+    return m_expressions;
+}
+
+const std::shared_ptr<t_expression_tables>&
+t_expression_cache::get_tables() const {
+    return m_tables;
+}
+
+std::string
+t_expression_cache::get_key(const t_computed_expression& expression) {
+    // Column names are replaced by IDs in the parsed expression string, so
+    // the names they map to are part of the key as well.
+    std::string key = expression.get_parsed_expression_string();
+    for (const auto& [column_id, column_name] : expression.get_column_ids()) {
+        key += '\0';
+        key += column_id;
+        key += '\0';
+        key += column_name;
+    }
+
+    return key;
+}
+
+const std::string&
+t_expression_cache::get_column_name(const t_computed_expression& expression
+) const {
+    auto it = m_entries.find(get_key(expression));
+    PSP_VERBOSE_ASSERT(
+        it != m_entries.end(), "Expression is not in the expression cache"
+    );
+    return it->second.m_expression->get_expression_alias();
+}
+
+void
+t_expression_cache::rebuild_tables() {
+    m_expressions.clear();
+    m_expressions.reserve(m_entries.size());
+    for (const auto& [key, entry] : m_entries) {
+        m_expressions.push_back(entry.m_expression);
+    }
+
+    auto tables = std::make_shared<t_expression_tables>(m_expressions);
+
+    std::pair<t_data_table*, t_data_table*> pairs[] = {
+        {m_tables->m_master.get(), tables->m_master.get()},
+        {m_tables->m_flattened.get(), tables->m_flattened.get()},
+        {m_tables->m_prev.get(), tables->m_prev.get()},
+        {m_tables->m_current.get(), tables->m_current.get()},
+        {m_tables->m_delta.get(), tables->m_delta.get()},
+        {m_tables->m_transitions.get(), tables->m_transitions.get()},
+    };
+
+    // Columns of expressions that were already cached keep their data, and
+    // new columns are sized to match so the tables stay rectangular.
+    for (const auto& [source, destination] : pairs) {
+        const t_schema& schema = source->get_schema();
+        t_uindex num_rows = source->size();
+        destination->reserve(num_rows);
+        destination->set_size(num_rows);
+        for (const auto& expr : m_expressions) {
+            const std::string& column_name = expr->get_expression_alias();
+            if (schema.has_column(column_name)) {
+                destination->set_column(
+                    column_name, source->get_column(column_name)
+                );
+            }
+        }
+    }
+
+    m_tables = tables;
 }
 
 } // end namespace perspective
@@ -11,6 +11,7 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 #include <perspective/expression_vocab.h>
+#include <perspective/pyutils.h>
 
 namespace perspective {
 
@@ -24,6 +25,7 @@ t_expression_vocab::t_expression_vocab() {
 
 const char*
 t_expression_vocab::intern(const char* str) {
+    PSP_WRITE_LOCK(m_lock);
     std::size_t bytelength = strlen(str);
 
     if (m_current_vocab_size + bytelength + 1 > m_max_vocab_size) {
@@ -43,6 +45,7 @@ t_expression_vocab::intern(const std::string& str) {
 
 void
 t_expression_vocab::clear() {
+    PSP_WRITE_LOCK(m_lock);
     m_vocabs.clear();
     allocate_new_vocab();
 }
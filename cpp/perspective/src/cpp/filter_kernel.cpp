@@ -0,0 +1,693 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#include <perspective/first.h>
+#include <perspective/filter_kernel.h>
+#include <perspective/scalar.h>
+#include <algorithm>
+#include <cstring>
+
+namespace perspective {
+
+namespace {
+
+    typedef t_mask::t_block t_block;
+
+    const t_uindex BLOCK_BITS = t_mask::m_bits_per_block;
+    const t_block FULL_BLOCK = ~t_block(0);
+
+    // The order in which terms are evaluated - cheaper kernels run first so
+    // that later, more expensive terms see as few live blocks as possible.
+    enum t_kernel_kind {
+        KERNEL_TYPED = 0,
+        KERNEL_VOCAB = 1,
+        KERNEL_SCALAR = 2
+    };
+
+    /**
+     * @brief The bits of block `bidx` that correspond to actual rows.
+     */
+    inline t_block
+    block_extent(t_uindex bidx, t_uindex nblocks, t_uindex nrows) {
+        t_uindex tail = nrows % BLOCK_BITS;
+        if (bidx + 1 < nblocks || tail == 0) {
+            return FULL_BLOCK;
+        }
+
+        return (t_block(1) << tail) - 1;
+    }
+
+    /**
+     * @brief The bits of a column validity bitmap for the block starting at
+     * row `begin`. Blocks are never wider than the bitmap's 64-bit words, so
+     * a block never straddles two words.
+     */
+    inline t_block
+    validity_block(const std::uint64_t* validity, t_uindex begin) {
+        return t_block(validity[begin / 64] >> (begin % 64));
+    }
+
+    /**
+     * @brief Read the raw storage of `s` as `T`, matching the layout used by
+     * `t_column`.
+     */
+    template <typename T>
+    inline T
+    scalar_raw(const t_tscalar& s) {
+        T rval;
+        std::memcpy(&rval, &s.m_data, sizeof(T));
+        return rval;
+    }
+
+    /**
+     * @brief `t_tscalar::operator==` compares the bits of non-bool, non-str
+     * scalars, so floats must be compared bitwise (NaN == NaN, 0.0 != -0.0)
+     * to return the same results as the scalar path.
+     */
+    template <typename T>
+    inline std::uint64_t
+    raw_bits(T v) {
+        std::uint64_t rval = 0;
+        std::memcpy(&rval, &v, sizeof(T));
+        return rval;
+    }
+
+    template <typename T>
+    inline bool
+    raw_eq(T a, T b) {
+        return a == b;
+    }
+
+    template <>
+    inline bool
+    raw_eq<double>(double a, double b) {
+        return raw_bits(a) == raw_bits(b);
+    }
+
+    template <>
+    inline bool
+    raw_eq<float>(float a, float b) {
+        return raw_bits(a) == raw_bits(b);
+    }
+
+    /**
+     * @brief Evaluate `eval(ridx)` for every row of every block that can
+     * still change the combined result, and fold the results into `blocks`.
+     *
+     * `eval` is evaluated for the whole block without branching on the
+     * current bits, which lets the typed kernels compile to tight loops.
+     * If `validity` is set, rows whose bit is unset take `invalid_rval`
+     * instead, applied a word at a time.
+     */
+    template <typename EVAL_T>
+    void
+    apply_dense(
+        t_filter_op combiner,
+        t_uindex nrows,
+        bool negated,
+        std::vector<t_block>& blocks,
+        const std::uint64_t* validity,
+        bool invalid_rval,
+        EVAL_T eval
+    ) {
+        const bool is_and = combiner == FILTER_OP_AND;
+        const t_uindex nblocks = blocks.size();
+
+        for (t_uindex bidx = 0; bidx < nblocks; ++bidx) {
+            t_block cur = blocks[bidx];
+            t_block extent = block_extent(bidx, nblocks, nrows);
+
+            if (is_and ? cur == 0 : cur == extent) {
+                continue;
+            }
+
+            t_uindex begin = bidx * BLOCK_BITS;
+            t_uindex end = std::min(begin + BLOCK_BITS, nrows);
+            t_block bits = 0;
+
+            for (t_uindex ridx = begin; ridx < end; ++ridx) {
+                bits |= t_block(eval(ridx)) << (ridx - begin);
+            }
+
+            if (validity != nullptr) {
+                t_block valid = validity_block(validity, begin);
+                bits = ((bits & valid) | (invalid_rval ? ~valid : 0)) & extent;
+            }
+
+            if (negated) {
+                bits = ~bits & extent;
+            }
+
+            blocks[bidx] = is_and ? (cur & bits) : (cur | bits);
+        }
+    }
+
+    /**
+     * @brief Like `apply_dense`, but only evaluates rows whose bit can still
+     * change - set bits under AND, unset bits under OR. Used for terms that
+     * are expensive per row.
+     */
+    template <typename EVAL_T>
+    void
+    apply_sparse(
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks,
+        EVAL_T eval
+    ) {
+        const bool is_and = combiner == FILTER_OP_AND;
+        const t_uindex nblocks = blocks.size();
+
+        for (t_uindex bidx = 0; bidx < nblocks; ++bidx) {
+            t_block cur = blocks[bidx];
+            t_block extent = block_extent(bidx, nblocks, nrows);
+            t_block todo = is_and ? cur : (~cur & extent);
+
+            if (todo == 0) {
+                continue;
+            }
+
+            t_uindex begin = bidx * BLOCK_BITS;
+            t_block bits = 0;
+
+            for (t_uindex bit = 0; todo != 0; ++bit, todo >>= 1) {
+                if ((todo & 1) != 0 && eval(begin + bit)) {
+                    bits |= t_block(1) << bit;
+                }
+            }
+
+            blocks[bidx] = is_and ? (cur & bits) : (cur | bits);
+        }
+    }
+
+    /**
+     * @brief Run a typed predicate over the column buffer. `invalid_rval`
+     * is the result for cells whose status is not `STATUS_VALID`, before
+     * negation.
+     */
+    template <typename T, typename PRED_T>
+    void
+    apply_typed(
+        const t_fterm& fterm,
+        const t_column* column,
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks,
+        bool invalid_rval,
+        PRED_T pred
+    ) {
+        const T* data = column->get_nth<T>(0);
+        const std::uint64_t* validity = column->is_status_enabled()
+            ? column->get_validity_words()
+            : nullptr;
+
+        apply_dense(
+            combiner,
+            nrows,
+            fterm.m_negated,
+            blocks,
+            validity,
+            invalid_rval,
+            [=](t_uindex ridx) { return pred(data[ridx]); }
+        );
+    }
+
+    /**
+     * @brief Dispatch `fterm` on its operator to a typed kernel over `T`.
+     * Returns false without touching `blocks` if the threshold or bag does
+     * not exactly match the column's dtype, in which case the caller must
+     * use the scalar path.
+     */
+    template <typename T>
+    bool
+    filter_typed(
+        const t_fterm& fterm,
+        const t_column* column,
+        t_dtype dtype,
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks
+    ) {
+        switch (fterm.m_op) {
+            case FILTER_OP_LT:
+            case FILTER_OP_LTEQ:
+            case FILTER_OP_GT:
+            case FILTER_OP_GTEQ:
+            case FILTER_OP_EQ:
+            case FILTER_OP_NE: {
+                if (fterm.m_threshold.m_type != dtype
+                    || fterm.m_threshold.m_status != STATUS_VALID) {
+                    return false;
+                }
+            } break;
+            case FILTER_OP_IN:
+            case FILTER_OP_NOT_IN: {
+                for (const auto& s : fterm.m_bag) {
+                    if (s.m_type != dtype || s.m_status != STATUS_VALID) {
+                        return false;
+                    }
+                }
+            } break;
+            default: {
+                return false;
+            }
+        }
+
+        const T threshold = scalar_raw<T>(fterm.m_threshold);
+
+        switch (fterm.m_op) {
+            case FILTER_OP_LT: {
+                apply_typed<T>(
+                    fterm,
+                    column,
+                    combiner,
+                    nrows,
+                    blocks,
+                    false,
+                    [=](T v) { return v < threshold; }
+                );
+            } break;
+            case FILTER_OP_LTEQ: {
+                apply_typed<T>(
+                    fterm,
+                    column,
+                    combiner,
+                    nrows,
+                    blocks,
+                    false,
+                    [=](T v) { return v < threshold || raw_eq(v, threshold); }
+                );
+            } break;
+            case FILTER_OP_GT: {
+                apply_typed<T>(
+                    fterm,
+                    column,
+                    combiner,
+                    nrows,
+                    blocks,
+                    false,
+                    [=](T v) { return v > threshold; }
+                );
+            } break;
+            case FILTER_OP_GTEQ: {
+                apply_typed<T>(
+                    fterm,
+                    column,
+                    combiner,
+                    nrows,
+                    blocks,
+                    false,
+                    [=](T v) { return v > threshold || raw_eq(v, threshold); }
+                );
+            } break;
+            case FILTER_OP_EQ: {
+                apply_typed<T>(
+                    fterm,
+                    column,
+                    combiner,
+                    nrows,
+                    blocks,
+                    false,
+                    [=](T v) { return raw_eq(v, threshold); }
+                );
+            } break;
+            case FILTER_OP_NE: {
+                apply_typed<T>(
+                    fterm,
+                    column,
+                    combiner,
+                    nrows,
+                    blocks,
+                    true,
+                    [=](T v) { return !raw_eq(v, threshold); }
+                );
+            } break;
+            case FILTER_OP_IN:
+            case FILTER_OP_NOT_IN: {
+                // Membership is tested on the raw bits, which is equality as
+                // defined by `t_tscalar::operator==` for these dtypes.
+                std::vector<std::uint64_t> bag;
+                bag.reserve(fterm.m_bag.size());
+                for (const auto& s : fterm.m_bag) {
+                    bag.push_back(raw_bits(scalar_raw<T>(s)));
+                }
+
+                std::sort(bag.begin(), bag.end());
+                bool is_in = fterm.m_op == FILTER_OP_IN;
+                const std::uint64_t* bbegin = bag.data();
+                const std::uint64_t* bend = bag.data() + bag.size();
+                apply_typed<T>(
+                    fterm,
+                    column,
+                    combiner,
+                    nrows,
+                    blocks,
+                    !is_in,
+                    [=](T v) {
+                        return std::binary_search(bbegin, bend, raw_bits(v))
+                            == is_in;
+                    }
+                );
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unexpected filter op");
+            } break;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Null checks only read the validity bitmap, so they apply to
+     * every dtype and need no per-row work.
+     */
+    void
+    filter_status(
+        const t_fterm& fterm,
+        const t_column* column,
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks
+    ) {
+        bool want_valid = fterm.m_op == FILTER_OP_IS_NOT_NULL;
+        const std::uint64_t* validity = column->is_status_enabled()
+            ? column->get_validity_words()
+            : nullptr;
+
+        apply_dense(
+            combiner,
+            nrows,
+            fterm.m_negated,
+            blocks,
+            validity,
+            !want_valid,
+            [=](t_uindex) { return want_valid; }
+        );
+    }
+
+    /**
+     * @brief The threshold of an interned string term holds the vocabulary
+     * id of the comparison string, so equality is id equality - read at
+     * whatever width the column stores its ids.
+     */
+    bool
+    filter_interned(
+        const t_fterm& fterm,
+        const t_column* column,
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks
+    ) {
+        t_dtype dtype = fterm.m_threshold.get_dtype();
+        std::uint32_t width = column->get_vocab_index_width();
+        std::uint64_t id = fterm.m_threshold.to_uint64();
+        if (id >= column->get_vlenidx()
+            || (width < sizeof(std::uint64_t) && (id >> (8 * width)) != 0)) {
+            // The string is not in the vocabulary, or its id is too wide to
+            // be stored in this column, so no cell holds it: EQ matches no
+            // row and NE matches every row, null or not, as NE on a string
+            // which is in the vocabulary does.
+            bool rval = fterm.m_op == FILTER_OP_NE;
+            apply_dense(
+                combiner,
+                nrows,
+                fterm.m_negated,
+                blocks,
+                nullptr,
+                rval,
+                [=](t_uindex) { return rval; }
+            );
+
+            return true;
+        }
+
+        switch (width) {
+            case 1: {
+                return filter_typed<std::uint8_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            }
+            case 2: {
+                return filter_typed<std::uint16_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            }
+            case 4: {
+                return filter_typed<std::uint32_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            }
+            default: {
+                return filter_typed<std::uint64_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            }
+        }
+    }
+
+    /**
+     * @brief String predicates other than interned equality depend only on
+     * the vocabulary entry, so evaluate each distinct index at most once.
+     */
+    void
+    filter_vocab(
+        const t_fterm& fterm,
+        const t_column* column,
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks
+    ) {
+        const std::uint64_t* validity = column->is_status_enabled()
+            ? column->get_validity_words()
+            : nullptr;
+
+        std::vector<std::int8_t> memo(column->get_vlenidx(), -1);
+        t_tscalar cell;
+
+        apply_sparse(combiner, nrows, blocks, [&](t_uindex ridx) {
+            if (validity != nullptr && !t_column::test_bit(validity, ridx)) {
+                return fterm(column->get_scalar(ridx));
+            }
+
+            t_uindex sidx = column->get_vocab_index(ridx);
+            if (sidx >= memo.size()) {
+                return fterm(column->get_scalar(ridx));
+            }
+
+            std::int8_t& rval = memo[sidx];
+            if (rval < 0) {
+                cell.set(column->unintern_c(sidx));
+                rval = fterm(cell) ? 1 : 0;
+            }
+
+            return rval == 1;
+        });
+    }
+
+    void
+    filter_scalar(
+        const t_fterm& fterm,
+        const t_column* column,
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks
+    ) {
+        apply_sparse(combiner, nrows, blocks, [&](t_uindex ridx) {
+            return fterm(column->get_scalar(ridx));
+        });
+    }
+
+    /**
+     * @brief Run the best available kernel for `fterm`.
+     */
+    void
+    filter_term(
+        const t_fterm& fterm,
+        const t_column* column,
+        t_filter_op combiner,
+        t_uindex nrows,
+        std::vector<t_block>& blocks
+    ) {
+        if (fterm.m_op == FILTER_OP_IS_NULL
+            || fterm.m_op == FILTER_OP_IS_NOT_NULL) {
+            filter_status(fterm, column, combiner, nrows, blocks);
+            return;
+        }
+
+        t_dtype dtype = column->get_dtype();
+        bool done = false;
+
+        switch (dtype) {
+            case DTYPE_INT64: {
+                done = filter_typed<std::int64_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_INT32: {
+                done = filter_typed<std::int32_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_INT16: {
+                done = filter_typed<std::int16_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_INT8: {
+                done = filter_typed<std::int8_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_UINT64: {
+                done = filter_typed<std::uint64_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_UINT32: {
+                done = filter_typed<std::uint32_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_UINT16: {
+                done = filter_typed<std::uint16_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_UINT8: {
+                done = filter_typed<std::uint8_t>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_FLOAT64: {
+                done = filter_typed<double>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_FLOAT32: {
+                done = filter_typed<float>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_BOOL: {
+                done = filter_typed<bool>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_DATE: {
+                done = filter_typed<t_date::t_rawtype>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_TIME: {
+                done = filter_typed<t_time::t_rawtype>(
+                    fterm, column, dtype, combiner, nrows, blocks
+                );
+            } break;
+            case DTYPE_STR: {
+                if (fterm.m_use_interned) {
+                    done = filter_interned(
+                        fterm, column, combiner, nrows, blocks
+                    );
+                } else {
+                    filter_vocab(fterm, column, combiner, nrows, blocks);
+                    done = true;
+                }
+            } break;
+            default: {
+            } break;
+        }
+
+        if (!done) {
+            filter_scalar(fterm, column, combiner, nrows, blocks);
+        }
+    }
+
+    t_kernel_kind
+    get_kernel_kind(const t_fterm& fterm, const t_column* column) {
+        switch (fterm.m_op) {
+            case FILTER_OP_IS_NULL:
+            case FILTER_OP_IS_NOT_NULL: {
+                return KERNEL_TYPED;
+            } break;
+            default: {
+            } break;
+        }
+
+        t_dtype threshold_dtype = fterm.m_threshold.get_dtype();
+        if ((fterm.m_op == FILTER_OP_IN || fterm.m_op == FILTER_OP_NOT_IN)
+            && !fterm.m_bag.empty()) {
+            threshold_dtype = fterm.m_bag[0].get_dtype();
+        }
+
+        switch (column->get_dtype()) {
+            case DTYPE_STR: {
+                return fterm.m_use_interned ? KERNEL_TYPED : KERNEL_VOCAB;
+            } break;
+            case DTYPE_OBJECT:
+            case DTYPE_F64PAIR:
+            case DTYPE_NONE: {
+                return KERNEL_SCALAR;
+            } break;
+            default: {
+                return threshold_dtype == column->get_dtype()
+                    ? KERNEL_TYPED
+                    : KERNEL_SCALAR;
+            } break;
+        }
+    }
+
+} // namespace
+
+t_mask
+filter_columns(
+    t_filter_op combiner,
+    const std::vector<t_fterm>& fterms,
+    const std::vector<const t_column*>& columns,
+    t_uindex nrows
+) {
+    PSP_VERBOSE_ASSERT(
+        fterms.size() == columns.size(), "Mismatched filter terms and columns"
+    );
+
+    if (combiner != FILTER_OP_AND && combiner != FILTER_OP_OR) {
+        PSP_COMPLAIN_AND_ABORT("Unknown filter op");
+    }
+
+    t_uindex nblocks = (nrows + BLOCK_BITS - 1) / BLOCK_BITS;
+    std::vector<t_block> blocks(
+        nblocks, combiner == FILTER_OP_AND ? FULL_BLOCK : t_block(0)
+    );
+
+    if (nblocks > 0) {
+        blocks.back() &= block_extent(nblocks - 1, nblocks, nrows);
+    }
+
+    // Both combiners are commutative, so terms can run in any order.
+    std::vector<t_uindex> order(fterms.size());
+    for (t_uindex idx = 0; idx < order.size(); ++idx) {
+        order[idx] = idx;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](t_uindex a, t_uindex b) {
+        return get_kernel_kind(fterms[a], columns[a])
+            < get_kernel_kind(fterms[b], columns[b]);
+    });
+
+    for (auto idx : order) {
+        filter_term(fterms[idx], columns[idx], combiner, nrows, blocks);
+    }
+
+    return {blocks, nrows};
+}
+
+} // end namespace perspective
@@ -16,16 +16,31 @@
 #include <perspective/flat_traversal.h>
 #include <perspective/scalar.h>
 #include <perspective/schema.h>
+#include <perspective/parallel_for.h>
 
 namespace perspective {
 
-t_ftrav::t_ftrav() : m_step_deletes(0), m_step_inserts(0) {
-    m_index = std::make_shared<std::vector<t_mselem>>();
-}
+t_ftrav::t_ftrav() : m_index(make_index(m_sort_orders)) {}
 
 void
 t_ftrav::init() {
-    m_index = std::make_shared<std::vector<t_mselem>>();
+    m_index.clear();
+    m_new_elems.clear();
+    m_deleted_pkeys.clear();
+}
+
+t_ftrav_index
+t_ftrav::make_index(const std::vector<t_sorttype>& sort_orders) {
+    // `t_multisorter` has no default constructor, so the comparator has to
+    // be handed to the ranked index explicitly.
+    t_ftrav_index::ctor_args_list args(
+        boost::make_tuple(
+            boost::multi_index::identity<t_mselem>(),
+            t_multisorter(sort_orders)
+        ),
+        t_ftrav_index::index<by_ftrav_pkey>::type::ctor_args()
+    );
+    return t_ftrav_index(args);
 }
 
 std::vector<t_tscalar>
@@ -35,9 +50,9 @@ t_ftrav::get_all_pkeys(const std::vector<std::pair<t_uindex, t_uindex>>& cells
     // cells
     std::vector<t_tscalar> rval;
     rval.reserve(cells.size());
-    std::vector<t_mselem>* index = m_index.get();
+    const auto& index = m_index.get<by_ftrav_order>();
     for (const auto& cell : cells) {
-        rval.push_back((*index)[cell.first].m_pkey);
+        rval.push_back(index.nth(cell.first)->m_pkey);
     }
     return rval;
 }
@@ -54,10 +69,11 @@ t_ftrav::get_pkeys(const std::vector<std::pair<t_uindex, t_uindex>>& cells
     }
 
     std::vector<t_tscalar> rval(all_rows.size());
+    const auto& index = m_index.get<by_ftrav_order>();
     std::set<t_index>::iterator it;
     t_index count = 0;
     for (it = all_rows.begin(); it != all_rows.end(); ++it) {
-        rval[count] = (*m_index)[*it].m_pkey;
+        rval[count] = index.nth(*it)->m_pkey;
         ++count;
     }
     return rval;
@@ -65,11 +81,17 @@ t_ftrav::get_pkeys(const std::vector<std::pair<t_uindex, t_uindex>>& cells
 
 std::vector<t_tscalar>
 t_ftrav::get_pkeys(t_index begin_row, t_index end_row) const {
-    t_index index_size = m_index->size();
+    t_index index_size = size();
     end_row = std::min(end_row, index_size);
+    if (begin_row >= end_row) {
+        return {};
+    }
+
+    // Resolve the first row by rank, then walk the index in order.
     std::vector<t_tscalar> rval(end_row - begin_row);
-    for (t_index ridx = begin_row; ridx < end_row; ++ridx) {
-        rval[ridx - begin_row] = (*m_index)[ridx].m_pkey;
+    auto iter = m_index.get<by_ftrav_order>().nth(begin_row);
+    for (t_index ridx = begin_row; ridx < end_row; ++ridx, ++iter) {
+        rval[ridx - begin_row] = iter->m_pkey;
     }
     return rval;
 }
@@ -78,8 +100,9 @@ std::vector<t_tscalar>
 t_ftrav::get_pkeys(const std::vector<t_uindex>& rows) const {
     std::vector<t_tscalar> rval;
     rval.reserve(rows.size());
+    const auto& index = m_index.get<by_ftrav_order>();
     for (unsigned long long ridx : rows) {
-        rval.push_back((*m_index)[ridx].m_pkey);
+        rval.push_back(index.nth(ridx)->m_pkey);
     }
     return rval;
 }
@@ -91,7 +114,7 @@ t_ftrav::get_pkeys() const {
 
 t_tscalar
 t_ftrav::get_pkey(t_index idx) const {
-    return (*m_index)[idx].m_pkey;
+    return m_index.get<by_ftrav_order>().nth(idx)->m_pkey;
 }
 
 void
@@ -102,8 +125,7 @@ t_ftrav::fill_sort_elem(
     t_tscalar pkey,
     t_mselem& out_elem
 ) {
-    t_index sortby_size = m_sortby.size();
-    out_elem.m_row.reserve(sortby_size);
+    m_sort_row.clear();
     out_elem.m_pkey = pkey;
 
     for (const t_sortspec& sort : m_sortby) {
@@ -118,12 +140,14 @@ t_ftrav::fill_sort_elem(
 
         const std::string& sortby_colname = config.get_sort_by(colname);
 
-        out_elem.m_row.push_back(
+        m_sort_row.push_back(
             m_symtable.get_interned_tscalar(get_from_gstate(
                 gstate, expression_master_table, sortby_colname, pkey
             ))
         );
     }
+
+    encode_sort_key(out_elem, m_sort_row, m_sort_orders);
 }
 
 void
@@ -133,8 +157,7 @@ t_ftrav::fill_sort_elem(
     const std::vector<t_tscalar>& row,
     t_mselem& out_elem
 ) const {
-    t_index sortby_size = m_sortby.size();
-    out_elem.m_row.reserve(sortby_size);
+    m_sort_row.clear();
     out_elem.m_pkey = mknone();
 
     for (const t_sortspec& sort : m_sortby) {
@@ -148,10 +171,12 @@ t_ftrav::fill_sort_elem(
 
         const std::string& sortby_colname = config.get_sort_by(colname);
 
-        out_elem.m_row.push_back(
+        m_sort_row.push_back(
             get_interned_tscalar(row.at(config.get_colidx(sortby_colname)))
         );
     }
+
+    encode_sort_key(out_elem, m_sort_row, m_sort_orders);
 }
 
 void
@@ -164,29 +189,35 @@ t_ftrav::sort_by(
     if (sortby.empty()) {
         return;
     }
-    t_multisorter sorter(get_sort_orders(sortby));
-    t_index size = m_index->size();
-    auto sort_elems =
-        std::make_shared<std::vector<t_mselem>>(static_cast<size_t>(size));
     m_sortby = sortby;
+    m_sort_orders = get_sort_orders(m_sortby);
 
-    for (t_index idx = 0; idx < size; ++idx) {
-        t_mselem& elem = (*sort_elems)[idx];
-        t_tscalar pkey = (*m_index)[idx].m_pkey;
-        fill_sort_elem(gstate, expression_master_table, config, pkey, elem);
+    std::vector<t_mselem> elems(size());
+    t_uindex idx = 0;
+    for (const t_mselem& old_elem : m_index.get<by_ftrav_order>()) {
+        fill_sort_elem(
+            gstate, expression_master_table, config, old_elem.m_pkey, elems[idx]
+        );
+        ++idx;
     }
 
-    std::swap(m_index, sort_elems);
-    std::sort(m_index->begin(), m_index->end(), sorter);
-    m_pkeyidx.clear();
-    for (t_index idx = 0, loop_end = m_index->size(); idx < loop_end; ++idx) {
-        m_pkeyidx[(*m_index)[idx].m_pkey] = idx;
+    parallel_sort(elems, t_multisorter(m_sort_orders));
+
+    // The ordering of the index is fixed at construction, so a new sort
+    // rebuilds it under the new comparator - appending rows in sorted order
+    // at the end of the index is amortized constant time per row.
+    t_ftrav_index sort_elems = make_index(m_sort_orders);
+    auto& order_index = sort_elems.get<by_ftrav_order>();
+    for (auto& elem : elems) {
+        order_index.insert(order_index.end(), std::move(elem));
     }
+
+    m_index.swap(sort_elems);
 }
 
 t_index
 t_ftrav::size() const {
-    return m_index->size();
+    return m_index.size();
 }
 
 void
@@ -194,12 +225,7 @@ t_ftrav::get_row_indices(
     const tsl::hopscotch_set<t_tscalar>& pkeys,
     tsl::hopscotch_map<t_tscalar, t_index>& out_map
 ) const {
-    for (t_index idx = 0, loop_end = size(); idx < loop_end; ++idx) {
-        const t_tscalar& pkey = (*m_index)[idx].m_pkey;
-        if (pkeys.find(pkey) != pkeys.end()) {
-            out_map[pkey] = idx;
-        }
-    }
+    get_row_indices(0, size(), pkeys, out_map);
 }
 
 void
@@ -209,9 +235,9 @@ t_ftrav::get_row_indices(
     const tsl::hopscotch_set<t_tscalar>& pkeys,
     tsl::hopscotch_map<t_tscalar, t_index>& out_map
 ) const {
-    for (t_index idx = bidx; idx < eidx; ++idx) {
-        const t_tscalar& pkey = (*m_index)[idx].m_pkey;
-        if (pkeys.find(pkey) != pkeys.end()) {
+    for (const auto& pkey : pkeys) {
+        t_index idx = get_row_idx(pkey);
+        if (idx >= bidx && idx < eidx) {
             out_map[pkey] = idx;
         }
     }
@@ -226,33 +252,32 @@ t_ftrav::get_row_indices(
 std::vector<t_uindex>
 t_ftrav::get_row_indices(const tsl::hopscotch_set<t_tscalar>& pkeys) const {
     std::vector<t_uindex> rows;
-    for (t_uindex idx = 0, loop_end = size(); idx < loop_end; ++idx) {
-        const t_tscalar& pkey = (*m_index)[idx].m_pkey;
-        if (pkeys.find(pkey) != pkeys.end()) {
+    rows.reserve(pkeys.size());
+    for (const auto& pkey : pkeys) {
+        t_index idx = get_row_idx(pkey);
+        if (idx >= 0) {
             rows.push_back(idx);
         }
     }
+    std::sort(rows.begin(), rows.end());
     return rows;
 }
 
 void
 t_ftrav::reset() {
-    if (m_index != nullptr) {
-        m_index->clear();
-    }
+    m_index.clear();
 }
 
 void
 t_ftrav::check_size() {
     tsl::hopscotch_set<t_tscalar> pkey_set;
-    for (t_index idx = 0, loop_end = m_index->size(); idx < loop_end; ++idx) {
-        if (pkey_set.find((*m_index)[idx].m_pkey) != pkey_set.end()) {
-            std::cout << "Duplicate entry for " << (*m_index)[idx].m_pkey
-                      << '\n';
+    for (const t_mselem& elem : m_index.get<by_ftrav_order>()) {
+        if (pkey_set.find(elem.m_pkey) != pkey_set.end()) {
+            std::cout << "Duplicate entry for " << elem.m_pkey << '\n';
             PSP_COMPLAIN_AND_ABORT("Exiting");
         }
 
-        pkey_set.insert((*m_index)[idx].m_pkey);
+        pkey_set.insert(elem.m_pkey);
     }
 }
 
@@ -272,75 +297,30 @@ t_ftrav::validate_cells(const std::vector<std::pair<t_uindex, t_uindex>>& cells
 
 void
 t_ftrav::step_begin() {
-    m_step_deletes = 0;
-    m_step_inserts = 0;
-    m_new_elems.clear();
+    reset_step_state();
 }
 
 void
 t_ftrav::step_end() {
-    // The new number of rows in this traversal
-    t_index new_size = m_index->size() + m_step_inserts - m_step_deletes;
-
-    auto new_index = std::make_shared<std::vector<t_mselem>>();
-    new_index->reserve(new_size);
+    // Apply this step's changes in place - each delete, insert and update is
+    // O(log n), so a step costs O(k log n) for k changed rows rather than
+    // rebuilding the whole index.
+    auto& pkey_index = m_index.get<by_ftrav_pkey>();
 
-    t_uindex i = 0;
-    t_multisorter sorter(get_sort_orders(m_sortby));
-
-    std::vector<t_mselem> new_rows;
-    new_rows.reserve(m_new_elems.size());
-
-    for (tsl::hopscotch_map<t_tscalar, t_mselem>::const_iterator pkelem_iter =
-             m_new_elems.begin();
-         pkelem_iter != m_new_elems.end();
-         ++pkelem_iter) {
-        new_rows.push_back(pkelem_iter->second);
+    for (const auto& pkey : m_deleted_pkeys) {
+        pkey_index.erase(pkey);
     }
 
-    // TODO: int/float/date/datetime pkeys are already sorted here, so if
-    // there was a way to assert that `psp_pkey` is a string typed column,
-    // we can conditional the sort on whether m_sortby.size() > 0 or if
-    // psp_pkey is a string column.
-    std::sort(new_rows.begin(), new_rows.end(), sorter);
-
-    for (auto& new_elem : new_rows) {
-        while (i < m_index->size()) {
-            const t_mselem& old_elem = (*m_index)[i];
-
-            if (old_elem.m_deleted) {
-                i++;
-                m_pkeyidx.erase(old_elem.m_pkey);
-            } else if (old_elem.m_updated) {
-                i++;
-            } else if (sorter(old_elem, new_elem)) {
-                m_pkeyidx[old_elem.m_pkey] = new_index->size();
-                new_index->push_back(old_elem);
-                i++;
-            } else {
-                break;
-            }
-        }
-
-        m_pkeyidx[new_elem.m_pkey] = new_index->size();
-        new_index->push_back(new_elem);
-    }
-
-    // reconcile old rows that are marked as removed or updated.
-    while (i < m_index->size()) {
-        const t_mselem& old_elem = (*m_index)[i++];
-
-        if (old_elem.m_deleted) {
-            m_pkeyidx.erase(old_elem.m_pkey);
-        } else if (!old_elem.m_updated) {
-            // Add back cells that have not changed during this step.
-            m_pkeyidx[old_elem.m_pkey] = new_index->size();
-            new_index->push_back(old_elem);
+    for (const auto& pkelem : m_new_elems) {
+        auto iter = pkey_index.find(pkelem.first);
+        if (iter == pkey_index.end()) {
+            pkey_index.insert(pkelem.second);
+        } else {
+            pkey_index.replace(iter, pkelem.second);
         }
     }
 
-    std::swap(new_index, m_index);
-    m_new_elems.clear();
+    reset_step_state();
 }
 
 void
@@ -352,8 +332,7 @@ t_ftrav::add_row(
 ) {
     t_mselem mselem;
     fill_sort_elem(gstate, expression_master_table, config, pkey, mselem);
-    m_new_elems[pkey] = mselem;
-    ++m_step_inserts;
+    m_new_elems[pkey] = std::move(mselem);
 }
 
 void
@@ -366,26 +345,18 @@ t_ftrav::update_row(
     if (m_sortby.empty()) {
         return;
     }
-    auto pkiter = m_pkeyidx.find(pkey);
-    if (pkiter == m_pkeyidx.end()) {
-        add_row(gstate, expression_master_table, config, pkey);
-        return;
-    }
-    t_mselem mselem;
-    fill_sort_elem(gstate, expression_master_table, config, pkey, mselem);
-    (*m_index)[pkiter->second].m_updated = true;
-    m_new_elems[pkey] = mselem;
+    // New and existing rows are both staged in `m_new_elems` - `step_end`
+    // decides whether to insert or re-position them.
+    add_row(gstate, expression_master_table, config, pkey);
 }
 
 void
 t_ftrav::delete_row(t_tscalar pkey) {
-    auto pkiter = m_pkeyidx.find(pkey);
-    if (pkiter == m_pkeyidx.end()) {
-        return;
-    }
-    (*m_index)[pkiter->second].m_deleted = true;
     m_new_elems.erase(pkey);
-    ++m_step_deletes;
+    const auto& pkey_index = m_index.get<by_ftrav_pkey>();
+    if (pkey_index.find(pkey) != pkey_index.end()) {
+        m_deleted_pkeys.insert(pkey);
+    }
 }
 
 std::vector<t_sortspec>
@@ -400,9 +371,8 @@ t_ftrav::empty_sort_by() const {
 
 void
 t_ftrav::reset_step_state() {
-    m_step_deletes = 0;
-    m_step_inserts = 0;
     m_new_elems.clear();
+    m_deleted_pkeys.clear();
 }
 
 t_uindex
@@ -411,24 +381,23 @@ t_ftrav::lower_bound_row_idx(
     const t_config& config,
     const std::vector<t_tscalar>& row
 ) const {
-    t_multisorter sorter(get_sort_orders(m_sortby));
     t_mselem target_val;
 
     fill_sort_elem(gstate, config, row, target_val);
 
-    auto iter =
-        std::lower_bound(m_index->begin(), m_index->end(), target_val, sorter);
-
-    return std::distance(m_index->begin(), iter);
+    const auto& index = m_index.get<by_ftrav_order>();
+    return index.rank(index.lower_bound(target_val));
 }
 
 t_index
 t_ftrav::get_row_idx(t_tscalar pkey) const {
-    auto pkiter = m_pkeyidx.find(pkey);
-    if (pkiter == m_pkeyidx.end()) {
+    const auto& pkey_index = m_index.get<by_ftrav_pkey>();
+    auto pkiter = pkey_index.find(pkey);
+    if (pkiter == pkey_index.end()) {
         return -1;
     }
-    return pkiter->second;
+    const auto& order_index = m_index.get<by_ftrav_order>();
+    return order_index.rank(m_index.project<by_ftrav_order>(pkiter));
 }
 
 t_tscalar
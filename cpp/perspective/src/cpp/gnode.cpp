@@ -129,6 +129,7 @@ t_gnode::init() {
     // Initialize expression-related state
     m_expression_vocab = std::make_shared<t_expression_vocab>();
     m_expression_regex_mapping = std::make_shared<t_regex_mapping>();
+    m_expression_cache = std::make_shared<t_expression_cache>();
 
     m_init = true;
 }
@@ -305,18 +306,15 @@ t_gnode::_process_table(t_uindex port_id) {
 
     t_uindex flattened_num_rows = flattened->num_rows();
 
-    std::vector<t_rlookup> row_lookup(flattened_num_rows);
-    t_column* pkey_col = flattened->get_column("psp_pkey").get();
-
-    for (t_uindex idx = 0; idx < flattened_num_rows; ++idx) {
-        // See if each primary key in flattened already exist in the dataset
-        t_tscalar pkey = pkey_col->get_scalar(idx);
-        row_lookup[idx] = m_gstate->lookup(pkey);
-    }
-
-    // first update - master table is empty
+    // first update - master table is empty, so every lookup would miss and
+    // the flattened table can be loaded as-is.
     if (m_gstate->mapping_size() == 0) {
-        m_gstate->update_master_table(flattened.get());
+        if (m_gstate->num_rows() == 0) {
+            m_gstate->bulk_load_master_table(flattened);
+        } else {
+            m_gstate->update_master_table(flattened.get());
+        }
+
         m_oports[PSP_PORT_FLATTENED]->set_table(flattened);
 
         _compute_expressions(flattened);
@@ -338,6 +336,10 @@ t_gnode::_process_table(t_uindex port_id) {
 
     input_port->release_or_clear();
 
+    // See if each primary key in flattened already exist in the dataset
+    std::vector<t_rlookup> row_lookup;
+    m_gstate->lookup(*flattened->get_const_column("psp_pkey"), row_lookup);
+
     // Use `t_process_state` to manage intermediate structures
     t_process_state _process_state;
 
@@ -658,9 +660,8 @@ t_gnode::_process_column<std::string>(
                 );
 
                 if (prev_valid) {
-                    pcolumn->set_nth<t_uindex>(
-                        added_count,
-                        *(scolumn->get_nth<t_uindex>(rlookup.m_idx))
+                    pcolumn->set_vocab_index(
+                        added_count, scolumn->get_vocab_index(rlookup.m_idx)
                     );
                 }
 
@@ -744,6 +745,49 @@ t_gnode::mapping_size() const {
     return m_gstate->mapping_size();
 }
 
+t_uindex
+t_gnode::compact_vocabularies() {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(
+        m_init, "Cannot `compact_vocabularies` on an uninited gnode."
+    );
+    PSP_GIL_UNLOCK();
+    PSP_WRITE_LOCK(*m_lock);
+    return m_gstate->compact_vocabularies();
+}
+
+t_uindex
+t_gnode::maybe_compact_vocabularies() {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(
+        m_init, "Cannot `maybe_compact_vocabularies` on an uninited gnode."
+    );
+    PSP_GIL_UNLOCK();
+    PSP_WRITE_LOCK(*m_lock);
+    if (!m_gstate->should_compact_vocabularies()) {
+        return 0;
+    }
+
+    return m_gstate->compact_vocabularies();
+}
+
+t_uindex
+t_gnode::get_reclaimable_vocab_bytes() const {
+    PSP_GIL_UNLOCK();
+    PSP_READ_LOCK(*m_lock);
+    return m_gstate->get_reclaimable_vocab_bytes();
+}
+
+t_uindex
+t_gnode::add_vocab_listener(t_gstate::t_vocab_listener listener) {
+    return m_gstate->add_vocab_listener(std::move(listener));
+}
+
+void
+t_gnode::remove_vocab_listener(t_uindex id) {
+    m_gstate->remove_vocab_listener(id);
+}
+
 t_data_table*
 t_gnode::_get_otable(t_uindex port_id) {
     PSP_TRACE_SENTINEL();
@@ -1012,29 +1056,17 @@ t_gnode::_register_context(
         pkeyed_table = m_gstate->get_pkeyed_table();
     }
 
-    t_expression_vocab& expression_vocab = *(m_expression_vocab);
-    t_regex_mapping& expression_regex_mapping = *(m_expression_regex_mapping);
-
     switch (type) {
         case TWO_SIDED_CONTEXT: {
             set_ctx_state<t_ctx2>(ptr_);
             auto* ctx = static_cast<t_ctx2*>(ptr_);
             ctx->reset();
+            _acquire_expressions(
+                ctx->get_config().get_expressions(),
+                *(ctx->get_expression_tables())
+            );
 
             if (should_update) {
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-
                 update_context_from_state<t_ctx2>(ctx, name, pkeyed_table);
             }
         } break;
@@ -1042,20 +1074,11 @@ t_gnode::_register_context(
             set_ctx_state<t_ctx1>(ptr_);
             auto* ctx = static_cast<t_ctx1*>(ptr_);
             ctx->reset();
+            _acquire_expressions(
+                ctx->get_config().get_expressions(),
+                *(ctx->get_expression_tables())
+            );
             if (should_update) {
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-
                 update_context_from_state<t_ctx1>(ctx, name, pkeyed_table);
             }
         } break;
@@ -1063,20 +1086,11 @@ t_gnode::_register_context(
             set_ctx_state<t_ctx0>(ptr_);
             auto* ctx = static_cast<t_ctx0*>(ptr_);
             ctx->reset();
+            _acquire_expressions(
+                ctx->get_config().get_expressions(),
+                *(ctx->get_expression_tables())
+            );
             if (should_update) {
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-
                 update_context_from_state<t_ctx0>(ctx, name, pkeyed_table);
             }
         } break;
@@ -1094,21 +1108,12 @@ t_gnode::_register_context(
             set_ctx_state<t_ctx0>(ptr_);
             auto* ctx = static_cast<t_ctx_grouped_pkey*>(ptr_);
             ctx->reset();
+            _acquire_expressions(
+                ctx->get_config().get_expressions(),
+                *(ctx->get_expression_tables())
+            );
 
             if (should_update) {
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-
                 update_context_from_state<t_ctx_grouped_pkey>(
                     ctx, name, pkeyed_table
                 );
@@ -1124,9 +1129,33 @@ void
 t_gnode::_unregister_context(const std::string& name) {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
-    if (m_contexts.count(name) != 0) {
-        m_contexts.erase(name);
+    auto it = m_contexts.find(name);
+    if (it == m_contexts.end()) {
+        return;
     }
+
+    const t_ctx_handle& ctxh = it->second;
+    switch (ctxh.get_type()) {
+        case TWO_SIDED_CONTEXT: {
+            _release_expressions(ctxh.get<t_ctx2>());
+        } break;
+        case ONE_SIDED_CONTEXT: {
+            _release_expressions(ctxh.get<t_ctx1>());
+        } break;
+        case ZERO_SIDED_CONTEXT: {
+            _release_expressions(ctxh.get<t_ctx0>());
+        } break;
+        case GROUPED_PKEY_CONTEXT: {
+            _release_expressions(ctxh.get<t_ctx_grouped_pkey>());
+        } break;
+        case UNIT_CONTEXT:
+            break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Unexpected context type");
+        } break;
+    }
+
+    m_contexts.erase(name);
 }
 
 void
@@ -1187,79 +1216,25 @@ void
 t_gnode::_compute_expressions(
     const std::shared_ptr<t_data_table>& flattened_masked
 ) {
-    t_expression_vocab& expression_vocab = *(m_expression_vocab);
-    t_regex_mapping& expression_regex_mapping = *(m_expression_regex_mapping);
-
-    for (const auto& iter : m_contexts) {
-        const t_ctx_handle& ctxh = iter.second;
-        switch (ctxh.get_type()) {
-            case TWO_SIDED_CONTEXT: {
-                auto* ctx = static_cast<t_ctx2*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-            } break;
-            case ONE_SIDED_CONTEXT: {
-                auto* ctx = static_cast<t_ctx1*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-            } break;
-            case ZERO_SIDED_CONTEXT: {
-                auto* ctx = static_cast<t_ctx0*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-            } break;
-            case GROUPED_PKEY_CONTEXT: {
-                auto* ctx = static_cast<t_ctx_grouped_pkey*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    m_gstate->get_table(),
-                    m_gstate->get_pkey_map(),
-                    expression_vocab,
-                    expression_regex_mapping
-                );
-                ctx->get_expression_tables()->set_flattened(
-                    m_gstate->get_pkeyed_table(
-                        ctx->get_expression_tables()->m_master->get_schema(),
-                        ctx->get_expression_tables()->m_master
-                    )
-                );
-            } break;
-            case UNIT_CONTEXT:
-                break;
-            default: {
-                PSP_COMPLAIN_AND_ABORT("Unexpected context type");
-            } break;
-        }
+    if (m_expression_cache->empty()) {
+        return;
     }
+
+    m_expression_cache->compute(
+        m_expression_cache->get_expressions(),
+        m_gstate->get_table(),
+        m_gstate->get_pkey_map(),
+        *(m_expression_vocab),
+        *(m_expression_regex_mapping)
+    );
+
+    const std::shared_ptr<t_expression_tables>& expression_tables =
+        m_expression_cache->get_tables();
+    expression_tables->set_flattened(m_gstate->get_pkeyed_table(
+        expression_tables->m_master->get_schema(), expression_tables->m_master
+    ));
+
+    _share_expressions();
 }
 
 void
@@ -1267,81 +1242,73 @@ t_gnode::_compute_expressions(
     const std::shared_ptr<t_data_table>& master,
     const std::shared_ptr<t_data_table>& flattened
 ) {
-    std::shared_ptr<t_data_table> delta = m_oports[PSP_PORT_DELTA]->get_table();
-    std::shared_ptr<t_data_table> prev = m_oports[PSP_PORT_PREV]->get_table();
-    std::shared_ptr<t_data_table> current =
-        m_oports[PSP_PORT_CURRENT]->get_table();
-    std::shared_ptr<t_data_table> transitions =
-        m_oports[PSP_PORT_TRANSITIONS]->get_table();
-    std::shared_ptr<t_data_table> existed =
-        m_oports[PSP_PORT_EXISTED]->get_table();
+    if (m_expression_cache->empty()) {
+        return;
+    }
+
+    m_expression_cache->compute(
+        master,
+        m_gstate->get_pkey_map(),
+        flattened,
+        m_oports[PSP_PORT_DELTA]->get_table(),
+        m_oports[PSP_PORT_PREV]->get_table(),
+        m_oports[PSP_PORT_CURRENT]->get_table(),
+        m_oports[PSP_PORT_EXISTED]->get_table(),
+        *(m_expression_vocab),
+        *(m_expression_regex_mapping)
+    );
+
+    _share_expressions();
+}
+
+void
+t_gnode::_acquire_expressions(
+    const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+    const t_expression_tables& expression_tables
+) {
+    std::vector<std::shared_ptr<t_computed_expression>> added =
+        m_expression_cache->acquire(expressions);
+
+    // Without any data, the expressions are computed with the first update.
+    if (m_gstate->mapping_size() == 0) {
+        return;
+    }
 
-    t_expression_vocab& expression_vocab = *(m_expression_vocab);
-    t_regex_mapping& expression_regex_mapping = *(m_expression_regex_mapping);
+    // Only expressions that no other context uses need to be computed.
+    if (!added.empty()) {
+        m_expression_cache->compute(
+            added,
+            m_gstate->get_table(),
+            m_gstate->get_pkey_map(),
+            *(m_expression_vocab),
+            *(m_expression_regex_mapping)
+        );
+    }
+
+    // The context is updated from its own flattened table, which leaves the
+    // cache's transitional tables as they were for the other contexts.
+    m_expression_cache->share_master(expressions, expression_tables);
+    expression_tables.set_flattened(m_gstate->get_pkeyed_table(
+        expression_tables.m_master->get_schema(), expression_tables.m_master
+    ));
+}
 
+void
+t_gnode::_share_expressions() const {
     for (const auto& iter : m_contexts) {
         const t_ctx_handle& ctxh = iter.second;
-
         switch (ctxh.get_type()) {
             case TWO_SIDED_CONTEXT: {
-                auto* ctx = static_cast<t_ctx2*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    master,
-                    m_gstate->get_pkey_map(),
-                    flattened,
-                    delta,
-                    prev,
-                    current,
-                    transitions,
-                    existed,
-                    expression_vocab,
-                    expression_regex_mapping
-                );
+                _share_expressions(ctxh.get<t_ctx2>());
             } break;
             case ONE_SIDED_CONTEXT: {
-                auto* ctx = static_cast<t_ctx1*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    master,
-                    m_gstate->get_pkey_map(),
-                    flattened,
-                    delta,
-                    prev,
-                    current,
-                    transitions,
-                    existed,
-                    expression_vocab,
-                    expression_regex_mapping
-                );
+                _share_expressions(ctxh.get<t_ctx1>());
             } break;
             case ZERO_SIDED_CONTEXT: {
-                auto* ctx = static_cast<t_ctx0*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    master,
-                    m_gstate->get_pkey_map(),
-                    flattened,
-                    delta,
-                    prev,
-                    current,
-                    transitions,
-                    existed,
-                    expression_vocab,
-                    expression_regex_mapping
-                );
+                _share_expressions(ctxh.get<t_ctx0>());
             } break;
             case GROUPED_PKEY_CONTEXT: {
-                auto* ctx = static_cast<t_ctx_grouped_pkey*>(ctxh.m_ctx);
-                ctx->compute_expressions(
-                    master,
-                    m_gstate->get_pkey_map(),
-                    flattened,
-                    delta,
-                    prev,
-                    current,
-                    transitions,
-                    existed,
-                    expression_vocab,
-                    expression_regex_mapping
-                );
+                _share_expressions(ctxh.get<t_ctx_grouped_pkey>());
             } break;
             case UNIT_CONTEXT:
                 break;
@@ -1477,6 +1444,16 @@ t_gnode::num_input_ports() const {
     return m_input_ports.size();
 }
 
+t_uindex
+t_gnode::num_queued_rows() const {
+    t_uindex rval = 0;
+    for (const auto& iter : m_input_ports) {
+        rval += iter.second->get_table()->size();
+    }
+
+    return rval;
+}
+
 t_uindex
 t_gnode::num_output_ports() const {
     return m_oports.size();
@@ -1591,6 +1568,7 @@ t_gnode::reset() {
     m_gstate->reset();
 
     // Clear expression-related state
+    m_expression_cache->reset();
     m_expression_vocab->clear();
     m_expression_regex_mapping->clear();
 }
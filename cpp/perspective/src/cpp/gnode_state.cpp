@@ -24,10 +24,24 @@
 
 namespace perspective {
 
+// Number of rows each task reads out of the pkey column during a bulk load.
+static const t_uindex BULK_LOAD_PARTITION_SIZE = 65536;
+
+// A string column's vocabulary is compacted once it holds more than this
+// many strings per live row, and at least `VOCAB_COMPACT_MIN_SIZE` strings.
+static const t_uindex VOCAB_COMPACT_RATIO = 2;
+static const t_uindex VOCAB_COMPACT_MIN_SIZE = 1024;
+
 t_gstate::t_gstate(t_schema input_schema, t_schema output_schema) :
     m_input_schema(std::move(input_schema)),
     m_output_schema(std::move(output_schema)),
-    m_init(false) {
+    m_init(false),
+    m_mapping(
+        m_input_schema.has_column("psp_pkey")
+            ? m_input_schema.get_dtype("psp_pkey")
+            : DTYPE_NONE
+    ),
+    m_vocab_listener_id(0) {
     LOG_CONSTRUCTOR("t_gstate");
 }
 
@@ -46,17 +60,12 @@ t_gstate::init() {
 
 t_rlookup
 t_gstate::lookup(t_tscalar pkey) const {
-    t_rlookup rval(0, false);
-
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
-
-    if (iter == m_mapping.end()) {
-        return rval;
-    }
+    return m_mapping.find(pkey);
+}
 
-    rval.m_idx = iter->second;
-    rval.m_exists = true;
-    return rval;
+void
+t_gstate::lookup(const t_column& pkeys, std::vector<t_rlookup>& out) const {
+    m_mapping.lookup(pkeys, out);
 }
 
 void
@@ -66,38 +75,37 @@ t_gstate::_mark_deleted(t_uindex idx) {
 
 void
 t_gstate::erase(const t_tscalar& pkey) {
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
+    t_rlookup row = m_mapping.find(pkey);
 
-    if (iter == m_mapping.end()) {
+    if (!row.m_exists) {
         return;
     }
 
     auto columns = m_table->get_columns();
 
-    t_uindex idx = iter->second;
+    t_uindex idx = row.m_idx;
 
     for (auto* c : columns) {
         c->clear(idx);
     }
 
-    m_mapping.erase(iter);
+    m_mapping.erase(pkey);
     _mark_deleted(idx);
 }
 
 t_uindex
 t_gstate::lookup_or_create(const t_tscalar& pkey) {
-    auto pkey_ = m_symtable.get_interned_tscalar(pkey);
-    t_mapping::const_iterator iter = m_mapping.find(pkey_);
+    t_rlookup row = m_mapping.find(pkey);
 
-    if (iter != m_mapping.end()) {
-        return iter->second;
+    if (row.m_exists) {
+        return row.m_idx;
     }
 
     if (!m_free.empty()) {
         t_free_items::const_iterator iter = m_free.begin();
         t_uindex idx = *iter;
         m_free.erase(iter);
-        m_mapping[pkey_] = idx;
+        m_mapping.insert(pkey, idx);
         return idx;
     }
 
@@ -114,7 +122,7 @@ t_gstate::lookup_or_create(const t_tscalar& pkey) {
     m_table->set_size(nrows + 1);
     m_opcol->set_nth<std::uint8_t>(nrows, OP_INSERT);
     m_pkcol->set_scalar(nrows, pkey);
-    m_mapping[pkey_] = nrows;
+    m_mapping.insert(pkey, nrows);
     return nrows;
 }
 
@@ -165,7 +173,7 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
         switch (op) {
             case OP_INSERT: {
                 // Write new primary keys into `m_mapping`
-                m_mapping[m_symtable.get_interned_tscalar(pkey)] = idx;
+                m_mapping.insert(pkey, idx);
                 m_opcol->set_nth<std::uint8_t>(idx, OP_INSERT);
                 m_pkcol->set_scalar(idx, pkey);
             } break;
@@ -183,6 +191,92 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
 #endif
 }
 
+void
+t_gstate::bulk_load_master_table(const std::shared_ptr<t_data_table>& flattened
+) {
+    PSP_VERBOSE_ASSERT(num_rows() == 0, "Master table is not empty");
+    m_free.clear();
+    m_mapping.clear();
+
+    const t_schema& master_table_schema = m_table->get_schema();
+    auto* master_table = m_table.get();
+
+    parallel_for(
+        int(master_table->num_columns()),
+        [&master_table, &master_table_schema, &flattened](int idx) {
+            // Adopt each column from flattened - the gnode releases flattened
+            // once the update has been processed, so nothing else writes to
+            // it. Columns borrowed from the update's Arrow payload are copied
+            // first, so that the master table never keeps the payload alive.
+            auto flattened_column =
+                flattened->get_column_safe(master_table_schema.m_columns[idx]);
+            if (!flattened_column) {
+                return;
+            }
+
+            flattened_column->detach_data();
+            master_table->set_column(idx, flattened_column);
+        }
+    );
+
+    m_pkcol = master_table->get_column("psp_pkey");
+    m_opcol = master_table->get_column("psp_op");
+
+    master_table->set_capacity(flattened->get_capacity());
+    master_table->set_size(flattened->size());
+
+    t_uindex num_rows = flattened->num_rows();
+    const t_column* flattened_pkey_col =
+        flattened->get_const_column("psp_pkey").get();
+    const t_column* flattened_op_col =
+        flattened->get_const_column("psp_op").get();
+
+    // Materializing the scalars is the expensive part of building the map,
+    // so do it in parallel over fixed size partitions of the pkey column.
+    std::vector<t_tscalar> pkeys(num_rows);
+    t_uindex num_partitions =
+        (num_rows + BULK_LOAD_PARTITION_SIZE - 1) / BULK_LOAD_PARTITION_SIZE;
+
+    parallel_for(
+        int(num_partitions),
+        [&pkeys, flattened_pkey_col, num_rows](int partition) {
+            t_uindex begin = partition * BULK_LOAD_PARTITION_SIZE;
+            t_uindex end =
+                std::min(begin + BULK_LOAD_PARTITION_SIZE, num_rows);
+            for (t_uindex idx = begin; idx < end; ++idx) {
+                pkeys[idx] = flattened_pkey_col->get_scalar(idx);
+            }
+        }
+    );
+
+    std::vector<t_uindex> inserted;
+    inserted.reserve(num_rows);
+
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        const auto* op_ptr = flattened_op_col->get_nth<std::uint8_t>(idx);
+        t_op op = static_cast<t_op>(*op_ptr);
+
+        switch (op) {
+            case OP_INSERT: {
+                inserted.push_back(idx);
+            } break;
+            case OP_DELETE: {
+                _mark_deleted(idx);
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unexpected OP");
+            } break;
+        }
+    }
+
+    // The index is built in parallel over partitions of the key space.
+    m_mapping.bulk_insert(pkeys, inserted);
+
+#ifdef PSP_TABLE_VERIFY
+    master_table->verify();
+#endif
+}
+
 void
 t_gstate::update_master_table(const t_data_table* flattened) {
     if (num_rows() == 0) {
@@ -380,10 +474,10 @@ void
 t_gstate::pprint() const {
     std::vector<t_uindex> indices(m_mapping.size());
     t_uindex idx = 0;
-    for (const auto& iter : m_mapping) {
-        indices[idx] = iter.second;
+    m_mapping.for_each([&indices, &idx](const t_tscalar&, t_uindex ridx) {
+        indices[idx] = ridx;
         ++idx;
-    }
+    });
     m_table->pprint(indices);
 }
 
@@ -391,9 +485,9 @@ t_mask
 t_gstate::get_cpp_mask() const {
     t_uindex sz = m_table->size();
     t_mask msk(sz);
-    for (const auto& iter : m_mapping) {
-        msk.set(iter.second, true);
-    }
+    m_mapping.for_each([&msk](const t_tscalar&, t_uindex idx) {
+        msk.set(idx, true);
+    });
     return msk;
 }
 
@@ -408,9 +502,9 @@ t_gstate::read_by_pkey(
 ) const {
     std::shared_ptr<const t_column> col = table.get_const_column(colname);
     const t_column* col_ = col.get();
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
-    if (iter != m_mapping.end()) {
-        return col_->get_scalar(iter->second);
+    t_rlookup row = m_mapping.find(pkey);
+    if (row.m_exists) {
+        return col_->get_scalar(row.m_idx);
     }
     PSP_COMPLAIN_AND_ABORT("Called without pkey");
 }
@@ -428,9 +522,9 @@ t_gstate::read_column(
     std::vector<t_tscalar> rval(num_rows);
 
     for (t_index idx = 0; idx < num_rows; ++idx) {
-        t_mapping::const_iterator iter = m_mapping.find(pkeys[idx]);
-        if (iter != m_mapping.end()) {
-            rval[idx].set(col_->get_scalar(iter->second));
+        t_rlookup row = m_mapping.find(pkeys[idx]);
+        if (row.m_exists) {
+            rval[idx].set(col_->get_scalar(row.m_idx));
         }
     }
 
@@ -462,9 +556,9 @@ t_gstate::read_column(
     std::vector<double> rval;
     rval.reserve(num_rows);
     for (t_index idx = 0; idx < num_rows; ++idx) {
-        t_mapping::const_iterator iter = m_mapping.find(pkeys[idx]);
-        if (iter != m_mapping.end()) {
-            auto tscalar = col_->get_scalar(iter->second);
+        t_rlookup row = m_mapping.find(pkeys[idx]);
+        if (row.m_exists) {
+            auto tscalar = col_->get_scalar(row.m_idx);
             if (include_nones || tscalar.is_valid()) {
                 rval.push_back(tscalar.to_double());
             }
@@ -528,10 +622,10 @@ t_tscalar
 t_gstate::get(
     const t_data_table& table, const std::string& colname, t_tscalar pkey
 ) const {
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
-    if (iter != m_mapping.end()) {
+    t_rlookup row = m_mapping.find(pkey);
+    if (row.m_exists) {
         std::shared_ptr<const t_column> col = table.get_const_column(colname);
-        return col->get_scalar(iter->second);
+        return col->get_scalar(row.m_idx);
     }
 
     return {};
@@ -545,9 +639,9 @@ t_gstate::get_value(
     const t_column* col_ = col.get();
     t_tscalar rval = mknone();
 
-    auto iter = m_mapping.find(pkey);
-    if (iter != m_mapping.end()) {
-        rval.set(col_->get_scalar(iter->second));
+    t_rlookup row = m_mapping.find(pkey);
+    if (row.m_exists) {
+        rval.set(col_->get_scalar(row.m_idx));
     }
 
     return rval;
@@ -565,9 +659,9 @@ t_gstate::is_unique(
     value = mknone();
 
     for (const auto& pkey : pkeys) {
-        t_mapping::const_iterator iter = m_mapping.find(pkey);
-        if (iter != m_mapping.end()) {
-            auto tmp = col_->get_scalar(iter->second);
+        t_rlookup row = m_mapping.find(pkey);
+        if (row.m_exists) {
+            auto tmp = col_->get_scalar(row.m_idx);
             if (!value.is_none() && value != tmp) {
                 return false;
             }
@@ -592,9 +686,9 @@ t_gstate::apply(
     value = mknone();
 
     for (const auto& pkey : pkeys) {
-        t_mapping::const_iterator iter = m_mapping.find(pkey);
-        if (iter != m_mapping.end()) {
-            auto tmp = col_->get_scalar(iter->second);
+        t_rlookup row = m_mapping.find(pkey);
+        if (row.m_exists) {
+            auto tmp = col_->get_scalar(row.m_idx);
             bool done = fn(tmp, value);
             if (done) {
                 value = tmp;
@@ -621,8 +715,7 @@ t_gstate::get_pkey_dtype() const {
     if (m_mapping.empty()) {
         return DTYPE_STR;
     }
-    auto iter = m_mapping.begin();
-    return iter->first.get_dtype();
+    return m_mapping.get_key_dtype();
 }
 
 std::shared_ptr<t_data_table>
@@ -693,13 +786,13 @@ t_gstate::get_row_data_pkeys(const std::vector<t_tscalar>& pkeys) const {
     auto none = mknone();
 
     for (const auto& pkey : pkeys) {
-        t_mapping::const_iterator iter = m_mapping.find(pkey);
-        if (iter == m_mapping.end()) {
+        t_rlookup row = m_mapping.find(pkey);
+        if (!row.m_exists) {
             continue;
         }
 
         for (t_uindex cidx = 0; cidx < ncols; ++cidx) {
-            auto v = columns[cidx]->get_scalar(iter->second);
+            auto v = columns[cidx]->get_scalar(row.m_idx);
             if (v.is_valid()) {
                 rval.push_back(v);
             } else {
@@ -712,7 +805,7 @@ t_gstate::get_row_data_pkeys(const std::vector<t_tscalar>& pkeys) const {
 
 bool
 t_gstate::has_pkey(t_tscalar pkey) const {
-    return m_mapping.find(pkey) != m_mapping.end();
+    return m_mapping.find(pkey).m_exists;
 }
 
 std::vector<t_tscalar>
@@ -726,7 +819,7 @@ t_gstate::has_pkeys(const std::vector<t_tscalar>& pkeys) const {
 
     for (const auto& p : pkeys) {
         t_tscalar tval;
-        tval.set(m_mapping.find(p) != m_mapping.end());
+        tval.set(m_mapping.find(p).m_exists);
         rval[idx].set(tval);
         ++idx;
     }
@@ -738,10 +831,10 @@ std::vector<t_tscalar>
 t_gstate::get_pkeys() const {
     std::vector<t_tscalar> rval(m_mapping.size());
     t_uindex idx = 0;
-    for (const auto& kv : m_mapping) {
-        rval[idx].set(kv.first);
+    m_mapping.for_each([&rval, &idx](const t_tscalar& pkey, t_uindex) {
+        rval[idx].set(pkey);
         ++idx;
-    }
+    });
     return rval;
 }
 
@@ -772,6 +865,81 @@ t_gstate::mapping_size() const {
     return m_mapping.size();
 }
 
+t_uindex
+t_gstate::compact_vocabularies() {
+    t_mask live_rows = get_cpp_mask();
+    t_uindex rv = 0;
+
+    for (const auto& colname : m_table->get_schema().m_columns) {
+        std::shared_ptr<t_column> col = m_table->get_column(colname);
+
+        if (col->get_dtype() != DTYPE_STR) {
+            continue;
+        }
+
+        t_uindex before = col->_get_vocab()->nbytes();
+        std::vector<t_uindex> remap = col->compact_vocabulary(live_rows);
+        t_uindex after = col->_get_vocab()->nbytes();
+
+        if (after < before) {
+            rv += before - after;
+        }
+
+        for (const auto& listener : m_vocab_listeners) {
+            listener.second(colname, remap);
+        }
+    }
+
+    return rv;
+}
+
+bool
+t_gstate::should_compact_vocabularies() const {
+    t_uindex threshold = std::max(
+        VOCAB_COMPACT_MIN_SIZE, VOCAB_COMPACT_RATIO * m_mapping.size()
+    );
+
+    for (const auto& colname : m_table->get_schema().m_columns) {
+        std::shared_ptr<t_column> col = m_table->get_column(colname);
+
+        if (col->get_dtype() == DTYPE_STR
+            && col->_get_vocab()->get_vlenidx() > threshold) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+t_uindex
+t_gstate::get_reclaimable_vocab_bytes() const {
+    t_mask live_rows = get_cpp_mask();
+    t_uindex rv = 0;
+
+    for (const auto& colname : m_table->get_schema().m_columns) {
+        std::shared_ptr<const t_column> col =
+            m_table->get_const_column(colname);
+
+        if (col->get_dtype() == DTYPE_STR) {
+            rv += col->get_reclaimable_vocab_bytes(live_rows);
+        }
+    }
+
+    return rv;
+}
+
+t_uindex
+t_gstate::add_vocab_listener(t_vocab_listener listener) {
+    t_uindex id = m_vocab_listener_id++;
+    m_vocab_listeners[id] = std::move(listener);
+    return id;
+}
+
+void
+t_gstate::remove_vocab_listener(t_uindex id) {
+    m_vocab_listeners.erase(id);
+}
+
 void
 t_gstate::reset() {
     m_table->reset();
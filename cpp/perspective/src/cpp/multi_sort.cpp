@@ -15,6 +15,8 @@
 #include <perspective/base.h>
 #include <perspective/multi_sort.h>
 #include <perspective/scalar.h>
+#include <cmath>
+#include <cstring>
 #include <utility>
 #include <vector>
 
@@ -24,28 +26,40 @@ t_mselem::t_mselem() :
     m_pkey(mknone()),
     m_order(0),
     m_deleted(false),
-    m_updated(false) {}
+    m_updated(false),
+    m_key(),
+    m_key_size(0),
+    m_key_complete(false) {}
 
 t_mselem::t_mselem(const std::vector<t_tscalar>& row) :
     m_row(row),
     m_pkey(mknone()),
     m_order(0),
     m_deleted(false),
-    m_updated(false) {}
+    m_updated(false),
+    m_key(),
+    m_key_size(0),
+    m_key_complete(false) {}
 
 t_mselem::t_mselem(const std::vector<t_tscalar>& row, t_uindex order) :
     m_row(row),
     m_pkey(mknone()),
     m_order(order),
     m_deleted(false),
-    m_updated(false) {}
+    m_updated(false),
+    m_key(),
+    m_key_size(0),
+    m_key_complete(false) {}
 
 t_mselem::t_mselem(const t_tscalar& pkey, const std::vector<t_tscalar>& row) :
     m_row(row),
     m_pkey(pkey),
     m_order(0),
     m_deleted(false),
-    m_updated(false) {}
+    m_updated(false),
+    m_key(),
+    m_key_size(0),
+    m_key_complete(false) {}
 
 t_mselem::t_mselem(const t_mselem& other) {
     m_pkey = other.m_pkey;
@@ -53,6 +67,9 @@ t_mselem::t_mselem(const t_mselem& other) {
     m_deleted = other.m_deleted;
     m_updated = other.m_updated;
     m_order = other.m_order;
+    m_key = other.m_key;
+    m_key_size = other.m_key_size;
+    m_key_complete = other.m_key_complete;
 }
 
 t_mselem::t_mselem(t_mselem&& other) noexcept {
@@ -61,6 +78,9 @@ t_mselem::t_mselem(t_mselem&& other) noexcept {
     m_deleted = other.m_deleted;
     m_updated = other.m_updated;
     m_order = other.m_order;
+    m_key = other.m_key;
+    m_key_size = other.m_key_size;
+    m_key_complete = other.m_key_complete;
 }
 
 t_mselem& t_mselem::operator=(const t_mselem& other) = default;
@@ -72,6 +92,9 @@ t_mselem::operator=(t_mselem&& other) noexcept {
     m_deleted = other.m_deleted;
     m_updated = other.m_updated;
     m_order = other.m_order;
+    m_key = other.m_key;
+    m_key_size = other.m_key_size;
+    m_key_complete = other.m_key_complete;
     return *this;
 }
 
@@ -207,6 +230,232 @@ nan_compare(t_sorttype order, const t_tscalar& a, const t_tscalar& b) {
     return rval;
 }
 
+namespace {
+
+    // The payload of every encoded column is 8 bytes wide, preceded by a
+    // tag byte.
+    const t_uindex SORT_KEY_PAYLOAD_WIDTH = 8;
+
+    void
+    write_sort_key_payload(std::uint8_t* out, std::uint64_t value) {
+        for (t_uindex idx = 0; idx < SORT_KEY_PAYLOAD_WIDTH; ++idx) {
+            out[idx] = static_cast<std::uint8_t>(
+                value >> (8 * (SORT_KEY_PAYLOAD_WIDTH - 1 - idx))
+            );
+        }
+    }
+
+    std::uint64_t
+    encode_signed(std::int64_t value) {
+        return static_cast<std::uint64_t>(value) ^ (1ULL << 63);
+    }
+
+    std::uint64_t
+    encode_double(double value) {
+        // -0.0 and 0.0 must encode identically, see `encode_sort_key`.
+        if (value == 0) {
+            value = 0;
+        }
+
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & (1ULL << 63)) != 0 ? ~bits : bits | (1ULL << 63);
+    }
+
+    bool
+    is_nan_for_sort(const t_tscalar& value) {
+        return value.is_floating_point() && std::isnan(value.to_double());
+    }
+
+    // Writes the key of `row` to `elem`, returning whether it encodes every
+    // column exactly.
+    bool
+    write_sort_key(
+        t_mselem& elem,
+        const std::vector<t_tscalar>& row,
+        const std::vector<t_sorttype>& sort_order
+    ) {
+        elem.m_key_size = 0;
+
+        if (row.size() != sort_order.size()) {
+            return false;
+        }
+
+        std::uint8_t* key = elem.m_key.data();
+        t_uindex offset = 0;
+        bool is_complete = true;
+
+        for (t_uindex idx = 0, loop_end = sort_order.size(); idx < loop_end;
+             ++idx) {
+            const t_tscalar& value = row[idx];
+            t_sorttype order = sort_order[idx];
+
+            if (order == SORTTYPE_NONE
+                || offset + 1 + SORT_KEY_PAYLOAD_WIDTH > MSELEM_KEY_WIDTH) {
+                is_complete = false;
+                break;
+            }
+
+            t_uindex begin = offset;
+            bool is_last = false;
+            std::uint8_t* tag = key + offset;
+            std::uint8_t* payload = tag + 1;
+
+            // NaN sorts before every other value, in both ascending and
+            // descending order before the inversion below.
+            if (is_nan_for_sort(value)) {
+                *tag = 0;
+                write_sort_key_payload(payload, 0);
+                offset += 1 + SORT_KEY_PAYLOAD_WIDTH;
+            } else if (order == SORTTYPE_ASCENDING_ABS
+                       || order == SORTTYPE_DESCENDING_ABS) {
+                // Ties on the absolute value fall back to the primary key
+                // rather than the next column, so nothing after this column
+                // can be encoded.
+                *tag = 1;
+                write_sort_key_payload(
+                    payload, encode_double(std::abs(value.to_double()))
+                );
+                offset += 1 + SORT_KEY_PAYLOAD_WIDTH;
+                is_complete = false;
+                is_last = true;
+            } else {
+                // Values of differing types or statuses order by type and
+                // then status, as in `t_tscalar::compare_common`.
+                *tag = static_cast<std::uint8_t>(
+                    1 + value.get_dtype() * 3 + value.m_status
+                );
+
+                switch (value.get_dtype()) {
+                    case DTYPE_INT64:
+                    case DTYPE_TIME: {
+                        write_sort_key_payload(
+                            payload, encode_signed(value.m_data.m_int64)
+                        );
+                    } break;
+                    case DTYPE_INT32: {
+                        write_sort_key_payload(
+                            payload, encode_signed(value.m_data.m_int32)
+                        );
+                    } break;
+                    case DTYPE_INT16: {
+                        write_sort_key_payload(
+                            payload, encode_signed(value.m_data.m_int16)
+                        );
+                    } break;
+                    case DTYPE_INT8: {
+                        write_sort_key_payload(
+                            payload, encode_signed(value.m_data.m_int8)
+                        );
+                    } break;
+                    case DTYPE_UINT64: {
+                        write_sort_key_payload(payload, value.m_data.m_uint64);
+                    } break;
+                    case DTYPE_UINT32:
+                    case DTYPE_DATE: {
+                        write_sort_key_payload(payload, value.m_data.m_uint32);
+                    } break;
+                    case DTYPE_UINT16: {
+                        write_sort_key_payload(payload, value.m_data.m_uint16);
+                    } break;
+                    case DTYPE_UINT8: {
+                        write_sort_key_payload(payload, value.m_data.m_uint8);
+                    } break;
+                    // `cmp_mselem` treats -0.0 and 0.0 as unequal but neither
+                    // less than the other, ordering the rows as equivalent
+                    // without looking at later columns - so a zero ends the
+                    // key and leaves the decision to `cmp_mselem`.
+                    case DTYPE_FLOAT64: {
+                        write_sort_key_payload(
+                            payload, encode_double(value.m_data.m_float64)
+                        );
+                        is_last = value.m_data.m_float64 == 0;
+                        is_complete = is_complete && !is_last;
+                    } break;
+                    case DTYPE_FLOAT32: {
+                        write_sort_key_payload(
+                            payload, encode_double(value.m_data.m_float32)
+                        );
+                        is_last = value.m_data.m_float32 == 0;
+                        is_complete = is_complete && !is_last;
+                    } break;
+                    case DTYPE_BOOL: {
+                        write_sort_key_payload(payload, value.m_data.m_bool);
+                    } break;
+                    case DTYPE_NONE: {
+                        write_sort_key_payload(payload, 0);
+                    } break;
+                    case DTYPE_STR: {
+                        // Strings store as much of their prefix as fits, zero
+                        // padded - a shorter string sorts first, as with
+                        // `strcmp`. Only a valid string in the last column,
+                        // stored with at least one byte of padding, is exact.
+                        t_uindex width = MSELEM_KEY_WIDTH - offset - 1;
+                        std::memset(payload, 0, width);
+                        bool is_exact = false;
+                        if (value.m_status == STATUS_VALID) {
+                            const char* str = value.get_char_ptr();
+                            t_uindex len =
+                                str == nullptr ? 0 : std::strlen(str);
+                            std::memcpy(payload, str, std::min(len, width));
+                            is_exact = str != nullptr && len < width
+                                && idx + 1 == loop_end;
+                        }
+                        is_complete = is_complete && is_exact;
+                        is_last = true;
+                    } break;
+                    default: {
+                        // No encoding - end the key before this column.
+                        elem.m_key_size = static_cast<std::uint8_t>(begin);
+                        return false;
+                    }
+                }
+
+                offset += value.get_dtype() == DTYPE_STR
+                    ? MSELEM_KEY_WIDTH - offset
+                    : 1 + SORT_KEY_PAYLOAD_WIDTH;
+            }
+
+            if (order == SORTTYPE_DESCENDING
+                || order == SORTTYPE_DESCENDING_ABS) {
+                for (t_uindex bidx = begin; bidx < offset; ++bidx) {
+                    key[bidx] = ~key[bidx];
+                }
+            }
+
+            if (is_last) {
+                break;
+            }
+        }
+
+        elem.m_key_size = static_cast<std::uint8_t>(offset);
+        return is_complete;
+    }
+
+} // namespace
+
+void
+encode_sort_key(
+    t_mselem& elem,
+    const std::vector<t_tscalar>& row,
+    const std::vector<t_sorttype>& sort_order
+) {
+    elem.m_key_complete = write_sort_key(elem, row, sort_order);
+    if (elem.m_key_complete) {
+        std::vector<t_tscalar>().swap(elem.m_row);
+    } else {
+        elem.m_row = row;
+    }
+}
+
+void
+encode_sort_key(t_mselem& elem, const std::vector<t_sorttype>& sort_order) {
+    elem.m_key_complete = write_sort_key(elem, elem.m_row, sort_order);
+    if (elem.m_key_complete) {
+        std::vector<t_tscalar>().swap(elem.m_row);
+    }
+}
+
 t_multisorter::t_multisorter(const std::vector<t_sorttype>& order) :
     m_sort_order(order) {}
 
@@ -219,6 +468,26 @@ t_multisorter::t_multisorter(
 
 bool
 t_multisorter::operator()(const t_mselem& a, const t_mselem& b) const {
+    int cmp = cmp_mselem_key(a, b);
+    if (cmp != 0) {
+        return cmp < 0;
+    }
+
+    if (a.m_key_complete || b.m_key_complete) {
+        // A complete key only ties another key that is equal to it - or, for
+        // a type without an encoding, a shorter prefix of it, which sorts
+        // first as it would in `memcmp` order.
+        if (a.m_key_size != b.m_key_size) {
+            return a.m_key_size < b.m_key_size;
+        }
+
+        if (a.m_order != b.m_order) {
+            return a.m_order < b.m_order;
+        }
+
+        return a.m_pkey < b.m_pkey;
+    }
+
     return cmp_mselem(a, b, m_sort_order);
 }
 
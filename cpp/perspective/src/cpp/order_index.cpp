@@ -0,0 +1,119 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#include <perspective/first.h>
+#include <perspective/order_index.h>
+#include <cmath>
+
+namespace perspective {
+
+bool
+t_order_index_less::operator()(const t_tscalar& a, const t_tscalar& b) const {
+    if (a.m_type == b.m_type && a.m_status == b.m_status
+        && a.is_floating_point()) {
+        double x = a.to_double();
+        double y = b.to_double();
+        bool x_nan = std::isnan(x);
+        bool y_nan = std::isnan(y);
+        if (x_nan || y_nan) {
+            if (x_nan != y_nan) {
+                return y_nan;
+            }
+
+            return a.m_data.m_uint64 < b.m_data.m_uint64;
+        }
+
+        if (x != y) {
+            return x < y;
+        }
+
+        return std::signbit(x) && !std::signbit(y);
+    }
+
+    return a < b;
+}
+
+t_order_index::t_order_index() : m_distinct(0) {}
+
+void
+t_order_index::clear() {
+    m_values.clear();
+    m_distinct = 0;
+}
+
+void
+t_order_index::insert(const t_tscalar& value) {
+    auto& values = m_values.get<by_order_value>();
+    if (values.find(value) == values.end()) {
+        ++m_distinct;
+    }
+
+    values.insert(value);
+}
+
+bool
+t_order_index::erase(const t_tscalar& value) {
+    auto& values = m_values.get<by_order_value>();
+    auto range = values.equal_range(value);
+    if (range.first == range.second) {
+        return false;
+    }
+
+    if (std::next(range.first) == range.second) {
+        --m_distinct;
+    }
+
+    values.erase(range.first);
+    return true;
+}
+
+t_uindex
+t_order_index::size() const {
+    return m_values.size();
+}
+
+bool
+t_order_index::empty() const {
+    return m_values.empty();
+}
+
+t_uindex
+t_order_index::distinct_count() const {
+    return m_distinct;
+}
+
+t_tscalar
+t_order_index::min() const {
+    if (m_values.empty()) {
+        return mknone();
+    }
+
+    return *(m_values.get<by_order_value>().begin());
+}
+
+t_tscalar
+t_order_index::max() const {
+    if (m_values.empty()) {
+        return mknone();
+    }
+
+    return *(m_values.get<by_order_value>().rbegin());
+}
+
+t_tscalar
+t_order_index::nth(t_uindex n) const {
+    PSP_VERBOSE_ASSERT(n < m_values.size(), "Order index out of bounds");
+    return *(m_values.get<by_order_value>().nth(n));
+}
+
+} // end namespace perspective
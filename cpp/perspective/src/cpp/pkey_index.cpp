@@ -0,0 +1,681 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#include <perspective/first.h>
+#include <perspective/pkey_index.h>
+#include <perspective/parallel_for.h>
+#include <algorithm>
+#include <cstring>
+
+namespace perspective {
+
+// Bulk inserts of fewer keys than this are not worth partitioning.
+static const t_uindex BULK_INSERT_MIN_KEYS = 65536;
+static const t_uindex BULK_INSERT_PARTITIONS = 64;
+
+// Group the positions `[0, num_keys)` by `partition_of(pos)`, keeping their
+// order within each partition. Partition `p` is
+// `order[offsets[p]] .. order[offsets[p + 1] - 1]`.
+template <typename FUNCTION>
+static void
+partition_keys(
+    t_uindex num_keys,
+    FUNCTION&& partition_of,
+    std::vector<t_uindex>& order,
+    std::vector<t_uindex>& offsets
+) {
+    offsets.assign(BULK_INSERT_PARTITIONS + 1, 0);
+    for (t_uindex pos = 0; pos < num_keys; ++pos) {
+        ++offsets[partition_of(pos) + 1];
+    }
+
+    for (t_uindex part = 0; part < BULK_INSERT_PARTITIONS; ++part) {
+        offsets[part + 1] += offsets[part];
+    }
+
+    std::vector<t_uindex> cursors(offsets.begin(), offsets.end() - 1);
+    order.resize(num_keys);
+    for (t_uindex pos = 0; pos < num_keys; ++pos) {
+        order[cursors[partition_of(pos)]++] = pos;
+    }
+}
+
+/******************************************************************************
+ *
+ * t_flat_pkey_map
+ */
+
+t_flat_pkey_map::t_flat_pkey_map() : m_size(0), m_mask(0) {}
+
+t_uindex
+t_flat_pkey_map::slot_for(std::uint64_t key) const {
+    // murmur3 finalizer - sequential keys are common, so they need to be
+    // spread out before masking.
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return static_cast<t_uindex>(key) & m_mask;
+}
+
+const t_uindex*
+t_flat_pkey_map::find(std::uint64_t key) const {
+    if (m_size == 0) {
+        return nullptr;
+    }
+
+    for (t_uindex slot = slot_for(key);; slot = (slot + 1) & m_mask) {
+        if (m_rows[slot] == EMPTY_SLOT) {
+            return nullptr;
+        }
+
+        if (m_keys[slot] == key) {
+            return &m_rows[slot];
+        }
+    }
+}
+
+void
+t_flat_pkey_map::insert(std::uint64_t key, t_uindex idx) {
+    // Keep the load factor at or below 1/2 so probe sequences stay short.
+    if ((m_size + 1) * 2 > m_rows.size()) {
+        rehash(std::max(static_cast<t_uindex>(16), m_rows.size() * 2));
+    }
+
+    t_uindex slot = slot_for(key);
+    while (m_rows[slot] != EMPTY_SLOT && m_keys[slot] != key) {
+        slot = (slot + 1) & m_mask;
+    }
+
+    if (m_rows[slot] == EMPTY_SLOT) {
+        m_keys[slot] = key;
+        ++m_size;
+    }
+
+    m_rows[slot] = idx;
+}
+
+void
+t_flat_pkey_map::bulk_insert(
+    const std::vector<std::uint64_t>& keys, const std::vector<t_uindex>& rows
+) {
+    t_uindex num_keys = keys.size();
+    reserve(m_size + num_keys);
+    if (m_size != 0 || num_keys < BULK_INSERT_MIN_KEYS) {
+        for (t_uindex pos = 0; pos < num_keys; ++pos) {
+            insert(keys[pos], rows[pos]);
+        }
+        return;
+    }
+
+    // Each partition owns a contiguous range of slots, and its task only
+    // probes within that range. A key whose probe would run past the end of
+    // its range is left for a serial pass, which probes as `insert()` does.
+    t_uindex range = m_rows.size() / BULK_INSERT_PARTITIONS;
+    std::vector<t_uindex> homes(num_keys);
+    parallel_for(int(BULK_INSERT_PARTITIONS), [&](int part) {
+        t_uindex begin = num_keys * part / BULK_INSERT_PARTITIONS;
+        t_uindex end = num_keys * (part + 1) / BULK_INSERT_PARTITIONS;
+        for (t_uindex pos = begin; pos < end; ++pos) {
+            homes[pos] = slot_for(keys[pos]);
+        }
+    });
+
+    std::vector<t_uindex> order;
+    std::vector<t_uindex> offsets;
+    partition_keys(
+        num_keys,
+        [&](t_uindex pos) { return homes[pos] / range; },
+        order,
+        offsets
+    );
+
+    std::vector<std::vector<t_uindex>> overflow(BULK_INSERT_PARTITIONS);
+    std::vector<t_uindex> sizes(BULK_INSERT_PARTITIONS, 0);
+    parallel_for(int(BULK_INSERT_PARTITIONS), [&](int part) {
+        t_uindex range_end = (part + 1) * range;
+        for (t_uindex opos = offsets[part]; opos < offsets[part + 1]; ++opos) {
+            t_uindex pos = order[opos];
+            t_uindex slot = homes[pos];
+            while (slot < range_end && m_rows[slot] != EMPTY_SLOT
+                   && m_keys[slot] != keys[pos]) {
+                ++slot;
+            }
+
+            if (slot == range_end) {
+                overflow[part].push_back(pos);
+                continue;
+            }
+
+            if (m_rows[slot] == EMPTY_SLOT) {
+                m_keys[slot] = keys[pos];
+                ++sizes[part];
+            }
+
+            m_rows[slot] = rows[pos];
+        }
+    });
+
+    for (t_uindex part = 0; part < BULK_INSERT_PARTITIONS; ++part) {
+        m_size += sizes[part];
+    }
+
+    // A duplicate of an overflowed key overflows too, so this keeps the
+    // last row for each key.
+    for (const auto& positions : overflow) {
+        for (auto pos : positions) {
+            insert(keys[pos], rows[pos]);
+        }
+    }
+}
+
+bool
+t_flat_pkey_map::erase(std::uint64_t key) {
+    if (m_size == 0) {
+        return false;
+    }
+
+    t_uindex hole = slot_for(key);
+    for (;; hole = (hole + 1) & m_mask) {
+        if (m_rows[hole] == EMPTY_SLOT) {
+            return false;
+        }
+
+        if (m_keys[hole] == key) {
+            break;
+        }
+    }
+
+    // Shift back every entry in the probe run that can legally move into
+    // the hole, i.e. whose home slot does not lie between the hole and it.
+    t_uindex next = (hole + 1) & m_mask;
+    while (m_rows[next] != EMPTY_SLOT) {
+        t_uindex home = slot_for(m_keys[next]);
+        if (((next - home) & m_mask) >= ((next - hole) & m_mask)) {
+            m_keys[hole] = m_keys[next];
+            m_rows[hole] = m_rows[next];
+            hole = next;
+        }
+        next = (next + 1) & m_mask;
+    }
+
+    m_rows[hole] = EMPTY_SLOT;
+    --m_size;
+    return true;
+}
+
+void
+t_flat_pkey_map::reserve(t_uindex size) {
+    t_uindex capacity = 16;
+    while (capacity < size * 2) {
+        capacity *= 2;
+    }
+
+    if (capacity > m_rows.size()) {
+        rehash(capacity);
+    }
+}
+
+void
+t_flat_pkey_map::rehash(t_uindex capacity) {
+    std::vector<std::uint64_t> keys(capacity);
+    std::vector<t_uindex> rows(capacity, EMPTY_SLOT);
+    std::swap(keys, m_keys);
+    std::swap(rows, m_rows);
+    m_mask = capacity - 1;
+    m_size = 0;
+
+    for (t_uindex slot = 0; slot < rows.size(); ++slot) {
+        if (rows[slot] != EMPTY_SLOT) {
+            insert(keys[slot], rows[slot]);
+        }
+    }
+}
+
+void
+t_flat_pkey_map::clear() {
+    m_keys.clear();
+    m_rows.clear();
+    m_size = 0;
+    m_mask = 0;
+}
+
+t_uindex
+t_flat_pkey_map::size() const {
+    return m_size;
+}
+
+/******************************************************************************
+ *
+ * t_pkey_index
+ */
+
+t_pkey_index::t_pkey_index() : t_pkey_index(DTYPE_NONE) {}
+
+t_pkey_index::t_pkey_index(t_dtype dtype) :
+    m_dtype(dtype),
+    m_mode(MODE_SCALAR),
+    m_dense_size(0) {
+    clear();
+}
+
+bool
+t_pkey_index::is_typed_key(const t_tscalar& pkey) const {
+    return m_mode != MODE_SCALAR && pkey.m_type == m_dtype
+        && pkey.m_status == STATUS_VALID;
+}
+
+t_tscalar
+t_pkey_index::to_scalar(std::uint64_t key) const {
+    t_tscalar rval;
+    rval.clear();
+    rval.m_type = m_dtype;
+    rval.m_status = STATUS_VALID;
+    rval.m_data.m_uint64 = key;
+    return rval;
+}
+
+t_rlookup
+t_pkey_index::find(const t_tscalar& pkey) const {
+    if (!is_typed_key(pkey)) {
+        auto iter = m_scalars.find(pkey);
+        if (iter == m_scalars.end()) {
+            return {0, false};
+        }
+        return {iter->second, true};
+    }
+
+    if (m_mode == MODE_STR) {
+        return find_str(pkey.get_char_ptr());
+    }
+
+    return find_raw(pkey.m_data.m_uint64);
+}
+
+t_rlookup
+t_pkey_index::find_raw(std::uint64_t key) const {
+    if (m_mode == MODE_DENSE) {
+        if (key < m_dense.size() && m_dense[key] != EMPTY_ROW) {
+            return {m_dense[key], true};
+        }
+        return {0, false};
+    }
+
+    const t_uindex* idx = m_flat.find(key);
+    if (idx == nullptr) {
+        return {0, false};
+    }
+    return {*idx, true};
+}
+
+t_rlookup
+t_pkey_index::find_str(const char* key) const {
+    auto iter = m_strings.find(std::string_view(key));
+    if (iter == m_strings.end()) {
+        return {0, false};
+    }
+    return {iter->second, true};
+}
+
+void
+t_pkey_index::lookup(const t_column& pkeys, std::vector<t_rlookup>& out)
+    const {
+    t_uindex num_rows = pkeys.size();
+    out.resize(num_rows);
+
+    if (num_rows == 0) {
+        return;
+    }
+
+    if (m_mode == MODE_SCALAR || pkeys.get_dtype() != m_dtype) {
+        for (t_uindex idx = 0; idx < num_rows; ++idx) {
+            out[idx] = find(pkeys.get_scalar(idx));
+        }
+        return;
+    }
+
+    switch (m_dtype) {
+        case DTYPE_INT64:
+        case DTYPE_TIME: {
+            lookup_typed<std::int64_t>(pkeys, out);
+        } break;
+        case DTYPE_INT32: {
+            lookup_typed<std::int32_t>(pkeys, out);
+        } break;
+        case DTYPE_INT16: {
+            lookup_typed<std::int16_t>(pkeys, out);
+        } break;
+        case DTYPE_INT8: {
+            lookup_typed<std::int8_t>(pkeys, out);
+        } break;
+        case DTYPE_UINT64: {
+            lookup_typed<std::uint64_t>(pkeys, out);
+        } break;
+        case DTYPE_UINT32:
+        case DTYPE_DATE: {
+            lookup_typed<std::uint32_t>(pkeys, out);
+        } break;
+        case DTYPE_UINT16: {
+            lookup_typed<std::uint16_t>(pkeys, out);
+        } break;
+        case DTYPE_UINT8: {
+            lookup_typed<std::uint8_t>(pkeys, out);
+        } break;
+        case DTYPE_FLOAT64: {
+            lookup_typed<double>(pkeys, out);
+        } break;
+        case DTYPE_FLOAT32: {
+            lookup_typed<float>(pkeys, out);
+        } break;
+        case DTYPE_STR: {
+            lookup_str(pkeys, out);
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Unexpected pkey dtype");
+        } break;
+    }
+}
+
+template <typename T>
+void
+t_pkey_index::lookup_typed(const t_column& pkeys, std::vector<t_rlookup>& out)
+    const {
+    const std::uint64_t* valid =
+        pkeys.is_status_enabled() ? pkeys.get_validity_words() : nullptr;
+    const T* values = pkeys.get_nth<T>(0);
+
+    for (t_uindex idx = 0, loop_end = pkeys.size(); idx < loop_end; ++idx) {
+        if (valid != nullptr && !t_column::test_bit(valid, idx)) {
+            out[idx] = find(pkeys.get_scalar(idx));
+            continue;
+        }
+
+        // Mirror `t_tscalar::set`, which zeroes the payload before writing a
+        // narrower value into it.
+        std::uint64_t key = 0;
+        std::memcpy(&key, values + idx, sizeof(T));
+        out[idx] = find_raw(key);
+    }
+}
+
+void
+t_pkey_index::lookup_str(const t_column& pkeys, std::vector<t_rlookup>& out)
+    const {
+    t_uindex num_rows = pkeys.size();
+    t_uindex vocab_size = pkeys.get_vlenidx();
+    const std::uint64_t* valid =
+        pkeys.is_status_enabled() ? pkeys.get_validity_words() : nullptr;
+
+    // Rows that share a string share a vocab index, so each string only
+    // needs to be hashed once - unless the vocab is much larger than the
+    // column, in which case the cache would cost more than it saves.
+    bool use_cache = vocab_size <= 2 * num_rows;
+    std::vector<t_rlookup> cache(use_cache ? vocab_size : 0);
+    std::vector<bool> cached(use_cache ? vocab_size : 0, false);
+
+    pkeys.visit_vocab_indices([&](const auto* indices) {
+        for (t_uindex idx = 0; idx < num_rows; ++idx) {
+            if (valid != nullptr && !t_column::test_bit(valid, idx)) {
+                out[idx] = find(pkeys.get_scalar(idx));
+                continue;
+            }
+
+            t_uindex vidx = indices[idx];
+            if (!use_cache || vidx >= vocab_size) {
+                out[idx] = find_str(pkeys.unintern_c(vidx));
+                continue;
+            }
+
+            if (!cached[vidx]) {
+                cache[vidx] = find_str(pkeys.unintern_c(vidx));
+                cached[vidx] = true;
+            }
+
+            out[idx] = cache[vidx];
+        }
+    });
+}
+
+void
+t_pkey_index::insert(const t_tscalar& pkey, t_uindex idx) {
+    if (!is_typed_key(pkey)) {
+        m_scalars[m_symtable.get_interned_tscalar(pkey)] = idx;
+        return;
+    }
+
+    if (m_mode == MODE_STR) {
+        const char* interned =
+            m_symtable.get_interned_cstr(pkey.get_char_ptr());
+        m_strings[std::string_view(interned)] = idx;
+        return;
+    }
+
+    insert_raw(pkey.m_data.m_uint64, idx);
+}
+
+void
+t_pkey_index::bulk_insert(
+    const std::vector<t_tscalar>& pkeys, const std::vector<t_uindex>& rows
+) {
+    if (!empty() || m_mode == MODE_STR || m_mode == MODE_SCALAR
+        || rows.size() < BULK_INSERT_MIN_KEYS) {
+        for (auto idx : rows) {
+            insert(pkeys[idx], idx);
+        }
+        return;
+    }
+
+    std::vector<std::uint64_t> keys;
+    std::vector<t_uindex> key_rows;
+    keys.reserve(rows.size());
+    key_rows.reserve(rows.size());
+    std::uint64_t max_key = 0;
+    for (auto idx : rows) {
+        if (!is_typed_key(pkeys[idx])) {
+            insert(pkeys[idx], idx);
+            continue;
+        }
+
+        keys.push_back(pkeys[idx].m_data.m_uint64);
+        key_rows.push_back(idx);
+        max_key = std::max(max_key, keys.back());
+    }
+
+    t_uindex num_keys = keys.size();
+    t_uindex dense_limit =
+        std::max(MIN_DENSE_CAPACITY, DENSE_LOAD_FACTOR * num_keys);
+
+    if (m_mode == MODE_DENSE && max_key >= dense_limit) {
+        m_mode = MODE_FLAT;
+    }
+
+    if (m_mode == MODE_FLAT) {
+        m_flat.bulk_insert(keys, key_rows);
+        return;
+    }
+
+    // Each partition owns a contiguous range of the dense vector.
+    m_dense.assign(max_key + 1, EMPTY_ROW);
+    t_uindex range =
+        (max_key + BULK_INSERT_PARTITIONS) / BULK_INSERT_PARTITIONS;
+
+    std::vector<t_uindex> order;
+    std::vector<t_uindex> offsets;
+    partition_keys(
+        num_keys,
+        [&](t_uindex pos) { return keys[pos] / range; },
+        order,
+        offsets
+    );
+
+    std::vector<t_uindex> sizes(BULK_INSERT_PARTITIONS, 0);
+    parallel_for(int(BULK_INSERT_PARTITIONS), [&](int part) {
+        for (t_uindex opos = offsets[part]; opos < offsets[part + 1]; ++opos) {
+            t_uindex pos = order[opos];
+            if (m_dense[keys[pos]] == EMPTY_ROW) {
+                ++sizes[part];
+            }
+
+            m_dense[keys[pos]] = key_rows[pos];
+        }
+    });
+
+    for (t_uindex part = 0; part < BULK_INSERT_PARTITIONS; ++part) {
+        m_dense_size += sizes[part];
+    }
+}
+
+void
+t_pkey_index::insert_raw(std::uint64_t key, t_uindex idx) {
+    if (m_mode == MODE_DENSE && key >= m_dense.size()) {
+        t_uindex limit = std::max(
+            MIN_DENSE_CAPACITY, DENSE_LOAD_FACTOR * (m_dense_size + 1)
+        );
+
+        if (key >= limit) {
+            spill_dense();
+        } else {
+            t_uindex capacity = std::min(limit, m_dense.size() * 2);
+            m_dense.resize(std::max(key + 1, capacity), EMPTY_ROW);
+        }
+    }
+
+    if (m_mode == MODE_DENSE) {
+        if (m_dense[key] == EMPTY_ROW) {
+            ++m_dense_size;
+        }
+        m_dense[key] = idx;
+        return;
+    }
+
+    m_flat.insert(key, idx);
+}
+
+void
+t_pkey_index::spill_dense() {
+    m_flat.reserve(m_dense_size);
+    for (t_uindex key = 0; key < m_dense.size(); ++key) {
+        if (m_dense[key] != EMPTY_ROW) {
+            m_flat.insert(key, m_dense[key]);
+        }
+    }
+
+    std::vector<t_uindex>().swap(m_dense);
+    m_dense_size = 0;
+    m_mode = MODE_FLAT;
+}
+
+bool
+t_pkey_index::erase(const t_tscalar& pkey) {
+    if (!is_typed_key(pkey)) {
+        return m_scalars.erase(pkey) > 0;
+    }
+
+    if (m_mode == MODE_STR) {
+        return m_strings.erase(std::string_view(pkey.get_char_ptr())) > 0;
+    }
+
+    return erase_raw(pkey.m_data.m_uint64);
+}
+
+bool
+t_pkey_index::erase_raw(std::uint64_t key) {
+    if (m_mode == MODE_DENSE) {
+        if (key >= m_dense.size() || m_dense[key] == EMPTY_ROW) {
+            return false;
+        }
+        m_dense[key] = EMPTY_ROW;
+        --m_dense_size;
+        return true;
+    }
+
+    return m_flat.erase(key);
+}
+
+void
+t_pkey_index::reserve(t_uindex size) {
+    switch (m_mode) {
+        case MODE_DENSE: {
+            m_dense.reserve(size);
+        } break;
+        case MODE_FLAT: {
+            m_flat.reserve(size);
+        } break;
+        case MODE_STR: {
+            m_strings.reserve(size);
+        } break;
+        case MODE_SCALAR: {
+            m_scalars.reserve(size);
+        } break;
+    }
+}
+
+void
+t_pkey_index::clear() {
+    std::vector<t_uindex>().swap(m_dense);
+    m_dense_size = 0;
+    m_flat.clear();
+    m_strings.clear();
+    m_scalars.clear();
+
+    switch (m_dtype) {
+        case DTYPE_INT64:
+        case DTYPE_INT32:
+        case DTYPE_INT16:
+        case DTYPE_INT8:
+        case DTYPE_UINT64:
+        case DTYPE_UINT32:
+        case DTYPE_UINT16:
+        case DTYPE_UINT8: {
+            m_mode = MODE_DENSE;
+        } break;
+        case DTYPE_FLOAT64:
+        case DTYPE_FLOAT32:
+        case DTYPE_DATE:
+        case DTYPE_TIME: {
+            m_mode = MODE_FLAT;
+        } break;
+        case DTYPE_STR: {
+            m_mode = MODE_STR;
+        } break;
+        default: {
+            m_mode = MODE_SCALAR;
+        } break;
+    }
+}
+
+t_uindex
+t_pkey_index::size() const {
+    return m_dense_size + m_flat.size() + m_strings.size() + m_scalars.size();
+}
+
+bool
+t_pkey_index::empty() const {
+    return size() == 0;
+}
+
+t_dtype
+t_pkey_index::get_key_dtype() const {
+    if (m_dense_size + m_flat.size() + m_strings.size() > 0) {
+        return m_dtype;
+    }
+
+    if (!m_scalars.empty()) {
+        return m_scalars.begin()->first.get_dtype();
+    }
+
+    return DTYPE_NONE;
+}
+
+} // end namespace perspective
@@ -11,11 +11,13 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 #include <perspective/regex.h>
+#include <perspective/pyutils.h>
 
 namespace perspective {
 
 RE2*
 t_regex_mapping::intern(const std::string& pattern) {
+    PSP_WRITE_LOCK(m_lock);
     if (m_regex_map.count(pattern) == 1) {
         return m_regex_map[pattern].get();
     }
@@ -34,6 +36,7 @@ t_regex_mapping::intern(const std::string& pattern) {
 
 void
 t_regex_mapping::clear() {
+    PSP_WRITE_LOCK(m_lock);
     m_regex_map.clear();
 }
 
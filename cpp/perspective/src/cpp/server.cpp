@@ -10,6 +10,8 @@
 // ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 #include "google/protobuf/repeated_ptr_field.h"
 #include "google/protobuf/struct.pb.h"
 #include "perspective.pb.h"
@@ -30,6 +32,8 @@
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <perspective/server.h>
 #include <re2/stringpiece.h>
 #include <string>
@@ -43,7 +47,7 @@
 #endif
 
 namespace perspective {
-std::uint32_t server::ProtoServer::m_client_id = 1;
+std::atomic<std::uint32_t> server::ProtoServer::m_client_id = 1;
 
 template <>
 std::shared_ptr<t_ctxunit>
@@ -464,6 +468,7 @@ ServerResources::delete_view(const std::uint32_t& client_id, const t_id& id) {
     {
         PSP_WRITE_LOCK(m_write_lock);
         auto table_id = m_view_to_table.at(id);
+        _unshare_view(id);
         if (m_views.find(id) != m_views.end()) {
             m_views.erase(id);
         }
@@ -488,12 +493,75 @@ ServerResources::delete_view(const std::uint32_t& client_id, const t_id& id) {
     drop_view_on_delete_sub(id);
 }
 
+std::shared_ptr<ErasedView>
+ServerResources::get_shared_view(const std::string& key) {
+    PSP_READ_LOCK(m_write_lock);
+    auto it = m_shared_views.find(key);
+    if (it == m_shared_views.end()) {
+        return nullptr;
+    }
+
+    return it->second.view.lock();
+}
+
+void
+ServerResources::share_view(
+    const t_id& view_id,
+    const std::string& key,
+    const std::shared_ptr<ErasedView>& view
+) {
+    PSP_WRITE_LOCK(m_write_lock);
+    auto it = m_shared_views.find(key);
+    if (it == m_shared_views.end()) {
+        m_shared_views.emplace(key, SharedView{view, 1});
+    } else {
+        it.value().num_handles++;
+    }
+
+    m_view_to_shared_key[view_id] = key;
+}
+
+bool
+ServerResources::unshare_view(const t_id& view_id) {
+    PSP_WRITE_LOCK(m_write_lock);
+    return _unshare_view(view_id);
+}
+
+bool
+ServerResources::_unshare_view(const t_id& view_id) {
+    auto key_it = m_view_to_shared_key.find(view_id);
+    if (key_it == m_view_to_shared_key.end()) {
+        return false;
+    }
+
+    auto it = m_shared_views.find(key_it->second);
+    m_view_to_shared_key.erase(key_it);
+    if (--it.value().num_handles > 0) {
+        return true;
+    }
+
+    m_shared_views.erase(it);
+    return false;
+}
+
+void
+ServerResources::replace_view(
+    const t_id& view_id, std::shared_ptr<ErasedView> view
+) {
+    PSP_WRITE_LOCK(m_write_lock);
+    m_views[view_id] = std::move(view);
+}
+
 void
 ServerResources::delete_table(const t_id& id) {
     PSP_WRITE_LOCK(m_write_lock);
     if (m_tables.find(id) != m_tables.end()) {
         if (m_table_to_view.find(id) == m_table_to_view.end()) {
             m_tables.erase(id);
+            m_dirty_tables.erase(id);
+            m_dirty_since.erase(id);
+            m_update_policies.erase(id);
+            m_update_stats.erase(id);
         } else {
             PSP_COMPLAIN_AND_ABORT("Cannot delete table with views");
         }
@@ -503,19 +571,134 @@ ServerResources::delete_table(const t_id& id) {
 void
 ServerResources::mark_table_dirty(const t_id& id) {
     PSP_WRITE_LOCK(m_write_lock);
-    m_dirty_tables.insert(id);
+    if (m_dirty_tables.insert(id).second) {
+        m_dirty_since[id] = std::chrono::steady_clock::now();
+    }
+
+    m_update_stats[id].num_updates++;
 }
 
 void
 ServerResources::mark_table_clean(const t_id& id) {
     PSP_WRITE_LOCK(m_write_lock);
     m_dirty_tables.erase(id);
+    m_dirty_since.erase(id);
 }
 
 void
 ServerResources::mark_all_tables_clean() {
     PSP_WRITE_LOCK(m_write_lock);
     m_dirty_tables.clear();
+    m_dirty_since.clear();
+}
+
+void
+ServerResources::set_table_update_policy(
+    const t_id& id, TableUpdatePolicy policy
+) {
+    PSP_WRITE_LOCK(m_write_lock);
+    m_update_policies[id] = policy;
+}
+
+void
+ServerResources::clear_table_update_policy(const t_id& id) {
+    PSP_WRITE_LOCK(m_write_lock);
+    m_update_policies.erase(id);
+}
+
+bool
+ServerResources::should_process_table(const t_id& id, std::uint64_t num_rows) {
+    PSP_WRITE_LOCK(m_write_lock);
+    auto policy = m_update_policies.find(id);
+    auto since = m_dirty_since.find(id);
+    if (policy == m_update_policies.end() || since == m_dirty_since.end()
+        || num_rows >= policy->second.max_batch_rows
+        || std::chrono::steady_clock::now() - since->second
+            >= policy->second.max_latency) {
+        return true;
+    }
+
+    m_update_stats[id].num_deferred++;
+    return false;
+}
+
+std::optional<std::chrono::milliseconds>
+ServerResources::get_poll_delay() {
+    PSP_READ_LOCK(m_write_lock);
+    std::optional<std::chrono::milliseconds> out;
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto& id : m_dirty_tables) {
+        // Tables without a policy (or whose policy is already met by queued
+        // rows) are processed by the next poll.
+        std::chrono::milliseconds delay{0};
+        auto policy = m_update_policies.find(id);
+        auto since = m_dirty_since.find(id);
+        if (policy != m_update_policies.end()
+            && since != m_dirty_since.end()) {
+            auto deadline = since->second + policy->second.max_latency;
+            if (deadline > now) {
+                delay = std::chrono::ceil<std::chrono::milliseconds>(
+                    deadline - now
+                );
+            }
+        }
+
+        if (!out.has_value() || delay < *out) {
+            out = delay;
+        }
+    }
+
+    for (const auto& [view_id, subs] : m_view_on_update_subs) {
+        for (const auto& sub : subs) {
+            if (!sub.pending_port_id.has_value()) {
+                continue;
+            }
+
+            std::chrono::milliseconds delay{0};
+            auto deadline = sub.last_notified + sub.throttle;
+            if (deadline > now) {
+                delay =
+                    std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+            }
+
+            if (!out.has_value() || delay < *out) {
+                out = delay;
+            }
+        }
+    }
+
+    return out;
+}
+
+void
+ServerResources::record_table_processed(
+    const t_id& id, std::uint64_t num_rows, std::uint64_t num_notifs
+) {
+    PSP_WRITE_LOCK(m_write_lock);
+    auto& stats = m_update_stats[id];
+    stats.num_rows += num_rows;
+    stats.num_cycles++;
+    stats.num_notifications += num_notifs;
+}
+
+TableUpdateStats
+ServerResources::get_table_update_stats(const t_id& id) {
+    PSP_READ_LOCK(m_write_lock);
+    auto stats = m_update_stats.find(id);
+    if (stats == m_update_stats.end()) {
+        return {};
+    }
+
+    return stats->second;
+}
+
+double
+TableUpdateStats::coalescing_ratio() const {
+    if (num_cycles == 0) {
+        return 0;
+    }
+
+    return static_cast<double>(num_updates) / num_cycles;
 }
 
 void
@@ -636,6 +819,60 @@ ServerResources::drop_view_on_update_sub(const t_id& view_id) {
     m_view_on_update_subs.erase(view_id);
 }
 
+bool
+ServerResources::throttle_view_on_update_sub(
+    const t_id& view_id,
+    std::uint32_t sub_id,
+    std::uint32_t client_id,
+    std::uint32_t port_id
+) {
+    PSP_WRITE_LOCK(m_write_lock);
+    auto subs = m_view_on_update_subs.find(view_id);
+    if (subs == m_view_on_update_subs.end()) {
+        return false;
+    }
+
+    for (auto& sub : subs.value()) {
+        if (sub.id != sub_id || sub.client_id != client_id
+            || sub.throttle.count() == 0) {
+            continue;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - sub.last_notified < sub.throttle) {
+            sub.pending_port_id = port_id;
+            return true;
+        }
+
+        sub.last_notified = now;
+        sub.pending_port_id.reset();
+        return false;
+    }
+
+    return false;
+}
+
+std::vector<std::pair<ServerResources::t_id, Subscription>>
+ServerResources::take_due_view_on_update_subs() {
+    PSP_WRITE_LOCK(m_write_lock);
+    std::vector<std::pair<t_id, Subscription>> out;
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = m_view_on_update_subs.begin();
+         it != m_view_on_update_subs.end();
+         ++it) {
+        for (auto& sub : it.value()) {
+            if (sub.pending_port_id.has_value()
+                && now - sub.last_notified >= sub.throttle) {
+                out.emplace_back(it->first, sub);
+                sub.last_notified = now;
+                sub.pending_port_id.reset();
+            }
+        }
+    }
+
+    return out;
+}
+
 std::vector<std::pair<std::shared_ptr<Table>, const ServerResources::t_id>>
 ServerResources::get_dirty_tables() {
     PSP_READ_LOCK(m_write_lock);
@@ -664,6 +901,29 @@ ServerResources::drop_client(const std::uint32_t client_id) {
     }
 }
 
+ProtoServer::ProtoServer() : ProtoServer(0) {}
+
+ProtoServer::ProtoServer(std::uint32_t num_workers) : m_stopping(false) {
+#ifdef PSP_PARALLEL_FOR
+    m_workers.reserve(num_workers);
+    for (std::uint32_t i = 0; i < num_workers; ++i) {
+        m_workers.emplace_back([this]() { _run_worker(); });
+    }
+#endif
+}
+
+ProtoServer::~ProtoServer() {
+    {
+        std::lock_guard<std::mutex> lock(m_dispatch_lock);
+        m_stopping = true;
+    }
+
+    m_dispatch_cv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
 std::uint32_t
 ProtoServer::new_session() {
     return m_client_id++;
@@ -672,6 +932,18 @@ ProtoServer::new_session() {
 void
 ProtoServer::close_session(const std::uint32_t client_id) {
     m_resources.drop_client(client_id);
+
+    std::lock_guard<std::mutex> lock(m_dispatch_lock);
+    auto iter = m_client_sequences.find(client_id);
+    if (iter != m_client_sequences.end() && !iter->second.delivering
+        && iter->second.next_deliver == iter->second.next_dispatch) {
+        m_client_sequences.erase(iter);
+    }
+}
+
+std::uint32_t
+ProtoServer::num_workers() const {
+    return m_workers.size();
 }
 
 std::vector<ProtoServerResp<std::string>>
@@ -680,6 +952,13 @@ ProtoServer::handle_request(
 ) {
     proto::Request req_env;
     req_env.ParseFromString(data);
+    return _handle_parsed_request(client_id, std::move(req_env));
+}
+
+std::vector<ProtoServerResp<std::string>>
+ProtoServer::_handle_parsed_request(
+    std::uint32_t client_id, Request&& req_env
+) {
     std::vector<ProtoServerResp<std::string>> serialized_responses;
     std::vector<proto::Response> responses;
 
@@ -687,9 +966,14 @@ ProtoServer::handle_request(
     auto entity_id = req_env.entity_id();
     try {
         auto resp_msg = _handle_request(client_id, std::move(req_env));
+        serialized_responses.reserve(resp_msg.size());
         for (auto& resp : resp_msg) {
+            // Move each response into a local released at the end of the
+            // iteration, so a request answered in chunks holds one copy of
+            // each chunk.
+            proto::Response data = std::move(resp.data);
             ProtoServerResp<std::string> str_resp;
-            str_resp.data = resp.data.SerializeAsString();
+            str_resp.data = data.SerializeAsString();
             str_resp.client_id = resp.client_id;
             serialized_responses.emplace_back(std::move(str_resp));
         }
@@ -961,6 +1245,356 @@ ProtoServer::handle_process_table(
     }
 }
 
+static constexpr bool
+is_read_only(const proto::Request::ClientReqCase proto_case) {
+    using ReqCase = proto::Request::ClientReqCase;
+
+    switch (proto_case) {
+        case ReqCase::kTableSizeReq:
+        case ReqCase::kTableSchemaReq:
+        case ReqCase::kViewDimensionsReq:
+        case ReqCase::kViewToColumnsStringReq:
+        case ReqCase::kViewToCsvReq:
+        case ReqCase::kViewToRowsStringReq:
+        case ReqCase::kViewToNdjsonStringReq:
+        case ReqCase::kViewToArrowReq:
+        case ReqCase::kViewSchemaReq:
+        case ReqCase::kViewGetMinMaxReq:
+        case ReqCase::kViewGetConfigReq:
+        case ReqCase::kViewColumnPathsReq:
+        case ReqCase::kViewExpressionSchemaReq:
+            return true;
+        case ReqCase::kTableMakePortReq:
+        case ReqCase::kTableValidateExprReq:
+        case ReqCase::kMakeTableReq:
+        case ReqCase::kTableRemoveReq:
+        case ReqCase::kTableMakeViewReq:
+        case ReqCase::kViewOnUpdateReq:
+        case ReqCase::kViewCollapseReq:
+        case ReqCase::kViewExpandReq:
+        case ReqCase::kViewSetDepthReq:
+        case ReqCase::kTableOnDeleteReq:
+        case ReqCase::kViewOnDeleteReq:
+        case ReqCase::kViewRemoveDeleteReq:
+        case ReqCase::kTableUpdateReq:
+        case ReqCase::kTableRemoveDeleteReq:
+        case ReqCase::kGetHostedTablesReq:
+        case ReqCase::kTableReplaceReq:
+        case ReqCase::kTableDeleteReq:
+        case ReqCase::kViewDeleteReq:
+        case ReqCase::kViewRemoveOnUpdateReq:
+        case ReqCase::kServerSystemInfoReq:
+        case ReqCase::kGetFeaturesReq:
+        case proto::Request::CLIENT_REQ_NOT_SET:
+            return false;
+    }
+    throw std::runtime_error("Unhandled request type");
+}
+
+void
+ProtoServer::dispatch_request(
+    std::uint32_t client_id, std::string data, t_callback callback
+) {
+    proto::Request req;
+    req.ParseFromString(data);
+    if (m_workers.empty()) {
+        callback(_handle_parsed_request(client_id, std::move(req)));
+        return;
+    }
+
+    LaneTask task;
+    task.client_id = client_id;
+    task.is_poll = false;
+    task.read_only = false;
+    task.req = std::move(req);
+    task.callback = std::move(callback);
+
+    {
+        std::lock_guard<std::mutex> lock(m_dispatch_lock);
+        task.lane = _get_lane_id(task.req);
+        task.seq = m_client_sequences[client_id].next_dispatch++;
+        _enqueue_task(std::move(task));
+    }
+
+    m_dispatch_cv.notify_all();
+}
+
+void
+ProtoServer::set_table_update_policy(
+    const std::string& table_id, TableUpdatePolicy policy
+) {
+    m_resources.set_table_update_policy(table_id, policy);
+}
+
+void
+ProtoServer::clear_table_update_policy(const std::string& table_id) {
+    m_resources.clear_table_update_policy(table_id);
+}
+
+std::optional<std::chrono::milliseconds>
+ProtoServer::get_poll_delay() {
+    return m_resources.get_poll_delay();
+}
+
+TableUpdateStats
+ProtoServer::get_table_update_stats(const std::string& table_id) {
+    return m_resources.get_table_update_stats(table_id);
+}
+
+std::size_t
+ProtoServer::dispatch_poll(t_callback callback) {
+    if (m_workers.empty()) {
+        callback(poll());
+        return 1;
+    }
+
+    auto tables = m_resources.get_dirty_tables();
+
+    {
+        std::lock_guard<std::mutex> lock(m_dispatch_lock);
+        for (const auto& [table, table_id] : tables) {
+            LaneTask task;
+            task.client_id = 0;
+            task.seq = 0;
+            task.is_poll = true;
+            task.read_only = false;
+            task.lane = table_id;
+            task.callback = callback;
+            _enqueue_task(std::move(task));
+        }
+    }
+
+    m_dispatch_cv.notify_all();
+
+    // Throttled notifications don't touch their table, so they are
+    // delivered from this thread rather than a lane.
+    std::vector<ProtoServerResp<Response>> throttled;
+    _flush_throttled_notifications(throttled);
+    if (throttled.empty()) {
+        return tables.size();
+    }
+
+    t_responses resps;
+    for (auto& resp : throttled) {
+        ProtoServerResp<std::string> str_resp;
+        str_resp.data = resp.data.SerializeAsString();
+        str_resp.client_id = resp.client_id;
+        resps.emplace_back(std::move(str_resp));
+    }
+
+    callback(std::move(resps));
+    return tables.size() + 1;
+}
+
+ServerResources::t_id
+ProtoServer::_get_lane_id(const Request& req) {
+    const auto req_case = req.client_req_case();
+    if (req_case == proto::Request::CLIENT_REQ_NOT_SET) {
+        return "";
+    }
+
+    if (req_case == proto::Request::kMakeTableReq
+        && req.make_table_req().data().data_case()
+            == proto::MakeTableData::kFromView) {
+        // Reads the source view for the whole request, so it runs on the
+        // source table's lane rather than the new table's, which no other
+        // request can address until this one has hosted it.
+        return _get_view_lane_id(req.make_table_req().data().from_view());
+    }
+
+    if (entity_type_is_table(req_case)) {
+        if (req_case == proto::Request::kTableMakeViewReq) {
+            // The view is not hosted until this request runs, so remember
+            // its lane for requests dispatched in the meantime. The entry is
+            // dropped by `_run_worker()` once the request has run, whether
+            // or not it created the view.
+            m_view_lanes[req.table_make_view_req().view_id()] =
+                req.entity_id();
+        }
+
+        return req.entity_id();
+    }
+
+    return _get_view_lane_id(req.entity_id());
+}
+
+ServerResources::t_id
+ProtoServer::_get_view_lane_id(const ServerResources::t_id& view_id) {
+    auto iter = m_view_lanes.find(view_id);
+    if (iter != m_view_lanes.end()) {
+        return iter->second;
+    }
+
+    // Unknown views are routed to the global lane, where the request fails
+    // with `VIEW_NOT_FOUND` as it would on the calling thread.
+    try {
+        return m_resources.get_table_id_for_view(view_id);
+    } catch (const PerspectiveViewNotFoundException&) {
+        return "";
+    }
+}
+
+void
+ProtoServer::_enqueue_task(LaneTask&& task) {
+    auto lane_id = task.lane;
+    m_lanes[lane_id].queue.emplace_back(std::move(task));
+    _schedule_lane(lane_id);
+}
+
+void
+ProtoServer::_schedule_lane(const ServerResources::t_id& lane_id) {
+    auto iter = m_lanes.find(lane_id);
+    if (iter == m_lanes.end()) {
+        return;
+    }
+
+    auto& lane = iter.value();
+    while (!lane.queue.empty() && !lane.has_writer) {
+        auto& task = lane.queue.front();
+
+        // A request on a dirty table processes the table first, so it must
+        // run exclusively even if the request itself is read-only.
+        task.read_only = !task.is_poll
+            && is_read_only(task.req.client_req_case())
+            && !m_resources.is_table_dirty(lane_id);
+
+        if (task.read_only) {
+            ++lane.num_readers;
+        } else if (lane.num_readers == 0) {
+            lane.has_writer = true;
+        } else {
+            break;
+        }
+
+        m_ready.emplace_back(std::move(task));
+        lane.queue.pop_front();
+    }
+
+    if (lane.queue.empty() && lane.num_readers == 0 && !lane.has_writer) {
+        m_lanes.erase(iter);
+    }
+}
+
+void
+ProtoServer::_run_worker() {
+    while (true) {
+        LaneTask task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_dispatch_lock);
+            m_dispatch_cv.wait(lock, [this]() {
+                return m_stopping || !m_ready.empty();
+            });
+
+            if (m_ready.empty()) {
+                return;
+            }
+
+            task = std::move(m_ready.front());
+            m_ready.pop_front();
+        }
+
+        // A pending view's lane outlives its `kTableMakeViewReq` only while
+        // the view is unhosted; afterwards it is found by its table.
+        std::optional<ServerResources::t_id> pending_view_id;
+        if (!task.is_poll
+            && task.req.client_req_case()
+                == proto::Request::kTableMakeViewReq) {
+            pending_view_id = task.req.table_make_view_req().view_id();
+        }
+
+        t_responses resps;
+        if (task.is_poll) {
+            std::vector<ProtoServerResp<Response>> proto_resps;
+            auto tables = m_resources.get_dirty_tables();
+            for (auto& [table, table_id] : tables) {
+                if (table_id == task.lane
+                    && _should_process_table(table, table_id)) {
+                    _process_table(table, table_id, proto_resps);
+                }
+            }
+
+            for (auto& resp : proto_resps) {
+                ProtoServerResp<std::string> str_resp;
+                str_resp.data = resp.data.SerializeAsString();
+                str_resp.client_id = resp.client_id;
+                resps.emplace_back(std::move(str_resp));
+            }
+        } else {
+            resps = _handle_parsed_request(task.client_id, std::move(task.req));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_dispatch_lock);
+            auto& lane = m_lanes[task.lane];
+            if (task.read_only) {
+                --lane.num_readers;
+            } else {
+                lane.has_writer = false;
+            }
+
+            if (pending_view_id.has_value()) {
+                auto iter = m_view_lanes.find(*pending_view_id);
+                if (iter != m_view_lanes.end() && iter->second == task.lane) {
+                    m_view_lanes.erase(iter);
+                }
+            }
+
+            _schedule_lane(task.lane);
+        }
+
+        m_dispatch_cv.notify_all();
+        if (task.is_poll) {
+            task.callback(std::move(resps));
+        } else {
+            _deliver(
+                task.client_id,
+                task.seq,
+                std::move(resps),
+                std::move(task.callback)
+            );
+        }
+    }
+}
+
+void
+ProtoServer::_deliver(
+    std::uint32_t client_id,
+    std::uint64_t seq,
+    t_responses&& resps,
+    t_callback&& callback
+) {
+    std::unique_lock<std::mutex> lock(m_dispatch_lock);
+    auto* sequence = &m_client_sequences[client_id];
+    sequence->pending.emplace(
+        seq, std::make_pair(std::move(resps), std::move(callback))
+    );
+
+    // Only one worker at a time flushes a client's responses, in dispatch
+    // order; the others just park their results.
+    if (sequence->delivering) {
+        return;
+    }
+
+    sequence->delivering = true;
+    while (true) {
+        sequence = &m_client_sequences[client_id];
+        auto iter = sequence->pending.find(sequence->next_deliver);
+        if (iter == sequence->pending.end()) {
+            sequence->delivering = false;
+            return;
+        }
+
+        auto ready = std::move(iter->second);
+        sequence->pending.erase(iter);
+        ++sequence->next_deliver;
+
+        lock.unlock();
+        ready.second(std::move(ready.first));
+        lock.lock();
+    }
+}
+
 static std::string_view
 view_sides_to_string(const ErasedView& view) {
     switch (view.sides()) {
@@ -1011,6 +1645,100 @@ calculate_num_hidden(const ErasedView& view, const t_view_config& config) {
     return num_hidden;
 }
 
+/**
+ * @brief Identify a view config on a table, such that views with the same
+ * key compute identical contexts. Map fields are serialized in key order.
+ */
+static std::string
+shared_view_key(
+    const ServerResources::t_id& table_id, const proto::ViewConfig& cfg
+) {
+    std::string key = std::to_string(table_id.size()) + ":" + table_id;
+    {
+        google::protobuf::io::StringOutputStream stream(&key);
+        google::protobuf::io::CodedOutputStream output(&stream);
+        output.SetSerializationDeterministic(true);
+        cfg.SerializeToCodedStream(&output);
+    }
+
+    return key;
+}
+
+static std::shared_ptr<ErasedView>
+make_erased_view(
+    const std::shared_ptr<Table>& table,
+    const std::shared_ptr<t_schema>& schema,
+    const std::shared_ptr<t_view_config>& config,
+    const std::string& name,
+    std::uint32_t sides,
+    bool is_unit_context
+) {
+    if (is_unit_context) {
+        auto ctx = make_context<t_ctxunit>(table, schema, config, name);
+        auto view = std::make_shared<View<t_ctxunit>>(
+            table, ctx, name, "|", config
+        );
+        return std::make_shared<CtxUnitView>(std::move(view));
+    }
+
+    if (sides == 0) {
+        auto ctx = make_context<t_ctx0>(table, schema, config, name);
+        auto view =
+            std::make_shared<View<t_ctx0>>(table, ctx, name, "|", config);
+        return std::make_shared<Ctx0View>(view);
+    }
+
+    if (sides == 1) {
+        auto ctx = make_context<t_ctx1>(table, schema, config, name);
+        auto view =
+            std::make_shared<View<t_ctx1>>(table, ctx, name, "|", config);
+        return std::make_shared<Ctx1View>(std::move(view));
+    }
+
+    if (sides == 2) {
+        auto ctx = make_context<t_ctx2>(table, schema, config, name);
+        auto view =
+            std::make_shared<View<t_ctx2>>(table, ctx, name, "|", config);
+        return std::make_shared<Ctx2View>(std::move(view));
+    }
+
+    PSP_COMPLAIN_AND_ABORT("Invalid number of sides");
+    return nullptr;
+}
+
+std::shared_ptr<ErasedView>
+ProtoServer::_get_unshared_view(const ServerResources::t_id& view_id) {
+    auto view = m_resources.get_view(view_id);
+    if (view->sides() == 0 || !m_resources.unshare_view(view_id)) {
+        return view;
+    }
+
+    // Other handles keep the shared context, so build this handle a new one
+    // from the same config. It starts from the same expansion state, as a
+    // shared context is never expanded or collapsed.
+    auto table = m_resources.get_table_for_view(view_id);
+    auto config = view->get_view_config();
+    auto schema =
+        std::make_shared<t_schema>(table->get_gnode()->get_output_schema());
+    for (const auto& expr : config->get_expressions()) {
+        schema->add_column(expr->get_expression_alias(), expr->get_dtype());
+    }
+
+    // The shared context may be registered under this handle's id.
+    auto unshared_view = make_erased_view(
+        table, schema, config, view_id + "|unshared", view->sides(), false
+    );
+
+    // Deltas are enabled on a context when a handle subscribes in ROW mode,
+    // which may have been this handle's subscription.
+    if (view->get_deltas_enabled()) {
+        unshared_view->set_deltas_enabled(true);
+    }
+
+    m_resources.replace_view(view_id, unshared_view);
+    return unshared_view;
+}
+
 template <typename A>
 static t_tscalar
 coerce_to(const t_dtype dtype, const A& val) {
@@ -1152,11 +1880,8 @@ coerce_to(const t_dtype dtype, const A& val) {
 
 std::vector<ProtoServerResp<ProtoServer::Response>>
 ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
-    static bool is_init_expr = false;
-    if (!is_init_expr) {
-        t_computed_expression_parser::init();
-        is_init_expr = true;
-    }
+    static std::once_flag is_init_expr;
+    std::call_once(is_init_expr, t_computed_expression_parser::init);
 
     std::vector<ProtoServerResp<ProtoServer::Response>> proto_resp;
     // proto::Response resp_env;
@@ -1271,6 +1996,11 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
             switch (r.data().data_case()) {
                 case proto::MakeTableData::kFromView: {
                     auto view = m_resources.get_view(r.data().from_view());
+                    auto source_pool =
+                        m_resources.get_table_for_view(r.data().from_view())
+                            ->get_pool();
+
+                    const t_uindex epoch = source_pool->epoch();
                     proto::ViewPort viewport;
                     auto dims = parse_format_options(
                         viewport,
@@ -1280,14 +2010,70 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
                         view->get_view_config()->is_column_only(),
                         0
                     );
-                    auto arrow = view->to_arrow(
-                        dims.start_row,
-                        dims.end_row,
-                        dims.start_col,
-                        dims.end_col
-                    );
 
-                    table = Table::from_arrow(index, std::move(*arrow), limit);
+                    // Load the view a chunk of rows at a time, each as its
+                    // own Arrow stream, so only one chunk's encoding is held
+                    // alongside the table being built. Every chunk must come
+                    // from the same state of the source table, so stop as
+                    // soon as its pool has processed an update.
+                    t_uindex chunk_start = dims.start_row;
+                    do {
+                        t_uindex chunk_end = std::min<t_uindex>(
+                            dims.end_row, chunk_start + DEFAULT_ARROW_CHUNK_ROWS
+                        );
+
+                        std::string arrow;
+                        view->to_arrow_chunked(
+                            chunk_start,
+                            chunk_end,
+                            dims.start_col,
+                            dims.end_col,
+                            true,
+                            true,
+                            DEFAULT_ARROW_CHUNK_ROWS,
+                            [&](std::string&& chunk) { arrow.append(chunk); }
+                        );
+
+                        if (source_pool->epoch() != epoch) {
+                            break;
+                        }
+
+                        if (table == nullptr) {
+                            table = Table::from_arrow(
+                                index, std::move(arrow), limit
+                            );
+                        } else {
+                            table->update_arrow(std::string_view(arrow), 0);
+                            table->get_pool()->_process();
+                        }
+
+                        chunk_start = chunk_end;
+                    } while (chunk_start < dims.end_row);
+
+                    if (source_pool->epoch() != epoch) {
+                        // The source changed partway through, so discard the
+                        // chunks loaded so far and export the view at once.
+                        table = nullptr;
+                        dims = parse_format_options(
+                            viewport,
+                            view->num_columns(),
+                            view->num_rows(),
+                            view->sides(),
+                            view->get_view_config()->is_column_only(),
+                            0
+                        );
+
+                        auto arrow = view->to_arrow(
+                            dims.start_row,
+                            dims.end_row,
+                            dims.start_col,
+                            dims.end_col
+                        );
+
+                        table =
+                            Table::from_arrow(index, std::move(*arrow), limit);
+                    }
+
                     break;
                 }
                 case proto::MakeTableData::kFromArrow: {
@@ -1518,7 +2304,13 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
             auto table = m_resources.get_table(req.entity_id());
             switch (r.data().data_case()) {
                 case proto::MakeTableData::kFromArrow: {
-                    table->update_arrow(r.data().from_arrow(), r.port_id());
+                    auto data = std::make_shared<const std::string>(std::move(
+                        *req.mutable_table_update_req()
+                             ->mutable_data()
+                             ->mutable_from_arrow()
+                    ));
+
+                    table->update_arrow(std::move(data), r.port_id());
                     break;
                 }
                 case proto::MakeTableData::kFromCsv: {
@@ -1552,12 +2344,29 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
             break;
         }
         case proto::Request::kTableMakeViewReq: {
+            const auto& r = req.table_make_view_req();
+            const auto& cfg = r.config();
+
+            // A view with an identical config on this table already has the
+            // context this view needs, so hand out another handle to it.
+            auto shared_key = shared_view_key(req.entity_id(), cfg);
+            if (auto shared_view = m_resources.get_shared_view(shared_key)) {
+                m_resources.host_view(
+                    client_id, r.view_id(), req.entity_id(), shared_view
+                );
+                m_resources.share_view(r.view_id(), shared_key, shared_view);
+
+                proto::Response resp;
+                auto* make_view = resp.mutable_table_make_view_resp();
+                make_view->set_view_id(r.view_id());
+                push_resp(std::move(resp));
+                break;
+            }
+
             auto table = m_resources.get_table(req.entity_id());
             auto schema = std::make_shared<t_schema>(
                 table->get_gnode()->get_output_schema()
             );
-            const auto& r = req.table_make_view_req();
-            const auto& cfg = r.config();
 
             const auto& group_by = cfg.group_by();
             std::vector<std::string> row_pivots{
@@ -1834,43 +2643,14 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
                 && aggregates.empty() && columns.empty() && sort_str.empty()
                 && cfg.expressions().empty();
 
-            std::shared_ptr<ErasedView> erased_view;
-
-            if (is_unit_context) {
-                auto ctx =
-                    make_context<t_ctxunit>(table, schema, config, r.view_id());
-                auto view = std::make_shared<View<t_ctxunit>>(
-                    table, ctx, r.view_id(), "|", config
-                );
-                erased_view = std::make_shared<CtxUnitView>(std::move(view));
-            } else if (sides == 0) {
-                auto ctx =
-                    make_context<t_ctx0>(table, schema, config, r.view_id());
-                auto view = std::make_shared<View<t_ctx0>>(
-                    table, ctx, r.view_id(), "|", config
-                );
-                erased_view = std::make_shared<Ctx0View>(view);
-            } else if (sides == 1) {
-                auto ctx =
-                    make_context<t_ctx1>(table, schema, config, r.view_id());
-                auto view = std::make_shared<View<t_ctx1>>(
-                    table, ctx, r.view_id(), "|", config
-                );
-                erased_view = std::make_shared<Ctx1View>(std::move(view));
-            } else if (sides == 2) {
-                auto ctx =
-                    make_context<t_ctx2>(table, schema, config, r.view_id());
-                auto view = std::make_shared<View<t_ctx2>>(
-                    table, ctx, r.view_id(), "|", config
-                );
-                erased_view = std::make_shared<Ctx2View>(std::move(view));
-            } else {
-                PSP_COMPLAIN_AND_ABORT("Invalid number of sides");
-            }
+            auto erased_view = make_erased_view(
+                table, schema, config, r.view_id(), sides, is_unit_context
+            );
 
             m_resources.host_view(
                 client_id, r.view_id(), req.entity_id(), erased_view
             );
+            m_resources.share_view(r.view_id(), shared_key, erased_view);
 
             proto::Response resp;
             auto* make_view = resp.mutable_table_make_view_resp();
@@ -2332,15 +3112,53 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
                 num_hidden
             );
 
+            // Encode the view in row chunks, so only one chunk's data slice
+            // is materialized at a time alongside the encoded bytes. A
+            // `chunked` request gets each chunk in its own response, the
+            // last of which has `more` unset, rather than one response
+            // holding the whole stream.
+            if (r.chunked()) {
+                std::optional<std::string> pending;
+                auto push_chunk = [&](std::string&& chunk, bool more) {
+                    proto::Response resp;
+                    auto* arrow_resp = resp.mutable_view_to_arrow_resp();
+                    *arrow_resp->mutable_arrow() = std::move(chunk);
+                    arrow_resp->set_more(more);
+                    push_resp(std::move(resp));
+                };
+
+                view->to_arrow_chunked(
+                    dims.start_row,
+                    dims.end_row,
+                    dims.start_col,
+                    dims.end_col,
+                    true,
+                    r.compression() == "lz4",
+                    DEFAULT_ARROW_CHUNK_ROWS,
+                    [&](std::string&& chunk) {
+                        if (pending.has_value()) {
+                            push_chunk(std::move(*pending), true);
+                        }
+
+                        pending = std::move(chunk);
+                    }
+                );
+
+                push_chunk(std::move(pending).value_or(""), false);
+                break;
+            }
+
             proto::Response resp;
             auto* arrow = resp.mutable_view_to_arrow_resp()->mutable_arrow();
-            *arrow = *view->to_arrow(
+            view->to_arrow_chunked(
                 dims.start_row,
                 dims.end_row,
                 dims.start_col,
                 dims.end_col,
                 true,
-                r.compression() == "lz4"
+                r.compression() == "lz4",
+                DEFAULT_ARROW_CHUNK_ROWS,
+                [&](std::string&& chunk) { arrow->append(chunk); }
             );
 
             push_resp(std::move(resp));
@@ -2371,13 +3189,25 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
             break;
         }
         case proto::Request::kViewOnUpdateReq: {
+            const auto& r = req.view_on_update_req();
+            const bool is_row_mode = r.has_mode()
+                && r.mode()
+                    == proto::ViewOnUpdateReq_Mode::ViewOnUpdateReq_Mode_ROW;
+
+            // A throttled subscriber misses some notifications, and the row
+            // deltas they carry cannot be merged into the next one.
+            if (is_row_mode && r.throttle() > 0) {
+                PSP_COMPLAIN_AND_ABORT(
+                    "`on_update` in \"row\" mode cannot be throttled"
+                );
+            }
+
             Subscription sub_info;
             sub_info.id = req.msg_id();
             sub_info.client_id = client_id;
+            sub_info.throttle = std::chrono::milliseconds(r.throttle());
             m_resources.create_view_on_update_sub(req.entity_id(), sub_info);
-            if (req.view_on_update_req().has_mode()
-                && req.view_on_update_req().mode()
-                    == proto::ViewOnUpdateReq_Mode::ViewOnUpdateReq_Mode_ROW) {
+            if (is_row_mode) {
                 auto view = m_resources.get_view(req.entity_id());
                 view->set_deltas_enabled(true);
             }
@@ -2402,7 +3232,7 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
         }
         case proto::Request::kViewCollapseReq: {
             const auto& r = req.view_collapse_req();
-            auto view = m_resources.get_view(req.entity_id());
+            auto view = _get_unshared_view(req.entity_id());
             auto num_changed = view->collapse(r.row_index());
             proto::Response resp;
             auto* collapse_resp = resp.mutable_view_collapse_resp();
@@ -2412,7 +3242,7 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
         }
         case proto::Request::kViewExpandReq: {
             const auto& r = req.view_expand_req();
-            auto view = m_resources.get_view(req.entity_id());
+            auto view = _get_unshared_view(req.entity_id());
             auto num_changed = view->expand(r.row_index());
             proto::Response resp;
             auto* expand_resp = resp.mutable_view_expand_resp();
@@ -2422,7 +3252,7 @@ ProtoServer::_handle_request(std::uint32_t client_id, Request&& req) {
         }
         case proto::Request::kViewSetDepthReq: {
             const auto& r = req.view_set_depth_req();
-            auto view = m_resources.get_view(req.entity_id());
+            auto view = _get_unshared_view(req.entity_id());
             view->set_depth(r.depth());
             proto::Response resp;
             resp.mutable_view_set_depth_resp();
@@ -2457,33 +3287,110 @@ ProtoServer::_poll() {
     std::vector<ProtoServerResp<Response>> resp_envs;
     auto tables = m_resources.get_dirty_tables();
     for (auto& [table, table_id] : tables) {
-        _process_table_unchecked(table, table_id, resp_envs);
+        if (_should_process_table(table, table_id)) {
+            _process_table_unchecked(table, table_id, resp_envs);
+            m_resources.mark_table_clean(table_id);
+        }
     }
 
-    m_resources.mark_all_tables_clean();
+    _flush_throttled_notifications(resp_envs);
     return resp_envs;
 }
 
+void
+ProtoServer::_flush_throttled_notifications(
+    std::vector<ProtoServerResp<ProtoServer::Response>>& outs
+) {
+    for (auto& [view_id, sub] : m_resources.take_due_view_on_update_subs()) {
+        Response out;
+        out.set_msg_id(sub.id);
+        out.set_entity_id(view_id);
+        out.mutable_view_on_update_resp()->set_port_id(*sub.pending_port_id);
+        ProtoServerResp<proto::Response> resp;
+        resp.data = std::move(out);
+        resp.client_id = sub.client_id;
+        outs.emplace_back(std::move(resp));
+    }
+}
+
+bool
+ProtoServer::_should_process_table(
+    const std::shared_ptr<Table>& table, const ServerResources::t_id& table_id
+) {
+    return m_resources.should_process_table(
+        table_id, table->get_gnode()->num_queued_rows()
+    );
+}
+
 void
 ProtoServer::_process_table_unchecked(
     std::shared_ptr<Table>& table,
     const ServerResources::t_id& table_id,
     std::vector<ProtoServerResp<ProtoServer::Response>>& outs
 ) {
+    const auto num_rows = table->get_gnode()->num_queued_rows();
+    const auto num_outs = outs.size();
     table->get_pool()->_process([this, table_id, &outs](auto port_id) {
-        // record changes per port.
+        // record changes per port. Handles to a shared view get the same
+        // delta, so their subscriptions are grouped by view.
+        std::vector<std::shared_ptr<ErasedView>> views;
+        std::vector<std::vector<std::pair<ServerResources::t_id, Subscription>>>
+            view_subscriptions;
+
         auto view_ids = m_resources.get_view_ids(table_id);
         for (const auto& view_id : view_ids) {
             auto view = m_resources.get_view(view_id);
             auto subscriptions = m_resources.get_view_on_update_sub(view_id);
-            for (auto& subscription : subscriptions) {
+            if (subscriptions.empty()) {
+                continue;
+            }
+
+            auto it = std::find(views.begin(), views.end(), view);
+            if (it == views.end()) {
+                views.push_back(view);
+                view_subscriptions.emplace_back();
+                it = views.end() - 1;
+            }
+
+            auto& subscribers = view_subscriptions[it - views.begin()];
+            for (const auto& subscription : subscriptions) {
+                subscribers.emplace_back(view_id, subscription);
+            }
+        }
+
+        for (std::size_t vidx = 0; vidx < views.size(); ++vidx) {
+            // Every subscriber to a view receives the same delta, so it is
+            // only calculated and serialized once per port.
+            std::shared_ptr<std::string> delta;
+            if (views[vidx]->get_deltas_enabled()) {
+                delta = views[vidx]->get_row_delta_as_arrow();
+            }
+
+            const auto& subscribers = view_subscriptions[vidx];
+            for (std::size_t idx = 0; idx < subscribers.size(); ++idx) {
+                const auto& [view_id, subscription] = subscribers[idx];
+                if (m_resources.throttle_view_on_update_sub(
+                        view_id,
+                        subscription.id,
+                        subscription.client_id,
+                        port_id
+                    )) {
+                    continue;
+                }
+
                 Response out;
                 out.set_msg_id(subscription.id);
                 out.set_entity_id(view_id);
                 auto* r = out.mutable_view_on_update_resp();
                 r->set_port_id(port_id);
-                if (view->get_deltas_enabled()) {
-                    *r->mutable_delta() = *view->get_row_delta_as_arrow();
+                if (delta != nullptr) {
+                    // Each response owns its bytes, so copy the delta into
+                    // all but the last, which can take the buffer itself.
+                    if (idx + 1 == subscribers.size()) {
+                        *r->mutable_delta() = std::move(*delta);
+                    } else {
+                        *r->mutable_delta() = *delta;
+                    }
                 }
 
                 ProtoServerResp<proto::Response> resp2;
@@ -2493,6 +3400,10 @@ ProtoServer::_process_table_unchecked(
             }
         }
     });
+
+    m_resources.record_table_processed(
+        table_id, num_rows, outs.size() - num_outs
+    );
 }
 
 void
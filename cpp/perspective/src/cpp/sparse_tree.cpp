@@ -38,6 +38,17 @@ namespace perspective {
 // Tweet length
 const t_uindex MAX_JOIN_SIZE = 280;
 
+// Incremental updates to a running aggregate row between full recomputes.
+const t_uindex RUNNING_AGG_MAX_UPDATES = 256;
+
+// Aggregates whose value can be maintained from the values leaving and
+// entering a node, rather than recomputed from all of the node's rows.
+static bool
+is_running_agg(t_aggtype agg) {
+    return agg == AGGTYPE_MEAN || agg == AGGTYPE_WEIGHTED_MEAN
+        || agg == AGGTYPE_VARIANCE || agg == AGGTYPE_STANDARD_DEVIATION;
+}
+
 t_tscalar
 get_dominant(std::vector<t_tscalar>& values) {
     if (values.empty()) {
@@ -371,6 +382,53 @@ t_stree::build_strand_table_metadata(
     }
 
     metadata.m_aggschema.add_column("psp_strand_count", DTYPE_INT8);
+
+    std::set<std::string> running_colset;
+    for (const auto& aggspec : aggspecs) {
+        const auto& deps = aggspec.get_dependencies();
+        bool tracked = false;
+
+        if (is_running_agg(aggspec.agg())) {
+            tracked = std::all_of(
+                deps.begin(),
+                deps.end(),
+                [&metadata](const t_dep& dep) {
+                    return dep.type() == DEPTYPE_COLUMN
+                        && is_numeric_type(
+                               metadata.m_flattened_schema.get_dtype(dep.name())
+                        );
+                }
+            );
+        } else if (aggspec.has_order_index()) {
+            tracked = deps[0].type() == DEPTYPE_COLUMN
+                && metadata.m_flattened_schema.get_dtype(deps[0].name())
+                    != DTYPE_OBJECT;
+        }
+
+        if (!tracked) {
+            continue;
+        }
+
+        for (const auto& dep : deps) {
+            if (running_colset.insert(dep.name()).second) {
+                t_dtype dtype =
+                    metadata.m_flattened_schema.get_dtype(dep.name());
+                metadata.m_running_columns.push_back(dep.name());
+                metadata.m_aggschema.add_column(
+                    "psp_leave_" + dep.name(), dtype
+                );
+                metadata.m_aggschema.add_column(
+                    "psp_enter_" + dep.name(), dtype
+                );
+            }
+        }
+    }
+
+    if (!metadata.m_running_columns.empty()) {
+        metadata.m_aggschema.add_column("psp_strand_leave", DTYPE_BOOL);
+        metadata.m_aggschema.add_column("psp_strand_enter", DTYPE_BOOL);
+    }
+
     return metadata;
 }
 
@@ -383,6 +441,7 @@ t_stree::build_strand_table_metadata(
  * @param prev
  * @param current
  * @param transitions
+ * @param existed
  * @param aggspecs
  * @param config
  * @return std::pair<std::shared_ptr<t_data_table>,
@@ -395,6 +454,7 @@ t_stree::build_strand_table(
     const t_data_table& prev,
     const t_data_table& current,
     const t_data_table& transitions,
+    const t_data_table& existed,
     const std::vector<t_aggspec>& aggspecs,
     const t_config& config
 ) const {
@@ -466,6 +526,68 @@ t_stree::build_strand_table(
 
     t_column* spkey = strands->get_column("psp_pkey").get();
 
+    // The values each strand removes from and adds to its nodes, for the
+    // dependencies of running and order-indexed aggregates. A row leaves its
+    // previous value if it was in the strand's nodes before this update, and
+    // enters its current value (invalid if the update cleared it) if it is
+    // in them afterwards. Values are invalid placeholders otherwise.
+    t_uindex nrunning = metadata.m_running_columns.size();
+    std::vector<const t_column*> run_pcols(nrunning);
+    std::vector<const t_column*> run_ccols(nrunning);
+    std::vector<const t_column*> run_fcols(nrunning);
+    std::vector<t_column*> run_lcols(nrunning);
+    std::vector<t_column*> run_ecols(nrunning);
+    std::vector<t_tscalar> run_absent(nrunning);
+    const t_column* existed_col = nullptr;
+    t_column* leave_col = nullptr;
+    t_column* enter_col = nullptr;
+
+    for (t_uindex ridx = 0; ridx < nrunning; ++ridx) {
+        const std::string& colname = metadata.m_running_columns[ridx];
+        run_pcols[ridx] = prev.get_const_column(colname).get();
+        run_ccols[ridx] = current.get_const_column(colname).get();
+        run_fcols[ridx] = flattened.get_const_column(colname).get();
+        run_lcols[ridx] = aggs->get_column("psp_leave_" + colname).get();
+        run_ecols[ridx] = aggs->get_column("psp_enter_" + colname).get();
+
+        t_dtype dtype = run_lcols[ridx]->get_dtype();
+        t_tscalar absent;
+        if (dtype == DTYPE_STR) {
+            absent.set("");
+        } else {
+            absent = t_tscalar::canonical(dtype);
+        }
+        absent.m_status = STATUS_INVALID;
+        run_absent[ridx] = absent;
+    }
+
+    if (nrunning > 0) {
+        existed_col = existed.get_const_column("psp_existed").get();
+        leave_col = aggs->get_column("psp_strand_leave").get();
+        enter_col = aggs->get_column("psp_strand_enter").get();
+    }
+
+    auto push_running = [&](t_uindex idx, bool leave, bool enter) {
+        if (nrunning == 0) {
+            return;
+        }
+
+        leave = leave && *(existed_col->get_nth<bool>(idx));
+        leave_col->push_back<bool>(leave);
+        enter_col->push_back<bool>(enter);
+
+        for (t_uindex ridx = 0; ridx < nrunning; ++ridx) {
+            run_lcols[ridx]->push_back(
+                leave ? run_pcols[ridx]->get_scalar(idx) : run_absent[ridx]
+            );
+
+            bool entered = enter && !run_fcols[ridx]->is_cleared(idx);
+            run_ecols[ridx]->push_back(
+                entered ? run_ccols[ridx]->get_scalar(idx) : run_absent[ridx]
+            );
+        }
+    };
+
     t_mask msk_prev;
     t_mask msk_curr;
 
@@ -513,6 +635,7 @@ t_stree::build_strand_table(
                     pivots_neq,
                     metadata.m_pivot_like_columns
                 );
+                push_running(idx, false, op != OP_DELETE);
             } else if (filter_prev && !filter_curr) {
                 // reverse prev row
                 build_strand_table_phase_2(
@@ -530,6 +653,7 @@ t_stree::build_strand_table(
                     insert_count,
                     metadata.m_pivot_like_columns
                 );
+                push_running(idx, true, false);
             } else if (filter_prev && filter_curr) {
                 // should be handled as normal
                 build_strand_table_phase_1(
@@ -552,6 +676,7 @@ t_stree::build_strand_table(
                     pivots_neq,
                     metadata.m_pivot_like_columns
                 );
+                push_running(idx, !pivots_neq, op != OP_DELETE);
 
                 if (op == OP_DELETE || !pivots_neq) {
                     continue;
@@ -572,6 +697,7 @@ t_stree::build_strand_table(
                     insert_count,
                     metadata.m_pivot_like_columns
                 );
+                push_running(idx, true, false);
             }
         }
     } else {
@@ -606,6 +732,7 @@ t_stree::build_strand_table(
                 pivots_neq,
                 metadata.m_pivot_like_columns
             );
+            push_running(idx, !pivots_neq, op != OP_DELETE);
 
             if (op == OP_DELETE || !pivots_neq) {
                 continue;
@@ -628,6 +755,7 @@ t_stree::build_strand_table(
                 insert_count,
                 metadata.m_pivot_like_columns
             );
+            push_running(idx, true, false);
         }
     }
 
@@ -989,6 +1117,55 @@ t_stree::update_aggs_from_static(
         agg_update_info.m_aggspecs.push_back(ctx.get_aggspec(colname));
     }
 
+    // Running and order-indexed aggregates are updated from the strands'
+    // leaving and entering values when the strand table carries them for
+    // every dependency.
+    t_uindex nrunning_cols = aggschema.m_columns.size();
+    const t_data_table& strand_deltas = *(ctx.get_strand_deltas());
+    const t_schema& strand_deltas_schema = strand_deltas.get_schema();
+    agg_update_info.m_ctx = &ctx;
+    agg_update_info.m_leave.resize(nrunning_cols);
+    agg_update_info.m_enter.resize(nrunning_cols);
+    m_running_state.resize(nrunning_cols);
+    m_order_indices.resize(nrunning_cols);
+
+    if (strand_deltas_schema.has_column("psp_strand_leave")) {
+        agg_update_info.m_leave_flags =
+            strand_deltas.get_const_column("psp_strand_leave").get();
+        agg_update_info.m_enter_flags =
+            strand_deltas.get_const_column("psp_strand_enter").get();
+    }
+
+    for (t_uindex idx = 0; idx < nrunning_cols; ++idx) {
+        const t_aggspec& spec = agg_update_info.m_aggspecs[idx];
+        if (is_running_agg(spec.agg())) {
+            m_running_state[idx].resize(m_aggregates->size());
+        } else if (spec.has_order_index()) {
+            m_order_indices[idx].resize(m_aggregates->size());
+        } else {
+            continue;
+        }
+
+        std::vector<const t_column*> leave;
+        std::vector<const t_column*> enter;
+        for (const auto& dep : spec.get_dependencies()) {
+            const std::string leave_name = "psp_leave_" + dep.name();
+            const std::string enter_name = "psp_enter_" + dep.name();
+            if (!strand_deltas_schema.has_column(leave_name)
+                || !strand_deltas_schema.has_column(enter_name)) {
+                leave.clear();
+                enter.clear();
+                break;
+            }
+
+            leave.push_back(strand_deltas.get_const_column(leave_name).get());
+            enter.push_back(strand_deltas.get_const_column(enter_name).get());
+        }
+
+        agg_update_info.m_leave[idx] = std::move(leave);
+        agg_update_info.m_enter[idx] = std::move(enter);
+    }
+
     auto is_col_scaled_aggregate = [&](int col_idx) -> bool {
         int agg_type = agg_update_info.m_aggspecs[col_idx].agg();
 
@@ -1195,6 +1372,19 @@ t_stree::update_agg_table(
                 dst->set_scalar(dst_ridx, new_value);
             } break;
             case AGGTYPE_MEAN: {
+                if (update_agg_running(
+                        nidx,
+                        info,
+                        idx,
+                        src_ridx,
+                        dst_ridx,
+                        expression_schema,
+                        old_value,
+                        new_value
+                    )) {
+                    break;
+                }
+
                 auto pkeys = get_pkeys(nidx);
                 std::vector<double> values;
 
@@ -1220,14 +1410,29 @@ t_stree::update_agg_table(
                 dst_pair->second = dr;
 
                 dst->set_valid(dst_ridx, true);
+                seed_agg_running(idx, dst_ridx, values.size(), 0, 0);
 
                 new_value.set(nr / dr);
             } break;
             case AGGTYPE_WEIGHTED_MEAN: {
+                if (update_agg_running(
+                        nidx,
+                        info,
+                        idx,
+                        src_ridx,
+                        dst_ridx,
+                        expression_schema,
+                        old_value,
+                        new_value
+                    )) {
+                    break;
+                }
+
                 auto pkeys = get_pkeys(nidx);
 
                 double nr = 0;
                 double dr = 0;
+                t_uindex count = 0;
                 std::vector<t_tscalar> values;
                 std::vector<t_tscalar> weights;
 
@@ -1256,6 +1461,7 @@ t_stree::update_agg_table(
                         && !weights_it->is_nan() && !values_it->is_nan()) {
                         nr += weights_it->to_double() * values_it->to_double();
                         dr += weights_it->to_double();
+                        ++count;
                     }
                 }
 
@@ -1268,6 +1474,7 @@ t_stree::update_agg_table(
 
                 bool valid = (dr != 0);
                 dst->set_valid(dst_ridx, valid);
+                seed_agg_running(idx, dst_ridx, count, 0, 0);
                 new_value.set(nr / dr);
             } break;
             case AGGTYPE_UNIQUE: {
@@ -1325,6 +1532,22 @@ t_stree::update_agg_table(
             } break;
             case AGGTYPE_MEDIAN: {
                 old_value.set(dst->get_scalar(dst_ridx));
+                const t_order_index* index = update_order_index(
+                    nidx,
+                    info,
+                    idx,
+                    src_ridx,
+                    dst_ridx,
+                    gstate,
+                    expression_master_table
+                );
+
+                if (index != nullptr) {
+                    new_value.set(get_aggregate_median(*index));
+                    dst->set_scalar(dst_ridx, new_value);
+                    break;
+                }
+
                 auto pkeys = get_pkeys(nidx);
 
                 new_value.set(
@@ -1543,6 +1766,22 @@ t_stree::update_agg_table(
             case AGGTYPE_MAX: {
                 t_tscalar dst_scalar = dst->get_scalar(dst_ridx);
                 old_value.set(dst_scalar);
+                const t_order_index* index = update_order_index(
+                    nidx,
+                    info,
+                    idx,
+                    src_ridx,
+                    dst_ridx,
+                    gstate,
+                    expression_master_table
+                );
+
+                if (index != nullptr) {
+                    new_value.set(index->max());
+                    dst->set_scalar(dst_ridx, new_value);
+                    break;
+                }
+
                 auto pkeys = get_pkeys(nidx);
                 std::vector<t_tscalar> values;
                 read_column_from_gstate(
@@ -1559,6 +1798,22 @@ t_stree::update_agg_table(
             case AGGTYPE_MIN: {
                 t_tscalar dst_scalar = dst->get_scalar(dst_ridx);
                 old_value.set(dst_scalar);
+                const t_order_index* index = update_order_index(
+                    nidx,
+                    info,
+                    idx,
+                    src_ridx,
+                    dst_ridx,
+                    gstate,
+                    expression_master_table
+                );
+
+                if (index != nullptr) {
+                    new_value.set(index->min());
+                    dst->set_scalar(dst_ridx, new_value);
+                    break;
+                }
+
                 auto pkeys = get_pkeys(nidx);
                 std::vector<t_tscalar> values;
                 read_column_from_gstate(
@@ -1600,6 +1855,23 @@ t_stree::update_agg_table(
             case AGGTYPE_HIGH_MINUS_LOW: {
                 t_tscalar dst_scalar = dst->get_scalar(dst_ridx);
                 old_value.set(dst_scalar);
+                const t_order_index* index = update_order_index(
+                    nidx,
+                    info,
+                    idx,
+                    src_ridx,
+                    dst_ridx,
+                    gstate,
+                    expression_master_table
+                );
+
+                if (index != nullptr) {
+                    t_tscalar high = index->max();
+                    new_value.set(high.sub_typesafe(index->min()));
+                    dst->set_scalar(dst_ridx, new_value);
+                    break;
+                }
+
                 auto pkeys = get_pkeys(nidx);
                 std::vector<t_tscalar> values;
                 read_column_from_gstate(
@@ -1742,6 +2014,24 @@ t_stree::update_agg_table(
             } break;
             case AGGTYPE_DISTINCT_COUNT: {
                 old_value.set(dst->get_scalar(dst_ridx));
+                const t_order_index* index = update_order_index(
+                    nidx,
+                    info,
+                    idx,
+                    src_ridx,
+                    dst_ridx,
+                    gstate,
+                    expression_master_table
+                );
+
+                if (index != nullptr) {
+                    new_value.set(
+                        static_cast<std::uint32_t>(index->distinct_count())
+                    );
+                    dst->set_scalar(dst_ridx, new_value);
+                    break;
+                }
+
                 auto pkeys = get_pkeys(nidx);
 
                 new_value.set(
@@ -1795,6 +2085,19 @@ t_stree::update_agg_table(
             } break;
             case AGGTYPE_VARIANCE:
             case AGGTYPE_STANDARD_DEVIATION: {
+                if (update_agg_running(
+                        nidx,
+                        info,
+                        idx,
+                        src_ridx,
+                        dst_ridx,
+                        expression_schema,
+                        old_value,
+                        new_value
+                    )) {
+                    break;
+                }
+
                 old_value.set(dst->get_scalar(dst_ridx));
 
                 auto pkeys = get_pkeys(nidx);
@@ -1822,6 +2125,10 @@ t_stree::update_agg_table(
                     mean = next_mean;
                 }
 
+                seed_agg_running(
+                    idx, dst_ridx, static_cast<t_uindex>(count), mean, m2
+                );
+
                 // Only calculate stddev for more than 1 element in the group.
                 if (count >= 2) {
                     double value = m2 / count;
@@ -1854,6 +2161,309 @@ t_stree::update_agg_table(
     } // end for
 }
 
+bool
+t_stree::update_agg_running(
+    t_uindex nidx,
+    const t_agg_update_info& info,
+    t_uindex idx,
+    t_uindex src_ridx,
+    t_uindex dst_ridx,
+    const t_schema& expression_schema,
+    t_tscalar& old_value,
+    t_tscalar& new_value
+) {
+    const auto& leave = info.m_leave[idx];
+    const auto& enter = info.m_enter[idx];
+    const t_aggspec& spec = info.m_aggspecs[idx];
+
+    // New nodes may reuse a freed aggregate row, and expression columns are
+    // recomputed wholesale, so neither can be updated from the strands.
+    if (leave.empty() || info.m_ctx == nullptr
+        || m_newids.find(nidx) != m_newids.end()
+        || dst_ridx >= m_running_state[idx].size()
+        || !m_running_state[idx][dst_ridx].m_seeded) {
+        return false;
+    }
+
+    for (const auto& dep : spec.get_dependencies()) {
+        if (expression_schema.has_column(dep.name())) {
+            return false;
+        }
+    }
+
+    // Removals accumulate rounding error, so the state is reseeded from a
+    // full recompute after a bounded number of incremental updates.
+    t_agg_running_state state = m_running_state[idx][dst_ridx];
+    if (state.m_num_updates >= RUNNING_AGG_MAX_UPDATES) {
+        return false;
+    }
+
+    ++state.m_num_updates;
+    t_column* dst = info.m_dst[idx];
+    bool weighted = spec.agg() == AGGTYPE_WEIGHTED_MEAN;
+    auto liters = info.m_ctx->get_leaf_iterators(src_ridx);
+
+    // Read the value and weight a strand row removes or adds, returning
+    // false if the row does not contribute. Non-finite values make the
+    // running state unrecoverable, so `finite` is cleared for them.
+    bool finite = true;
+    auto read_row = [&](const std::vector<const t_column*>& cols,
+                        t_uindex ridx,
+                        double& value,
+                        double& weight) {
+        if (!cols[0]->is_valid(ridx)) {
+            return false;
+        }
+
+        value = cols[0]->get_scalar(ridx).to_double();
+        weight = 1;
+
+        if (weighted) {
+            if (!cols[1]->is_valid(ridx)) {
+                return false;
+            }
+
+            weight = cols[1]->get_scalar(ridx).to_double();
+
+            // Weighted mean skips NaN values and weights entirely.
+            if (std::isnan(value) || std::isnan(weight)) {
+                return false;
+            }
+        }
+
+        finite = finite && std::isfinite(value) && std::isfinite(weight);
+        return true;
+    };
+
+    switch (spec.agg()) {
+        case AGGTYPE_MEAN:
+        case AGGTYPE_WEIGHTED_MEAN: {
+            auto* dst_pair = dst->get_nth<std::pair<double, double>>(dst_ridx);
+            double nr = dst_pair->first;
+            double dr = dst_pair->second;
+            double value;
+            double weight;
+
+            if (!std::isfinite(nr) || !std::isfinite(dr)) {
+                return false;
+            }
+
+            for (const auto* lfiter = liters.first; lfiter != liters.second;
+                 ++lfiter) {
+                if (read_row(leave, *lfiter, value, weight)) {
+                    if (state.m_count <= 1) {
+                        return false;
+                    }
+
+                    nr -= weight * value;
+                    dr -= weight;
+                    --state.m_count;
+                }
+
+                if (read_row(enter, *lfiter, value, weight)) {
+                    nr += weight * value;
+                    dr += weight;
+                    ++state.m_count;
+                }
+            }
+
+            if (!finite || state.m_count == 0) {
+                return false;
+            }
+
+            // Keep the mean's denominator an exact count.
+            if (!weighted) {
+                dr = static_cast<double>(state.m_count);
+            }
+
+            old_value.set(dst_pair->first / dst_pair->second);
+            dst_pair->first = nr;
+            dst_pair->second = dr;
+            dst->set_valid(dst_ridx, weighted ? dr != 0 : true);
+            new_value.set(nr / dr);
+        } break;
+        case AGGTYPE_VARIANCE:
+        case AGGTYPE_STANDARD_DEVIATION: {
+            double value;
+            double weight;
+
+            if (!std::isfinite(state.m_mean) || !std::isfinite(state.m_m2)) {
+                return false;
+            }
+
+            // Remove leaving values before adding entering ones, reversing
+            // the Welford update used to seed the state.
+            for (const auto* lfiter = liters.first; lfiter != liters.second;
+                 ++lfiter) {
+                if (!read_row(leave, *lfiter, value, weight)) {
+                    continue;
+                }
+
+                // An emptied node is recomputed rather than carrying the
+                // rounding error of its removed values.
+                if (state.m_count <= 1) {
+                    return false;
+                }
+
+                double count = static_cast<double>(state.m_count);
+                double prev_mean = (count * state.m_mean - value) / (count - 1);
+                state.m_m2 -= (value - prev_mean) * (value - state.m_mean);
+                state.m_mean = prev_mean;
+                --state.m_count;
+
+                // Cancellation has outrun the remaining spread.
+                if (state.m_m2 < 0) {
+                    return false;
+                }
+            }
+
+            for (const auto* lfiter = liters.first; lfiter != liters.second;
+                 ++lfiter) {
+                if (!read_row(enter, *lfiter, value, weight)) {
+                    continue;
+                }
+
+                ++state.m_count;
+                double count = static_cast<double>(state.m_count);
+                double next_mean = state.m_mean + (value - state.m_mean) / count;
+                state.m_m2 += (value - state.m_mean) * (value - next_mean);
+                state.m_mean = next_mean;
+            }
+
+            if (!finite) {
+                return false;
+            }
+
+            old_value.set(dst->get_scalar(dst_ridx));
+
+            if (state.m_count >= 2) {
+                double result = state.m_m2 / static_cast<double>(state.m_count);
+
+                if (spec.agg() == AGGTYPE_STANDARD_DEVIATION) {
+                    result = std::sqrt(result);
+                }
+
+                new_value.set(result);
+                dst->set_scalar(dst_ridx, new_value);
+                dst->set_valid(dst_ridx, true);
+            } else {
+                dst->set_valid(dst_ridx, false);
+            }
+        } break;
+        default: {
+            return false;
+        }
+    }
+
+    m_running_state[idx][dst_ridx] = state;
+    return true;
+}
+
+t_tscalar
+t_stree::order_index_key(const t_tscalar& value) {
+    // Invalid values compare equal regardless of the stale data beneath them,
+    // and strings are interned so the index never outlives its keys.
+    if (!value.is_valid()) {
+        t_tscalar key = value;
+        if (key.is_str()) {
+            key.set("");
+        } else {
+            key.m_data.m_uint64 = 0;
+        }
+
+        key.m_status = STATUS_INVALID;
+        return key;
+    }
+
+    return m_symtable.get_interned_tscalar(value);
+}
+
+const t_order_index*
+t_stree::update_order_index(
+    t_uindex nidx,
+    const t_agg_update_info& info,
+    t_uindex idx,
+    t_uindex src_ridx,
+    t_uindex dst_ridx,
+    const t_gstate& gstate,
+    const t_data_table& expression_master_table
+) {
+    const t_aggspec& spec = info.m_aggspecs[idx];
+    if (!spec.has_order_index() || idx >= m_order_indices.size()) {
+        return nullptr;
+    }
+
+    auto& indices = m_order_indices[idx];
+    if (dst_ridx >= indices.size()) {
+        indices.resize(std::max(dst_ridx + 1, m_aggregates->size()));
+    }
+
+    std::unique_ptr<t_order_index>& index = indices[dst_ridx];
+    const std::string& colname = spec.get_dependencies()[0].name();
+    const auto& leave = info.m_leave[idx];
+    const auto& enter = info.m_enter[idx];
+
+    bool rebuild = index == nullptr || leave.empty()
+        || info.m_leave_flags == nullptr || info.m_ctx == nullptr
+        || m_newids.find(nidx) != m_newids.end()
+        || expression_master_table.get_schema().has_column(colname);
+
+    if (!rebuild) {
+        auto liters = info.m_ctx->get_leaf_iterators(src_ridx);
+        for (const auto* lfiter = liters.first; lfiter != liters.second;
+             ++lfiter) {
+            t_uindex ridx = *lfiter;
+            if (*(info.m_leave_flags->get_nth<bool>(ridx))
+                && !index->erase(order_index_key(leave[0]->get_scalar(ridx)))) {
+                // The index has drifted from the gnode state - rebuild it.
+                rebuild = true;
+                break;
+            }
+
+            if (*(info.m_enter_flags->get_nth<bool>(ridx))) {
+                index->insert(order_index_key(enter[0]->get_scalar(ridx)));
+            }
+        }
+    }
+
+    if (rebuild) {
+        if (index == nullptr) {
+            index = std::make_unique<t_order_index>();
+        } else {
+            index->clear();
+        }
+
+        auto pkeys = get_pkeys(nidx);
+        std::vector<t_tscalar> values;
+        read_column_from_gstate(
+            gstate, expression_master_table, colname, pkeys, values
+        );
+
+        for (const auto& value : values) {
+            index->insert(order_index_key(value));
+        }
+    }
+
+    return index.get();
+}
+
+void
+t_stree::seed_agg_running(
+    t_uindex idx, t_uindex dst_ridx, t_uindex count, double mean, double m2
+) {
+    if (idx >= m_running_state.size()
+        || dst_ridx >= m_running_state[idx].size()) {
+        return;
+    }
+
+    t_agg_running_state& state = m_running_state[idx][dst_ridx];
+    state.m_count = count;
+    state.m_mean = mean;
+    state.m_m2 = m2;
+    state.m_num_updates = 0;
+    state.m_seeded = true;
+}
+
 std::vector<t_uindex>
 t_stree::zero_strands() const {
     auto iterators = m_nodes->get<by_nstrands>().equal_range(0);
@@ -1994,6 +2604,22 @@ t_stree::clear_aggregates(const std::vector<t_uindex>& indices) {
         }
     }
 
+    for (auto& states : m_running_state) {
+        for (auto aggidx : indices) {
+            if (aggidx < states.size()) {
+                states[aggidx].m_seeded = false;
+            }
+        }
+    }
+
+    for (auto& order_indices : m_order_indices) {
+        for (auto aggidx : indices) {
+            if (aggidx < order_indices.size()) {
+                order_indices[aggidx].reset();
+            }
+        }
+    }
+
     m_agg_freelist.insert(
         std::end(m_agg_freelist), std::begin(indices), std::end(indices)
     );
@@ -2325,6 +2951,23 @@ t_stree::get_aggregate(t_index idx, t_index aggnum) const {
     return extract_aggregate(m_aggspecs[aggnum], c, agg_ridx, agg_pridx);
 }
 
+t_tscalar
+t_stree::get_aggregate_median(const t_order_index& index) const {
+    t_uindex size = index.size();
+    if (size == 0) {
+        return {};
+    }
+
+    // The middle value, preceded by its lower neighbour for even sizes, so
+    // the vector overload averages them exactly as it would the full set.
+    std::vector<t_tscalar> middle{index.nth(size / 2)};
+    if (size % 2 == 0) {
+        middle.insert(middle.begin(), index.nth((size / 2) - 1));
+    }
+
+    return get_aggregate_median(middle);
+}
+
 t_tscalar
 t_stree::get_aggregate_median(std::vector<t_tscalar>& values) const {
     int size = values.size();
@@ -2340,9 +2983,11 @@ t_stree::get_aggregate_median(std::vector<t_tscalar>& values) const {
         t_tscalar median_average;
         auto middle = values.begin() + (size / 2);
         nth_element(values.begin(), middle, values.end());
-        median_average.set(
-            (*middle + *(middle - 1)) / static_cast<t_tscalar>(2)
-        );
+
+        // `nth_element` only partitions the values below `middle`, so the
+        // lower middle value is the largest of them, not `*(middle - 1)`.
+        auto lower = std::max_element(values.begin(), middle);
+        median_average.set((*middle + *lower) / static_cast<t_tscalar>(2));
         return median_average;
     }
     auto middle = values.begin() + (size / 2);
@@ -2373,6 +3018,8 @@ t_stree::clear_deltas() {
 void
 t_stree::clear() {
     m_nodes->clear();
+    m_running_state.clear();
+    m_order_indices.clear();
     clear_deltas();
 }
 
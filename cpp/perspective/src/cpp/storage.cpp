@@ -13,6 +13,7 @@
 #include <perspective/first.h>
 #include <perspective/portable.h>
 SUPPRESS_WARNINGS_VC(4505)
+#include <array>
 #include <cstdlib>
 #include <cassert>
 #include <csignal>
@@ -31,6 +32,8 @@ SUPPRESS_WARNINGS_VC(4505)
 #include <utility>
 #include <vector>
 #include <fstream>
+#include <functional>
+#include <mutex>
 #ifndef WIN32
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -259,7 +262,7 @@ t_lstore::~t_lstore() {
                 _aligned_free(m_base); // seriously
             } else
 #endif // _MSC_VER
-            {
+            if (!is_borrowed()) {
                 free(m_base);
             }
 
@@ -282,6 +285,86 @@ t_lstore::set_size(t_uindex idx) // in bytes
     PSP_VERBOSE_ASSERT(m_size <= m_capacity, "Setting bad size");
 #endif
     m_size = idx;
+
+    // Don't keep a borrowed buffer alive for an emptied store.
+    if (idx == 0 && has_owner()) {
+        detach();
+    }
+}
+
+bool
+t_lstore::borrow(
+    std::shared_ptr<const void> owner, const void* base, t_uindex size
+) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    if (m_backing_store != BACKING_STORE_MEMORY || m_alignment >= 2
+        || owner == nullptr) {
+        return false;
+    }
+
+    t_unlock_store tmp(this);
+    if (!is_borrowed()) {
+        free(m_base);
+    }
+
+    m_base = const_cast<void*>(base);
+    m_borrowed = std::move(owner);
+    m_unborrowed.store(false, std::memory_order_release);
+    m_size = size;
+    m_capacity = size;
+    ++m_version;
+    return true;
+}
+
+bool
+t_lstore::borrow(const t_lstore& other) {
+    if (!other.is_borrowed()) {
+        return false;
+    }
+
+    return borrow(other.m_borrowed, other.m_base, other.m_size);
+}
+
+// Copy-on-write may be triggered by reads on several threads at once, so
+// it is serialized per store by one of a fixed set of locks.
+static std::mutex&
+get_unborrow_lock(const t_lstore* store) {
+    static std::array<std::mutex, 64> locks;
+    return locks[std::hash<const t_lstore*>{}(store) % locks.size()];
+}
+
+void
+t_lstore::unborrow() {
+    PSP_TRACE_SENTINEL();
+    std::lock_guard<std::mutex> lock(get_unborrow_lock(this));
+    if (!is_borrowed()) {
+        return;
+    }
+
+    t_uindex capacity = std::max(m_size, static_cast<t_uindex>(8));
+    void* base = calloc(size_t(capacity), 1);
+    PSP_VERBOSE_ASSERT(base, "MALLOC_FAILED");
+    memcpy(base, m_base, size_t(m_size));
+
+    // `m_borrowed` stays alive for readers of the old memory, whose bytes
+    // are identical to the copy.
+    t_unlock_store tmp(this);
+    m_base = base;
+    m_capacity = capacity;
+    ++m_version;
+    m_unborrowed.store(true, std::memory_order_release);
+}
+
+void
+t_lstore::detach() {
+    PSP_TRACE_SENTINEL();
+    if (is_borrowed()) {
+        unborrow();
+    }
+
+    m_borrowed = nullptr;
+    m_unborrowed.store(false, std::memory_order_release);
 }
 
 void
@@ -360,6 +443,10 @@ void
 t_lstore::reserve_impl(t_uindex capacity, bool allow_shrink) {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     if ((capacity < m_capacity) && !allow_shrink) {
         return;
     }
@@ -517,6 +604,10 @@ t_lstore::get_fname() const {
 void
 t_lstore::push_back(const void* ptr, t_uindex len) {
     PSP_TRACE_SENTINEL();
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     if (m_size + len >= m_capacity) {
         reserve(static_cast<t_uindex>(m_size + len)
         ); // reserve() will multiply by m_resize_factor internally
@@ -535,6 +626,10 @@ t_lstore::push_back(const void* ptr, t_uindex len) {
 
 void*
 t_lstore::get_ptr(t_uindex offset) {
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     return static_cast<void*>(static_cast<unsigned char*>(m_base) + offset);
 }
 
@@ -561,6 +656,12 @@ void
 t_lstore::append(const t_lstore& other) {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    // Appending borrowed memory to an empty store shares it instead.
+    if (m_size == 0 && borrow(other)) {
+        return;
+    }
+
     push_back(other.m_base, other.size());
 }
 
@@ -568,6 +669,10 @@ void
 t_lstore::clear() {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    if (has_owner()) {
+        set_size(0);
+    }
+
 #ifndef PSP_ENABLE_WASM
     memset(m_base, 0, size_t(capacity()));
 #endif
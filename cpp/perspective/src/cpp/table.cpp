@@ -14,11 +14,15 @@
 #include "perspective/base.h"
 #include "perspective/column.h"
 #include "perspective/data_table.h"
+#include "perspective/parallel_for.h"
 #include "perspective/raw_types.h"
 #include "perspective/schema.h"
 #include "rapidjson/document.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
 #include <chrono>
 #include <ctime>
+#include <map>
 #include <memory>
 #include <optional>
 #include <perspective/table.h>
@@ -26,6 +30,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -785,6 +790,726 @@ fill_column_json(
     }
 }
 
+// Rows read by `from_rows` and `from_ndjson` to infer a table's schema.
+static const t_uindex JSON_SCHEMA_INFERENCE_ROWS = 1000;
+
+// Bytes of NDJSON read per `parallel_for` task by `update_ndjson`.
+static const t_uindex NDJSON_BYTES_PER_TASK = 1 << 20;
+
+/**
+ * @brief A rapidjson SAX handler which streams the rows of a JSON document
+ * to `SINK` as they are parsed, without building a `rapidjson::Document`.
+ * Rows are the objects at `row_depth` - 2 for an array of rows, 1 for
+ * NDJSON - and each of their scalar members is handed to the sink as a
+ * standalone `rapidjson::Value`, so that it is coerced exactly as a value
+ * from a parsed document would be.
+ *
+ * `SINK` implements `begin_row()`, `set_column(name)`, `set_cell(value)`,
+ * `skips_column()` and `end_row()`, the last of which returns `false` to
+ * stop parsing.
+ */
+template <typename SINK>
+class t_json_row_reader
+    : public rapidjson::
+          BaseReaderHandler<rapidjson::UTF8<>, t_json_row_reader<SINK>> {
+public:
+    t_json_row_reader(SINK& sink, t_uindex row_depth) :
+        m_sink(sink),
+        m_row_depth(row_depth),
+        m_depth(0),
+        m_skip_depth(0) {}
+
+    bool
+    Null() {
+        return scalar(rapidjson::Value());
+    }
+
+    bool
+    Bool(bool b) {
+        return scalar(rapidjson::Value(b));
+    }
+
+    bool
+    Int(int i) {
+        return scalar(rapidjson::Value(i));
+    }
+
+    bool
+    Uint(unsigned u) {
+        return scalar(rapidjson::Value(u));
+    }
+
+    bool
+    Int64(std::int64_t i) {
+        return scalar(rapidjson::Value(i));
+    }
+
+    bool
+    Uint64(std::uint64_t u) {
+        return scalar(rapidjson::Value(u));
+    }
+
+    bool
+    Double(double d) {
+        return scalar(rapidjson::Value(d));
+    }
+
+    bool
+    String(const char* str, rapidjson::SizeType length, bool /* copy */) {
+        return scalar(rapidjson::Value(rapidjson::StringRef(str, length)));
+    }
+
+    bool
+    Key(const char* str, rapidjson::SizeType length, bool /* copy */) {
+        if (m_skip_depth == 0) {
+            m_sink.set_column(std::string_view(str, length));
+        }
+
+        return true;
+    }
+
+    bool
+    StartObject() {
+        if (m_skip_depth > 0) {
+            ++m_skip_depth;
+            return true;
+        }
+
+        if (m_depth + 1 == m_row_depth) {
+            ++m_depth;
+            m_sink.begin_row();
+            return true;
+        }
+
+        return start_nested();
+    }
+
+    bool
+    EndObject(rapidjson::SizeType /* member_count */) {
+        if (m_skip_depth > 0) {
+            --m_skip_depth;
+            return true;
+        }
+
+        --m_depth;
+        return m_sink.end_row();
+    }
+
+    bool
+    StartArray() {
+        if (m_skip_depth > 0) {
+            ++m_skip_depth;
+            return true;
+        }
+
+        if (m_depth + 1 < m_row_depth) {
+            ++m_depth;
+            return true;
+        }
+
+        return start_nested();
+    }
+
+    bool
+    EndArray(rapidjson::SizeType /* element_count */) {
+        if (m_skip_depth > 0) {
+            --m_skip_depth;
+        } else {
+            --m_depth;
+        }
+
+        return true;
+    }
+
+private:
+    bool
+    scalar(const rapidjson::Value& value) {
+        if (m_skip_depth > 0) {
+            return true;
+        }
+
+        if (m_depth != m_row_depth) {
+            PSP_COMPLAIN_AND_ABORT(
+                "Cannot determine data types without column names!\n"
+            );
+        }
+
+        m_sink.set_cell(value);
+        return true;
+    }
+
+    // An object or array where a row, or a row's value, should be - values
+    // for columns the sink ignores are skipped, and anything else is an
+    // error.
+    bool
+    start_nested() {
+        if (m_depth != m_row_depth) {
+            PSP_COMPLAIN_AND_ABORT(
+                "Cannot determine data types without column names!\n"
+            );
+        }
+
+        if (!m_sink.skips_column()) {
+            PSP_COMPLAIN_AND_ABORT("Cannot coerce nested JSON value");
+        }
+
+        m_skip_depth = 1;
+        return true;
+    }
+
+    SINK& m_sink;
+    t_uindex m_row_depth;
+    t_uindex m_depth;
+    t_uindex m_skip_depth;
+};
+
+/**
+ * @brief Stream the NDJSON rows in `stream` to `sink`, a document at a time
+ * until the input ends or the sink stops reading. Returns `false` if a
+ * document fails to parse, leaving the rows before it in `sink`.
+ */
+template <typename SINK, typename STREAM>
+static bool
+try_read_ndjson_rows(STREAM& stream, SINK& sink) {
+    t_json_row_reader<SINK> handler(sink, 1);
+    rapidjson::Reader reader;
+    while (true) {
+        rapidjson::SkipWhitespace(stream);
+        if (stream.Peek() == '\0') {
+            return true;
+        }
+
+        reader.Parse<rapidjson::kParseStopWhenDoneFlag>(stream, handler);
+        auto error = reader.GetParseErrorCode();
+        if (error == rapidjson::kParseErrorTermination) {
+            return true;
+        }
+
+        if (error != rapidjson::kParseErrorNone) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Stream the rows in `stream` to `sink`, where `stream` holds either
+ * a JSON array of rows or NDJSON, until the input ends or the sink stops
+ * reading. Input which fails to parse is an error.
+ */
+template <typename SINK, typename STREAM>
+static void
+read_json_rows(STREAM& stream, bool is_ndjson, SINK& sink) {
+    if (is_ndjson) {
+        if (!try_read_ndjson_rows(stream, sink)) {
+            std::stringstream ss;
+            ss << "Could not parse NDJSON at byte " << stream.Tell();
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+
+        return;
+    }
+
+    t_json_row_reader<SINK> handler(sink, 2);
+    rapidjson::Reader reader;
+    reader.Parse(stream, handler);
+    auto error = reader.GetParseErrorCode();
+    if (error != rapidjson::kParseErrorNone
+        && error != rapidjson::kParseErrorTermination) {
+        PSP_COMPLAIN_AND_ABORT("Could not parse JSON rows");
+    }
+}
+
+/**
+ * @brief Finds the state for each column name a sink reads. Rows usually
+ * repeat their keys in the same order, so the slot after the last one
+ * found is tried before the names are searched.
+ */
+template <typename SLOT_T>
+class t_json_column_cache {
+public:
+    t_json_column_cache() : m_next(0) {}
+
+    template <typename F>
+    SLOT_T&
+    get(std::string_view name, F make_slot) {
+        if (m_next < m_slots.size() && m_names[m_next] == name) {
+            return m_slots[m_next++];
+        }
+
+        auto iter = m_slot_idx.find(name);
+        t_uindex idx;
+        if (iter == m_slot_idx.end()) {
+            idx = m_slots.size();
+            m_names.emplace_back(name);
+            m_slots.push_back(make_slot(m_names.back()));
+            m_slot_idx.emplace(m_names.back(), idx);
+        } else {
+            idx = iter->second;
+        }
+
+        m_next = idx + 1;
+        return m_slots[idx];
+    }
+
+private:
+    std::vector<std::string> m_names;
+    std::vector<SLOT_T> m_slots;
+    std::map<std::string, t_uindex, std::less<>> m_slot_idx;
+    t_uindex m_next;
+};
+
+/**
+ * @brief Grow `table` to fit row `row`; rows streamed from JSON are written
+ * before the number of rows is known.
+ */
+static void
+reserve_json_row(t_data_table& table, t_uindex row) {
+    if (row >= table.get_capacity()) {
+        table.reserve(std::max<t_uindex>(2 * row, DEFAULT_CAPACITY));
+    }
+}
+
+/**
+ * @brief Infers a schema from the first `max_rows` rows of JSON. A column's
+ * type is that of its first non-null value, and columns which are only
+ * ever null in those rows are typed as strings and reported by
+ * `get_untyped_columns`, so that a later value can retype them.
+ */
+class t_json_schema_sink {
+public:
+    t_json_schema_sink(const std::string& index, t_uindex max_rows) :
+        m_index(index),
+        m_max_rows(max_rows),
+        m_num_rows(0),
+        m_is_implicit(true),
+        m_is_done(false) {}
+
+    void
+    begin_row() {
+        m_row.clear();
+    }
+
+    void
+    set_column(std::string_view name) {
+        m_row.emplace_back(name, DTYPE_NONE);
+    }
+
+    void
+    set_cell(const rapidjson::Value& value) {
+        m_row.back().second = rapidjson_type_to_dtype(value);
+    }
+
+    bool
+    skips_column() const {
+        return false;
+    }
+
+    bool
+    end_row() {
+        for (const auto& [name, _] : m_row) {
+            m_columns_seen.insert(name);
+        }
+
+        for (const auto& [name, dtype] : m_row) {
+            if (name == m_index) {
+                m_is_implicit = false;
+            }
+
+            if (m_columns_known_type.count(name) > 0) {
+                continue;
+            }
+
+            if (dtype != DTYPE_NONE) {
+                m_columns_known_type.insert(name);
+                m_data_types.push_back(dtype);
+                m_column_names.push_back(name);
+            }
+
+            // Theoretically there can end too early if the first
+            // few rows are missing columns that are present in later rows.
+            if (m_columns_known_type.size() == m_columns_seen.size()) {
+                m_is_done = true;
+                return false;
+            }
+        }
+
+        return ++m_num_rows < m_max_rows;
+    }
+
+    t_schema
+    get_schema() {
+        if (!m_is_done) {
+            for (const auto& col : m_columns_seen) {
+                if (m_columns_known_type.count(col) == 0) {
+                    // Default all null columns to string
+                    m_data_types.push_back(DTYPE_STR);
+                    m_column_names.emplace_back(col);
+                    m_untyped_columns.insert(col);
+                }
+            }
+
+            m_is_done = true;
+        }
+
+        return {m_column_names, m_data_types};
+    }
+
+    bool
+    is_implicit() const {
+        return m_is_implicit;
+    }
+
+    const std::set<std::string>&
+    get_untyped_columns() const {
+        return m_untyped_columns;
+    }
+
+private:
+    const std::string& m_index;
+    t_uindex m_max_rows;
+    t_uindex m_num_rows;
+    bool m_is_implicit;
+    bool m_is_done;
+    std::vector<std::pair<std::string, t_dtype>> m_row;
+    std::vector<std::string> m_column_names;
+    std::vector<t_dtype> m_data_types;
+    std::set<std::string> m_columns_known_type;
+    std::set<std::string> m_columns_seen;
+    std::set<std::string> m_untyped_columns;
+};
+
+/**
+ * @brief Writes JSON rows into a new table, promoting a column's type when
+ * a value does not fit it. A column in `untyped_columns` has only held nulls
+ * so far, so it takes the type of its first value instead. Columns missing
+ * from `table`'s schema, because they were not in the rows it was inferred
+ * from, are an error.
+ */
+class t_json_insert_sink {
+public:
+    t_json_insert_sink(
+        t_data_table& table,
+        const std::string& index,
+        bool is_implicit,
+        std::uint32_t limit,
+        const std::set<std::string>& untyped_columns
+    ) :
+        m_table(table),
+        m_index(index),
+        m_is_implicit(is_implicit),
+        m_limit(limit),
+        m_untyped_columns(untyped_columns),
+        m_pkey(table.get_column("psp_pkey")),
+        m_okey(table.get_column("psp_okey")),
+        m_num_rows(0),
+        m_slot(nullptr) {}
+
+    void
+    begin_row() {
+        reserve_json_row(m_table, m_num_rows);
+    }
+
+    void
+    set_column(std::string_view name) {
+        m_slot = &m_columns.get(name, [&](const std::string& key) {
+            auto column = m_table.get_column_safe(key);
+            if (column == nullptr) {
+                std::stringstream ss;
+                ss << "Column `" << key << "` first appears in row "
+                   << m_num_rows << ", after the rows the schema was "
+                   << "inferred from; provide a schema instead" << std::endl;
+                PSP_COMPLAIN_AND_ABORT(ss.str());
+            }
+
+            return t_slot{
+                key,
+                column,
+                !m_is_implicit && key == m_index,
+                m_untyped_columns.count(key) > 0
+            };
+        });
+    }
+
+    void
+    set_cell(const rapidjson::Value& value) {
+        const auto& col_name = m_slot->m_name;
+        if (m_slot->m_is_untyped && !value.IsNull()) {
+            // Every row so far was null, so the column can be replaced with
+            // one of this value's type rather than promoted.
+            m_slot->m_is_untyped = false;
+            auto dtype = rapidjson_type_to_dtype(value);
+            if (dtype != DTYPE_NONE && dtype != DTYPE_STR) {
+                m_table.promote_column(col_name, dtype, 0, false);
+                m_slot->m_column = m_table.get_column(col_name);
+                for (t_uindex ridx = 0; ridx < m_num_rows; ++ridx) {
+                    m_slot->m_column->clear(ridx);
+                }
+            }
+        }
+
+        auto promote =
+            fill_column_json(m_slot->m_column, m_num_rows, value, false);
+        if (promote) {
+            LOG_DEBUG(
+                "Promoting column "
+                << col_name << " from "
+                << dtype_to_str(m_slot->m_column->get_dtype()) << " to "
+                << dtype_to_str(*promote)
+            );
+
+            m_table.promote_column(col_name, *promote, m_num_rows, true);
+            m_slot->m_column = m_table.get_column(col_name);
+            fill_column_json(m_slot->m_column, m_num_rows, value, false);
+        }
+
+        if (m_slot->m_is_index) {
+            fill_column_json(m_pkey, m_num_rows, value, false);
+            fill_column_json(m_okey, m_num_rows, value, false);
+        }
+    }
+
+    bool
+    skips_column() const {
+        return false;
+    }
+
+    bool
+    end_row() {
+        if (m_is_implicit) {
+            m_pkey->set_nth<std::int32_t>(m_num_rows, m_num_rows % m_limit);
+            m_okey->set_nth<std::int32_t>(m_num_rows, m_num_rows % m_limit);
+        }
+
+        ++m_num_rows;
+        return true;
+    }
+
+    t_uindex
+    get_num_rows() const {
+        return m_num_rows;
+    }
+
+private:
+    struct t_slot {
+        std::string m_name;
+        std::shared_ptr<t_column> m_column;
+        bool m_is_index;
+        bool m_is_untyped;
+    };
+
+    t_data_table& m_table;
+    const std::string& m_index;
+    bool m_is_implicit;
+    std::uint32_t m_limit;
+    const std::set<std::string>& m_untyped_columns;
+    std::shared_ptr<t_column> m_pkey;
+    std::shared_ptr<t_column> m_okey;
+    t_uindex m_num_rows;
+    t_json_column_cache<t_slot> m_columns;
+    t_slot* m_slot;
+};
+
+/**
+ * @brief Writes JSON rows into an update for an existing table, whose
+ * schema (plus `psp_pkey`) is `table`'s. Columns the table does not have
+ * are ignored, and values which do not fit their column are an error.
+ *
+ * Rows are written from `row_offset`, which places an implicit index for
+ * a batch read in parts. Columns missing from the batch's first row are
+ * collected, for `unset_json_overflow_rows` to unset.
+ */
+class t_json_update_sink {
+public:
+    t_json_update_sink(
+        t_data_table& table,
+        const std::string& index,
+        const std::vector<std::string>& column_names,
+        t_uindex offset,
+        t_uindex limit,
+        t_uindex row_offset
+    ) :
+        m_table(table),
+        m_schema(table.get_schema()),
+        m_index(index),
+        m_is_implicit(index.empty()),
+        m_offset(offset),
+        m_limit(limit),
+        m_row_offset(row_offset),
+        m_pkey(table.get_column("psp_pkey")),
+        m_num_rows(0),
+        m_missing_columns(column_names),
+        m_slot(nullptr) {}
+
+    void
+    begin_row() {
+        reserve_json_row(m_table, m_num_rows);
+        if (m_is_implicit) {
+            m_pkey->set_nth<std::uint32_t>(
+                m_num_rows, (m_row_offset + m_num_rows + m_offset) % m_limit
+            );
+        }
+    }
+
+    void
+    set_column(std::string_view name) {
+        m_slot = &m_columns.get(name, [&](const std::string& key) {
+            std::string_view col_name = key;
+            if (col_name == "__INDEX__") {
+                col_name = "psp_pkey";
+            }
+
+            if (!m_schema.has_column(col_name)) {
+                LOG_DEBUG("Ignoring column " << col_name);
+                LOG_DEBUG("Schema:\n" << m_schema);
+                return t_slot{nullptr, false};
+            }
+
+            return t_slot{
+                m_table.get_column(col_name), !m_is_implicit && key == m_index
+            };
+        });
+
+        if (m_num_rows == 0 && m_slot->m_column != nullptr) {
+            std::string_view col_name = name;
+            if (col_name == "__INDEX__") {
+                col_name = "psp_pkey";
+            }
+
+            m_missing_columns.erase(
+                std::remove(
+                    m_missing_columns.begin(), m_missing_columns.end(), col_name
+                ),
+                m_missing_columns.end()
+            );
+        }
+    }
+
+    void
+    set_cell(const rapidjson::Value& value) {
+        const auto& col = m_slot->m_column;
+        if (col == nullptr) {
+            return;
+        }
+
+        auto promote = fill_column_json(col, m_num_rows, value, true);
+        if (promote) {
+            std::stringstream ss;
+            ss << "Cannot append value of type " << dtype_to_str(*promote)
+               << " to column of type " << dtype_to_str(col->get_dtype())
+               << std::endl;
+            PSP_COMPLAIN_AND_ABORT(ss.str());
+        }
+
+        if (m_slot->m_is_index) {
+            fill_column_json(m_pkey, m_num_rows, value, true);
+        }
+    }
+
+    bool
+    skips_column() const {
+        return m_slot->m_column == nullptr;
+    }
+
+    bool
+    end_row() {
+        ++m_num_rows;
+        return true;
+    }
+
+    t_uindex
+    get_num_rows() const {
+        return m_num_rows;
+    }
+
+    const std::vector<std::string>&
+    get_missing_columns() const {
+        return m_missing_columns;
+    }
+
+private:
+    struct t_slot {
+        std::shared_ptr<t_column> m_column;
+        bool m_is_index;
+    };
+
+    t_data_table& m_table;
+    t_schema m_schema;
+    const std::string& m_index;
+    bool m_is_implicit;
+    t_uindex m_offset;
+    t_uindex m_limit;
+    t_uindex m_row_offset;
+    std::shared_ptr<t_column> m_pkey;
+    t_uindex m_num_rows;
+    std::vector<std::string> m_missing_columns;
+    t_json_column_cache<t_slot> m_columns;
+    t_slot* m_slot;
+};
+
+/**
+ * @brief An update which runs past the table's `limit` wraps around onto
+ * existing rows, so columns missing from the update's first row are unset
+ * on those rows rather than left holding the old values.
+ */
+static void
+unset_json_overflow_rows(
+    t_data_table& table,
+    const std::vector<std::string>& missing_columns,
+    t_uindex offset,
+    t_uindex limit
+) {
+    t_uindex first_row = limit > offset ? limit - offset : 0;
+    for (const auto& col_name : missing_columns) {
+        auto col = table.get_column(col_name);
+        for (t_uindex ii = first_row; ii < table.size(); ++ii) {
+            col->unset(ii);
+        }
+    }
+}
+
+/**
+ * @brief The number of rows in `data` if it is well-formed NDJSON, i.e. its
+ * number of lines which are not blank.
+ */
+static t_uindex
+count_ndjson_rows(std::string_view data) {
+    t_uindex num_rows = 0;
+    bool is_blank = true;
+    for (char c : data) {
+        if (c == '\n') {
+            num_rows += is_blank ? 0 : 1;
+            is_blank = true;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            is_blank = false;
+        }
+    }
+
+    return num_rows + (is_blank ? 0 : 1);
+}
+
+/**
+ * @brief Split `data` into at most `num_parts` parts of about equal size,
+ * each ending on a line boundary.
+ */
+static std::vector<std::string_view>
+split_ndjson(std::string_view data, t_uindex num_parts) {
+    std::vector<std::string_view> parts;
+    t_uindex begin = 0;
+    for (t_uindex part = 1; part <= num_parts && begin < data.size(); ++part) {
+        t_uindex end = data.size();
+        if (part < num_parts) {
+            t_uindex target = data.size() * part / num_parts;
+            end = data.find('\n', std::max(begin, target));
+            end = end == std::string_view::npos ? data.size() : end + 1;
+        }
+
+        parts.push_back(data.substr(begin, end - begin));
+        begin = end;
+    }
+
+    return parts;
+}
+
 void
 Table::remove_rows(const std::string_view& data) {
     // 1.) Infer schema
@@ -1116,28 +1841,12 @@ Table::from_cols(
 
 void
 Table::update_rows(const std::string_view& data, std::uint32_t port_id) {
-    // 1.) Infer schema
-    rapidjson::Document document;
-    document.Parse(data.data());
-    if (document.Size() == 0) {
-        return;
-    }
-
-    if (!document[0].IsObject()) {
-        // TODO Legacy error message
-        PSP_COMPLAIN_AND_ABORT(
-            "Cannot determine data types without column names!\n"
-        )
-    }
-
     bool is_implicit = m_index.empty();
     t_schema table_schema = get_schema();
 
-    // 2.) Create table
-    t_uindex size = document.Size();
+    // 1.) Create table
     t_data_table data_table(table_schema);
     data_table.init();
-    data_table.extend(size);
     if (is_implicit) {
         data_table.add_column("psp_pkey", DTYPE_INT32, true);
     } else {
@@ -1146,79 +1855,23 @@ Table::update_rows(const std::string_view& data, std::uint32_t port_id) {
         );
     }
 
-    t_uindex ii = 0;
-    const auto& psp_pkey_col = data_table.get_column("psp_pkey");
-    auto schema = data_table.get_schema();
-    // t_uindex col_count;
-    // bool supports_partial =
-    //     m_limit == std::numeric_limits<int>::max() && !m_index.empty();
-    bool is_first_row = true;
-    std::vector<std::string> missing_columns = m_column_names;
-
-    // 3.) Fill table
-    for (const auto& row : document.GetArray()) {
-        if (is_implicit) {
-            psp_pkey_col->set_nth<std::uint32_t>(ii, (ii + m_offset) % m_limit);
-        }
-
-        // col_count = m_column_names.size();
-        for (const auto& it : row.GetObj()) {
-            std::shared_ptr<t_column> col;
-            std::string_view col_name = it.name.GetString();
-            if (std::string_view{it.name.GetString()} == "__INDEX__") {
-                col_name = "psp_pkey";
-            }
-
-            if (!schema.has_column(col_name)) {
-                LOG_DEBUG("Ignoring column " << col_name);
-                LOG_DEBUG("Schema:\n" << schema);
-                continue;
-            }
-
-            if (is_first_row) {
-                missing_columns.erase(
-                    std ::remove(
-                        missing_columns.begin(), missing_columns.end(), col_name
-                    ),
-                    missing_columns.end()
-                );
-            }
-
-            col = data_table.get_column(col_name);
-            auto promote = fill_column_json(col, ii, it.value, true);
-            if (promote) {
-                std::stringstream ss;
-                ss << "Cannot append value of type " << dtype_to_str(*promote)
-                   << " to column of type " << dtype_to_str(col->get_dtype())
-                   << std::endl;
-                PSP_COMPLAIN_AND_ABORT(ss.str());
-            }
-
-            if (!is_implicit && m_index == it.name.GetString()) {
-                fill_column_json(psp_pkey_col, ii, it.value, true);
-            }
-        }
-
-        // // Check if this row "overflows", wrapping around due to a `m_limit`
-        // // value, as partial updates are not allowed in this case.
-        // if (!supports_partial && col_count != 0) {
-        //     std::cout << col_count << std::endl;
-        //     PSP_COMPLAIN_AND_ABORT(
-        //         "Inconsistent row count in update - `Table` partial updates "
-        //         "require an `index`"
-        //     );
-        // }
-
-        is_first_row = false;
-        if (ii + m_offset >= m_limit) {
-            for (auto& col_name : missing_columns) {
-                data_table.get_column(col_name)->unset(ii);
-            }
-        }
+    // 2.) Fill table, writing each row as it is parsed
+    t_json_update_sink sink(
+        data_table, m_index, m_column_names, m_offset, m_limit, 0
+    );
 
-        ii++;
+    rapidjson::StringStream s(data.data());
+    read_json_rows(s, false, sink);
+    t_uindex size = sink.get_num_rows();
+    if (size == 0) {
+        return;
     }
 
+    data_table.extend(size);
+    unset_json_overflow_rows(
+        data_table, sink.get_missing_columns(), m_offset, m_limit
+    );
+
     data_table.clone_column("psp_pkey", "psp_okey");
     process_op_column(data_table, t_op::OP_INSERT);
     calculate_offset(size);
@@ -1229,74 +1882,19 @@ std::shared_ptr<Table>
 Table::from_rows(
     const std::string& index, std::string&& data, std::uint32_t limit
 ) {
-    // 1.) Infer schema
-    rapidjson::Document document;
-    document.Parse(data.data());
-    // if (document.Size() == 0) {
-    //     PSP_COMPLAIN_AND_ABORT("Can't create table from empty rows")
-    // }
-
-    if (document.Size() > 0 && !document[0].IsObject()) {
-        LOG_DEBUG("Received non-object " << document[0].GetType());
-        // TODO Legacy error message
-        PSP_COMPLAIN_AND_ABORT(
-            "Cannot determine data types without column names!\n"
-        )
-    }
-
-    std::vector<std::string> column_names;
-    std::vector<t_dtype> data_types;
-    bool is_implicit = true;
-    std::set<std::string> columns_known_type;
-    std::set<std::string> columns_seen;
-
-    [&]() {
-        for (const auto& row : document.GetArray()) {
-            for (const auto& col : row.GetObj()) {
-                columns_seen.insert(col.name.GetString());
-            }
-
-            // https://github.com/Tencent/rapidjson/issues/1994
-            for (const auto& col : row.GetObj()) {
-                if (col.name.GetString() == index) {
-                    is_implicit = false;
-                }
-
-                if (columns_known_type.count(col.name.GetString()) > 0) {
-                    continue;
-                }
-
-                auto dtype = rapidjson_type_to_dtype(col.value);
-                if (dtype != DTYPE_NONE) {
-                    columns_known_type.insert(col.name.GetString());
-                    data_types.push_back(rapidjson_type_to_dtype(col.value));
-                    column_names.emplace_back(col.name.GetString());
-                }
-
-                // Theoretically there can end too early if the first
-                // few rows are missing columns that are present in later rows.
-                if (columns_known_type.size() == columns_seen.size()) {
-                    return;
-                }
-            }
-        }
-    }();
-
-    auto untyped_columns = columns_seen;
-    for (const auto& col : columns_seen) {
-        if (columns_known_type.count(col) == 0) {
-            // Default all null columns to string
-            data_types.push_back(DTYPE_STR);
-            column_names.emplace_back(col);
-        }
+    // 1.) Infer schema from the first rows
+    t_json_schema_sink schema_sink(index, JSON_SCHEMA_INFERENCE_ROWS);
+    {
+        rapidjson::StringStream s(data.data());
+        read_json_rows(s, false, schema_sink);
     }
 
-    t_schema schema(column_names, data_types);
+    t_schema schema = schema_sink.get_schema();
+    bool is_implicit = schema_sink.is_implicit();
 
     // 2.) Create table
     auto data_table = std::make_unique<t_data_table>(schema);
     data_table->init();
-    data_table->extend(document.Size());
 
     if (is_implicit) {
         data_table->add_column("psp_pkey", DTYPE_INT32, true);
@@ -1306,44 +1904,22 @@ Table::from_rows(
         data_table->add_column("psp_okey", schema.get_dtype(index), true);
     }
 
-    std::int32_t ii = 0;
-
-    const auto& psp_pkey_col = data_table->get_column("psp_pkey");
-    const auto& psp_okey_col = data_table->get_column("psp_okey");
-
-    // 3.) Fill table
-    for (const auto& row : document.GetArray()) {
-        for (const auto& it : row.GetObj()) {
-            auto col = data_table->get_column(it.name.GetString());
-            const auto* col_name = it.name.GetString();
-            const auto& cell = it.value;
-            auto promote = fill_column_json(col, ii, cell, false);
-            if (promote) {
-                LOG_DEBUG(
-                    "Promoting column " << col_name << " from "
-                                        << dtype_to_str(col->get_dtype())
-                                        << " to " << dtype_to_str(*promote)
-                );
-                data_table->promote_column(col_name, *promote, ii, true);
-                col = data_table->get_column(col_name);
-                fill_column_json(col, ii, cell, false);
-            }
-
-            if (!is_implicit && index == it.name.GetString()) {
-                fill_column_json(psp_pkey_col, ii, it.value, false);
-                fill_column_json(psp_okey_col, ii, it.value, false);
-            }
-        }
-
-        if (is_implicit) {
-            psp_pkey_col->set_nth<std::int32_t>(ii, ii % limit);
-            psp_okey_col->set_nth<std::int32_t>(ii, ii % limit);
-        }
-
-        ii++;
+    // 3.) Fill table, writing each row as it is parsed
+    t_json_insert_sink sink(
+        *data_table,
+        index,
+        is_implicit,
+        limit,
+        schema_sink.get_untyped_columns()
+    );
+    {
+        rapidjson::StringStream s(data.data());
+        read_json_rows(s, false, sink);
     }
 
-    { auto _ = std::move(document); }
+    t_uindex nrows = sink.get_num_rows();
+    data_table->extend(nrows);
+
     { auto _ = std::move(data); }
 
     auto pool = std::make_shared<t_pool>();
@@ -1352,7 +1928,7 @@ Table::from_rows(
         pool, schema.columns(), schema.types(), limit, index
     );
 
-    tbl->init(*data_table, document.Size(), t_op::OP_INSERT, 0);
+    tbl->init(*data_table, nrows, t_op::OP_INSERT, 0);
     data_table.reset();
     pool->_process();
     return tbl;
@@ -1360,113 +1936,115 @@ Table::from_rows(
 
 void
 Table::update_ndjson(const std::string_view& data, std::uint32_t port_id) {
-    rapidjson::Document document;
-    rapidjson::StringStream s(data.data());
-    document.ParseStream<rapidjson::kParseStopWhenDoneFlag>(s);
-    if (document.Size() == 0) {
-        return;
-    }
-
-    if (!document.IsObject()) {
-        // TODO Legacy error message
-        PSP_COMPLAIN_AND_ABORT(
-            "Cannot determine data types without column names!\n"
-        )
-    }
-
     bool is_implicit = m_index.empty();
     t_schema table_schema = get_schema();
 
-    // 2.) Create table
-    t_data_table data_table(table_schema);
-    data_table.init();
-
-    // 2a.) Estimate row size to reduce malloc pressure.
-    auto newlines = 0;
-    for (char i : data) {
-        if (i == '\n') {
-            newlines++;
+    auto make_data_table = [&]() {
+        auto data_table = std::make_unique<t_data_table>(table_schema);
+        data_table->init();
+        if (is_implicit) {
+            data_table->add_column("psp_pkey", DTYPE_INT32, true);
+        } else {
+            data_table->add_column(
+                "psp_pkey", table_schema.get_dtype(m_index), true
+            );
         }
-    }
-
-    data_table.reserve(newlines + 1);
-    if (is_implicit) {
-        data_table.add_column("psp_pkey", DTYPE_INT32, true);
-    } else {
-        data_table.add_column(
-            "psp_pkey", table_schema.get_dtype(m_index), true
-        );
-    }
 
-    t_uindex ii = 0;
-    const auto& psp_pkey_col = data_table.get_column("psp_pkey");
-    auto schema = data_table.get_schema();
-    bool is_first_row = true;
-    std::vector<std::string> missing_columns = m_column_names;
+        return data_table;
+    };
 
-    // 3.) Fill table
-    bool is_finished = false;
-    while (!is_finished) {
-        if (is_implicit) {
-            psp_pkey_col->set_nth<std::uint32_t>(ii, (ii + m_offset) % m_limit);
+    // 1.) Fill a table for each part of the batch, split on line boundaries
+    // so that the parts can be read in parallel.
+    t_uindex num_parts = 1;
+#ifdef PSP_PARALLEL_FOR
+    num_parts = std::min<t_uindex>(
+        data.size() / NDJSON_BYTES_PER_TASK,
+        std::max(1U, std::thread::hardware_concurrency())
+    );
+#endif
+
+    std::vector<std::unique_ptr<t_data_table>> data_tables;
+    std::vector<std::string> missing_columns;
+    bool is_filled = false;
+    if (num_parts > 1) {
+        auto parts = split_ndjson(data, num_parts);
+        std::vector<t_uindex> part_rows(parts.size());
+        parallel_for(int(parts.size()), [&](int part) {
+            part_rows[part] = count_ndjson_rows(parts[part]);
+        });
+
+        // Each part writes its implicit index from the rows before it, so
+        // a part which does not read one row per line (because a line does
+        // not parse on its own, or holds more or less than one row) is read
+        // again with the rest of the batch below, where a line which does
+        // not parse is an error.
+        std::vector<t_uindex> row_offsets(parts.size(), 0);
+        for (t_uindex part = 1; part < parts.size(); ++part) {
+            row_offsets[part] = row_offsets[part - 1] + part_rows[part - 1];
         }
 
-        for (const auto& it : document.GetObj()) {
-            std::shared_ptr<t_column> col;
-            std::string_view col_name = it.name.GetString();
-            if (std::string_view{it.name.GetString()} == "__INDEX__") {
-                col_name = "psp_pkey";
-            }
+        std::vector<std::uint8_t> is_part_filled(parts.size(), false);
+        data_tables.resize(parts.size());
+        parallel_for(int(parts.size()), [&](int part) {
+            data_tables[part] = make_data_table();
+            data_tables[part]->reserve(part_rows[part]);
+            t_json_update_sink sink(
+                *data_tables[part],
+                m_index,
+                m_column_names,
+                m_offset,
+                m_limit,
+                row_offsets[part]
+            );
 
-            if (!schema.has_column(col_name)) {
-                LOG_DEBUG("Ignoring column " << col_name);
-                LOG_DEBUG("Schema:\n" << schema);
-                continue;
+            rapidjson::MemoryStream s(parts[part].data(), parts[part].size());
+            bool is_parsed = try_read_ndjson_rows(s, sink);
+            data_tables[part]->extend(sink.get_num_rows());
+            is_part_filled[part] =
+                is_parsed && sink.get_num_rows() == part_rows[part];
+            if (part == 0) {
+                missing_columns = sink.get_missing_columns();
             }
+        });
 
-            if (is_first_row) {
-                missing_columns.erase(
-                    std ::remove(
-                        missing_columns.begin(), missing_columns.end(), col_name
-                    ),
-                    missing_columns.end()
-                );
-            }
+        is_filled = std::all_of(
+            is_part_filled.begin(),
+            is_part_filled.end(),
+            [](std::uint8_t is_part_filled) { return is_part_filled; }
+        );
+    }
 
-            col = data_table.get_column(col_name);
-            auto promote = fill_column_json(col, ii, it.value, true);
-            if (promote) {
-                std::stringstream ss;
-                ss << "Cannot append value of type " << dtype_to_str(*promote)
-                   << " to column of type " << dtype_to_str(col->get_dtype())
-                   << std::endl;
-                PSP_COMPLAIN_AND_ABORT(ss.str());
-            }
+    if (!is_filled) {
+        data_tables.clear();
+        data_tables.push_back(make_data_table());
 
-            if (!is_implicit && m_index == it.name.GetString()) {
-                fill_column_json(psp_pkey_col, ii, it.value, true);
-            }
-        }
+        // Estimate row size to reduce malloc pressure.
+        data_tables[0]->reserve(count_ndjson_rows(data));
+        t_json_update_sink sink(
+            *data_tables[0], m_index, m_column_names, m_offset, m_limit, 0
+        );
 
-        is_first_row = false;
-        if (ii + m_offset >= m_limit) {
-            for (auto& col_name : missing_columns) {
-                data_table.get_column(col_name)->unset(ii);
-            }
-        }
+        rapidjson::StringStream s(data.data());
+        read_json_rows(s, true, sink);
+        data_tables[0]->extend(sink.get_num_rows());
+        missing_columns = sink.get_missing_columns();
+    }
 
-        ii++;
+    // 2.) Join the parts in order
+    t_data_table& data_table = *data_tables[0];
+    for (t_uindex part = 1; part < data_tables.size(); ++part) {
+        data_table.append(*data_tables[part]);
+    }
 
-        document.ParseStream<rapidjson::kParseStopWhenDoneFlag>(s);
-        if (document.HasParseError()) {
-            is_finished = true;
-        }
+    t_uindex size = data_table.size();
+    if (size == 0) {
+        return;
     }
 
-    data_table.extend(ii);
+    unset_json_overflow_rows(data_table, missing_columns, m_offset, m_limit);
     data_table.clone_column("psp_pkey", "psp_okey");
     process_op_column(data_table, t_op::OP_INSERT);
-    calculate_offset(ii);
+    calculate_offset(size);
     m_pool->send(get_gnode()->get_id(), port_id, data_table);
 }
 
@@ -1474,66 +2052,15 @@ std::shared_ptr<Table>
 Table::from_ndjson(
     const std::string& index, std::string&& data, std::uint32_t limit
 ) {
-    // 1.) Infer schema
-    rapidjson::Document document;
-    rapidjson::StringStream s(data.data());
-    document.ParseStream<rapidjson::kParseStopWhenDoneFlag>(s);
-
-    if (document.Size() > 0 && !document.IsObject()) {
-        std::stringstream ss;
-        ss << "Received non-object " << document[0].GetType();
-        PSP_COMPLAIN_AND_ABORT(ss.str())
-    }
-
-    std::vector<std::string> column_names;
-    std::vector<t_dtype> data_types;
-    bool is_implicit = true;
-    std::set<std::string> columns_known_type;
-    std::set<std::string> columns_seen;
-
-    // TODO I don't think it makes sense to do the same incremental-schema
-    // enhancement we do for regular JSON. For now this only checks the first
-    // row.
-    [&]() {
-        for (const auto& col : document.GetObj()) {
-            columns_seen.insert(col.name.GetString());
-        }
-
-        // https://github.com/Tencent/rapidjson/issues/1994
-        for (const auto& col : document.GetObj()) {
-            if (col.name.GetString() == index) {
-                is_implicit = false;
-            }
-
-            if (columns_known_type.count(col.name.GetString()) > 0) {
-                continue;
-            }
-
-            auto dtype = rapidjson_type_to_dtype(col.value);
-            if (dtype != DTYPE_NONE) {
-                columns_known_type.insert(col.name.GetString());
-                data_types.push_back(rapidjson_type_to_dtype(col.value));
-                column_names.emplace_back(col.name.GetString());
-            }
-
-            // Theoretically there can end too early if the first
-            // few rows are missing columns that are present in later rows.
-            if (columns_known_type.size() == columns_seen.size()) {
-                return;
-            }
-        }
-    }();
-
-    auto untyped_columns = columns_seen;
-    for (const auto& col : columns_seen) {
-        if (columns_known_type.count(col) == 0) {
-            // Default all null columns to string
-            data_types.push_back(DTYPE_STR);
-            column_names.emplace_back(col);
-        }
+    // 1.) Infer schema from the first rows
+    t_json_schema_sink schema_sink(index, JSON_SCHEMA_INFERENCE_ROWS);
+    {
+        rapidjson::StringStream s(data.data());
+        read_json_rows(s, true, schema_sink);
     }
 
-    t_schema schema(column_names, data_types);
+    t_schema schema = schema_sink.get_schema();
+    bool is_implicit = schema_sink.is_implicit();
 
     // 2.) Create table
     auto data_table = std::make_unique<t_data_table>(schema);
@@ -1547,61 +2074,25 @@ Table::from_ndjson(
         data_table->add_column("psp_okey", schema.get_dtype(index), true);
     }
 
-    std::int32_t ii = 0;
-    const auto& psp_pkey_col = data_table->get_column("psp_pkey");
-    const auto& psp_okey_col = data_table->get_column("psp_okey");
-
     // 2a.) Estimate row size to reduce malloc pressure.
-    auto newlines = 0;
-    for (char i : data) {
-        if (i == '\n') {
-            newlines++;
-        }
-    }
-
-    data_table->reserve(newlines + 1);
-
-    // 3.) Fill table
-    bool is_finished = false;
-    while (!is_finished) {
-        for (const auto& it : document.GetObj()) {
-            auto col = data_table->get_column(it.name.GetString());
-            const auto* col_name = it.name.GetString();
-            const auto& cell = it.value;
-            auto promote = fill_column_json(col, ii, cell, false);
-            if (promote) {
-                LOG_DEBUG(
-                    "Promoting column " << col_name << " from "
-                                        << dtype_to_str(col->get_dtype())
-                                        << " to " << dtype_to_str(*promote)
-                );
-
-                data_table->promote_column(col_name, *promote, ii, true);
-                col = data_table->get_column(col_name);
-                fill_column_json(col, ii, cell, false);
-            }
-
-            if (!is_implicit && index == it.name.GetString()) {
-                fill_column_json(psp_pkey_col, ii, it.value, false);
-                fill_column_json(psp_okey_col, ii, it.value, false);
-            }
-        }
-
-        if (is_implicit) {
-            psp_pkey_col->set_nth<std::int32_t>(ii, ii % limit);
-            psp_okey_col->set_nth<std::int32_t>(ii, ii % limit);
-        }
-
-        ii++;
-        document.ParseStream<rapidjson::kParseStopWhenDoneFlag>(s);
-        if (document.HasParseError()) {
-            is_finished = true;
-        }
+    data_table->reserve(count_ndjson_rows(data));
+
+    // 3.) Fill table, writing each row as it is parsed
+    t_json_insert_sink sink(
+        *data_table,
+        index,
+        is_implicit,
+        limit,
+        schema_sink.get_untyped_columns()
+    );
+    {
+        rapidjson::StringStream s(data.data());
+        read_json_rows(s, true, sink);
     }
 
-    data_table->extend(ii);
+    t_uindex nrows = sink.get_num_rows();
+    data_table->extend(nrows);
 
-    { auto _ = std::move(document); }
     { auto _ = std::move(data); }
 
     auto pool = std::make_shared<t_pool>();
@@ -1610,7 +2101,7 @@ Table::from_ndjson(
         pool, schema.columns(), schema.types(), limit, index
     );
 
-    tbl->init(*data_table, ii, t_op::OP_INSERT, 0);
+    tbl->init(*data_table, nrows, t_op::OP_INSERT, 0);
     data_table.reset();
     pool->_process();
     return tbl;
@@ -1658,6 +2149,22 @@ Table::update_arrow(const std::string_view& data, std::uint32_t port_id) {
         reinterpret_cast<const std::uint8_t*>(data.data()), data.size()
     );
 
+    update_arrow(arrow_loader, port_id);
+}
+
+void
+Table::update_arrow(
+    std::shared_ptr<const std::string> data, std::uint32_t port_id
+) {
+    apachearrow::ArrowLoader arrow_loader;
+    arrow_loader.initialize(std::move(data));
+    update_arrow(arrow_loader, port_id);
+}
+
+void
+Table::update_arrow(
+    apachearrow::ArrowLoader& arrow_loader, std::uint32_t port_id
+) {
     t_data_table data_table{this->get_schema()};
     data_table.init();
     auto row_count = arrow_loader.row_count();
@@ -1691,10 +2198,10 @@ Table::from_arrow(
 ) {
     apachearrow::ArrowLoader arrow_loader;
 
-    // Parse the arrow and get its metadata
-    arrow_loader.initialize(
-        reinterpret_cast<const std::uint8_t*>(data.data()), data.size()
-    );
+    // Parse the arrow and get its metadata. The loader shares ownership of
+    // `data` with any columns it loads without copying.
+    auto shared_data = std::make_shared<const std::string>(std::move(data));
+    arrow_loader.initialize(shared_data);
 
     // Infer schema
     auto columns = arrow_loader.names();
@@ -1718,7 +2225,7 @@ Table::from_arrow(
     data_table->init();
 
     {
-        auto _ = std::move(data);
+        auto _ = std::move(shared_data);
         auto loader = std::move(arrow_loader);
         auto row_count = loader.row_count();
         data_table->extend(row_count);
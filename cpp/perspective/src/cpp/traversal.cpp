@@ -146,17 +146,19 @@ t_traversal::expand_node(
         t_index num_aggs = sortby.size();
         std::vector<t_tscalar> aggregates(num_aggs);
 
+        std::vector<t_sorttype> sort_orders = get_sort_orders(sortby);
+
         t_uindex child_idx = 0;
         for (const auto& iter : tchildren) {
             m_tree->get_aggregates_for_sorting(
                 iter.m_idx, sortby_agg_indices, aggregates, ctx2
             );
-            (*sortelems)[count] = t_mselem(aggregates, child_idx);
+            (*sortelems)[count].m_order = child_idx;
+            encode_sort_key((*sortelems)[count], aggregates, sort_orders);
             ++count;
             ++child_idx;
         }
 
-        std::vector<t_sorttype> sort_orders = get_sort_orders(sortby);
         t_multisorter sorter(sortelems, sort_orders);
         argsort(sorted_idx, sorter);
     } else {
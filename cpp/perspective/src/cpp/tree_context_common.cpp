@@ -168,7 +168,14 @@ notify_sparse_tree(
 ) {
 
     auto strand_values = tree->build_strand_table(
-        flattened, delta, prev, current, transitions, aggregates, config
+        flattened,
+        delta,
+        prev,
+        current,
+        transitions,
+        existed,
+        aggregates,
+        config
     );
 
     auto strands = strand_values.first;
@@ -40,6 +40,10 @@ t_update_task::run(std::optional<std::function<void(std::uint32_t)>> callback) {
                     }
                     g->clear_output_ports();
                 }
+
+                // Drop the strings left behind by overwritten and removed
+                // rows, once they outnumber the live ones.
+                g->maybe_compact_vocabularies();
             }
         }
     }
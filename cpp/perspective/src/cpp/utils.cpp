@@ -130,8 +130,7 @@ parse_all_date_time(
     std::chrono::system_clock::time_point& tp, std::string_view date_time_str
 ) {
     std::tm tm;
-    const auto result =
-        apachearrow::parseAsArrowTimestamp(std::string(date_time_str));
+    const auto result = apachearrow::parseAsArrowTimestamp(date_time_str);
     if (result.has_value()) {
         std::chrono::milliseconds dur(*result);
         tp = std::chrono::time_point<std::chrono::system_clock>(dur);
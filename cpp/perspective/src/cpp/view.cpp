@@ -13,6 +13,7 @@
 #include <perspective/first.h>
 #include <perspective/view.h>
 #include <perspective/arrow_writer.h>
+#include <perspective/env_vars.h>
 #include <sstream>
 #include <utility>
 #include <rapidjson/writer.h>
@@ -89,8 +90,8 @@ View<CTX_T>::~View() {
     auto gnode = m_table->get_gnode();
     PSP_GIL_UNLOCK();
 
-    // TODO: need to invalidate memory used by previous computed columns
-    // without affecting views that depend on those computed columns.
+    // Expression columns that no other view depends on are freed when the
+    // context is unregistered.
     pool->unregister_context(gnode->get_id(), m_name);
 }
 
@@ -597,6 +598,23 @@ View<t_ctx2>::get_data(
     return data_slice_ptr;
 }
 
+static arrow::ipc::IpcWriteOptions
+make_ipc_write_options(bool compress) {
+    auto options = arrow::ipc::IpcWriteOptions::Defaults();
+    if (compress) {
+        auto codec = arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME);
+        options.codec = std::move(codec).ValueUnsafe();
+    }
+
+#ifdef PSP_PARALLEL_FOR
+    options.use_threads = true;
+#else
+    options.use_threads = false;
+#endif
+
+    return options;
+}
+
 template <typename CTX_T>
 std::shared_ptr<std::string>
 View<CTX_T>::to_arrow(
@@ -607,11 +625,86 @@ View<CTX_T>::to_arrow(
     bool emit_group_by,
     bool compress
 ) const {
+    auto batch = columns_to_batch(start_row, end_row, start_col, end_col);
+    if (batch != nullptr) {
+        return batch_to_arrow(batch, compress);
+    }
+
     std::shared_ptr<t_data_slice<CTX_T>> data_slice =
         get_data(start_row, end_row, start_col, end_col);
     return data_slice_to_arrow(data_slice, emit_group_by, compress);
 };
 
+template <typename CTX_T>
+void
+View<CTX_T>::to_arrow_chunked(
+    std::int32_t start_row,
+    std::int32_t end_row,
+    std::int32_t start_col,
+    std::int32_t end_col,
+    bool emit_group_by,
+    bool compress,
+    t_uindex chunk_rows,
+    const std::function<void(std::string&&)>& sink
+) const {
+    PSP_VERBOSE_ASSERT(chunk_rows > 0, "Arrow chunk size must be positive");
+    auto maybe_stream = arrow::io::BufferOutputStream::Create();
+    if (!maybe_stream.ok()) {
+        std::stringstream ss;
+        ss << "Failed to allocate buffer: "
+           << maybe_stream.status().message() << std::endl;
+        PSP_COMPLAIN_AND_ABORT(ss.str());
+    }
+
+    std::shared_ptr<arrow::io::BufferOutputStream> stream = *maybe_stream;
+    auto options = make_ipc_write_options(compress);
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+
+    // Hand off everything written since the last flush and start a fresh
+    // buffer, so at most one encoded batch is held at a time.
+    auto flush = [&]() {
+        auto buffer = stream->Finish();
+        PSP_CHECK_ARROW_STATUS(buffer.status());
+        if ((*buffer)->size() > 0) {
+            sink((*buffer)->ToString());
+        }
+
+        PSP_CHECK_ARROW_STATUS(stream->Reset());
+    };
+
+    // An empty range still writes one (empty) batch, so the stream always
+    // carries the view's schema.
+    std::int32_t chunk_start = start_row;
+    do {
+        std::int32_t chunk_end = end_row;
+        if (static_cast<t_uindex>(end_row - chunk_start) > chunk_rows) {
+            chunk_end = chunk_start + static_cast<std::int32_t>(chunk_rows);
+        }
+
+        auto batch =
+            columns_to_batch(chunk_start, chunk_end, start_col, end_col);
+        if (batch == nullptr) {
+            auto data_slice =
+                get_data(chunk_start, chunk_end, start_col, end_col);
+            batch = data_slice_to_batches(emit_group_by, data_slice).second;
+        }
+
+        if (writer == nullptr) {
+            auto res =
+                arrow::ipc::MakeStreamWriter(stream, batch->schema(), options);
+            PSP_CHECK_ARROW_STATUS(res.status());
+            writer = *res;
+        }
+
+        PSP_CHECK_ARROW_STATUS(writer->WriteRecordBatch(*batch));
+        flush();
+        chunk_start = chunk_end;
+    } while (chunk_start < end_row);
+
+    PSP_CHECK_ARROW_STATUS(writer->Close());
+    flush();
+}
+
 template <>
 std::shared_ptr<std::string>
 View<t_ctx2>::to_csv(
@@ -1180,6 +1273,130 @@ View<CTX_T>::data_slice_to_batches(
     return std::make_pair(arrow_schema, batches);
 }
 
+template <typename CTX_T>
+std::shared_ptr<arrow::RecordBatch>
+View<CTX_T>::columns_to_batch(
+    std::int32_t start_row,
+    std::int32_t end_row,
+    std::int32_t start_col,
+    std::int32_t end_col
+) const {
+    return nullptr;
+}
+
+template <>
+std::shared_ptr<arrow::RecordBatch>
+View<t_ctxunit>::columns_to_batch(
+    std::int32_t start_row,
+    std::int32_t end_row,
+    std::int32_t start_col,
+    std::int32_t end_col
+) const {
+    t_get_data_extents extents = sanitize_get_data_extents(
+        m_ctx->get_row_count(),
+        m_ctx->get_column_count(),
+        start_row,
+        end_row,
+        start_col,
+        end_col
+    );
+
+    std::vector<t_rlookup> rows;
+    m_ctx->get_master_rows(extents.m_srow, extents.m_erow, rows);
+    return gather_columns_to_batch(
+        rows,
+        extents.m_scol,
+        extents.m_ecol,
+        [&](t_uindex cidx) { return m_ctx->get_master_column(cidx); }
+    );
+}
+
+template <>
+std::shared_ptr<arrow::RecordBatch>
+View<t_ctx0>::columns_to_batch(
+    std::int32_t start_row,
+    std::int32_t end_row,
+    std::int32_t start_col,
+    std::int32_t end_col
+) const {
+    t_get_data_extents extents = sanitize_get_data_extents(
+        m_ctx->get_row_count(),
+        m_ctx->get_column_count(),
+        start_row,
+        end_row,
+        start_col,
+        end_col
+    );
+
+    // Rows come out in traversal order, so sorts and filters are already
+    // applied by the time the columns are gathered.
+    std::vector<t_rlookup> rows;
+    m_ctx->get_master_rows(extents.m_srow, extents.m_erow, rows);
+    return gather_columns_to_batch(
+        rows,
+        extents.m_scol,
+        extents.m_ecol,
+        [&](t_uindex cidx) { return m_ctx->get_master_column(cidx); }
+    );
+}
+
+template <typename CTX_T>
+std::shared_ptr<arrow::RecordBatch>
+View<CTX_T>::gather_columns_to_batch(
+    const std::vector<t_rlookup>& rows,
+    t_uindex start_col,
+    t_uindex end_col,
+    const std::function<std::shared_ptr<const t_column>(t_uindex)>& get_column
+) const {
+    if (t_env::backout_arrow_gather()) {
+        return nullptr;
+    }
+
+    std::vector<std::vector<t_tscalar>> names = column_names();
+    std::vector<t_uindex> indices;
+    std::vector<std::shared_ptr<const t_column>> columns;
+    for (t_uindex cidx = start_col; cidx < end_col; ++cidx) {
+        // Do not output hidden sort columns - they are always at the end
+        // of the columns list.
+        if (cidx >= m_columns.size()) {
+            continue;
+        }
+
+        // Leave anything the typed columns can't represent exactly as the
+        // data slice would to `data_slice_to_batches`.
+        std::shared_ptr<const t_column> column = get_column(cidx);
+        if (column == nullptr
+            || column->get_dtype() != get_column_dtype(cidx)) {
+            return nullptr;
+        }
+
+        indices.push_back(cidx);
+        columns.push_back(std::move(column));
+    }
+
+    std::vector<std::shared_ptr<arrow::Field>> fields(indices.size());
+    std::vector<std::shared_ptr<arrow::Array>> vectors(indices.size());
+    parallel_for(int(indices.size()), [&](auto iidx) {
+        const std::vector<t_tscalar>& col_path = names.at(indices[iidx]);
+        vectors[iidx] = apachearrow::column_to_array(*columns[iidx], rows);
+        fields[iidx] = arrow::field(
+            col_path.at(col_path.size() - 1).to_string(), vectors[iidx]->type()
+        );
+    });
+
+    std::shared_ptr<arrow::RecordBatch> batch = arrow::RecordBatch::Make(
+        arrow::schema(fields), static_cast<std::int64_t>(rows.size()), vectors
+    );
+    auto valid = batch->Validate();
+    if (!valid.ok()) {
+        std::stringstream ss;
+        ss << "Invalid RecordBatch: " << valid.message() << std::endl;
+        PSP_COMPLAIN_AND_ABORT(ss.str());
+    }
+
+    return batch;
+}
+
 template <typename CTX_T>
 std::shared_ptr<std::string>
 View<CTX_T>::data_slice_to_arrow(
@@ -1191,8 +1408,14 @@ View<CTX_T>::data_slice_to_arrow(
         std::shared_ptr<arrow::Schema>,
         std::shared_ptr<arrow::RecordBatch>>
         pairs = data_slice_to_batches(emit_group_by, data_slice);
-    std::shared_ptr<arrow::RecordBatch> batches = pairs.second;
-    std::shared_ptr<arrow::Schema> arrow_schema = pairs.first;
+    return batch_to_arrow(pairs.second, compress);
+}
+
+template <typename CTX_T>
+std::shared_ptr<std::string>
+View<CTX_T>::batch_to_arrow(
+    const std::shared_ptr<arrow::RecordBatch>& batch, bool compress
+) const {
     arrow::Result<std::shared_ptr<arrow::ResizableBuffer>> allocated =
         arrow::AllocateResizableBuffer(0);
     if (!allocated.ok()) {
@@ -1205,21 +1428,10 @@ View<CTX_T>::data_slice_to_arrow(
     std::shared_ptr<arrow::ResizableBuffer> buffer;
     buffer = *allocated;
     arrow::io::BufferOutputStream sink(buffer);
-    auto options = arrow::ipc::IpcWriteOptions::Defaults();
-    if (compress) {
-        auto codec = arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME);
-        options.codec = std::move(codec).ValueUnsafe();
-    }
-
-#ifdef PSP_PARALLEL_FOR
-    options.use_threads = true;
-#else
-    options.use_threads = false;
-#endif
-
-    auto res = arrow::ipc::MakeStreamWriter(&sink, arrow_schema, options);
+    auto options = make_ipc_write_options(compress);
+    auto res = arrow::ipc::MakeStreamWriter(&sink, batch->schema(), options);
     std::shared_ptr<arrow::ipc::RecordBatchWriter> writer = *res;
-    PSP_CHECK_ARROW_STATUS(writer->WriteRecordBatch(*batches));
+    PSP_CHECK_ARROW_STATUS(writer->WriteRecordBatch(*batch));
     PSP_CHECK_ARROW_STATUS(writer->Close());
     PSP_CHECK_ARROW_STATUS(sink.Close());
     return std::make_shared<std::string>(buffer->ToString());
@@ -1609,6 +1821,108 @@ write_scalar(
     }
 }
 
+// Rows serialized per `parallel_for` task by `write_json_values`.
+const t_uindex JSON_VALUES_PER_TASK = 1024;
+
+/**
+ * @brief Serialize `num_values` JSON values and join them, in order, with
+ * `separator`. Values are written a block at a time on separate threads,
+ * each block into its own buffer, and the blocks are spliced together, so
+ * the output is byte-identical to writing every value on one thread.
+ *
+ * `write_value` is called with each value's index and a writer reset for a
+ * new root value, and returns `false` if it skipped the value, in which
+ * case no separator is written for it either.
+ *
+ * @param num_values
+ * @param separator
+ * @param write_value
+ * @return std::string
+ */
+template <typename F>
+std::string
+write_json_values(t_uindex num_values, char separator, F write_value) {
+    t_uindex num_blocks =
+        (num_values + JSON_VALUES_PER_TASK - 1) / JSON_VALUES_PER_TASK;
+    std::vector<rapidjson::StringBuffer> buffers(num_blocks);
+    std::vector<std::uint8_t> written(num_blocks, false);
+    parallel_for(int(num_blocks), [&](int block) {
+        rapidjson::StringBuffer& buffer = buffers[block];
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        t_uindex begin = block * JSON_VALUES_PER_TASK;
+        t_uindex end = std::min(num_values, begin + JSON_VALUES_PER_TASK);
+        for (t_uindex idx = begin; idx < end; ++idx) {
+            std::size_t mark = buffer.GetSize();
+            if (written[block]) {
+                buffer.Put(separator);
+            }
+
+            writer.Reset(buffer);
+            if (write_value(idx, writer)) {
+                written[block] = true;
+            } else {
+                buffer.Pop(buffer.GetSize() - mark);
+            }
+        }
+    });
+
+    std::string out;
+    for (t_uindex block = 0; block < num_blocks; ++block) {
+        if (!written[block]) {
+            continue;
+        }
+
+        if (!out.empty()) {
+            out += separator;
+        }
+
+        out.append(buffers[block].GetString(), buffers[block].GetSize());
+    }
+
+    return out;
+}
+
+// Writes zero or more keys, and their values, into a JSON object.
+typedef std::function<void(rapidjson::Writer<rapidjson::StringBuffer>&)>
+    t_json_member;
+
+/**
+ * @brief Serialize a JSON object whose members are written by `members`,
+ * each of which writes zero or more keys and their values. Members are
+ * written into their own buffers in parallel and spliced together in
+ * order, so the output is byte-identical to writing them on one thread.
+ *
+ * @param members
+ * @return std::string
+ */
+std::string
+write_json_object(const std::vector<t_json_member>& members) {
+    std::vector<rapidjson::StringBuffer> buffers(members.size());
+    parallel_for(int(members.size()), [&](int idx) {
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffers[idx]);
+        writer.StartObject();
+        members[idx](writer);
+        writer.EndObject();
+    });
+
+    std::string out = "{";
+    for (const auto& buffer : buffers) {
+        // Strip each buffer's enclosing braces, keeping just its members.
+        if (buffer.GetSize() <= 2) {
+            continue;
+        }
+
+        if (out.size() > 1) {
+            out += ',';
+        }
+
+        out.append(buffer.GetString() + 1, buffer.GetSize() - 2);
+    }
+
+    out += '}';
+    return out;
+}
+
 template <typename CTX_T>
 void
 View<CTX_T>::write_row_path(
@@ -1753,14 +2067,9 @@ View<T>::to_rows(
     PSP_READ_LOCK(*get_lock());
     auto slice = get_data(start_row, end_row, start_col, end_col);
     auto& col_names = slice->get_column_names();
-    rapidjson::StringBuffer s;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    writer.StartArray();
-
     if ((start_row == end_row || start_col == end_col) && !get_ids
         && !get_pkeys) {
-        writer.EndArray();
-        return s.GetString();
+        return "[]";
     }
 
     std::vector<std::string> column_names;
@@ -1782,50 +2091,56 @@ View<T>::to_rows(
     // columns are out of bounds.
     auto num_virtual_columns = (int)get_pkeys + (int)get_ids;
 
+    std::string rows;
     if (start_col <= (end_col + num_virtual_columns)) {
-        for (auto r = start_row; r < end_row; ++r) {
-            if (has_row_path && leaves_only) {
-                if (m_ctx->unity_get_row_depth(r) < depth) {
-                    continue;
+        rows = write_json_values(
+            end_row - start_row,
+            ',',
+            [&](t_uindex idx, auto& writer) {
+                auto r = start_row + idx;
+                if (has_row_path && leaves_only) {
+                    if (m_ctx->unity_get_row_depth(r) < depth) {
+                        return false;
+                    }
                 }
-            }
-
-            writer.StartObject();
-            if (get_ids) {
-                std::pair<t_uindex, t_uindex> pair{r, 0};
-                std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
-                const auto keys = m_ctx->get_pkeys(vec);
-                const t_tscalar& scalar = keys[0];
-                writer.Key("__ID__");
-                writer.StartArray();
-                write_scalar(scalar, is_formatted, writer);
-                writer.EndArray();
-            }
 
-            if (get_pkeys) {
-                std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
-                writer.Key("__INDEX__");
-                writer.StartArray();
-                for (auto i = keys.size(); i > 0; --i) {
-                    auto scalar = keys[i - 1];
+                writer.StartObject();
+                if (get_ids) {
+                    std::pair<t_uindex, t_uindex> pair{r, 0};
+                    std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
+                    const auto keys = m_ctx->get_pkeys(vec);
+                    const t_tscalar& scalar = keys[0];
+                    writer.Key("__ID__");
+                    writer.StartArray();
                     write_scalar(scalar, is_formatted, writer);
+                    writer.EndArray();
                 }
 
-                writer.EndArray();
-            }
+                if (get_pkeys) {
+                    std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
+                    writer.Key("__INDEX__");
+                    writer.StartArray();
+                    for (auto i = keys.size(); i > 0; --i) {
+                        auto scalar = keys[i - 1];
+                        write_scalar(scalar, is_formatted, writer);
+                    }
 
-            for (auto c = start_col; c < end_col; ++c) {
-                writer.Key(column_names[c - start_col].c_str());
-                auto scalar = slice->get(r, c);
-                write_scalar(scalar, is_formatted, writer);
-            }
+                    writer.EndArray();
+                }
 
-            writer.EndObject();
-        }
+                for (auto c = start_col; c < end_col; ++c) {
+                    writer.Key(column_names[c - start_col].c_str());
+                    auto scalar = slice->get(r, c);
+                    write_scalar(scalar, is_formatted, writer);
+                }
+
+                writer.EndObject();
+                return true;
+            }
+        );
     }
 
-    writer.EndArray();
-    return s.GetString();
+    return "[" + rows + "]";
 }
 
 template <>
@@ -1850,13 +2165,8 @@ View<t_ctx1>::to_rows(
     PSP_READ_LOCK(*get_lock());
     auto slice = get_data(start_row, end_row, start_col, end_col);
     const auto& col_names = slice->get_column_names();
-    rapidjson::StringBuffer s;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    writer.StartArray();
-
     if (start_row == end_row || (start_col == end_col && !has_row_path)) {
-        writer.EndArray();
-        return s.GetString();
+        return "[]";
     }
 
     t_uindex depth = m_row_pivots.size();
@@ -1872,66 +2182,71 @@ View<t_ctx1>::to_rows(
         );
     }
 
-    for (auto r = start_row; r < end_row; ++r) {
-        if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
-                continue;
+    std::string rows = write_json_values(
+        end_row - start_row,
+        ',',
+        [&](t_uindex idx, auto& writer) {
+            auto r = start_row + idx;
+            if (has_row_path && leaves_only) {
+                if (m_ctx->unity_get_row_depth(r) < depth) {
+                    return false;
+                }
             }
-        }
-
-        // Row
-        writer.StartObject();
-
-        // `__ROW_PATH__`
-        writer.Key("__ROW_PATH__");
-        writer.StartArray();
-        const auto row_path = get_row_path(r);
-        for (auto entry = row_path.size(); entry > 0; entry--) {
-            const t_tscalar& scalar = row_path[entry - 1];
-            write_scalar(scalar, is_formatted, writer);
-        }
 
-        writer.EndArray();
+            // Row
+            writer.StartObject();
 
-        if (get_ids) {
-            writer.Key("__ID__");
+            // `__ROW_PATH__`
+            writer.Key("__ROW_PATH__");
             writer.StartArray();
+            const auto row_path = get_row_path(r);
             for (auto entry = row_path.size(); entry > 0; entry--) {
                 const t_tscalar& scalar = row_path[entry - 1];
                 write_scalar(scalar, is_formatted, writer);
             }
 
             writer.EndArray();
-        }
 
-        if (get_pkeys) {
-            std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
-            writer.Key("__INDEX__");
-            writer.StartArray();
-            for (auto i = keys.size(); i > 0; --i) {
-                auto scalar = keys[i - 1];
-                write_scalar(scalar, is_formatted, writer);
+            if (get_ids) {
+                writer.Key("__ID__");
+                writer.StartArray();
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
+
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            if (get_pkeys) {
+                std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
+                writer.Key("__INDEX__");
+                writer.StartArray();
+                for (auto i = keys.size(); i > 0; --i) {
+                    auto scalar = keys[i - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
 
-        // Columns
-        for (auto c = start_col + 1; c < end_col; ++c) {
-            if (c >= columns_length + 1) {
-                continue;
+                writer.EndArray();
             }
 
-            writer.Key(column_names[c - (start_col + 1)].c_str());
-            auto scalar = slice->get(r, c);
-            write_scalar(scalar, is_formatted, writer);
-        }
+            // Columns
+            for (auto c = start_col + 1; c < end_col; ++c) {
+                if (c >= columns_length + 1) {
+                    continue;
+                }
 
-        writer.EndObject();
-    }
+                writer.Key(column_names[c - (start_col + 1)].c_str());
+                auto scalar = slice->get(r, c);
+                write_scalar(scalar, is_formatted, writer);
+            }
 
-    writer.EndArray();
-    return s.GetString();
+            writer.EndObject();
+            return true;
+        }
+    );
+
+    return "[" + rows + "]";
 }
 
 template <>
@@ -1956,13 +2271,8 @@ View<t_ctx2>::to_rows(
     PSP_READ_LOCK(*get_lock());
     auto slice = get_data(start_row, end_row, start_col, end_col);
     const auto& col_names = slice->get_column_names();
-    rapidjson::StringBuffer s;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    writer.StartArray();
-
     if (start_row == end_row || (start_col == end_col && !has_row_path)) {
-        writer.EndArray();
-        return s.GetString();
+        return "[]";
     }
 
     std::vector<std::string> column_names;
@@ -1972,68 +2282,73 @@ View<t_ctx2>::to_rows(
 
     t_uindex depth = m_row_pivots.size();
     bool column_only = is_column_only();
-    for (auto r = start_row; r < end_row; ++r) {
-        if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
-                continue;
+    std::string rows = write_json_values(
+        end_row - start_row,
+        ',',
+        [&](t_uindex idx, auto& writer) {
+            auto r = start_row + idx;
+            if (has_row_path && leaves_only) {
+                if (m_ctx->unity_get_row_depth(r) < depth) {
+                    return false;
+                }
             }
-        }
 
-        // Row
-        writer.StartObject();
+            // Row
+            writer.StartObject();
 
-        // `__ROW_PATH__`
-        const auto row_path = get_row_path(r);
-        if (!column_only) {
-            writer.Key("__ROW_PATH__");
-            writer.StartArray();
-            for (auto entry = row_path.size(); entry > 0; entry--) {
-                const t_tscalar& scalar = row_path[entry - 1];
-                write_scalar(scalar, is_formatted, writer);
+            // `__ROW_PATH__`
+            const auto row_path = get_row_path(r);
+            if (!column_only) {
+                writer.Key("__ROW_PATH__");
+                writer.StartArray();
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
+
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            if (get_ids) {
+                writer.Key("__ID__");
+                writer.StartArray();
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
 
-        if (get_ids) {
-            writer.Key("__ID__");
-            writer.StartArray();
-            for (auto entry = row_path.size(); entry > 0; entry--) {
-                const t_tscalar& scalar = row_path[entry - 1];
-                write_scalar(scalar, is_formatted, writer);
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            if (get_pkeys) {
+                std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
+                writer.Key("__INDEX__");
+                writer.StartArray();
+                for (auto i = keys.size(); i > 0; --i) {
+                    auto scalar = keys[i - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
 
-        if (get_pkeys) {
-            std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
-            writer.Key("__INDEX__");
-            writer.StartArray();
-            for (auto i = keys.size(); i > 0; --i) {
-                auto scalar = keys[i - 1];
-                write_scalar(scalar, is_formatted, writer);
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            // Columns
+            for (auto c = start_col + 1; c < end_col; ++c) {
+                if (((c - 1) % (columns_length + hidden)) >= columns_length) {
+                    continue;
+                }
 
-        // Columns
-        for (auto c = start_col + 1; c < end_col; ++c) {
-            if (((c - 1) % (columns_length + hidden)) >= columns_length) {
-                continue;
+                writer.Key(column_names[c - (start_col + 1)].c_str());
+                auto scalar = slice->get(r, c);
+                write_scalar(scalar, is_formatted, writer);
             }
 
-            writer.Key(column_names[c - (start_col + 1)].c_str());
-            auto scalar = slice->get(r, c);
-            write_scalar(scalar, is_formatted, writer);
+            writer.EndObject();
+            return true;
         }
+    );
 
-        writer.EndObject();
-    }
-
-    writer.EndArray();
-    return s.GetString();
+    return "[" + rows + "]";
 }
 
 // template <>
@@ -2131,57 +2446,57 @@ View<T>::to_ndjson(
     // return a list of empty objects when all of the physical and "virtual"
     // columns are out of bounds.
     auto num_virtual_columns = (int)get_pkeys + (int)get_ids;
-    std::stringstream ndjson;
+    std::string ndjson;
     if (start_col <= (end_col + num_virtual_columns)) {
-        for (auto r = start_row; r < end_row; ++r) {
-            if (r != start_row) {
-                ndjson << "\n";
-            }
+        // Rows skipped by `leaves_only` still get their own (empty) line.
+        ndjson = write_json_values(
+            end_row - start_row,
+            '\n',
+            [&](t_uindex idx, auto& writer) {
+                auto r = start_row + idx;
+                if (has_row_path && leaves_only) {
+                    if (m_ctx->unity_get_row_depth(r) < depth) {
+                        return true;
+                    }
+                }
 
-            rapidjson::StringBuffer s;
-            rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-            if (has_row_path && leaves_only) {
-                if (m_ctx->unity_get_row_depth(r) < depth) {
-                    continue;
+                writer.StartObject();
+                if (get_ids) {
+                    std::pair<t_uindex, t_uindex> pair{r, 0};
+                    std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
+                    const auto keys = m_ctx->get_pkeys(vec);
+                    const t_tscalar& scalar = keys[0];
+                    writer.Key("__ID__");
+                    writer.StartArray();
+                    write_scalar(scalar, is_formatted, writer);
+                    writer.EndArray();
                 }
-            }
 
-            writer.StartObject();
-            if (get_ids) {
-                std::pair<t_uindex, t_uindex> pair{r, 0};
-                std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
-                const auto keys = m_ctx->get_pkeys(vec);
-                const t_tscalar& scalar = keys[0];
-                writer.Key("__ID__");
-                writer.StartArray();
-                write_scalar(scalar, is_formatted, writer);
-                writer.EndArray();
-            }
+                if (get_pkeys) {
+                    std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
+                    writer.Key("__INDEX__");
+                    writer.StartArray();
+                    for (auto i = keys.size(); i > 0; --i) {
+                        auto scalar = keys[i - 1];
+                        write_scalar(scalar, is_formatted, writer);
+                    }
 
-            if (get_pkeys) {
-                std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
-                writer.Key("__INDEX__");
-                writer.StartArray();
-                for (auto i = keys.size(); i > 0; --i) {
-                    auto scalar = keys[i - 1];
-                    write_scalar(scalar, is_formatted, writer);
+                    writer.EndArray();
                 }
 
-                writer.EndArray();
-            }
+                for (auto c = start_col; c < end_col; ++c) {
+                    writer.Key(column_names[c - start_col].c_str());
+                    auto scalar = slice->get(r, c);
+                    write_scalar(scalar, is_formatted, writer);
+                }
 
-            for (auto c = start_col; c < end_col; ++c) {
-                writer.Key(column_names[c - start_col].c_str());
-                auto scalar = slice->get(r, c);
-                write_scalar(scalar, is_formatted, writer);
+                writer.EndObject();
+                return true;
             }
-
-            writer.EndObject();
-            ndjson << s.GetString();
-        }
+        );
     }
 
-    return ndjson.str();
+    return ndjson;
 }
 
 template <>
@@ -2222,74 +2537,70 @@ View<t_ctx1>::to_ndjson(
         );
     }
 
-    std::stringstream ndjson;
-    for (auto r = start_row; r < end_row; ++r) {
-        if (r != start_row) {
-            ndjson << "\n";
-        }
-
-        rapidjson::StringBuffer s;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-        if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
-                continue;
+    // Rows skipped by `leaves_only` still get their own (empty) line.
+    return write_json_values(
+        end_row - start_row,
+        '\n',
+        [&](t_uindex idx, auto& writer) {
+            auto r = start_row + idx;
+            if (has_row_path && leaves_only) {
+                if (m_ctx->unity_get_row_depth(r) < depth) {
+                    return true;
+                }
             }
-        }
-
-        // Row
-        writer.StartObject();
-
-        // `__ROW_PATH__`
-        writer.Key("__ROW_PATH__");
-        writer.StartArray();
-        const auto row_path = get_row_path(r);
-        for (auto entry = row_path.size(); entry > 0; entry--) {
-            const t_tscalar& scalar = row_path[entry - 1];
-            write_scalar(scalar, is_formatted, writer);
-        }
 
-        writer.EndArray();
+            // Row
+            writer.StartObject();
 
-        if (get_ids) {
-            writer.Key("__ID__");
+            // `__ROW_PATH__`
+            writer.Key("__ROW_PATH__");
             writer.StartArray();
+            const auto row_path = get_row_path(r);
             for (auto entry = row_path.size(); entry > 0; entry--) {
                 const t_tscalar& scalar = row_path[entry - 1];
                 write_scalar(scalar, is_formatted, writer);
             }
 
             writer.EndArray();
-        }
 
-        if (get_pkeys) {
-            std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
-            writer.Key("__INDEX__");
-            writer.StartArray();
-            for (auto i = keys.size(); i > 0; --i) {
-                auto scalar = keys[i - 1];
-                write_scalar(scalar, is_formatted, writer);
+            if (get_ids) {
+                writer.Key("__ID__");
+                writer.StartArray();
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
+
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            if (get_pkeys) {
+                std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
+                writer.Key("__INDEX__");
+                writer.StartArray();
+                for (auto i = keys.size(); i > 0; --i) {
+                    auto scalar = keys[i - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
 
-        // Columns
-        for (auto c = start_col + 1; c < end_col; ++c) {
-            if (c >= columns_length + 1) {
-                continue;
+                writer.EndArray();
             }
 
-            writer.Key(column_names[c - (start_col + 1)].c_str());
-            auto scalar = slice->get(r, c);
-            write_scalar(scalar, is_formatted, writer);
-        }
+            // Columns
+            for (auto c = start_col + 1; c < end_col; ++c) {
+                if (c >= columns_length + 1) {
+                    continue;
+                }
 
-        writer.EndObject();
-        ndjson << s.GetString();
-    }
+                writer.Key(column_names[c - (start_col + 1)].c_str());
+                auto scalar = slice->get(r, c);
+                write_scalar(scalar, is_formatted, writer);
+            }
 
-    // writer.EndArray();
-    return ndjson.str();
+            writer.EndObject();
+            return true;
+        }
+    );
 }
 
 template <>
@@ -2325,75 +2636,72 @@ View<t_ctx2>::to_ndjson(
 
     t_uindex depth = m_row_pivots.size();
     bool column_only = is_column_only();
-    std::stringstream ndjson;
-    for (auto r = start_row; r < end_row; ++r) {
-        if (r != start_row) {
-            ndjson << "\n";
-        }
-
-        rapidjson::StringBuffer s;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-        if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
-                continue;
+    // Rows skipped by `leaves_only` still get their own (empty) line.
+    return write_json_values(
+        end_row - start_row,
+        '\n',
+        [&](t_uindex idx, auto& writer) {
+            auto r = start_row + idx;
+            if (has_row_path && leaves_only) {
+                if (m_ctx->unity_get_row_depth(r) < depth) {
+                    return true;
+                }
             }
-        }
 
-        // Row
-        writer.StartObject();
+            // Row
+            writer.StartObject();
 
-        // `__ROW_PATH__`
-        const auto row_path = get_row_path(r);
-        if (!column_only) {
-            writer.Key("__ROW_PATH__");
-            writer.StartArray();
-            for (auto entry = row_path.size(); entry > 0; entry--) {
-                const t_tscalar& scalar = row_path[entry - 1];
-                write_scalar(scalar, is_formatted, writer);
+            // `__ROW_PATH__`
+            const auto row_path = get_row_path(r);
+            if (!column_only) {
+                writer.Key("__ROW_PATH__");
+                writer.StartArray();
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
+
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            if (get_ids) {
+                writer.Key("__ID__");
+                writer.StartArray();
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
 
-        if (get_ids) {
-            writer.Key("__ID__");
-            writer.StartArray();
-            for (auto entry = row_path.size(); entry > 0; entry--) {
-                const t_tscalar& scalar = row_path[entry - 1];
-                write_scalar(scalar, is_formatted, writer);
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            if (get_pkeys) {
+                std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
+                writer.Key("__INDEX__");
+                writer.StartArray();
+                for (auto i = keys.size(); i > 0; --i) {
+                    auto scalar = keys[i - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
 
-        if (get_pkeys) {
-            std::vector<t_tscalar> keys = slice->get_pkeys(r, 0);
-            writer.Key("__INDEX__");
-            writer.StartArray();
-            for (auto i = keys.size(); i > 0; --i) {
-                auto scalar = keys[i - 1];
-                write_scalar(scalar, is_formatted, writer);
+                writer.EndArray();
             }
 
-            writer.EndArray();
-        }
+            // Columns
+            for (auto c = start_col + 1; c < end_col; ++c) {
+                if (((c - 1) % (columns_length + hidden)) >= columns_length) {
+                    continue;
+                }
 
-        // Columns
-        for (auto c = start_col + 1; c < end_col; ++c) {
-            if (((c - 1) % (columns_length + hidden)) >= columns_length) {
-                continue;
+                writer.Key(column_names[c - (start_col + 1)].c_str());
+                auto scalar = slice->get(r, c);
+                write_scalar(scalar, is_formatted, writer);
             }
 
-            writer.Key(column_names[c - (start_col + 1)].c_str());
-            auto scalar = slice->get(r, c);
-            write_scalar(scalar, is_formatted, writer);
+            writer.EndObject();
+            return true;
         }
-
-        writer.EndObject();
-        ndjson << s.GetString();
-    }
-
-    return ndjson.str();
+    );
 }
 
 template <typename T>
@@ -2420,47 +2728,50 @@ View<T>::to_columns(
     const std::vector<std::vector<t_tscalar>>& col_names =
         slice->get_column_names();
 
-    rapidjson::StringBuffer s;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    writer.StartObject();
+    std::vector<t_json_member> members;
     for (auto c = start_col; c < end_col; ++c) {
-        write_column(
-            c,
-            start_row,
-            end_row,
-            false,
-            false,
-            is_formatted,
-            slice,
-            col_names,
-            writer
-        );
+        members.emplace_back([&, c](auto& writer) {
+            write_column(
+                c,
+                start_row,
+                end_row,
+                false,
+                false,
+                is_formatted,
+                slice,
+                col_names,
+                writer
+            );
+        });
     }
 
     if (get_pkeys) {
-        write_index_column(
-            start_row, end_row, false, false, is_formatted, slice, writer
-        );
+        members.emplace_back([&](auto& writer) {
+            write_index_column(
+                start_row, end_row, false, false, is_formatted, slice, writer
+            );
+        });
     }
 
     if (get_ids) {
-        writer.Key("__ID__");
-        writer.StartArray();
-        for (auto x = start_row; x < end_row; ++x) {
-            std::pair<t_uindex, t_uindex> pair{x, 0};
-            std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
-            const auto keys = m_ctx->get_pkeys(vec);
-            const t_tscalar& scalar = keys[0];
+        members.emplace_back([&](auto& writer) {
+            writer.Key("__ID__");
             writer.StartArray();
-            write_scalar(scalar, is_formatted, writer);
-            writer.EndArray();
-        }
+            for (auto x = start_row; x < end_row; ++x) {
+                std::pair<t_uindex, t_uindex> pair{x, 0};
+                std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
+                const auto keys = m_ctx->get_pkeys(vec);
+                const t_tscalar& scalar = keys[0];
+                writer.StartArray();
+                write_scalar(scalar, is_formatted, writer);
+                writer.EndArray();
+            }
 
-        writer.EndArray();
+            writer.EndArray();
+        });
     }
 
-    writer.EndObject();
-    return s.GetString();
+    return write_json_object(members);
 }
 
 template <>
@@ -2486,25 +2797,30 @@ View<t_ctx1>::to_columns(
 
     auto slice = get_data(start_row, end_row, start_col, end_col);
     const auto& col_names = slice->get_column_names();
-    rapidjson::StringBuffer s;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    writer.StartObject();
-    write_row_path(start_row, end_row, true, leaves_only, is_formatted, writer);
+    std::vector<t_json_member> members;
+    members.emplace_back([&](auto& writer) {
+        write_row_path(
+            start_row, end_row, true, leaves_only, is_formatted, writer
+        );
+    });
+
     if (get_ids) {
-        writer.Key("__ID__");
-        writer.StartArray();
-        for (auto r = start_row; r < end_row; ++r) {
+        members.emplace_back([&](auto& writer) {
+            writer.Key("__ID__");
             writer.StartArray();
-            const auto row_path = m_ctx->get_row_path(r);
-            for (auto entry = row_path.size(); entry > 0; entry--) {
-                const t_tscalar& scalar = row_path[entry - 1];
-                write_scalar(scalar, is_formatted, writer);
+            for (auto r = start_row; r < end_row; ++r) {
+                writer.StartArray();
+                const auto row_path = m_ctx->get_row_path(r);
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
+
+                writer.EndArray();
             }
 
             writer.EndArray();
-        }
-
-        writer.EndArray();
+        });
     }
 
     // Hidden columns are always at the end of the column names
@@ -2513,27 +2829,36 @@ View<t_ctx1>::to_columns(
         if ((c - 1) > columns_length - hidden) {
             continue;
         }
-        write_column(
-            c,
-            start_row,
-            end_row,
-            true,
-            leaves_only,
-            is_formatted,
-            slice,
-            col_names,
-            writer
-        );
+        members.emplace_back([&, c](auto& writer) {
+            write_column(
+                c,
+                start_row,
+                end_row,
+                true,
+                leaves_only,
+                is_formatted,
+                slice,
+                col_names,
+                writer
+            );
+        });
     }
 
     if (get_pkeys) {
-        write_index_column(
-            start_row, end_row, true, leaves_only, is_formatted, slice, writer
-        );
+        members.emplace_back([&](auto& writer) {
+            write_index_column(
+                start_row,
+                end_row,
+                true,
+                leaves_only,
+                is_formatted,
+                slice,
+                writer
+            );
+        });
     }
 
-    writer.EndObject();
-    return s.GetString();
+    return write_json_object(members);
 }
 
 template <>
@@ -2558,28 +2883,30 @@ View<t_ctx2>::to_columns(
     PSP_READ_LOCK(*get_lock());
     const auto slice = get_data(start_row, end_row, start_col, end_col);
     const auto& col_names = slice->get_column_names();
-    rapidjson::StringBuffer s;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    writer.StartObject();
-    write_row_path(
-        start_row, end_row, has_row_path, leaves_only, is_formatted, writer
-    );
+    std::vector<t_json_member> members;
+    members.emplace_back([&](auto& writer) {
+        write_row_path(
+            start_row, end_row, has_row_path, leaves_only, is_formatted, writer
+        );
+    });
 
     if (get_ids) {
-        writer.Key("__ID__");
-        writer.StartArray();
-        for (auto r = start_row; r < end_row; ++r) {
+        members.emplace_back([&](auto& writer) {
+            writer.Key("__ID__");
             writer.StartArray();
-            const auto row_path = m_ctx->get_row_path(r);
-            for (auto entry = row_path.size(); entry > 0; entry--) {
-                const t_tscalar& scalar = row_path[entry - 1];
-                write_scalar(scalar, is_formatted, writer);
+            for (auto r = start_row; r < end_row; ++r) {
+                writer.StartArray();
+                const auto row_path = m_ctx->get_row_path(r);
+                for (auto entry = row_path.size(); entry > 0; entry--) {
+                    const t_tscalar& scalar = row_path[entry - 1];
+                    write_scalar(scalar, is_formatted, writer);
+                }
+
+                writer.EndArray();
             }
 
             writer.EndArray();
-        }
-
-        writer.EndArray();
+        });
     }
 
     LOG_DEBUG("Using ctx2 to_columns");
@@ -2592,33 +2919,36 @@ View<t_ctx2>::to_columns(
             continue;
         }
         LOG_DEBUG("Writing column {}" << col_path_to_legacy(col_names[c]));
-        write_column(
-            c,
-            start_row,
-            end_row,
-            has_row_path,
-            leaves_only,
-            is_formatted,
-            slice,
-            col_names,
-            writer
-        );
+        members.emplace_back([&, c](auto& writer) {
+            write_column(
+                c,
+                start_row,
+                end_row,
+                has_row_path,
+                leaves_only,
+                is_formatted,
+                slice,
+                col_names,
+                writer
+            );
+        });
     }
 
     if (get_pkeys) {
-        write_index_column(
-            start_row,
-            end_row,
-            has_row_path,
-            leaves_only,
-            is_formatted,
-            slice,
-            writer
-        );
+        members.emplace_back([&](auto& writer) {
+            write_index_column(
+                start_row,
+                end_row,
+                has_row_path,
+                leaves_only,
+                is_formatted,
+                slice,
+                writer
+            );
+        });
     }
 
-    writer.EndObject();
-    return s.GetString();
+    return write_json_object(members);
 }
 
 template <typename CTX_T>
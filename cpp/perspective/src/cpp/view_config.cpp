@@ -442,6 +442,12 @@ t_view_config::make_aggspec(
         aggspec = t_aggspec(column, agg_type, dependencies);
     }
 
+    // An optional trailing "indexed" opts order-statistic aggregates into a
+    // per-node index, e.g. `["median", "indexed"]`.
+    if (aggregate.size() > 1 && aggregate.back() == "indexed") {
+        aggspec.set_order_index(true);
+    }
+
     m_aggspecs.push_back(aggspec);
     m_aggregate_names.push_back(column);
 }
@@ -14,6 +14,7 @@
 #include <perspective/vocab.h>
 #include <tsl/hopscotch_set.h>
 
+#include <cstring>
 #include <memory>
 
 namespace perspective {
@@ -58,6 +59,75 @@ t_vocab::reserve(size_t total_string_size, size_t string_count) {
     rebuild_map();
 }
 
+std::vector<t_uindex>
+t_vocab::compact(const std::vector<bool>& live) {
+    std::vector<t_uindex> remap(m_vlenidx, 0);
+
+    if (m_vlenidx == 0) {
+        return remap;
+    }
+
+    t_extent_pair* extents = get_extents_base();
+    unsigned char* base = get_vlen_base();
+    t_uindex nidx = 0;
+    t_uindex offset = 0;
+
+    // Offsets only ever grow with the id, so every string moves down into
+    // space that has already been read.
+    for (t_uindex idx = 0; idx < m_vlenidx; ++idx) {
+        if (idx != 0 && !(idx < live.size() && live[idx])) {
+            continue;
+        }
+
+        t_extent_pair extent = extents[idx];
+        t_uindex len = extent.m_end - extent.m_begin;
+
+        if (extent.m_begin != offset) {
+            std::memmove(base + offset, base + extent.m_begin, len);
+        }
+
+        extents[nidx].m_begin = offset;
+        extents[nidx].m_end = offset + len;
+        remap[idx] = nidx;
+        offset += len;
+        ++nidx;
+    }
+
+    if (nidx == m_vlenidx) {
+        return remap;
+    }
+
+    m_vlenidx = nidx;
+    m_vlendata->set_size(offset);
+    m_extents->set_size(nidx * sizeof(t_extent_pair));
+    m_vlendata->shrink(offset);
+    m_extents->shrink(nidx * sizeof(t_extent_pair));
+    rebuild_map();
+    return remap;
+}
+
+t_uindex
+t_vocab::reclaimable_bytes(const std::vector<bool>& live) const {
+    t_uindex rv = 0;
+
+    if (m_vlenidx < 2) {
+        return rv;
+    }
+
+    const auto* extents = m_extents->get_nth<t_extent_pair>(0);
+
+    for (t_uindex idx = 1; idx < m_vlenidx; ++idx) {
+        if (idx < live.size() && live[idx]) {
+            continue;
+        }
+
+        rv += extents[idx].m_end - extents[idx].m_begin;
+        rv += sizeof(t_extent_pair);
+    }
+
+    return rv;
+}
+
 bool
 t_vocab::string_exists(const char* c, t_uindex& interned) const {
     auto iter = m_map.find(c);
@@ -98,6 +98,20 @@ public:
 
     bool is_non_delta() const;
 
+    /**
+     * @brief Whether this aggregate can be maintained by a per-node
+     * `t_order_index` (median, min, max, high minus low and distinct count).
+     */
+    bool supports_order_index() const;
+
+    /**
+     * @brief Opt this aggregate into a per-node order-statistics index, which
+     * trades memory proportional to the number of rows under each node for
+     * O(log n) updates. Ignored for aggregates that do not support one.
+     */
+    void set_order_index(bool enabled);
+    bool has_order_index() const;
+
     std::string get_first_depname() const;
 
 private:
@@ -112,6 +126,7 @@ private:
     double m_agg_one_weight;
     double m_agg_two_weight;
     t_invmode m_invmode;
+    bool m_order_index = false;
     // t_uindex m_kernel;
 };
 
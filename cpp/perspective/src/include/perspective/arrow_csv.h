@@ -11,6 +11,7 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 #pragma once
+#include <string_view>
 #include <unordered_map>
 #include <arrow/io/memory.h>
 #include <arrow/table.h>
@@ -18,7 +19,7 @@
 namespace perspective {
 namespace apachearrow {
 
-    std::optional<int64_t> parseAsArrowTimestamp(const std::string& input);
+    std::optional<int64_t> parseAsArrowTimestamp(std::string_view input);
 
     /**
      * @brief Initialize the arrow loader with a CSV.
@@ -41,6 +41,16 @@ namespace apachearrow {
          */
         void initialize(const std::uint8_t* ptr, std::uint32_t);
 
+        /**
+         * @brief Initialize the arrow loader with a binary it shares
+         * ownership of. Primitive columns loaded from it are borrowed
+         * (zero-copy) by the filled `t_data_table` rather than copied, and
+         * keep `data` alive until they are mutated or released.
+         *
+         * @param data
+         */
+        void initialize(std::shared_ptr<const std::string> data);
+
         /**
          * @brief Initialize the arrow loader with a CSV.
          *
@@ -90,6 +100,10 @@ namespace apachearrow {
         );
 
         std::shared_ptr<arrow::Table> m_table;
+
+        // Keeps the memory behind `m_table`'s buffers alive for columns
+        // which borrow it; `nullptr` if the loader doesn't own that memory.
+        std::shared_ptr<const void> m_owner;
         std::vector<std::string> m_names;
         std::vector<t_dtype> m_types;
     };
@@ -109,5 +123,11 @@ namespace apachearrow {
         const int64_t len
     );
 
+    bool borrow_array(
+        const std::shared_ptr<t_column>& dest,
+        const std::shared_ptr<arrow::Array>& src,
+        const std::shared_ptr<const void>& owner
+    );
+
 } // namespace apachearrow
 } // namespace perspective
\ No newline at end of file
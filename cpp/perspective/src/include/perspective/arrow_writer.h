@@ -18,6 +18,7 @@
 #include <perspective/scalar.h>
 #include <perspective/data_table.h>
 #include <perspective/get_data_extents.h>
+#include <perspective/rlookup.h>
 #include <perspective/last.h>
 
 #include <arrow/api.h>
@@ -62,6 +63,29 @@ namespace apachearrow {
         t_get_data_extents extents
     );
 
+    /**
+     * @brief Return `val` as a count of days since the Unix epoch, which is
+     * how Arrow's `date32` stores dates.
+     *
+     * @param val
+     * @return std::int32_t
+     */
+    std::int32_t get_days_since_epoch(t_date val);
+
+    /**
+     * @brief Build an `arrow::Array` by gathering `rows` straight out of
+     * `column`, without materializing a `t_tscalar` per cell. Rows that do
+     * not exist or are invalid are written as nulls. String columns become
+     * dictionary arrays over the vocabulary ids referenced by `rows`, in the
+     * same first-appearance order `string_col_to_dictionary_array` produces.
+     *
+     * @param column
+     * @param rows
+     * @return std::shared_ptr<arrow::Array>
+     */
+    std::shared_ptr<arrow::Array>
+    column_to_array(const t_column& column, const std::vector<t_rlookup>& rows);
+
     /**
      * @brief Build an `arrow::Array` from a column typed as `DTYPE_BOOL.`
      *
@@ -288,18 +312,9 @@ namespace apachearrow {
         for (int ridx = extents.m_srow; ridx < extents.m_erow; ++ridx) {
             t_tscalar scalar = f(ridx);
             if (scalar.is_valid() && scalar.get_dtype() != DTYPE_NONE) {
-                t_date val = scalar.get<t_date>();
-                // years are signed, while month/days are unsigned
-                date::year year{val.year()};
-                // Increment month by 1, as date::month is [1-12] but
-                // t_date::month() is [0-11]
-                date::month month{static_cast<std::uint32_t>(val.month() + 1)};
-                date::day day{static_cast<std::uint32_t>(val.day())};
-                date::year_month_day ymd(year, month, day);
-                date::sys_days days_since_epoch = ymd;
-                array_builder.UnsafeAppend(static_cast<std::int32_t>(
-                    days_since_epoch.time_since_epoch().count()
-                ));
+                array_builder.UnsafeAppend(
+                    get_days_since_epoch(scalar.get<t_date>())
+                );
             } else {
                 array_builder.UnsafeAppendNull();
             }
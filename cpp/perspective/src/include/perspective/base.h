@@ -48,6 +48,7 @@ const t_index INVALID_INDEX = -1;
 #define DEFAULT_CAPACITY 4000
 #define DEFAULT_CHUNK_SIZE 4000
 #define DEFAULT_EMPTY_CAPACITY 8
+#define DEFAULT_ARROW_CHUNK_ROWS 65536
 #define ROOT_AGGIDX 0
 #ifndef CHAR_BIT
 #define CHAR_BIT 8
@@ -23,14 +23,14 @@
 #include <functional>
 #include <limits>
 #include <cmath>
+#include <type_traits>
 #include <tsl/hopscotch_map.h>
 
 /*
 TODO -
-1. Implement implicit typepunning based on cardinality.
-2. No pointers should be returned from columns. Only
+1. No pointers should be returned from columns. Only
 accessors!
-3. Add get_nth for strings
+2. Add get_nth for strings
 */
 
 namespace perspective {
@@ -49,6 +49,15 @@ class t_column;
 #define COLUMN_CHECK_STRCOL()
 #endif
 
+/**
+ * @brief A column of fixed-width values (or vocabulary ids, for strings)
+ * with an optional status per row.
+ *
+ * Row statuses are bit-packed, 64 rows to a word, so writing the status of
+ * one row reads and rewrites its neighbours' - unlike the data, the rows of
+ * a column must not be written from more than one thread at a time. Code
+ * that fills a table in parallel partitions the work by column.
+ */
 class PERSPECTIVE_EXPORT t_column {
 public:
 #ifdef PSP_DBG_MALLOC
@@ -107,7 +116,7 @@ public:
     const T* get_nth(t_uindex idx) const;
 
     // idx is in items
-    const t_status* get_nth_status(t_uindex idx) const;
+    t_status get_nth_status(t_uindex idx) const;
 
     // idx is in items
     template <typename T>
@@ -141,6 +150,41 @@ public:
 
     const char* unintern_c(t_uindex idx) const;
 
+    /**
+     * @brief The width in bytes - 1, 2, 4 or 8 - of each vocabulary id in
+     * a string column. Columns start out 1 byte wide and are widened as
+     * their vocabulary grows, so low-cardinality columns stay small.
+     */
+    std::uint32_t get_vocab_index_width() const;
+
+    /**
+     * @brief Bytes per row of a new column of `dtype` - for string columns,
+     * the initial vocabulary id width.
+     */
+    static std::uint32_t get_initial_elemsize(t_dtype dtype);
+
+    // idx is in items
+    t_uindex get_vocab_index(t_uindex idx) const;
+
+    /**
+     * @brief Store vocabulary id `vidx` at row `idx`, widening the column
+     * first if `vidx` does not fit. Status is left untouched.
+     */
+    void set_vocab_index(t_uindex idx, t_uindex vidx);
+
+    /**
+     * @brief Call `fn` with a pointer to this string column's vocabulary
+     * ids, typed `std::uint8_t`, `std::uint16_t`, `std::uint32_t` or
+     * `std::uint64_t` to match `get_vocab_index_width()`.
+     */
+    void push_back_vocab_index(t_uindex vidx, t_status status);
+
+    template <typename FN_T>
+    void visit_vocab_indices(FN_T fn) const;
+
+    template <typename FN_T>
+    void visit_vocab_indices(FN_T fn);
+
     // Internal apis
 
     t_lstore* _get_data_lstore();
@@ -156,10 +200,63 @@ public:
 
     bool is_cleared(t_uindex idx) const;
 
+    /**
+     * @brief The validity bitmap, where bit `idx % 64` of word `idx / 64` is
+     * set if row `idx` is `STATUS_VALID`. On little-endian targets this is
+     * byte-for-byte an Arrow validity bitmap.
+     */
+    const std::uint64_t* get_validity_words() const;
+
+    /**
+     * @brief The bitmap of `STATUS_CLEAR` rows, in the same layout as
+     * `get_validity_words()`.
+     */
+    const std::uint64_t* get_cleared_words() const;
+
+    static bool test_bit(const std::uint64_t* words, t_uindex idx);
+
+    /**
+     * @brief Set the status of rows `[offset, offset + size)` from an Arrow
+     * validity bitmap, read from bit `bit_offset` of `bitmap`. Set bits
+     * become `STATUS_VALID` and unset bits `invalid_status`; a null `bitmap`
+     * marks every row valid. Data is left untouched.
+     */
+    void set_validity(
+        const std::uint8_t* bitmap,
+        t_uindex bit_offset,
+        t_uindex offset,
+        t_uindex size,
+        t_status invalid_status
+    );
+
     bool is_vlen() const;
 
     void append(const t_column& other);
 
+    /**
+     * @brief Point this column's data at `size` elements of memory owned by
+     * `owner` rather than copying them; see `t_lstore::borrow()`. Only
+     * fixed-width columns can borrow. Validity is left untouched.
+     */
+    bool borrow_data(
+        std::shared_ptr<const void> owner, const void* base, t_uindex size
+    );
+
+    /**
+     * @brief Share `other`'s borrowed data and copy its validity, if `other`
+     * is borrowed and has no invalid rows, i.e. if this column would
+     * otherwise become an element-for-element copy of `other`.
+     */
+    bool borrow_data(const t_column& other);
+
+    /**
+     * @brief Copy any borrowed data into memory owned by this column and
+     * release its owner; see `t_lstore::detach()`.
+     */
+    void detach_data();
+
+    bool is_data_borrowed() const;
+
     void clear();
     void clear_objects() const;
 
@@ -217,11 +314,59 @@ public:
 
     t_uindex get_interned(const std::string& s);
     t_uindex get_interned(const char* s);
+
+    /**
+     * @brief Look up the vocabulary id of `s` without interning it, for
+     * readers which must not widen or otherwise modify the column. Returns
+     * false if `s` is not in this column's vocabulary.
+     *
+     * @param s
+     * @param interned
+     * @return bool
+     */
+    bool string_exists(const char* s, t_uindex& interned) const;
     void _rebuild_map();
 
     void borrow_vocabulary(const t_column& o);
 
+    /**
+     * @brief Rebuild this string column's vocabulary from the strings that
+     * rows set in `live_rows` point at, and rewrite every row's id in place.
+     * Rows outside `live_rows` are pointed at id 0, as if cleared. The
+     * vocabulary must not be shared with another column. Returns the new id
+     * for each old id, or 0 for strings that were dropped.
+     *
+     * @param live_rows
+     * @return std::vector<t_uindex>
+     */
+    std::vector<t_uindex> compact_vocabulary(const t_mask& live_rows);
+
+    /**
+     * @brief The number of vocabulary bytes `compact_vocabulary(live_rows)`
+     * would release.
+     *
+     * @param live_rows
+     * @return t_uindex
+     */
+    t_uindex get_reclaimable_vocab_bytes(const t_mask& live_rows) const;
+
 private:
+    std::vector<bool> get_live_vocabulary(const t_mask& live_rows) const;
+
+    // Widen the column's vocabulary ids so that `vidx` can be stored.
+    void fit_vocab_index(t_uindex vidx);
+    void set_vocab_index_width(std::uint32_t width);
+    void push_back_vocab_index(t_uindex vidx);
+
+    static t_uindex get_status_bytes(t_uindex size);
+
+    // Not safe against concurrent writes to rows sharing the same 64-bit
+    // word, see the class comment.
+    void store_status(t_uindex idx, t_status status);
+    void push_back_status(t_status status);
+    void resize_status(t_uindex size);
+    void append_status(const t_column& other);
+
     t_dtype m_dtype;
     bool m_init;
     bool m_isvlen;
@@ -232,8 +377,12 @@ private:
 
     std::shared_ptr<t_vocab> m_vocab;
 
-    // Missing value support
+    // Missing value support - a bitmap of valid rows and one of cleared
+    // rows, each stored as 64-bit words. `m_status_size` counts the rows
+    // they hold.
     std::shared_ptr<t_lstore> m_status;
+    std::shared_ptr<t_lstore> m_cleared;
+    t_uindex m_status_size;
 
     t_uindex m_size;
 
@@ -241,6 +390,7 @@ private:
 
     bool m_from_recipe;
 
+    // Bytes per row; for string columns, the vocabulary id width.
     std::uint32_t m_elemsize;
 };
 
@@ -285,7 +435,7 @@ t_column::get(t_uindex idx) {
 template <typename T>
 const T*
 t_column::get(t_uindex idx) const {
-    return m_data->get<T>(idx);
+    return static_cast<const t_lstore&>(*m_data).get<T>(idx);
 }
 
 template <typename T>
@@ -299,7 +449,7 @@ template <typename T>
 const T*
 t_column::get_nth(t_uindex idx) const {
     COLUMN_CHECK_ACCESS(idx);
-    return m_data->get_nth<T>(idx);
+    return static_cast<const t_lstore&>(*m_data).get_nth<T>(idx);
 }
 
 template <typename T>
@@ -328,10 +478,115 @@ void
 t_column::push_back(DATA_T elem, t_status status) {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Validity not enabled for column");
     m_data->push_back(elem);
-    m_status->push_back(status);
+    push_back_status(status);
     ++m_size;
 }
 
+inline bool
+t_column::test_bit(const std::uint64_t* words, t_uindex idx) {
+    return ((words[idx / 64] >> (idx % 64)) & 1) != 0;
+}
+
+inline void
+t_column::store_status(t_uindex idx, t_status status) {
+    std::uint64_t bit = std::uint64_t(1) << (idx % 64);
+    auto* valid = m_status->get_nth<std::uint64_t>(idx / 64);
+    auto* cleared = m_cleared->get_nth<std::uint64_t>(idx / 64);
+    *valid = status == STATUS_VALID ? (*valid | bit) : (*valid & ~bit);
+    *cleared = status == STATUS_CLEAR ? (*cleared | bit) : (*cleared & ~bit);
+}
+
+inline t_uindex
+t_column::get_vocab_index(t_uindex idx) const {
+    COLUMN_CHECK_ACCESS(idx);
+    const t_lstore& data = *m_data;
+    switch (m_elemsize) {
+        case 1: {
+            return *(data.get_nth<std::uint8_t>(idx));
+        }
+        case 2: {
+            return *(data.get_nth<std::uint16_t>(idx));
+        }
+        case 4: {
+            return *(data.get_nth<std::uint32_t>(idx));
+        }
+        default: {
+            return *(data.get_nth<std::uint64_t>(idx));
+        }
+    }
+}
+
+inline void
+t_column::fit_vocab_index(t_uindex vidx) {
+    std::uint32_t width = m_elemsize;
+    while (width < sizeof(std::uint64_t) && (vidx >> (8 * width)) != 0) {
+        width *= 2;
+    }
+
+    if (width != m_elemsize) {
+        set_vocab_index_width(width);
+    }
+}
+
+inline void
+t_column::set_vocab_index(t_uindex idx, t_uindex vidx) {
+    COLUMN_CHECK_ACCESS(idx);
+    fit_vocab_index(vidx);
+    switch (m_elemsize) {
+        case 1: {
+            m_data->set_nth<std::uint8_t>(idx, vidx);
+        } break;
+        case 2: {
+            m_data->set_nth<std::uint16_t>(idx, vidx);
+        } break;
+        case 4: {
+            m_data->set_nth<std::uint32_t>(idx, vidx);
+        } break;
+        default: {
+            m_data->set_nth<std::uint64_t>(idx, vidx);
+        }
+    }
+}
+
+template <typename FN_T>
+void
+t_column::visit_vocab_indices(FN_T fn) const {
+    const t_lstore& data = *m_data;
+    switch (m_elemsize) {
+        case 1: {
+            fn(data.get_nth<std::uint8_t>(0));
+        } break;
+        case 2: {
+            fn(data.get_nth<std::uint16_t>(0));
+        } break;
+        case 4: {
+            fn(data.get_nth<std::uint32_t>(0));
+        } break;
+        default: {
+            fn(data.get_nth<std::uint64_t>(0));
+        }
+    }
+}
+
+template <typename FN_T>
+void
+t_column::visit_vocab_indices(FN_T fn) {
+    switch (m_elemsize) {
+        case 1: {
+            fn(m_data->get_nth<std::uint8_t>(0));
+        } break;
+        case 2: {
+            fn(m_data->get_nth<std::uint16_t>(0));
+        } break;
+        case 4: {
+            fn(m_data->get_nth<std::uint32_t>(0));
+        } break;
+        default: {
+            fn(m_data->get_nth<std::uint64_t>(0));
+        }
+    }
+}
+
 // idx is in items
 
 template <typename T>
@@ -341,7 +596,7 @@ t_column::set_nth(t_uindex idx, T v) {
     m_data->set_nth<T>(idx, v);
 
     if (is_status_enabled()) {
-        m_status->set_nth<t_status>(idx, STATUS_VALID);
+        store_status(idx, STATUS_VALID);
     }
 }
 
@@ -352,7 +607,7 @@ t_column::set_nth(t_uindex idx, T v, t_status status) {
     m_data->set_nth<T>(idx, v);
 
     if (is_status_enabled()) {
-        m_status->set_nth<t_status>(idx, status);
+        store_status(idx, status);
     }
 }
 
@@ -367,6 +622,17 @@ t_column::fill(VEC_T& vec, const t_uindex* bidx, const t_uindex* eidx) const {
 
     PSP_VERBOSE_ASSERT(eidx - bidx > 0, "Invalid pointers passed in");
 
+    // String columns are read as their vocabulary ids, whatever the width.
+    if constexpr (std::is_integral_v<typename VEC_T::value_type>) {
+        if (m_dtype == DTYPE_STR) {
+            for (t_uindex idx = 0, loop_end = eidx - bidx; idx < loop_end;
+                 ++idx) {
+                vec[idx] = get_vocab_index(*(bidx + idx));
+            }
+            return;
+        }
+    }
+
     for (t_uindex idx = 0, loop_end = eidx - bidx; idx < loop_end; ++idx)
 
     {
@@ -380,10 +646,10 @@ t_column::set_nth_body(t_uindex idx, DATA_T elem, t_status status) {
     COLUMN_CHECK_ACCESS(idx);
     PSP_VERBOSE_ASSERT(m_dtype == DTYPE_STR, "Setting non string column");
     t_uindex interned = m_vocab->get_interned(elem);
-    m_data->set_nth<t_uindex>(idx, interned);
+    set_vocab_index(idx, interned);
 
     if (is_status_enabled()) {
-        m_status->set_nth<t_status>(idx, status);
+        store_status(idx, status);
     }
 }
 
@@ -436,7 +702,7 @@ t_column::copy_helper(
 
     if (is_status_enabled() && other->is_status_enabled()) {
         for (t_uindex idx = 0; idx < eidx; ++idx) {
-            set_status(idx + offset, *other->get_nth_status(indices[idx]));
+            set_status(idx + offset, other->get_nth_status(indices[idx]));
         }
     }
     COLUMN_CHECK_VALUES();
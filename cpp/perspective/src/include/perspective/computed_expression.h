@@ -21,8 +21,10 @@
 #include <perspective/rlookup.h>
 #include <perspective/computed_function.h>
 #include <perspective/gnode_state.h>
+#include <perspective/expression_bytecode.h>
 #include <date/date.h>
 #include <tsl/hopscotch_set.h>
+#include <shared_mutex>
 
 // a header that includes exprtk and overload definitions for `t_tscalar` so
 // it can be used inside exprtk.
@@ -64,6 +66,28 @@ public:
         t_regex_mapping& regex_mapping
     ) const;
 
+    /**
+     * @brief Compute every expression in `expressions` from `source_table`
+     * into `destination_table`. The output columns are created before any
+     * expression is computed, which leaves each expression writing to its
+     * own column so that they can be computed in parallel.
+     *
+     * @param expressions
+     * @param source_table
+     * @param pkey_map
+     * @param destination_table
+     * @param vocab
+     * @param regex_mapping
+     */
+    static void compute_all(
+        const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+        const std::shared_ptr<t_data_table>& source_table,
+        const t_gstate::t_mapping& pkey_map,
+        const std::shared_ptr<t_data_table>& destination_table,
+        t_expression_vocab& vocab,
+        t_regex_mapping& regex_mapping
+    );
+
     const std::string& get_expression_alias() const;
     const std::string& get_expression_string() const;
     const std::string& get_parsed_expression_string() const;
@@ -77,6 +101,10 @@ private:
     std::string m_parsed_expression_string;
     std::vector<std::pair<std::string, std::string>> m_column_ids;
     t_dtype m_dtype;
+
+    // Arithmetic-only expressions are also lowered to bytecode, which
+    // `compute` runs instead of ExprTk where it can.
+    t_expression_bytecode m_bytecode;
 };
 
 class PERSPECTIVE_EXPORT t_computed_expression_parser {
@@ -147,6 +175,10 @@ public:
 
     static std::shared_ptr<exprtk::parser<t_tscalar>> PARSER;
 
+    // `PARSER` is shared by every table, so compilation (and reading back
+    // the parser's errors) is serialized when tables update concurrently.
+    static std::shared_mutex PARSER_LOCK;
+
     // Applied to the parser
     static std::size_t PARSER_COMPILE_OPTIONS;
 
@@ -100,28 +100,6 @@ t_uindex num_expressions() const;
 
 std::shared_ptr<t_expression_tables> get_expression_tables() const;
 
-// Given shared pointers to data tables from the gnode, use them to
-// compute the results of expression columns.
-void compute_expressions(
-    const std::shared_ptr<t_data_table>& master,
-    const t_gstate::t_mapping& pkey_map,
-    t_expression_vocab& expression_vocab,
-    t_regex_mapping& regex_mapping
-);
-
-void compute_expressions(
-    const std::shared_ptr<t_data_table>& master,
-    const t_gstate::t_mapping& pkey_map,
-    const std::shared_ptr<t_data_table>& flattened,
-    const std::shared_ptr<t_data_table>& delta,
-    const std::shared_ptr<t_data_table>& prev,
-    const std::shared_ptr<t_data_table>& current,
-    const std::shared_ptr<t_data_table>& transitions,
-    const std::shared_ptr<t_data_table>& existed,
-    t_expression_vocab& expression_vocab,
-    t_regex_mapping& regex_mapping
-);
-
 // Unity api
 std::vector<t_tscalar> unity_get_row_data(t_uindex idx) const;
 std::vector<t_tscalar> unity_get_column_data(t_uindex idx) const;
@@ -23,6 +23,7 @@
 #include <perspective/expression_tables.h>
 #include <perspective/expression_vocab.h>
 #include <perspective/regex.h>
+#include <functional>
 
 namespace perspective {
 
@@ -61,6 +62,13 @@ public:
 
     using t_ctxbase<t_ctx2>::get_data;
 
+    /**
+     * @brief The wall time in milliseconds that the last `notify` spent on
+     * each tree, indexed as `m_trees` - the first tree is the column tree
+     * and the last the row tree, with one tree per row pivot depth between.
+     */
+    const std::vector<double>& get_tree_notify_times() const;
+
 protected:
     std::vector<t_cellinfo>
     resolve_cells(const std::vector<std::pair<t_uindex, t_uindex>>& cells
@@ -81,6 +89,43 @@ protected:
 
     t_uindex calc_translated_colidx(t_uindex n_aggs, t_uindex cidx) const;
 
+    typedef std::function<void(
+        const std::shared_ptr<t_stree>& tree,
+        const std::shared_ptr<t_traversal>& traversal,
+        bool process_traversal,
+        const std::vector<t_sortspec>& sortby
+    )>
+        t_notify_tree_fn;
+
+    /**
+     * @brief Call `notify_tree` once for each tree, with the traversal and
+     * sort that belong to it, running the trees in parallel and recording
+     * the time each one took.
+     */
+    void notify_trees(const t_notify_tree_fn& notify_tree);
+
+    /**
+     * @brief Build the tree at `treeidx` from its pivots, without data.
+     */
+    std::shared_ptr<t_stree> make_tree(t_uindex treeidx) const;
+
+    /**
+     * @brief Whether the tree at `treeidx` holds data and is notified. The
+     * row and column trees always are; the trees between them are not
+     * when lazy row trees are enabled and no row at their depth is
+     * visible in the row traversal.
+     */
+    bool is_tree_materialized(t_uindex treeidx) const;
+
+    /**
+     * @brief With lazy row trees enabled, materialize the intermediate
+     * trees for every depth the row traversal currently shows from the
+     * gnode state, and release the ones for depths it no longer shows.
+     * Must be called whenever the row traversal's depth may have changed,
+     * before its cells are read or sorted.
+     */
+    void update_row_trees();
+
 private:
     std::shared_ptr<t_traversal> m_rtraversal;
     std::shared_ptr<t_traversal> m_ctraversal;
@@ -93,6 +138,12 @@ private:
     t_depth m_column_depth;
     bool m_column_depth_set;
     std::shared_ptr<t_expression_tables> m_expression_tables;
+    std::vector<double> m_tree_notify_times;
+
+    // Set from `PSP_CTX2_LAZY_ROW_TREES` - when enabled, `m_tree_materialized`
+    // tracks which intermediate trees currently hold data.
+    bool m_lazy_row_trees;
+    std::vector<bool> m_tree_materialized;
 };
 
 } // end namespace perspective
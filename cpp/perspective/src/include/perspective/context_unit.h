@@ -67,6 +67,28 @@ public:
 
     std::vector<t_tscalar> get_data(const std::vector<t_tscalar>& pkeys) const;
 
+    /**
+     * @brief Write the master table row of each view row in
+     * [start_row, end_row) to `out`, so columns returned by
+     * `get_master_column` can be read without a pkey lookup per cell.
+     *
+     * @param start_row
+     * @param end_row
+     * @param out
+     */
+    void get_master_rows(
+        t_index start_row, t_index end_row, std::vector<t_rlookup>& out
+    ) const;
+
+    /**
+     * @brief Return the column backing the view column at `idx`, as stored
+     * in the table `get_master_rows` indexes into.
+     *
+     * @param idx
+     * @return std::shared_ptr<const t_column>
+     */
+    std::shared_ptr<const t_column> get_master_column(t_uindex idx) const;
+
     // will only work on empty contexts
     void notify(const t_data_table& flattened);
 
@@ -243,6 +243,15 @@ protected:
         const t_column* scol,
         t_column* dcol
     ) const;
+
+    // As `flatten_helper_2`, for the vocabulary ids of a string column.
+    template <typename ROWPACK_VEC_T>
+    void flatten_helper_str(
+        ROWPACK_VEC_T& sorted,
+        std::vector<t_flatten_record>& fltrecs,
+        const t_column* scol,
+        t_column* dcol
+    ) const;
     std::string repr() const;
 
 private:
@@ -335,7 +344,7 @@ t_data_table::flatten_helper_2(
              --spanidx) {
             const auto& sort_rec = sorted[spanidx];
             fragidx = sort_rec.m_idx;
-            status = *(scol->get_nth_status(fragidx));
+            status = scol->get_nth_status(fragidx);
             if (status != STATUS_INVALID) {
                 added = true;
                 break;
@@ -350,6 +359,38 @@ t_data_table::flatten_helper_2(
     }
 }
 
+template <typename ROWPACK_VEC_T>
+void
+t_data_table::flatten_helper_str(
+    ROWPACK_VEC_T& sorted,
+    std::vector<t_flatten_record>& fltrecs,
+    const t_column* scol,
+    t_column* dcol
+) const {
+    for (const auto& rec : fltrecs) {
+        bool added = false;
+        t_index fragidx = 0;
+        t_status status = STATUS_INVALID;
+        for (t_index spanidx = rec.m_eidx - 1; spanidx >= t_index(rec.m_bidx);
+             --spanidx) {
+            const auto& sort_rec = sorted[spanidx];
+            fragidx = sort_rec.m_idx;
+            status = scol->get_nth_status(fragidx);
+            if (status != STATUS_INVALID) {
+                added = true;
+                break;
+            }
+        }
+
+        if (added) {
+            dcol->set_vocab_index(
+                rec.m_store_idx, scol->get_vocab_index(fragidx)
+            );
+            dcol->set_status(rec.m_store_idx, status);
+        }
+    }
+}
+
 template <typename FLATTENED_T, typename PKEY_T>
 void
 t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
@@ -380,9 +421,15 @@ t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
 
     typedef std::vector<t_rowpack<PKEY_T>> t_rpvec;
 
+    // String keys are flattened by their vocabulary ids, which are read and
+    // written through the column at whatever width it stores them.
+    bool str_pkey = s_pkey_col->get_dtype() == DTYPE_STR;
+
     std::vector<t_rowpack<PKEY_T>> sorted(frags_size);
     for (t_uindex fragidx = 0; fragidx < frags_size; ++fragidx) {
-        sorted[fragidx].m_pkey = *(s_pkey_col->get_nth<PKEY_T>(fragidx));
+        sorted[fragidx].m_pkey = str_pkey
+            ? static_cast<PKEY_T>(s_pkey_col->get_vocab_index(fragidx))
+            : *(s_pkey_col->get_nth<PKEY_T>(fragidx));
         sorted[fragidx].m_pkey_is_valid = s_pkey_col->is_valid(fragidx);
         sorted[fragidx].m_op =
             static_cast<t_op>(*(s_op_col->get_nth<std::uint8_t>(fragidx)));
@@ -398,8 +445,12 @@ t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
         }
     };
 
+    // Batches whose keys are already in order - such as appends to an
+    // implicit `__INDEX__` - need no sort, and checking is a linear pass.
     t_packcomp cmp;
-    std::sort(sorted.begin(), sorted.end(), cmp);
+    if (!std::is_sorted(sorted.begin(), sorted.end(), cmp)) {
+        parallel_sort(sorted, cmp);
+    }
 
     std::vector<t_index> edges;
     edges.push_back(0);
@@ -413,6 +464,16 @@ t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
 
     flattened->reserve(size());
 
+    auto push_pkey = [d_pkey_col, str_pkey](const t_rowpack<PKEY_T>& rec) {
+        t_status status = rec.m_pkey_is_valid ? t_status::STATUS_VALID
+                                              : t_status::STATUS_INVALID;
+        if (str_pkey) {
+            d_pkey_col->push_back_vocab_index(rec.m_pkey, status);
+        } else {
+            d_pkey_col->push_back(rec.m_pkey, status);
+        }
+    };
+
     std::vector<t_flatten_record> fltrecs;
 
     t_uindex store_idx = 0;
@@ -433,11 +494,7 @@ t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
 
         const auto& sort_rec = sorted[bidx];
         if (delete_encountered) {
-            d_pkey_col->push_back(
-                sort_rec.m_pkey,
-                sort_rec.m_pkey_is_valid ? t_status::STATUS_VALID
-                                         : t_status::STATUS_INVALID
-            );
+            push_pkey(sort_rec);
             std::uint8_t op8 = OP_DELETE;
             d_op_col->push_back(op8);
             ++store_idx;
@@ -450,11 +507,7 @@ t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
             rec.m_eidx = eidx;
             fltrecs.push_back(rec);
 
-            d_pkey_col->push_back(
-                sort_rec.m_pkey,
-                sort_rec.m_pkey_is_valid ? t_status::STATUS_VALID
-                                         : t_status::STATUS_INVALID
-            );
+            push_pkey(sort_rec);
 
             std::uint8_t op8 = OP_INSERT;
             d_op_col->push_back(op8);
@@ -465,11 +518,25 @@ t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
     flattened->set_size(store_idx);
     t_uindex ndata_cols = d_columns.size();
 
+    // Fragments which are already unique, in primary key order and free of
+    // deletes flatten to themselves, so borrowed (zero-copy) columns can be
+    // shared with `flattened` rather than copied row by row.
+    bool is_identity = store_idx == frags_size;
+    for (t_uindex idx = 0; is_identity && idx < frags_size; ++idx) {
+        is_identity = static_cast<t_uindex>(sorted[idx].m_idx) == idx
+            && sorted[idx].m_op != OP_DELETE;
+    }
+
     parallel_for(
         int(ndata_cols),
-        [&s_columns, &sorted, &d_columns, &fltrecs, this](int colidx) {
+        [&s_columns, &sorted, &d_columns, &fltrecs, is_identity, this](
+            int colidx
+        ) {
             auto scol = s_columns[colidx];
             auto dcol = d_columns[colidx];
+            if (is_identity && dcol->borrow_data(*scol)) {
+                return;
+            }
 
             switch (scol->get_dtype()) {
                 case DTYPE_INT64: {
@@ -538,7 +605,7 @@ t_data_table::flatten_helper_1(FLATTENED_T flattened) const {
                     );
                 } break;
                 case DTYPE_STR: {
-                    this->flatten_helper_2<t_uindex, t_rpvec>(
+                    this->flatten_helper_str<t_rpvec>(
                         sorted, fltrecs, scol, dcol
                     );
                 } break;
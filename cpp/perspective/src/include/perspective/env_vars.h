@@ -168,6 +168,36 @@ struct PERSPECTIVE_EXPORT t_env {
             std::getenv("PSP_BACKOUT_EQ_INVALID_INVALID") != 0;
         return rv;
     }
+
+    // Read on every call rather than cached, so the data slice path can be
+    // switched on and off within one process to compare it with the gather
+    // path.
+    static inline bool
+    backout_arrow_gather() {
+        return std::getenv("PSP_BACKOUT_ARROW_GATHER") != 0;
+    }
+
+    // Read on every call, so a test can run the same work with and without
+    // `parallel_for`'s thread pool and compare the results.
+    static inline bool
+    backout_parallel_for() {
+        return std::getenv("PSP_BACKOUT_PARALLEL_FOR") != 0;
+    }
+
+    // Read on every call, so expressions can be computed with and without
+    // the bytecode within one process to compare it with ExprTk.
+    static inline bool
+    backout_expression_bytecode() {
+        return std::getenv("PSP_BACKOUT_EXPRESSION_BYTECODE") != 0;
+    }
+
+    // Read on every call, as each `t_ctx2` reads it once when it is
+    // constructed, so lazy and eager contexts can run side by side in one
+    // process.
+    static inline bool
+    ctx2_lazy_row_trees() {
+        return std::getenv("PSP_CTX2_LAZY_ROW_TREES") != 0;
+    }
 };
 
 } // end namespace perspective
@@ -0,0 +1,107 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/raw_types.h>
+#include <perspective/column.h>
+#include <perspective/data_table.h>
+#include <string>
+#include <vector>
+
+namespace perspective {
+
+/**
+ * @brief A columnar program for arithmetic-only expressions, which evaluates
+ * blocks of rows over typed column buffers instead of running the ExprTk
+ * interpreter once per row.
+ *
+ * `compile` accepts numeric literals, column references, parentheses, unary
+ * `+`/`-` and the binary `+`, `-`, `*`, `/` and `%` operators - anything
+ * else is rejected so that the caller can fall back to ExprTk. Results
+ * follow `t_tscalar` arithmetic: they are `DTYPE_FLOAT64`, any invalid input
+ * makes the row invalid, as does dividing by (or taking the modulus of)
+ * zero.
+ */
+class PERSPECTIVE_EXPORT t_expression_bytecode {
+public:
+    enum t_opcode {
+        OPCODE_COLUMN,
+        OPCODE_CONSTANT,
+        OPCODE_ADD,
+        OPCODE_SUBTRACT,
+        OPCODE_MULTIPLY,
+        OPCODE_DIVIDE,
+        OPCODE_MODULUS,
+        OPCODE_NEGATE
+    };
+
+    struct t_instruction {
+        t_opcode m_opcode;
+
+        // Index into `m_column_names` for `OPCODE_COLUMN`.
+        t_uindex m_column;
+
+        // The value of an `OPCODE_CONSTANT`.
+        double m_constant;
+    };
+
+    t_expression_bytecode();
+
+    /**
+     * @brief Lower a parsed expression string (with column names replaced
+     * by the IDs in `column_ids`) to bytecode, returning false if the
+     * expression uses anything the bytecode cannot express.
+     *
+     * @param parsed_expression_string
+     * @param column_ids
+     * @return bool
+     */
+    bool compile(
+        const std::string& parsed_expression_string,
+        const std::vector<std::pair<std::string, std::string>>& column_ids
+    );
+
+    bool is_compiled() const;
+
+    /**
+     * @brief Whether every column the program reads exists in `source_table`
+     * with a dtype the bytecode can load.
+     */
+    bool can_evaluate(const t_data_table& source_table) const;
+
+    /**
+     * @brief Evaluate the program over every row of `source_table`, writing
+     * results to the `DTYPE_FLOAT64` column `output` and clearing rows whose
+     * result is invalid.
+     */
+    void evaluate(const t_data_table& source_table, t_column& output) const;
+
+private:
+    void evaluate_block(
+        const std::vector<const t_column*>& columns,
+        t_uindex bidx,
+        t_uindex eidx,
+        t_column& output,
+        std::vector<double>& values,
+        std::vector<std::uint8_t>& valid
+    ) const;
+
+    std::vector<t_instruction> m_program;
+    std::vector<std::string> m_column_names;
+    t_uindex m_stack_size;
+};
+
+} // end namespace perspective
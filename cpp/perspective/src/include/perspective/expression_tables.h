@@ -16,6 +16,7 @@
 #include <perspective/computed_expression.h>
 #include <perspective/data_table.h>
 #include <perspective/parallel_for.h>
+#include <map>
 
 namespace perspective {
 
@@ -24,6 +25,10 @@ namespace perspective {
  * columns from the main tables managed by the context, we ensure that cleaning
  * up a context will also clean up its expression columns and not leak memory
  * after the lifetime of a context.
+ *
+ * Once data has been computed, the columns are borrowed from the gnode's
+ * `t_expression_cache` and may be shared with other contexts, so they must
+ * be treated as read-only.
  */
 struct t_expression_tables {
 
@@ -53,6 +58,8 @@ struct t_expression_tables {
 
     void set_flattened(const std::shared_ptr<t_data_table>& flattened) const;
 
+    // Detach from the current (possibly shared) columns and start over with
+    // empty ones.
     void reset() const;
 
     t_data_table* get_table() const;
@@ -69,4 +76,107 @@ struct t_expression_tables {
     std::shared_ptr<t_data_table> m_transitions;
 };
 
+/**
+ * @brief Expression columns for every context registered on a gnode. Each
+ * expression is keyed by its parsed expression string and input columns, so
+ * an expression used by many contexts (under any alias) is stored and
+ * computed once per update, and each context's `t_expression_tables` borrows
+ * the shared columns under its own aliases.
+ */
+class t_expression_cache {
+public:
+    PSP_NON_COPYABLE(t_expression_cache);
+
+    t_expression_cache();
+
+    /**
+     * @brief Add a reference to each of `expressions`, returning the
+     * expressions that were not already in the cache - these have not been
+     * computed yet.
+     *
+     * @param expressions
+     * @return std::vector<std::shared_ptr<t_computed_expression>>
+     */
+    std::vector<std::shared_ptr<t_computed_expression>>
+    acquire(const std::vector<std::shared_ptr<t_computed_expression>>&
+                expressions);
+
+    /**
+     * @brief Remove a reference to each of `expressions`, dropping the
+     * columns of any expression that is no longer referenced.
+     *
+     * @param expressions
+     */
+    void release(const std::vector<std::shared_ptr<t_computed_expression>>&
+                     expressions);
+
+    // Compute `expressions`, as returned from `acquire`, on the master table.
+    void compute(
+        const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+        const std::shared_ptr<t_data_table>& master,
+        const t_gstate::t_mapping& pkey_map,
+        t_expression_vocab& expression_vocab,
+        t_regex_mapping& regex_mapping
+    ) const;
+
+    // Compute every cached expression on the master and transitional tables.
+    void compute(
+        const std::shared_ptr<t_data_table>& master,
+        const t_gstate::t_mapping& pkey_map,
+        const std::shared_ptr<t_data_table>& flattened,
+        const std::shared_ptr<t_data_table>& delta,
+        const std::shared_ptr<t_data_table>& prev,
+        const std::shared_ptr<t_data_table>& current,
+        const std::shared_ptr<t_data_table>& existed,
+        t_expression_vocab& expression_vocab,
+        t_regex_mapping& regex_mapping
+    ) const;
+
+    // Point the master columns of `tables` at the cached columns.
+    void share_master(
+        const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+        const t_expression_tables& tables
+    ) const;
+
+    // Point the master and transitional columns of `tables` at the cached
+    // columns.
+    void share(
+        const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+        const t_expression_tables& tables
+    ) const;
+
+    void reset() const;
+
+    bool empty() const;
+
+    const std::vector<std::shared_ptr<t_computed_expression>>&
+    get_expressions() const;
+
+    const std::shared_ptr<t_expression_tables>& get_tables() const;
+
+private:
+    struct t_entry {
+        std::shared_ptr<t_computed_expression> m_expression;
+        t_uindex m_refcount;
+    };
+
+    static std::string get_key(const t_computed_expression& expression);
+
+    // The name of the cached column for an expression that has been acquired.
+    const std::string&
+    get_column_name(const t_computed_expression& expression) const;
+
+    // Rebuild `m_tables` for the current set of expressions, keeping the
+    // columns that were already computed.
+    void rebuild_tables();
+
+    std::map<std::string, t_entry> m_entries;
+
+    // Cached expressions are aliased by the name of their column in
+    // `m_tables`, which is unique for the lifetime of the cache.
+    std::vector<std::shared_ptr<t_computed_expression>> m_expressions;
+    std::shared_ptr<t_expression_tables> m_tables;
+    t_uindex m_next_column_id;
+};
+
 } // end namespace perspective
\ No newline at end of file
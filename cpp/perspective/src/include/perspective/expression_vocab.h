@@ -14,6 +14,7 @@
 #include <perspective/first.h>
 #include <perspective/base.h>
 #include <perspective/vocab.h>
+#include <shared_mutex>
 
 namespace perspective {
 class PERSPECTIVE_EXPORT t_expression_vocab {
@@ -65,6 +66,9 @@ private:
 
     // An empty string for validation functions to use.
     std::string m_empty_string;
+
+    // Expressions on a context are computed in parallel and share the vocab.
+    std::shared_mutex m_lock;
 };
 
 } // end namespace perspective
\ No newline at end of file
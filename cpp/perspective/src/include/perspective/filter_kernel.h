@@ -0,0 +1,46 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/column.h>
+#include <perspective/exports.h>
+#include <perspective/filter.h>
+#include <perspective/mask.h>
+#include <vector>
+
+namespace perspective {
+
+/**
+ * @brief Evaluate `fterms` against `columns` (one column per term, in the
+ * same order) and return the combined mask over the first `nrows` rows.
+ *
+ * Each term is dispatched once on (dtype, operator) to a typed kernel that
+ * scans the raw column buffer and status array a block at a time, writing
+ * a word of the result bitmap per block. Terms that have no typed kernel
+ * fall back to `t_fterm::operator()` on a per-cell `t_tscalar`. Under
+ * `FILTER_OP_AND`, blocks with no surviving rows are skipped by every
+ * subsequent term; under `FILTER_OP_OR`, blocks that are already full are.
+ *
+ * `fterms` must already be coerced to their column's dtype, and string
+ * `m_use_interned` thresholds must already hold the interned index.
+ */
+PERSPECTIVE_EXPORT t_mask filter_columns(
+    t_filter_op combiner,
+    const std::vector<t_fterm>& fterms,
+    const std::vector<const t_column*>& columns,
+    t_uindex nrows
+);
+
+} // end namespace perspective
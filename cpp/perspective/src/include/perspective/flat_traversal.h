@@ -26,9 +26,37 @@
 #include <perspective/sym_table.h>
 #include <set>
 #include <tsl/hopscotch_map.h>
+#include <tsl/hopscotch_set.h>
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/ranked_index.hpp>
 
 namespace perspective {
 
+struct by_ftrav_order {};
+struct by_ftrav_pkey {};
+
+/**
+ * @brief The rows of a flat view, kept in sort order by a ranked index so
+ * that a row's position can be found (and a position resolved to a row) in
+ * O(log n), and looked up by primary key through a hashed index.
+ */
+typedef boost::multi_index::multi_index_container<
+    t_mselem,
+    boost::multi_index::indexed_by<
+        boost::multi_index::ranked_non_unique<
+            boost::multi_index::tag<by_ftrav_order>,
+            boost::multi_index::identity<t_mselem>,
+            t_multisorter>,
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<by_ftrav_pkey>,
+            boost::multi_index::
+                member<t_mselem, t_tscalar, &t_mselem::m_pkey>,
+            std::hash<t_tscalar>>>>
+    t_ftrav_index;
+
 class PERSPECTIVE_EXPORT t_ftrav {
 
 public:
@@ -138,18 +166,23 @@ private:
         t_tscalar pkey
     ) const;
 
-    t_index m_step_deletes;
-    t_index m_step_inserts;
-
-    // map primary keys to row indices
-    tsl::hopscotch_map<t_tscalar, t_uindex> m_pkeyidx;
+    static t_ftrav_index
+    make_index(const std::vector<t_sorttype>& sort_orders);
 
-    // map primary keys to sort items
+    // map primary keys to sort items added or updated during this step
     tsl::hopscotch_map<t_tscalar, t_mselem> m_new_elems;
 
+    // primary keys removed during this step
+    tsl::hopscotch_set<t_tscalar> m_deleted_pkeys;
+
     std::vector<t_sortspec> m_sortby;
-    std::shared_ptr<std::vector<t_mselem>> m_index;
+    std::vector<t_sorttype> m_sort_orders;
+    t_ftrav_index m_index;
     t_symtable m_symtable;
+
+    // scratch row for `fill_sort_elem`, which only copies it to the sort
+    // item when the item's key does not encode it exactly.
+    mutable std::vector<t_tscalar> m_sort_row;
 };
 
 } // end namespace perspective
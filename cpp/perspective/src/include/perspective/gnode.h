@@ -166,6 +166,13 @@ public:
     const t_schema& get_state_input_schema() const;
 
     t_uindex num_input_ports() const;
+
+    /**
+     * @brief The number of rows sent to the input ports since the gnode was
+     * last processed. Updates accumulate in their port until then, so this
+     * is the size of the next process cycle.
+     */
+    t_uindex num_queued_rows() const;
     t_uindex num_output_ports() const;
 
     std::vector<t_pivot> get_pivots() const;
@@ -196,6 +203,34 @@ public:
 
     t_uindex mapping_size() const;
 
+    /**
+     * @brief Compact the vocabularies of the master table's string columns
+     * under the write lock, returning the number of bytes released. See
+     * `t_gstate::compact_vocabularies`.
+     *
+     * @return t_uindex
+     */
+    t_uindex compact_vocabularies();
+
+    /**
+     * @brief Compact the vocabularies if
+     * `t_gstate::should_compact_vocabularies`, returning the number of bytes
+     * released. Called after each update is processed.
+     *
+     * @return t_uindex
+     */
+    t_uindex maybe_compact_vocabularies();
+
+    /**
+     * @brief The number of bytes `compact_vocabularies` would release.
+     *
+     * @return t_uindex
+     */
+    t_uindex get_reclaimable_vocab_bytes() const;
+
+    t_uindex add_vocab_listener(t_gstate::t_vocab_listener listener);
+    void remove_vocab_listener(t_uindex id);
+
     // helper function for JS interface
     void promote_column(const std::string& name, t_dtype new_type);
 
@@ -358,6 +393,28 @@ protected:
         const std::shared_ptr<t_data_table>& flattened
     );
 
+    /**
+     * @brief Reference a newly registered context's expressions in the
+     * expression cache, computing any that no other context uses, and point
+     * the context's expression tables at the cached columns.
+     */
+    void _acquire_expressions(
+        const std::vector<std::shared_ptr<t_computed_expression>>& expressions,
+        const t_expression_tables& expression_tables
+    );
+
+    template <typename CTX_T>
+    void _release_expressions(const CTX_T* ctx);
+
+    /**
+     * @brief Point the expression tables of each registered context at the
+     * columns computed by the expression cache.
+     */
+    void _share_expressions() const;
+
+    template <typename CTX_T>
+    void _share_expressions(const CTX_T* ctx) const;
+
 private:
     /**
      * @brief Process the input data table by flattening it, calculating
@@ -401,6 +458,9 @@ private:
     std::shared_ptr<t_expression_vocab> m_expression_vocab;
     std::shared_ptr<t_regex_mapping> m_expression_regex_mapping;
 
+    // Expression columns shared by all contexts, computed once per update.
+    std::shared_ptr<t_expression_cache> m_expression_cache;
+
 #ifdef PSP_PARALLEL_FOR
     std::shared_mutex* m_lock;
 #endif
@@ -471,6 +531,20 @@ t_gnode::notify_context(
     ctx->step_end();
 }
 
+template <typename CTX_T>
+void
+t_gnode::_release_expressions(const CTX_T* ctx) {
+    m_expression_cache->release(ctx->get_config().get_expressions());
+}
+
+template <typename CTX_T>
+void
+t_gnode::_share_expressions(const CTX_T* ctx) const {
+    m_expression_cache->share(
+        ctx->get_config().get_expressions(), *(ctx->get_expression_tables())
+    );
+}
+
 /**
  * @brief Given a flattened `t_data_table`, update the context with the table.
  *
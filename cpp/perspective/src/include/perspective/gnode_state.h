@@ -20,6 +20,7 @@
 #include <perspective/mask.h>
 #include <perspective/sym_table.h>
 #include <perspective/rlookup.h>
+#include <perspective/pkey_index.h>
 
 namespace perspective {
 
@@ -29,12 +30,22 @@ get_vec_min_max(const std::vector<t_tscalar>& vec);
 class PERSPECTIVE_EXPORT t_gstate {
 public:
     /**
-     * @brief A mapping of `t_tscalar` primary keys to `t_uindex` row indices.
+     * @brief A mapping of `t_tscalar` primary keys to `t_uindex` row indices,
+     * specialized on the dtype of the `psp_pkey` column.
      */
-    typedef tsl::hopscotch_map<t_tscalar, t_uindex> t_mapping;
+    typedef t_pkey_index t_mapping;
 
     typedef tsl::hopscotch_set<t_uindex> t_free_items;
 
+    /**
+     * @brief Called with a column name and the old-to-new id remap each
+     * time that column's vocabulary is compacted.
+     */
+    typedef std::function<void(
+        const std::string& colname, const std::vector<t_uindex>& remap
+    )>
+        t_vocab_listener;
+
     /**
      * @brief Construct a new `t_gstate`, which manages the canonical state of
      * the `t_gnode` and associated `Table`.
@@ -64,6 +75,16 @@ public:
      */
     t_rlookup lookup(t_tscalar pkey) const;
 
+    /**
+     * @brief Look up every primary key in `pkeys`, writing one `t_rlookup`
+     * per row into `out`. Prefer this over calling `lookup` per row, as keys
+     * are read directly out of the column.
+     *
+     * @param pkeys
+     * @param out
+     */
+    void lookup(const t_column& pkeys, std::vector<t_rlookup>& out) const;
+
     /**
      * @brief If the master table has 0 rows, fill it using `flattened`.
      *
@@ -71,6 +92,18 @@ public:
      */
     void fill_master_table(const t_data_table* flattened);
 
+    /**
+     * @brief If the master table has 0 rows, load `flattened` into it in
+     * bulk. The master table takes ownership of the flattened columns
+     * instead of cloning them, so `flattened` must not be written to after
+     * this call. The primary key map is reserved once and filled from keys
+     * that are read out of the pkey column in parallel.
+     *
+     * @param flattened
+     */
+    void bulk_load_master_table(const std::shared_ptr<t_data_table>& flattened
+    );
+
     /**
      * @brief Update the master `t_data_table` with the flattened and masked
      * `t_data_table` after an `update` has been called and fully processed
@@ -226,6 +259,49 @@ public:
      */
     t_uindex mapping_size() const;
 
+    /**
+     * @brief Rebuild the vocabulary of every string column in the master
+     * table from the strings its live rows point at, dropping those left
+     * behind by updates and removes. Registered vocab listeners are called
+     * for each column so that anything holding its string ids can remap
+     * them. Returns the number of bytes released.
+     *
+     * Column data is rewritten in place, so this must not run while the
+     * master table is being read or written.
+     *
+     * @return t_uindex
+     */
+    t_uindex compact_vocabularies();
+
+    /**
+     * @brief Whether a string column's vocabulary has grown to hold more
+     * than `VOCAB_COMPACT_RATIO` strings per live row, so that compacting
+     * it would release at least that share of its strings. Only looks at
+     * the vocabulary sizes, so it is cheap enough to check after each
+     * update.
+     *
+     * @return bool
+     */
+    bool should_compact_vocabularies() const;
+
+    /**
+     * @brief Returns the number of bytes `compact_vocabularies` would drop
+     * from the master table's string columns.
+     *
+     * @return t_uindex
+     */
+    t_uindex get_reclaimable_vocab_bytes() const;
+
+    /**
+     * @brief Register a listener that is called after each vocabulary
+     * compaction, returning an id for `remove_vocab_listener`.
+     *
+     * @param listener
+     * @return t_uindex
+     */
+    t_uindex add_vocab_listener(t_vocab_listener listener);
+    void remove_vocab_listener(t_uindex id);
+
     /**
      * @brief Resets the gnode state and its master `t_data_table` and
      * mapping.
@@ -292,9 +368,10 @@ private:
     std::shared_ptr<t_data_table> m_table;
     t_mapping m_mapping;
     t_free_items m_free;
-    t_symtable m_symtable;
     std::shared_ptr<t_column> m_pkcol;
     std::shared_ptr<t_column> m_opcol;
+    std::map<t_uindex, t_vocab_listener> m_vocab_listeners;
+    t_uindex m_vocab_listener_id;
 };
 
 template <typename FN_T>
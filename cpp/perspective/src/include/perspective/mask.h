@@ -25,11 +25,19 @@ class PERSPECTIVE_EXPORT t_mask {
     typedef boost::dynamic_bitset<>::size_type t_msize;
 
 public:
+    typedef boost::dynamic_bitset<>::block_type t_block;
+    static const t_uindex m_bits_per_block =
+        boost::dynamic_bitset<>::bits_per_block;
+
     t_mask();
     t_mask(t_uindex size);
 
     t_mask(const t_simple_bitmask& m);
 
+    // Adopt a word-packed bitmap of `size` bits, least significant bit first
+    // within each block. Bits past `size` in the last block are ignored.
+    t_mask(const std::vector<t_block>& blocks, t_uindex size);
+
     ~t_mask();
 
     void clear();
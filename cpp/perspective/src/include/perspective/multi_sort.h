@@ -16,10 +16,15 @@
 #include <perspective/scalar.h>
 #include <perspective/exports.h>
 #include <perspective/comparators.h>
+#include <array>
+#include <cstring>
 #include <vector>
 
 namespace perspective {
 
+// Width in bytes of the normalized sort key held inline by `t_mselem`.
+static const t_uindex MSELEM_KEY_WIDTH = 32;
+
 struct PERSPECTIVE_EXPORT t_mselem {
     t_mselem();
     t_mselem(const std::vector<t_tscalar>& row);
@@ -35,6 +40,14 @@ struct PERSPECTIVE_EXPORT t_mselem {
     t_uindex m_order;
     bool m_deleted;
     bool m_updated;
+
+    // An order-preserving encoding of a prefix of `m_row`, written by
+    // `encode_sort_key` - `m_key_size` is 0 until the row is encoded. When
+    // `m_key_complete` is set the key encodes every column exactly, and
+    // `m_row` is left empty.
+    std::array<std::uint8_t, MSELEM_KEY_WIDTH> m_key;
+    std::uint8_t m_key_size;
+    bool m_key_complete;
 };
 
 } // end namespace perspective
@@ -160,6 +173,54 @@ cmp_mselem(
     return first_pkey < second_pkey;
 }
 
+/**
+ * @brief Write the normalized sort key of `row` into `elem.m_key`.
+ *
+ * Each column is encoded as a tag byte followed by a big-endian payload,
+ * with the bytes of descending columns inverted, so that when the keys of
+ * two rows differ, `memcmp` orders them exactly as `cmp_mselem` would.
+ * Strings contribute a prefix and end the key, as do absolute sorts;
+ * `SORTTYPE_NONE` and types without an encoding end the key before the
+ * column.
+ *
+ * If the key encodes every column exactly, rows whose keys are equal are
+ * equal, and `row` is not kept - otherwise it is copied to `elem.m_row` so
+ * that `cmp_mselem` can break ties between equal keys.
+ *
+ * @param elem
+ * @param row
+ * @param sort_order
+ */
+PERSPECTIVE_EXPORT void encode_sort_key(
+    t_mselem& elem,
+    const std::vector<t_tscalar>& row,
+    const std::vector<t_sorttype>& sort_order
+);
+
+/**
+ * @brief Write the normalized sort key of `elem.m_row` into `elem.m_key`,
+ * releasing `elem.m_row` if the key encodes it exactly.
+ *
+ * @param elem
+ * @param sort_order
+ */
+PERSPECTIVE_EXPORT void
+encode_sort_key(t_mselem& elem, const std::vector<t_sorttype>& sort_order);
+
+/**
+ * @brief Compare two rows by their normalized sort keys, returning a value
+ * less than, equal to or greater than 0 - 0 means the keys cannot order the
+ * rows, and unless both keys are complete `cmp_mselem` must.
+ */
+inline int
+cmp_mselem_key(const t_mselem& a, const t_mselem& b) {
+    t_uindex size = std::min(a.m_key_size, b.m_key_size);
+    if (size == 0) {
+        return 0;
+    }
+    return std::memcmp(a.m_key.data(), b.m_key.data(), size);
+}
+
 inline PERSPECTIVE_EXPORT bool
 cmp_mselem(
     const t_mselem* a,
@@ -0,0 +1,86 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/ranked_index.hpp>
+
+namespace perspective {
+
+/**
+ * @brief A strict weak ordering over the scalars of a single column. This is
+ * `t_tscalar::operator<`, except that floating point values are totally
+ * ordered: -0.0 sorts before 0.0, and NaN sorts after every other value
+ * (ordered by its bits) instead of comparing equivalent to all of them.
+ * Equivalent scalars are therefore equal by `t_tscalar::operator==`, so
+ * `distinct_count()` matches a hash set of the same values.
+ *
+ * The unindexed min, max, high minus low and median aggregates have no
+ * such order - their result for a group holding NaN or both zeroes depends
+ * on the order of its rows - whereas indexed ones return NaN for the max
+ * of any group holding NaN, and skip it for the min.
+ */
+struct PERSPECTIVE_EXPORT t_order_index_less {
+    bool operator()(const t_tscalar& a, const t_tscalar& b) const;
+};
+
+struct by_order_value {};
+
+typedef boost::multi_index::multi_index_container<
+    t_tscalar,
+    boost::multi_index::indexed_by<boost::multi_index::ranked_non_unique<
+        boost::multi_index::tag<by_order_value>,
+        boost::multi_index::identity<t_tscalar>,
+        t_order_index_less>>>
+    t_order_index_values;
+
+/**
+ * @brief An order-statistics multiset of the values under a single tree
+ * node, used by `t_stree` to answer median, min, max, high minus low and
+ * distinct count aggregates in O(log n) as rows enter and leave the node.
+ *
+ * Scalars must be canonicalized by the caller - string values must outlive
+ * the index, and invalid values should compare equal to each other.
+ */
+class PERSPECTIVE_EXPORT t_order_index {
+public:
+    t_order_index();
+
+    void clear();
+    void insert(const t_tscalar& value);
+
+    /**
+     * @brief Remove one occurrence of `value`, returning false if it is not
+     * in the index.
+     */
+    bool erase(const t_tscalar& value);
+
+    t_uindex size() const;
+    bool empty() const;
+    t_uindex distinct_count() const;
+
+    t_tscalar min() const;
+    t_tscalar max() const;
+    t_tscalar nth(t_uindex n) const;
+
+private:
+    t_order_index_values m_values;
+    t_uindex m_distinct;
+};
+
+} // end namespace perspective
@@ -14,28 +14,56 @@
 
 #ifdef PSP_PARALLEL_FOR
 #include "base.h"
+#include "env_vars.h"
 #include <arrow/util/parallel.h>
 #include <arrow/status.h>
 #include <mutex>
 #else
 #include "raw_types.h"
 #endif
+#include <algorithm>
+#include <vector>
 
 namespace perspective {
 
+#ifdef PSP_PARALLEL_FOR
+/**
+ * @brief Whether the calling thread is running a `parallel_for` task.
+ */
+inline bool&
+in_parallel_for_task() {
+    thread_local bool rv = false;
+    return rv;
+}
+#endif
+
 template <class FUNCTION>
 void
 parallel_for(int num_tasks, FUNCTION&& func) {
 #ifdef PSP_PARALLEL_FOR
+    // `ParallelFor` blocks its caller until the tasks finish, so a task that
+    // starts a nested loop would wait on tasks queued behind it in the same
+    // pool - nested loops run serially instead, and a single task runs
+    // inline so that it leaves the pool free for loops inside it.
+    if (num_tasks == 1 || in_parallel_for_task()
+        || t_env::backout_parallel_for()) {
+        for (int task = 0; task < num_tasks; ++task) {
+            func(task);
+        }
+        return;
+    }
+
     std::exception_ptr e;
     std::mutex e_mtx;
     const auto rethrow_wrapper = [&](int64_t task) {
+        in_parallel_for_task() = true;
         try {
-            return func(task);
+            func(task);
         } catch (...) {
             std::lock_guard<std::mutex> lg(e_mtx);
             e = std::current_exception();
         }
+        in_parallel_for_task() = false;
     };
     auto status = arrow::internal::ParallelFor(num_tasks, rethrow_wrapper);
     if (!status.ok()) {
@@ -51,4 +79,43 @@ parallel_for(int num_tasks, FUNCTION&& func) {
 #endif
 }
 
+// `parallel_sort` sorts runs of this many elements in parallel, then merges
+// them.
+const t_uindex PARALLEL_SORT_RUN_SIZE = 65536;
+
+/**
+ * @brief Sort `elems` by `cmp`, sorting runs of `PARALLEL_SORT_RUN_SIZE`
+ * elements in parallel and then merging them pairwise, each round of merges
+ * in parallel. When `cmp` is a total order the result is the same as
+ * `std::sort`'s.
+ */
+template <typename T, typename COMPARE>
+void
+parallel_sort(std::vector<T>& elems, const COMPARE& cmp) {
+    t_uindex size = elems.size();
+    t_uindex num_runs =
+        (size + PARALLEL_SORT_RUN_SIZE - 1) / PARALLEL_SORT_RUN_SIZE;
+
+    parallel_for(int(num_runs), [&](int run) {
+        t_uindex begin = run * PARALLEL_SORT_RUN_SIZE;
+        t_uindex end = std::min(begin + PARALLEL_SORT_RUN_SIZE, size);
+        std::sort(elems.begin() + begin, elems.begin() + end, cmp);
+    });
+
+    for (t_uindex width = PARALLEL_SORT_RUN_SIZE; width < size; width *= 2) {
+        t_uindex num_merges = (size + 2 * width - 1) / (2 * width);
+        parallel_for(int(num_merges), [&](int merge) {
+            t_uindex begin = merge * 2 * width;
+            t_uindex mid = std::min(begin + width, size);
+            t_uindex end = std::min(begin + 2 * width, size);
+            std::inplace_merge(
+                elems.begin() + begin,
+                elems.begin() + mid,
+                elems.begin() + end,
+                cmp
+            );
+        });
+    }
+}
+
 } // namespace perspective
@@ -0,0 +1,219 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/column.h>
+#include <perspective/rlookup.h>
+#include <perspective/scalar.h>
+#include <perspective/sym_table.h>
+#include <tsl/hopscotch_map.h>
+#include <string_view>
+#include <vector>
+
+namespace perspective {
+
+/**
+ * @brief An open addressing map from the raw 64 bit payload of a fixed width
+ * scalar to a row index. Collisions are resolved by linear probing, and
+ * erase shifts the following entries back so that no tombstones are left.
+ */
+class PERSPECTIVE_EXPORT t_flat_pkey_map {
+public:
+    t_flat_pkey_map();
+
+    const t_uindex* find(std::uint64_t key) const;
+    void insert(std::uint64_t key, t_uindex idx);
+
+    /**
+     * @brief Insert `keys[i] -> rows[i]` for every `i`, as `insert()` would
+     * in order. An empty map is built in parallel over disjoint ranges of
+     * its slots.
+     */
+    void bulk_insert(
+        const std::vector<std::uint64_t>& keys,
+        const std::vector<t_uindex>& rows
+    );
+
+    bool erase(std::uint64_t key);
+    void reserve(t_uindex size);
+    void clear();
+    t_uindex size() const;
+
+    template <typename FUNCTION>
+    void
+    for_each(FUNCTION&& func) const {
+        for (t_uindex slot = 0; slot < m_rows.size(); ++slot) {
+            if (m_rows[slot] != EMPTY_SLOT) {
+                func(m_keys[slot], m_rows[slot]);
+            }
+        }
+    }
+
+private:
+    static constexpr t_uindex EMPTY_SLOT = static_cast<t_uindex>(-1);
+
+    t_uindex slot_for(std::uint64_t key) const;
+    void rehash(t_uindex capacity);
+
+    std::vector<std::uint64_t> m_keys;
+    std::vector<t_uindex> m_rows;
+    t_uindex m_size;
+    t_uindex m_mask;
+};
+
+/**
+ * @brief The primary key index of a `t_gstate`, mapping primary keys to row
+ * indices in the master table.
+ *
+ * The index picks its representation from the dtype of the `psp_pkey`
+ * column:
+ *
+ * - integer keys are stored in a dense vector indexed by key while they are
+ *   small and non-negative (which covers the implicit `__INDEX__`), and move
+ *   to a `t_flat_pkey_map` once they are not.
+ * - other fixed width keys are stored in a `t_flat_pkey_map` keyed on the
+ *   scalar payload, which is what `t_tscalar::operator==` compares.
+ * - string keys are interned into a symtable owned by the index, and stored
+ *   in a map keyed on the interned string.
+ *
+ * Keys that do not match the index dtype or are not valid go into a
+ * `t_tscalar` keyed map, so lookups behave exactly as they would on a map of
+ * `t_tscalar`.
+ */
+class PERSPECTIVE_EXPORT t_pkey_index {
+public:
+    PSP_NON_COPYABLE(t_pkey_index);
+
+    t_pkey_index();
+    explicit t_pkey_index(t_dtype dtype);
+
+    t_rlookup find(const t_tscalar& pkey) const;
+
+    /**
+     * @brief Look up every row of `pkeys` in the index, writing one
+     * `t_rlookup` per row into `out`. When the column matches the index
+     * dtype, keys are read directly out of the column instead of being
+     * materialized as scalars, and string columns are looked up once per
+     * vocab entry rather than once per row.
+     *
+     * @param pkeys
+     * @param out
+     */
+    void lookup(const t_column& pkeys, std::vector<t_rlookup>& out) const;
+
+    void insert(const t_tscalar& pkey, t_uindex idx);
+
+    /**
+     * @brief Insert `pkeys[idx] -> idx` for every `idx` in `rows`, as
+     * `insert()` would in order. Into an empty index, fixed width keys are
+     * inserted in parallel over partitions of the key space (or of the
+     * `t_flat_pkey_map` slots) which no two tasks share. String and
+     * mistyped keys are inserted serially.
+     *
+     * @param pkeys
+     * @param rows
+     */
+    void bulk_insert(
+        const std::vector<t_tscalar>& pkeys, const std::vector<t_uindex>& rows
+    );
+
+    bool erase(const t_tscalar& pkey);
+    void reserve(t_uindex size);
+    void clear();
+
+    t_uindex size() const;
+    bool empty() const;
+
+    /**
+     * @brief Returns the dtype of the keys stored in the index, or
+     * `DTYPE_NONE` if the index is empty.
+     */
+    t_dtype get_key_dtype() const;
+
+    /**
+     * @brief Call `func(pkey, idx)` for every key in the index, in no
+     * particular order.
+     */
+    template <typename FUNCTION>
+    void
+    for_each(FUNCTION&& func) const {
+        switch (m_mode) {
+            case MODE_DENSE: {
+                for (t_uindex key = 0; key < m_dense.size(); ++key) {
+                    if (m_dense[key] != EMPTY_ROW) {
+                        func(to_scalar(key), m_dense[key]);
+                    }
+                }
+            } break;
+            case MODE_FLAT: {
+                m_flat.for_each([&](std::uint64_t key, t_uindex idx) {
+                    func(to_scalar(key), idx);
+                });
+            } break;
+            case MODE_STR: {
+                for (const auto& kv : m_strings) {
+                    t_tscalar pkey;
+                    pkey.set(kv.first.data());
+                    func(pkey, kv.second);
+                }
+            } break;
+            case MODE_SCALAR:
+                break;
+        }
+
+        for (const auto& kv : m_scalars) {
+            func(kv.first, kv.second);
+        }
+    }
+
+private:
+    enum t_mode { MODE_DENSE, MODE_FLAT, MODE_STR, MODE_SCALAR };
+
+    static constexpr t_uindex EMPTY_ROW = static_cast<t_uindex>(-1);
+
+    // Keys are allowed into the dense vector while they are below
+    // max(MIN_DENSE_CAPACITY, DENSE_LOAD_FACTOR * size()).
+    static constexpr t_uindex MIN_DENSE_CAPACITY = 1024;
+    static constexpr t_uindex DENSE_LOAD_FACTOR = 4;
+
+    bool is_typed_key(const t_tscalar& pkey) const;
+    t_tscalar to_scalar(std::uint64_t key) const;
+
+    t_rlookup find_raw(std::uint64_t key) const;
+    t_rlookup find_str(const char* key) const;
+    void insert_raw(std::uint64_t key, t_uindex idx);
+    bool erase_raw(std::uint64_t key);
+    void spill_dense();
+
+    template <typename T>
+    void lookup_typed(const t_column& pkeys, std::vector<t_rlookup>& out)
+        const;
+    void lookup_str(const t_column& pkeys, std::vector<t_rlookup>& out) const;
+
+    t_dtype m_dtype;
+    t_mode m_mode;
+
+    std::vector<t_uindex> m_dense;
+    t_uindex m_dense_size;
+    t_flat_pkey_map m_flat;
+
+    t_symtable m_symtable;
+    tsl::hopscotch_map<std::string_view, t_uindex> m_strings;
+
+    tsl::hopscotch_map<t_tscalar, t_uindex> m_scalars;
+};
+
+} // end namespace perspective
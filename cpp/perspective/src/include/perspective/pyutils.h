@@ -15,6 +15,7 @@
 
 #ifdef PSP_PARALLEL_FOR
 #include <thread>
+#include <mutex>
 #include <shared_mutex>
 #endif
 
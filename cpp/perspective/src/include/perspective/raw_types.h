@@ -153,7 +153,8 @@ struct t_accumulation_type<bool> {
 };
 
 struct t_tscalar;
+class t_pkey_index;
 
-typedef tsl::hopscotch_map<t_tscalar, t_uindex> t_pkey_mapping;
+typedef t_pkey_index t_pkey_mapping;
 
 } // end namespace perspective
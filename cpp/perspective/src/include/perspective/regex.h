@@ -17,6 +17,7 @@
 #include <perspective/exports.h>
 #include <tsl/hopscotch_map.h>
 #include <re2/re2.h>
+#include <shared_mutex>
 
 namespace perspective {
 
@@ -40,6 +41,9 @@ struct PERSPECTIVE_EXPORT t_regex_mapping {
     // Store pointers to RE2 objects as the default copy assignment operator
     // for RE2 is disabled.
     tsl::hopscotch_map<std::string, std::shared_ptr<RE2>> m_regex_map;
+
+    // Guards `m_regex_map`, as expressions may be computed in parallel.
+    std::shared_mutex m_lock;
 };
 
 } // end namespace perspective
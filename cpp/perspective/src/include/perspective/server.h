@@ -18,8 +18,17 @@
 #include "perspective/schema.h"
 #include "perspective/view.h"
 #include "perspective/view_config.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <tsl/hopscotch_set.h>
 #include <utility>
 #include <perspective/table.h>
@@ -161,6 +170,17 @@ namespace server {
             bool compress = true
         ) const = 0;
 
+        virtual void to_arrow_chunked(
+            t_uindex start_row,
+            t_uindex end_row,
+            t_uindex start_col,
+            t_uindex end_col,
+            bool emit_group_by,
+            bool compress,
+            t_uindex chunk_rows,
+            const std::function<void(std::string&&)>& sink
+        ) const = 0;
+
         [[nodiscard]]
         virtual std::string to_rows(
             t_uindex start_row,
@@ -296,6 +316,29 @@ namespace server {
             );
         }
 
+        void
+        to_arrow_chunked(
+            t_uindex start_row,
+            t_uindex end_row,
+            t_uindex start_col,
+            t_uindex end_col,
+            bool emit_group_by,
+            bool compress,
+            t_uindex chunk_rows,
+            const std::function<void(std::string&&)>& sink
+        ) const override {
+            m_view->to_arrow_chunked(
+                start_row,
+                end_row,
+                start_col,
+                end_col,
+                emit_group_by,
+                compress,
+                chunk_rows,
+                sink
+            );
+        }
+
         [[nodiscard]]
         std::string
         to_rows(
@@ -513,6 +556,43 @@ namespace server {
     struct Subscription {
         uint32_t id;
         uint32_t client_id;
+
+        // An `on_update()` subscription with a `throttle` is notified at most
+        // once per `throttle`. A notification within `throttle` of the last
+        // is held back as `pending_port_id`, and delivered by a later poll.
+        std::chrono::milliseconds throttle{0};
+        std::chrono::steady_clock::time_point last_notified;
+        std::optional<std::uint32_t> pending_port_id;
+    };
+
+    /**
+     * @brief How updates to a table are coalesced. A dirty table is only
+     * processed by a poll once `max_batch_rows` rows are queued on its input
+     * ports, or once its oldest unprocessed update is `max_latency` old.
+     * Until then, further updates accumulate in the ports and are processed
+     * in the same cycle, which notifies each `on_update` subscriber once.
+     */
+    struct TableUpdatePolicy {
+        std::chrono::milliseconds max_latency;
+        std::uint64_t max_batch_rows;
+    };
+
+    /**
+     * @brief Counters for the updates to a table and the process cycles
+     * which applied them.
+     */
+    struct PERSPECTIVE_EXPORT TableUpdateStats {
+        // Update, remove and replace requests
+        std::uint64_t num_updates = 0;
+        std::uint64_t num_rows = 0;
+        std::uint64_t num_cycles = 0;
+        std::uint64_t num_notifications = 0;
+
+        // Polls which left the table dirty because of its policy
+        std::uint64_t num_deferred = 0;
+
+        // Updates applied per process cycle
+        double coalescing_ratio() const;
     };
 
     /**
@@ -546,6 +626,28 @@ namespace server {
         void delete_view(const std::uint32_t& client_id, const t_id& id);
         void delete_table(const t_id& id);
 
+        // Views made from identical configs on the same table are handles to
+        // one `ErasedView`, and so share a single context. `key` identifies
+        // the table and config.
+        std::shared_ptr<ErasedView> get_shared_view(const std::string& key);
+        void share_view(
+            const t_id& view_id,
+            const std::string& key,
+            const std::shared_ptr<ErasedView>& view
+        );
+
+        /**
+         * @brief Stop offering a view's context to new handles, e.g. before
+         * its expansion state is changed.
+         *
+         * @param view_id
+         * @return true if other handles still share the view, in which case
+         * this handle needs a view of its own.
+         */
+        bool unshare_view(const t_id& view_id);
+        void
+        replace_view(const t_id& view_id, std::shared_ptr<ErasedView> view);
+
         // `on_update()`
         void create_view_on_update_sub(const t_id& view_id, Subscription sub);
         std::vector<Subscription> get_view_on_update_sub(const t_id& view_id);
@@ -554,6 +656,24 @@ namespace server {
         );
         void drop_view_on_update_sub(const t_id& view_id);
 
+        /**
+         * @brief Whether a notification on `port_id` to an `on_update()`
+         * subscription should be held back by the subscription's throttle.
+         */
+        bool throttle_view_on_update_sub(
+            const t_id& view_id,
+            std::uint32_t sub_id,
+            std::uint32_t client_id,
+            std::uint32_t port_id
+        );
+
+        /**
+         * @brief Take the held back notifications whose throttle has passed,
+         * as the view and subscription they are for.
+         */
+        std::vector<std::pair<t_id, Subscription>>
+        take_due_view_on_update_subs();
+
         // `Table::on_delete()`
         void create_table_on_delete_sub(const t_id& table_id, Subscription sub);
         std::vector<Subscription> get_table_on_delete_sub(const t_id& table_id);
@@ -578,7 +698,32 @@ namespace server {
         bool is_table_dirty(const t_id& id);
         void drop_client(const std::uint32_t);
 
+        // Update coalescing, see `TableUpdatePolicy`.
+        void set_table_update_policy(const t_id& id, TableUpdatePolicy policy);
+        void clear_table_update_policy(const t_id& id);
+
+        /**
+         * @brief Whether a poll should process the dirty table `id` now,
+         * given the rows queued on its input ports.
+         */
+        bool should_process_table(const t_id& id, std::uint64_t num_rows);
+
+        /**
+         * @brief The time until the next poll has a table to process or a
+         * throttled notification to deliver, or `std::nullopt` if it has
+         * nothing to do.
+         */
+        std::optional<std::chrono::milliseconds> get_poll_delay();
+
+        void record_table_processed(
+            const t_id& id, std::uint64_t num_rows, std::uint64_t num_notifs
+        );
+        TableUpdateStats get_table_update_stats(const t_id& id);
+
     protected:
+        // `unshare_view()` for callers that hold `m_write_lock`.
+        bool _unshare_view(const t_id& view_id);
+
         tsl::hopscotch_map<t_id, t_id> m_view_to_table;
         std::multimap<t_id, t_id> m_table_to_view;
         tsl::hopscotch_map<std::uint32_t, std::vector<t_id>> m_client_to_view;
@@ -595,6 +740,18 @@ namespace server {
             m_table_on_delete_subs;
 
         tsl::hopscotch_set<t_id> m_dirty_tables;
+        tsl::hopscotch_map<t_id, std::chrono::steady_clock::time_point>
+            m_dirty_since;
+        tsl::hopscotch_map<t_id, TableUpdatePolicy> m_update_policies;
+        tsl::hopscotch_map<t_id, TableUpdateStats> m_update_stats;
+
+        struct SharedView {
+            std::weak_ptr<ErasedView> view;
+            std::uint32_t num_handles;
+        };
+
+        tsl::hopscotch_map<std::string, SharedView> m_shared_views;
+        tsl::hopscotch_map<t_id, std::string> m_view_to_shared_key;
 
 #ifdef PSP_PARALLEL_FOR
         std::shared_mutex m_write_lock;
@@ -611,6 +768,24 @@ namespace server {
     public:
         using Request = perspective::proto::Request;
         using Response = perspective::proto::Response;
+        using t_callback =
+            std::function<void(std::vector<ProtoServerResp<std::string>>)>;
+
+        ProtoServer();
+
+        /**
+         * @brief Construct a server which owns `num_workers` worker threads
+         * for `dispatch_request()` and `dispatch_poll()`. Requests are
+         * routed to a serial execution lane per table, so work on unrelated
+         * tables runs concurrently. With `num_workers == 0` (or without
+         * `PSP_PARALLEL_FOR`), dispatched requests run on the calling
+         * thread.
+         */
+        explicit ProtoServer(std::uint32_t num_workers);
+        ~ProtoServer();
+
+        ProtoServer(const ProtoServer&) = delete;
+        ProtoServer& operator=(const ProtoServer&) = delete;
 
         std::uint32_t new_session();
         void close_session(std::uint32_t);
@@ -618,7 +793,89 @@ namespace server {
         handle_request(std::uint32_t client_id, const std::string_view& data);
         std::vector<ProtoServerResp<std::string>> poll();
 
+        /**
+         * @brief Queue a request on the execution lane of the table it
+         * targets. `callback` is invoked from a worker thread with the
+         * request's responses; responses are delivered to each client in
+         * the order its requests were dispatched. Read-only requests on a
+         * clean table may run in parallel with each other, under the
+         * table's `t_pool` lock.
+         */
+        void dispatch_request(
+            std::uint32_t client_id, std::string data, t_callback callback
+        );
+
+        /**
+         * @brief Queue a `poll()` of each dirty table on that table's lane.
+         * `callback` is invoked once per queued table with the `on_update`
+         * notifications it produced, and once more if any notifications
+         * held back by a throttle are due.
+         *
+         * @return The number of times `callback` will be invoked.
+         */
+        std::size_t dispatch_poll(t_callback callback);
+
+        /**
+         * @brief Coalesce updates to `table_id` according to `policy`.
+         * `poll()` and `dispatch_poll()` leave the table dirty until the
+         * policy is met, while requests which read from the table still
+         * process it first. Hosts should poll again after `get_poll_delay()`
+         * so that deferred updates, and notifications held back by an
+         * `on_update()` throttle, are delivered on time.
+         */
+        void set_table_update_policy(
+            const std::string& table_id, TableUpdatePolicy policy
+        );
+        void clear_table_update_policy(const std::string& table_id);
+        std::optional<std::chrono::milliseconds> get_poll_delay();
+        TableUpdateStats get_table_update_stats(const std::string& table_id);
+
+        [[nodiscard]]
+        std::uint32_t num_workers() const;
+
     private:
+        using t_responses = std::vector<ProtoServerResp<std::string>>;
+
+        struct LaneTask {
+            std::uint32_t client_id;
+            std::uint64_t seq;
+            bool is_poll;
+            bool read_only;
+            ServerResources::t_id lane;
+            Request req;
+            t_callback callback;
+        };
+
+        struct Lane {
+            std::deque<LaneTask> queue;
+            std::uint32_t num_readers = 0;
+            bool has_writer = false;
+        };
+
+        struct ClientSequence {
+            std::uint64_t next_dispatch = 0;
+            std::uint64_t next_deliver = 0;
+            bool delivering = false;
+            std::map<std::uint64_t, std::pair<t_responses, t_callback>>
+                pending;
+        };
+
+        t_responses
+        _handle_parsed_request(std::uint32_t client_id, Request&& req);
+
+        ServerResources::t_id _get_lane_id(const Request& req);
+        ServerResources::t_id
+        _get_view_lane_id(const ServerResources::t_id& view_id);
+        void _enqueue_task(LaneTask&& task);
+        void _schedule_lane(const ServerResources::t_id& lane_id);
+        void _run_worker();
+        void _deliver(
+            std::uint32_t client_id,
+            std::uint64_t seq,
+            t_responses&& resps,
+            t_callback&& callback
+        );
+
         void handle_process_table(
             const Request& req,
             std::vector<ProtoServerResp<ProtoServer::Response>>& proto_resp
@@ -629,20 +886,50 @@ namespace server {
 
         std::vector<ProtoServerResp<Response>> _poll();
 
+        // Deliver the `on_update()` notifications whose throttle has passed.
+        void _flush_throttled_notifications(
+            std::vector<ProtoServerResp<Response>>& outs
+        );
+
+        bool _should_process_table(
+            const std::shared_ptr<Table>& table,
+            const ServerResources::t_id& table_id
+        );
+
         void _process_table(
             std::shared_ptr<Table>& table,
             const ServerResources::t_id& table_id,
             std::vector<ProtoServerResp<Response>>& outs
         );
 
+        /**
+         * @brief Get a view that only `view_id` uses, giving the handle a
+         * context of its own if it currently shares one.
+         */
+        std::shared_ptr<ErasedView>
+        _get_unshared_view(const ServerResources::t_id& view_id);
+
         void _process_table_unchecked(
             std::shared_ptr<Table>& table,
             const ServerResources::t_id& table_id,
             std::vector<ProtoServerResp<Response>>& outs
         );
 
-        static std::uint32_t m_client_id;
+        static std::atomic<std::uint32_t> m_client_id;
         ServerResources m_resources;
+
+        // Lane scheduling state, guarded by `m_dispatch_lock`.
+        std::mutex m_dispatch_lock;
+        std::condition_variable m_dispatch_cv;
+        bool m_stopping;
+        std::deque<LaneTask> m_ready;
+        tsl::hopscotch_map<ServerResources::t_id, Lane> m_lanes;
+        // Lanes of views whose `kTableMakeViewReq` has been dispatched but
+        // has not yet run.
+        tsl::hopscotch_map<ServerResources::t_id, ServerResources::t_id>
+            m_view_lanes;
+        tsl::hopscotch_map<std::uint32_t, ClientSequence> m_client_sequences;
+        std::vector<std::thread> m_workers;
     };
 
 } // namespace server
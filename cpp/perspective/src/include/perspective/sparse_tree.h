@@ -28,6 +28,7 @@ SUPPRESS_WARNINGS_VC(4503)
 #include <perspective/aggspec.h>
 #include <perspective/step_delta.h>
 #include <perspective/mask.h>
+#include <perspective/order_index.h>
 #include <perspective/sym_table.h>
 #include <perspective/data_table.h>
 #include <perspective/dense_tree.h>
@@ -73,6 +74,12 @@ struct t_build_strand_table_metadata {
     t_uindex m_npivotlike;
     std::vector<std::string> m_pivot_like_columns;
     t_uindex m_pivsize;
+
+    // Dependencies of aggregates maintained incrementally by
+    // `update_agg_table` (mean, weighted mean, variance, standard deviation
+    // and order-indexed aggregates), which need the values leaving and
+    // entering each strand.
+    std::vector<std::string> m_running_columns;
 };
 
 typedef multi_index_container<
@@ -140,6 +147,27 @@ struct PERSPECTIVE_EXPORT t_agg_update_info {
     std::vector<t_aggspec> m_aggspecs;
 
     std::vector<t_uindex> m_dst_topo_sorted;
+
+    // For each aggregate column that can be updated incrementally, the
+    // strand columns holding the values that leave and enter each strand,
+    // one per dependency. Empty if the column must be recomputed.
+    std::vector<std::vector<const t_column*>> m_leave;
+    std::vector<std::vector<const t_column*>> m_enter;
+    const t_column* m_leave_flags = nullptr;
+    const t_column* m_enter_flags = nullptr;
+    const t_dtree_ctx* m_ctx = nullptr;
+};
+
+// Running state for an incrementally maintained aggregate row - the number
+// of contributing values and, for variance and standard deviation, the
+// Welford mean and sum of squared differences. `m_num_updates` counts the
+// incremental updates since the state was last seeded by a recompute.
+struct t_agg_running_state {
+    t_uindex m_count = 0;
+    double m_mean = 0;
+    double m_m2 = 0;
+    t_uindex m_num_updates = 0;
+    bool m_seeded = false;
 };
 
 struct t_tree_unify_rec {
@@ -224,6 +252,7 @@ public:
         const t_data_table& prev,
         const t_data_table& current,
         const t_data_table& transitions,
+        const t_data_table& existed,
         const std::vector<t_aggspec>& aggspecs,
         const t_config& config
     ) const;
@@ -313,6 +342,7 @@ public:
     t_tscalar get_aggregate(t_index idx, t_index aggnum) const;
 
     t_tscalar get_aggregate_median(std::vector<t_tscalar>& values) const;
+    t_tscalar get_aggregate_median(const t_order_index& index) const;
 
     void get_child_indices(t_index idx, std::vector<t_index>& out_data) const;
 
@@ -373,6 +403,44 @@ protected:
         const t_data_table& expression_master_table
     );
 
+    /**
+     * @brief Update a mean, weighted mean, variance or standard deviation
+     * aggregate from the values leaving and entering the strands under
+     * `src_ridx`, without reading the node's rows from the gnode state.
+     * Returns false if the aggregate must be recomputed instead.
+     */
+    bool update_agg_running(
+        t_uindex nidx,
+        const t_agg_update_info& info,
+        t_uindex idx,
+        t_uindex src_ridx,
+        t_uindex dst_ridx,
+        const t_schema& expression_schema,
+        t_tscalar& old_value,
+        t_tscalar& new_value
+    );
+
+    /**
+     * @brief Bring the order index for an opted-in aggregate up to date with
+     * the strands under `src_ridx`, rebuilding it from the gnode state if it
+     * is new or has drifted. Returns nullptr if the aggregate has no index.
+     */
+    const t_order_index* update_order_index(
+        t_uindex nidx,
+        const t_agg_update_info& info,
+        t_uindex idx,
+        t_uindex src_ridx,
+        t_uindex dst_ridx,
+        const t_gstate& gstate,
+        const t_data_table& expression_master_table
+    );
+
+    t_tscalar order_index_key(const t_tscalar& value);
+
+    void seed_agg_running(
+        t_uindex idx, t_uindex dst_ridx, t_uindex count, double mean, double m2
+    );
+
     bool is_leaf(t_uindex nidx) const;
 
     t_build_strand_table_metadata build_strand_table_metadata(
@@ -459,6 +527,8 @@ private:
     t_uindex m_cur_aggidx;
     std::set<t_uindex> m_newids;
     std::set<t_uindex> m_newleaves;
+    std::vector<std::vector<t_agg_running_state>> m_running_state;
+    std::vector<std::vector<std::unique_ptr<t_order_index>>> m_order_indices;
     t_sidxmap m_smap;
     std::vector<const t_column*> m_aggcols;
     std::shared_ptr<t_tcdeltas> m_deltas;
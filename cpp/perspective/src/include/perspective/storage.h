@@ -18,7 +18,9 @@
 #include <perspective/mask.h>
 #include <perspective/compat.h>
 #include <perspective/debug_helpers.h>
+#include <atomic>
 #include <cmath>
+#include <memory>
 
 /*
 TODO.
@@ -227,6 +229,45 @@ public:
         return size() == 0;
     }
 
+    /**
+     * @brief Point this store at `size` bytes of memory owned elsewhere
+     * instead of copying them, keeping `owner` alive for as long as the
+     * store references it. The memory is treated as read-only: the first
+     * non-const access copies it into storage owned by this store
+     * (copy-on-write). Only memory-backed stores with trivial alignment can
+     * borrow; returns `false` (and leaves the store untouched) otherwise.
+     *
+     * Concurrent non-const accesses copy the memory once. Since readers on
+     * other threads may still hold pointers into the borrowed memory, a
+     * copy made this way keeps `owner` alive until `detach()`, `clear()` or
+     * the store is destroyed.
+     */
+    bool borrow(
+        std::shared_ptr<const void> owner, const void* base, t_uindex size
+    );
+
+    // Share `other`'s borrowed memory, if it has any.
+    bool borrow(const t_lstore& other);
+
+    /**
+     * @brief Copy any borrowed memory into storage owned by this store and
+     * release its owner. Unlike copy-on-write, this must not run
+     * concurrently with any other access to the store.
+     */
+    void detach();
+
+    bool
+    is_borrowed() const {
+        return m_borrowed != nullptr
+            && !m_unborrowed.load(std::memory_order_acquire);
+    }
+
+    // Whether this store keeps an owner alive, borrowed or not.
+    bool
+    has_owner() const {
+        return m_borrowed != nullptr;
+    }
+
 #ifdef PSP_ENABLE_PYTHON
     /* Python bits */
     // py::array _as_numpy(t_dtype dtype);
@@ -239,6 +280,7 @@ protected:
 
 private:
     void reserve_impl(t_uindex capacity, bool allow_shrink);
+    void unborrow();
     t_handle create_file();
     // NOLINTNEXTLINE
     void* create_mapping();
@@ -263,15 +305,19 @@ private:
     bool m_init;
     double m_resize_factor;
     t_uindex m_version;
+    std::shared_ptr<const void> m_borrowed;
     bool m_from_recipe;
 
+    // Set once copy-on-write has replaced `m_borrowed`'s memory.
+    std::atomic<bool> m_unborrowed{false};
+
 #ifdef PSP_MPROTECT
     // size of padding + size of fields above
     // ==
     // page_size. this invariant is checked in
     // the constructor if
     // mprotect is enabled
-    char m_padding[3820];
+    char m_padding[3803];
 #endif
 };
 
@@ -298,6 +344,10 @@ struct t_unlock_store {
 template <typename T>
 void
 t_lstore::push_back(T value) {
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     if (m_size + sizeof(T) >= m_capacity) {
         reserve(static_cast<t_uindex>(std::ceil(m_capacity + m_size + sizeof(T))
         )); // reserve will multiply by m_resize_factor
@@ -320,6 +370,10 @@ template <typename T>
 T*
 t_lstore::get(t_uindex idx) {
     STORAGE_CHECK_ACCESS_GET(idx);
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     T* ptr = reinterpret_cast<T*>(static_cast<unsigned char*>(m_base) + idx);
     return ptr;
 }
@@ -336,6 +390,10 @@ template <typename T>
 T*
 t_lstore::get_nth(t_uindex idx) {
     STORAGE_CHECK_ACCESS_GET(idx);
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     return static_cast<T*>(m_base) + idx;
 }
 
@@ -350,6 +408,10 @@ template <typename T>
 void
 t_lstore::set_nth(t_uindex idx, T v) {
     STORAGE_CHECK_ACCESS(idx);
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     T* tgt = static_cast<T*>(m_base) + idx;
     *tgt = v;
 }
@@ -378,6 +440,10 @@ t_lstore::extend() {
 template <typename DATA_T>
 void
 t_lstore::raw_fill(DATA_T v) {
+    if (is_borrowed()) {
+        unborrow();
+    }
+
     auto biter = static_cast<DATA_T*>(m_base);
     auto eiter = reinterpret_cast<DATA_T*>(static_cast<char*>(m_base) + size());
     std::fill(biter, eiter, v);
@@ -391,9 +457,11 @@ struct PERSPECTIVE_EXPORT t_column_recipe {
     t_lstore_recipe m_vlendata;
     t_lstore_recipe m_extents;
     t_lstore_recipe m_status;
+    t_lstore_recipe m_cleared;
     t_uindex m_vlenidx;
     t_uindex m_size;
     bool m_status_enabled;
+    std::uint32_t m_elemsize;
 };
 
 } // end namespace perspective
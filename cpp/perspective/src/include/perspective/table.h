@@ -21,6 +21,10 @@
 
 namespace perspective {
 
+namespace apachearrow {
+    class ArrowLoader;
+} // namespace apachearrow
+
 /**
  * @brief the `Table` class encapsulates `t_data_table`, `t_pool` and `t_gnode`,
  * offering a unified public API for consumption by binding languages.
@@ -195,6 +199,14 @@ public:
     void remove_rows(const std::string_view& data);
 
     void update_arrow(const std::string_view& data, std::uint32_t port_id);
+
+    /**
+     * @brief Update from an Arrow binary the table may share ownership of,
+     * so primitive columns can be loaded without copying them.
+     */
+    void update_arrow(
+        std::shared_ptr<const std::string> data, std::uint32_t port_id
+    );
     void update_csv(const std::string_view& data, std::uint32_t port_id);
     void update_rows(const std::string_view& data, std::uint32_t port_id);
     void update_cols(const std::string_view& data, std::uint32_t port_id);
@@ -246,6 +258,10 @@ public:
     );
 
 private:
+    void update_arrow(
+        apachearrow::ArrowLoader& arrow_loader, std::uint32_t port_id
+    );
+
     /**
      * @brief Make sure that the table does not have an explicit index AND an
      * implicit index (with the `__INDEX__` column in data).
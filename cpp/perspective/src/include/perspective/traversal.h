@@ -197,6 +197,7 @@ t_traversal::sort_by(
                 std::make_shared<std::vector<t_mselem>>(size_t(n_changed));
             auto num_aggs = sortby.size();
             std::vector<t_tscalar> aggregates(num_aggs);
+            std::vector<t_sorttype> sort_orders = get_sort_orders(sortby);
 
             for (t_uindex i = 0, loop_end = n_changed; i < loop_end; i++) {
                 children_ptidx[i] = h_children[i].second;
@@ -205,11 +206,10 @@ t_traversal::sort_by(
                     children_ptidx[i], sortby_agg_indices, aggregates, ctx2
                 );
 
-                (*sortelems)[i] =
-                    t_mselem(aggregates, static_cast<t_uindex>(i));
+                (*sortelems)[i].m_order = static_cast<t_uindex>(i);
+                encode_sort_key((*sortelems)[i], aggregates, sort_orders);
             }
 
-            std::vector<t_sorttype> sort_orders = get_sort_orders(sortby);
             t_multisorter sorter(sortelems, sort_orders);
             argsort(sorted_idx, sorter);
 
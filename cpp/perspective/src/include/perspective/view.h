@@ -277,6 +277,34 @@ public:
         bool compress
     ) const;
 
+    /**
+     * @brief Serializes the `View`'s data into a single Apache Arrow IPC
+     * stream, `chunk_rows` rows at a time. Each chunk is read from the
+     * context, written as its own record batch, and its encoded bytes are
+     * handed to `sink` before the next chunk is read, so peak memory is
+     * bounded by the chunk size rather than the size of the view.
+     * Concatenating every call to `sink` yields a valid stream.
+     *
+     * @param start_row
+     * @param end_row
+     * @param start_col
+     * @param end_col
+     * @param emit_group_by
+     * @param compress
+     * @param chunk_rows
+     * @param sink
+     */
+    void to_arrow_chunked(
+        std::int32_t start_row,
+        std::int32_t end_row,
+        std::int32_t start_col,
+        std::int32_t end_col,
+        bool emit_group_by,
+        bool compress,
+        t_uindex chunk_rows,
+        const std::function<void(std::string&&)>& sink
+    ) const;
+
     /**
      * @brief Serializes the `View`'s data into the Apache Arrow format
      * as a bytestring. Using start/end row and column, retrieve a data
@@ -427,6 +455,45 @@ private:
         bool emit_group_by, std::shared_ptr<t_data_slice<CTX_T>> data_slice
     ) const;
 
+    /**
+     * @brief For flat (`t_ctxunit` and `t_ctx0`) views, build a record batch
+     * by gathering rows straight out of the typed master table columns,
+     * skipping the `t_data_slice` entirely. Returns `nullptr` for views that
+     * cannot be read this way, in which case callers fall back to
+     * `data_slice_to_batches`.
+     *
+     * @param start_row
+     * @param end_row
+     * @param start_col
+     * @param end_col
+     * @return std::shared_ptr<arrow::RecordBatch>
+     */
+    std::shared_ptr<arrow::RecordBatch> columns_to_batch(
+        std::int32_t start_row,
+        std::int32_t end_row,
+        std::int32_t start_col,
+        std::int32_t end_col
+    ) const;
+
+    std::shared_ptr<arrow::RecordBatch> gather_columns_to_batch(
+        const std::vector<t_rlookup>& rows,
+        t_uindex start_col,
+        t_uindex end_col,
+        const std::function<std::shared_ptr<const t_column>(t_uindex)>&
+            get_column
+    ) const;
+
+    /**
+     * @brief Write `batch` as an Apache Arrow IPC stream.
+     *
+     * @param batch
+     * @param compress
+     * @return std::shared_ptr<std::string>
+     */
+    std::shared_ptr<std::string> batch_to_arrow(
+        const std::shared_ptr<arrow::RecordBatch>& batch, bool compress
+    ) const;
+
     void _find_hidden_sort(const std::vector<t_sortspec>& sort);
 
     std::shared_ptr<Table> m_table;
@@ -64,6 +64,26 @@ public:
 
     void reserve(size_t total_string_size, size_t string_count);
 
+    /**
+     * @brief Drop every string whose id is not set in `live`, moving the
+     * strings that remain down so that ids stay dense, and release the
+     * memory they occupied. Id 0 is always kept, as cleared cells point at
+     * it. Returns the new id for each old id, or 0 for dropped strings.
+     *
+     * @param live
+     * @return std::vector<t_uindex>
+     */
+    std::vector<t_uindex> compact(const std::vector<bool>& live);
+
+    /**
+     * @brief The number of bytes `compact(live)` would drop from the
+     * vocabulary's string data and extents.
+     *
+     * @param live
+     * @return t_uindex
+     */
+    t_uindex reclaimable_bytes(const std::vector<bool>& live) const;
+
 protected:
     // vlen interface
     t_uindex genidx();
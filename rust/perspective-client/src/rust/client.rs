@@ -66,6 +66,10 @@ type BoxFn<I, O> = Box<dyn Fn(I) -> O + Send + Sync + 'static>;
 
 type Subscriptions<C> = Arc<RwLock<HashMap<u32, C>>>;
 type OnceCallback = Box<dyn FnOnce(Response) -> ClientResult<()> + Send + Sync + 'static>;
+
+/// A callback for a request answered by several responses, which returns
+/// `true` from the last of them.
+type UntilCallback = Box<dyn FnMut(Response) -> ClientResult<bool> + Send + Sync + 'static>;
 type SendCallback = Arc<
     dyn for<'a> Fn(&'a Request) -> BoxFuture<'a, Result<(), Box<dyn Error + Send + Sync>>>
         + Send
@@ -87,6 +91,7 @@ pub struct Client {
     send: SendCallback,
     id_gen: Arc<AtomicU32>,
     subscriptions_once: Subscriptions<OnceCallback>,
+    subscriptions_until: Subscriptions<UntilCallback>,
     subscriptions: Subscriptions<BoxFn<Response, BoxFuture<'static, Result<(), ClientError>>>>,
 }
 
@@ -120,6 +125,7 @@ impl Client {
             features: Arc::default(),
             id_gen: Arc::new(AtomicU32::new(1)),
             subscriptions_once: Arc::default(),
+            subscriptions_until: Arc::default(),
             subscriptions: Subscriptions::default(),
             send,
         }
@@ -150,7 +156,23 @@ impl Client {
             drop(wr);
             handler(msg)?;
             return Ok(true);
-        } else if let Some(handler) = self.subscriptions.try_read().unwrap().get(&msg.msg_id) {
+        }
+
+        let mut until = self.subscriptions_until.write().await;
+        if let Some(handler) = until.get_mut(&msg.msg_id) {
+            drop(wr);
+            let msg_id = msg.msg_id;
+            let result = handler(msg);
+            if !matches!(result, Ok(false)) {
+                until.remove(&msg_id);
+            }
+
+            result?;
+            return Ok(true);
+        }
+
+        drop(until);
+        if let Some(handler) = self.subscriptions.try_read().unwrap().get(&msg.msg_id) {
             drop(wr);
             handler(msg).await?;
             return Ok(true);
@@ -213,6 +235,27 @@ impl Client {
         }
     }
 
+    /// Register a callback which is expected to respond one or more times,
+    /// returning `true` from the last response.
+    pub(crate) async fn subscribe_until(
+        &self,
+        msg: &Request,
+        on_update: UntilCallback,
+    ) -> ClientResult<()> {
+        self.subscriptions_until
+            .write()
+            .await
+            .insert(msg.msg_id, on_update);
+
+        tracing::debug!("SEND {}", msg);
+        if let Err(e) = (self.send)(msg).await {
+            self.subscriptions_until.write().await.remove(&msg.msg_id);
+            Err(e.into())
+        } else {
+            Ok(())
+        }
+    }
+
     pub(crate) async fn subscribe(
         &self,
         msg: &Request,
@@ -289,6 +332,7 @@ impl Client {
             let on_update_token = view
                 .on_update(callback, crate::view::OnUpdateOptions {
                     mode: Some(crate::view::OnUpdateMode::Row),
+                    ..crate::view::OnUpdateOptions::default()
                 })
                 .await?;
 
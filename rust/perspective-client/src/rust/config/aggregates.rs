@@ -192,11 +192,32 @@ impl Display for MultiAggregate {
     }
 }
 
+/// The trailing tag of an indexed aggregate, e.g. `["median", "indexed"]`,
+/// which keeps a per-group order-statistics index for `median`, `min`,
+/// `max`, `high minus low` and `distinct count` so they update in O(log n)
+/// rather than re-reading every row of each changed group. The tag is
+/// ignored by other aggregates.
+#[derive(Clone, Copy, Debug, Deserialize, Eq, Ord, PartialEq, PartialOrd, Serialize, TS)]
+#[serde()]
+pub enum AggregateIndex {
+    #[serde(rename = "indexed")]
+    Indexed,
+}
+
+impl Display for AggregateIndex {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        match self {
+            AggregateIndex::Indexed => write!(f, "indexed"),
+        }
+    }
+}
+
 #[derive(Clone, Debug, Deserialize, Eq, Ord, PartialEq, PartialOrd, Serialize, TS)]
 #[serde(untagged)]
 pub enum Aggregate {
     SingleAggregate(SingleAggregate),
     MultiAggregate(MultiAggregate, String),
+    IndexedAggregate(SingleAggregate, AggregateIndex),
 }
 
 impl From<&'static str> for Aggregate {
@@ -212,6 +233,7 @@ impl Display for Aggregate {
             Self::MultiAggregate(MultiAggregate::WeightedMean, x) => {
                 write!(fmt, "weighted mean by {}", x)?
             },
+            Self::IndexedAggregate(x, y) => write!(fmt, "{} ({})", x, y)?,
         };
         Ok(())
     }
@@ -224,6 +246,11 @@ impl FromStr for Aggregate {
         Ok(
             if let Some(stripped) = input.strip_prefix("weighted mean by ") {
                 Self::MultiAggregate(MultiAggregate::WeightedMean, stripped.to_owned())
+            } else if let Some(stripped) = input.strip_suffix(" (indexed)") {
+                Self::IndexedAggregate(
+                    SingleAggregate::from_str(stripped)?,
+                    AggregateIndex::Indexed,
+                )
             } else {
                 Self::SingleAggregate(SingleAggregate::from_str(input)?)
             },
@@ -326,6 +353,7 @@ impl From<Aggregate> for view_config::AggList {
             aggregations: match value {
                 Aggregate::SingleAggregate(x) => vec![format!("{}", x)],
                 Aggregate::MultiAggregate(x, y) => vec![format!("{}", x), format!("{}", y)],
+                Aggregate::IndexedAggregate(x, y) => vec![format!("{}", x), format!("{}", y)],
             },
         }
     }
@@ -333,8 +361,17 @@ impl From<Aggregate> for view_config::AggList {
 
 impl From<view_config::AggList> for Aggregate {
     fn from(value: view_config::AggList) -> Self {
-        Aggregate::SingleAggregate(
-            SingleAggregate::from_str(value.aggregations.first().unwrap()).unwrap(),
-        )
+        let mut aggregations = value.aggregations.into_iter();
+        let name = aggregations.next().unwrap();
+        match aggregations.next() {
+            Some(arg) if name == MultiAggregate::WeightedMean.to_string() => {
+                Aggregate::MultiAggregate(MultiAggregate::WeightedMean, arg)
+            },
+            Some(arg) if arg == AggregateIndex::Indexed.to_string() => Aggregate::IndexedAggregate(
+                SingleAggregate::from_str(&name).unwrap(),
+                AggregateIndex::Indexed,
+            ),
+            _ => Aggregate::SingleAggregate(SingleAggregate::from_str(&name).unwrap()),
+        }
     }
 }
@@ -17,7 +17,8 @@ use futures::Future;
 use prost::Message;
 
 use crate::proto::request::ClientReq;
-use crate::proto::{Request, Response};
+use crate::proto::response::ClientResp;
+use crate::proto::{Request, Response, ViewToArrowReq, ViewToArrowResp};
 use crate::{Client, ClientError};
 #[cfg(doc)]
 use crate::{Table, View};
@@ -126,6 +127,21 @@ impl Session<ClientError> for ProxySession {
 
                 self.parent.subscribe(&req, Box::new(on_update)).await?
             },
+            ClientReq::ViewToArrowReq(ViewToArrowReq { chunked: true, .. }) => {
+                let on_update = move |response: Response| -> Result<bool, ClientError> {
+                    let is_last = !matches!(
+                        response.client_resp,
+                        Some(ClientResp::ViewToArrowResp(ViewToArrowResp { more: true, .. }))
+                    );
+
+                    encode(response, callback.clone())?;
+                    Ok(is_last)
+                };
+
+                self.parent
+                    .subscribe_until(&req, Box::new(on_update))
+                    .await?
+            },
             _ => {
                 let on_update = move |response| encode(response, callback);
                 self.parent
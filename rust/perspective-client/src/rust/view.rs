@@ -32,6 +32,12 @@ pub use crate::utils::*;
 #[derive(Default, Debug, Deserialize, TS)]
 pub struct OnUpdateOptions {
     pub mode: Option<OnUpdateMode>,
+
+    /// Call back at most once per `throttle` milliseconds. Not allowed with
+    /// [`OnUpdateMode::Row`].
+    #[serde(default)]
+    #[ts(optional)]
+    pub throttle: Option<u32>,
 }
 
 #[derive(Default, Debug, Deserialize, TS)]
@@ -192,12 +198,47 @@ impl View {
         let msg = self.client_message(ClientReq::ViewToArrowReq(ViewToArrowReq {
             viewport: Some(window.clone().into()),
             compression: window.compression,
+            chunked: true,
         }));
 
-        match self.client.oneshot(&msg).await? {
-            ClientResp::ViewToArrowResp(ViewToArrowResp { arrow }) => Ok(arrow.into()),
-            resp => Err(resp.into()),
-        }
+        // The server answers with one response per chunk of rows, so that it
+        // never holds the whole stream at once - concatenated, they are the
+        // Arrow stream.
+        let (sender, receiver) = futures::channel::oneshot::channel::<ClientResult<Vec<u8>>>();
+        let mut sender = Some(sender);
+        let mut arrow = vec![];
+        let on_update = move |msg: Response| -> ClientResult<bool> {
+            let result = match msg.client_resp {
+                Some(ClientResp::ViewToArrowResp(ViewToArrowResp { arrow: chunk, more })) => {
+                    arrow.extend_from_slice(&chunk);
+                    if more {
+                        return Ok(false);
+                    }
+
+                    Ok(std::mem::take(&mut arrow))
+                },
+                Some(resp) => Err(resp.into()),
+                None => Err(ClientError::Unknown("Empty response".to_owned())),
+            };
+
+            if let Some(sender) = sender.take() {
+                sender
+                    .send(result)
+                    .map_err(|_| ClientError::Unknown("Internal error".to_owned()))?;
+            }
+
+            Ok(true)
+        };
+
+        self.client
+            .subscribe_until(&msg, Box::new(on_update))
+            .await?;
+
+        let arrow = receiver
+            .await
+            .map_err(|_| ClientError::Unknown("Internal error".to_owned()))??;
+
+        Ok(arrow.into())
     }
 
     #[doc = include_str!("../../docs/view/to_columns_string.md")]
@@ -326,6 +367,7 @@ impl View {
 
         let msg = self.client_message(ClientReq::ViewOnUpdateReq(ViewOnUpdateReq {
             mode: options.mode.map(|OnUpdateMode::Row| Mode::Row as i32),
+            throttle: options.throttle.unwrap_or_default(),
         }));
 
         self.client.subscribe(&msg, Box::new(callback)).await?;
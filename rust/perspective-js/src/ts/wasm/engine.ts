@@ -46,12 +46,47 @@ export class PerspectiveServer {
         );
     }
 
+    /**
+     * Coalesce updates to the table named `table_id`, processing them
+     * together once `max_batch_rows` rows are waiting or the oldest has
+     * waited `max_latency_ms`.
+     */
+    set_table_update_policy(
+        table_id: string,
+        policy: { max_latency_ms: number; max_batch_rows: number }
+    ) {
+        with_string_pointer(this.module, table_id, (ptr, len) => {
+            this.module._psp_set_table_update_policy(
+                this.server as any,
+                ptr as any,
+                len as any,
+                policy.max_latency_ms,
+                policy.max_batch_rows
+            );
+        });
+    }
+
+    /**
+     * Process every update to the table named `table_id` as it arrives.
+     */
+    clear_table_update_policy(table_id: string) {
+        with_string_pointer(this.module, table_id, (ptr, len) => {
+            this.module._psp_clear_table_update_policy(
+                this.server as any,
+                ptr as any,
+                len as any
+            );
+        });
+    }
+
     delete() {
         this.module._psp_delete_server(this.server as any);
     }
 }
 
 export class PerspectiveSession {
+    private poll_timer?: ReturnType<typeof setTimeout>;
+
     constructor(
         private mod: MainModule,
         private server: EmscriptenServer,
@@ -85,9 +120,21 @@ export class PerspectiveSession {
         decode_api_responses(this.mod, polled, async (msg: ApiResponse) => {
             await this.client_map.get(msg.client_id)!(msg.data);
         });
+
+        // Deferred table updates and throttled `on_update` notifications
+        // are only delivered by a later poll, which no request may trigger.
+        const delay = this.mod._psp_get_poll_delay(this.server as any);
+        if (delay >= 0 && this.poll_timer === undefined) {
+            this.poll_timer = setTimeout(() => {
+                this.poll_timer = undefined;
+                this.poll();
+            }, delay);
+        }
     }
 
     close() {
+        clearTimeout(this.poll_timer);
+        this.poll_timer = undefined;
         this.mod._psp_close_session(this.server as any, this.client_id);
     }
 }
@@ -109,6 +156,25 @@ async function convert_typed_array_to_pointer(
     return msg;
 }
 
+function with_string_pointer(
+    core: MainModule,
+    value: string,
+    callback: (ptr: PspPtr, len: number | bigint) => void
+) {
+    const bytes = new TextEncoder().encode(value);
+    const len = core._psp_is_memory64()
+        ? BigInt(bytes.byteLength)
+        : bytes.byteLength;
+
+    const ptr = core._psp_alloc(len as any as number);
+    core.HEAPU8.set(bytes, Number(ptr));
+    try {
+        callback(ptr, len);
+    } finally {
+        core._psp_free(ptr);
+    }
+}
+
 /**
  * Convert a pointer to WASM memory into an `ApiResponse[]`, via a custom
  * encoding.
@@ -678,6 +678,34 @@ function validate_typed_array(typed_array, column_data) {
             view.delete();
             table.delete();
         });
+
+        test("Construct a table from a view spanning several row chunks", async function () {
+            const n = 150000;
+            const data = { x: [], y: [] };
+            for (let i = 0; i < n; i++) {
+                data.x.push(i);
+                data.y.push(`s${i % 1000}`);
+            }
+
+            const table = await perspective.table(data);
+            const view = await table.view({ sort: [["x", "desc"]] });
+            const table2 = await perspective.table(view, { index: "x" });
+            const view2 = await table2.view();
+            expect(await view2.num_rows()).toEqual(n);
+            const cols = await view2.to_columns({
+                start_row: 65530,
+                end_row: 65542,
+            });
+
+            expect(cols.x).toEqual(
+                Array.from({ length: 12 }, (_, i) => 65530 + i)
+            );
+            expect(cols.y).toEqual(cols.x.map((x) => `s${x % 1000}`));
+            view2.delete();
+            table2.delete();
+            view.delete();
+            table.delete();
+        });
     });
 
     test.describe("Errors", function () {
@@ -920,6 +948,94 @@ function validate_typed_array(typed_array, column_data) {
         });
     });
 
+    test.describe("JSON schema inference", function () {
+        // Past the rows a JSON table's schema is inferred from.
+        const LATE_ROW = 1500;
+
+        function late_rows(make_late) {
+            const rows = [];
+            for (let i = 0; i < LATE_ROW + 10; i++) {
+                rows.push({ x: i, ...(i >= LATE_ROW ? make_late(i) : {}) });
+            }
+
+            return rows;
+        }
+
+        function to_ndjson(rows) {
+            return rows.map((row) => JSON.stringify(row)).join("\n");
+        }
+
+        for (const format of ["rows", "ndjson"]) {
+            const make_table = (rows) =>
+                format === "rows"
+                    ? perspective.table(rows)
+                    : perspective.table(to_ndjson(rows), { format: "ndjson" });
+
+            test(`A column null until after inference takes the type of its first value, from ${format}`, async function () {
+                const rows = late_rows((i) => ({ y: i * 2 }));
+                for (let i = 0; i < LATE_ROW; i++) {
+                    rows[i].y = null;
+                }
+
+                const table = await make_table(rows);
+                expect(await table.schema()).toEqual({
+                    x: "integer",
+                    y: "integer",
+                });
+
+                const view = await table.view();
+                const result = await view.to_columns();
+                expect(result.y.slice(0, LATE_ROW)).toEqual(
+                    Array(LATE_ROW).fill(null)
+                );
+                expect(result.y.slice(LATE_ROW)).toEqual(
+                    rows.slice(LATE_ROW).map((row) => row.y)
+                );
+                view.delete();
+                table.delete();
+            });
+
+            test(`A column promoted after inference keeps its earlier values, from ${format}`, async function () {
+                const rows = late_rows((i) => ({ x: i + 0.5 }));
+                const table = await make_table(rows);
+                expect(await table.schema()).toEqual({ x: "float" });
+                const view = await table.view();
+                const result = await view.to_columns();
+                expect(result.x).toEqual(rows.map((row) => row.x));
+                view.delete();
+                table.delete();
+            });
+
+            test(`A column first seen after inference is an error, from ${format}`, async function () {
+                const rows = late_rows(() => ({ z: "late" }));
+                await expect(make_table(rows)).rejects.toThrow(
+                    `Column \`z\` first appears in row ${LATE_ROW}`
+                );
+            });
+        }
+
+        test("Malformed NDJSON is an error", async function () {
+            const ndjson = `{"x":1}\n{"x":2\n{"x":3}`;
+            await expect(
+                perspective.table(ndjson, { format: "ndjson" })
+            ).rejects.toThrow("Could not parse NDJSON");
+
+            const table = await perspective.table({ x: "integer" });
+            await expect(
+                table.update(ndjson, { format: "ndjson" })
+            ).rejects.toThrow("Could not parse NDJSON");
+            expect(await table.size()).toEqual(0);
+            table.delete();
+        });
+
+        test("Malformed NDJSON after valid rows is an error", async function () {
+            const ndjson = to_ndjson(late_rows(() => ({}))) + "\n{x:1}";
+            await expect(
+                perspective.table(ndjson, { format: "ndjson" })
+            ).rejects.toThrow("Could not parse NDJSON");
+        });
+    });
+
     test.describe("Constructors", function () {
         test("JSON constructor", async function () {
             var table = await perspective.table(data);
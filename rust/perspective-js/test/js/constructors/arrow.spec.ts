@@ -68,4 +68,137 @@ test.describe("Arrow", function () {
             process.env.TZ = `UTC`;
         });
     });
+
+    // Null-free primitive columns are borrowed from the Arrow payload rather
+    // than copied, and copied on first write.
+    test.describe("Borrowed primitive columns", function () {
+        const make_arrow = (start: number, n: number) => {
+            const idx = Int32Array.from({ length: n }, (_, i) => start + i);
+            return arrow.tableToIPC(
+                arrow.tableFromArrays({
+                    idx,
+                    x: Float64Array.from(idx, (i) => i * 1.5),
+                    t: arrow.vectorFromArray(
+                        Array.from(idx, (i) => 1735689600000 + i * 1000),
+                        new arrow.TimestampMillisecond()
+                    ),
+                })
+            );
+        };
+
+        test("Values survive writes to rows of a borrowed table", async function () {
+            const table = await perspective.table(make_arrow(0, 1000), {
+                index: "idx",
+            });
+
+            const view = await table.view({ columns: ["idx", "x", "t"] });
+            await table.update([
+                { idx: 0, x: -1 },
+                { idx: 999, x: -2 },
+            ]);
+
+            await table.remove([500]);
+            const json = await view.to_columns();
+            expect(json.idx.length).toEqual(999);
+            expect(json.x[0]).toEqual(-1);
+            expect(json.x[1]).toEqual(1.5);
+            expect(json.x[998]).toEqual(-2);
+            expect(json.idx.includes(500)).toBeFalsy();
+            expect(json.t[1]).toEqual(1735689601000);
+            await view.delete();
+            await table.delete();
+        });
+
+        test("Arrow updates to a borrowed table match a JSON load", async function () {
+            const table = await perspective.table(make_arrow(0, 100), {
+                index: "idx",
+            });
+
+            const view = await table.view({
+                group_by: ["idx"],
+                columns: ["x"],
+                aggregates: { x: "sum" },
+            });
+
+            await table.update(make_arrow(50, 100));
+            await table.update(make_arrow(120, 10));
+            const expected_table = await perspective.table(
+                {
+                    idx: Array.from({ length: 150 }, (_, i) => i),
+                    x: Array.from({ length: 150 }, (_, i) => i * 1.5),
+                },
+                { index: "idx" }
+            );
+
+            const expected_view = await expected_table.view({
+                group_by: ["idx"],
+                columns: ["x"],
+                aggregates: { x: "sum" },
+            });
+
+            expect(await view.to_columns()).toEqual(
+                await expected_view.to_columns()
+            );
+
+            await expected_view.delete();
+            await expected_table.delete();
+            await view.delete();
+            await table.delete();
+        });
+
+        test("Statuses written to a borrowed table stay on their rows", async function () {
+            const table = await perspective.table(make_arrow(0, 200), {
+                index: "idx",
+            });
+
+            const view = await table.view({ columns: ["idx", "x", "t"] });
+
+            // Either side of the 64-row words statuses are packed into.
+            const rows = [0, 1, 62, 63, 64, 65, 126, 127, 128, 129, 199];
+            await table.update(rows.map((idx) => ({ idx, x: null })));
+            let json = await view.to_columns();
+            for (let idx = 0; idx < 200; idx++) {
+                expect(json.x[idx]).toEqual(
+                    rows.includes(idx) ? null : idx * 1.5
+                );
+                expect(json.t[idx]).toEqual(1735689600000 + idx * 1000);
+            }
+
+            await table.update(
+                rows
+                    .filter((idx) => idx % 2 === 1)
+                    .map((idx) => ({ idx, x: -idx, t: null }))
+            );
+
+            json = await view.to_columns();
+            for (const idx of rows) {
+                expect(json.x[idx]).toEqual(idx % 2 === 1 ? -idx : null);
+                expect(json.t[idx]).toEqual(
+                    idx % 2 === 1 ? null : 1735689600000 + idx * 1000
+                );
+            }
+
+            expect(json.x[2]).toEqual(3);
+            expect(json.x[66]).toEqual(99);
+            await view.delete();
+            await table.delete();
+        });
+
+        test("Appending Arrow batches keeps each batch's values", async function () {
+            const table = await perspective.table(make_arrow(0, 10));
+            for (let i = 1; i < 10; i++) {
+                await table.update(make_arrow(i * 10, 10));
+            }
+
+            const view = await table.view({ columns: ["idx", "x"] });
+            const json = await view.to_columns();
+            expect(json.idx).toEqual(Array.from({ length: 100 }, (_, i) => i));
+            expect(json.x).toEqual(
+                Array.from({ length: 100 }, (_, i) => i * 1.5)
+            );
+
+            await view.delete();
+            await table.delete();
+        });
+    });
 });
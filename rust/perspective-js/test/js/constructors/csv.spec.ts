@@ -63,4 +63,72 @@ test.describe("CSV Constructors", function () {
             { x: 4, y: 5, z: 6 },
         ]);
     });
+
+    test.describe("Timestamp formats", function () {
+        // Each format with the UTC time it names. Only the datetime schema
+        // reads bare epoch milliseconds.
+        const FORMATS: [string, number][] = [
+            ["2020-01-02 03:04:05", Date.UTC(2020, 0, 2, 3, 4, 5)],
+            ["2020-03-04T05:06:07.890", Date.UTC(2020, 2, 4, 5, 6, 7, 890)],
+            ["05/06/2020", Date.UTC(2020, 4, 6)],
+            ["07-08-2020", Date.UTC(2020, 6, 8)],
+            ["1594857600000", Date.UTC(2020, 6, 16)],
+        ];
+
+        const make_csv = (values: string[]) => `t\n${values.join("\n")}`;
+
+        test("Mixed formats in one column", async function () {
+            const rows = Array.from(
+                { length: 5000 },
+                (_, i) => FORMATS[(i * 3) % FORMATS.length]
+            );
+
+            const table = await perspective.table({ t: "datetime" });
+            await table.update(make_csv(rows.map(([s]) => s)));
+            const view = await table.view();
+            expect(await view.to_columns()).toEqual({
+                t: rows.map(([, t]) => t),
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("A format switch partway through the file", async function () {
+            // Long runs of each format, so the format cached for a run is
+            // tried first, and fails, on the first value of the next.
+            const rows = [...FORMATS, FORMATS[0]].flatMap((format) =>
+                Array(3000).fill(format)
+            );
+
+            const table = await perspective.table({ t: "datetime" });
+            await table.update(make_csv(rows.map(([s]) => s)));
+            const view = await table.view();
+            expect(await view.to_columns()).toEqual({
+                t: rows.map(([, t]) => t),
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("A format switch partway through an inferred column", async function () {
+            const rows = Array(3000)
+                .fill(FORMATS[0])
+                .concat(Array(3000).fill(FORMATS[1]))
+                .concat(Array(3000).fill(FORMATS[2]));
+
+            const table = await perspective.table(
+                make_csv(rows.map(([s]) => s))
+            );
+            expect(await table.schema()).toEqual({ t: "datetime" });
+            const view = await table.view();
+            expect(await view.to_columns()).toEqual({
+                t: rows.map(([, t]) => t),
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+    });
 });
@@ -702,6 +702,38 @@ function it_old_behavior(name, capture) {
                 table.update(partial_change_y);
             });
 
+            test("returns changed rows after expand or collapse on a view sharing its context", async function () {
+                const config = {
+                    group_by: ["y"],
+                    aggregates: { y: "distinct count", z: "distinct count" },
+                };
+
+                const table = await perspective.table(data, { index: "x" });
+                const view = await table.view(config);
+                const shared = await table.view(config);
+                let updated;
+                const result = new Promise((x) => {
+                    updated = x;
+                });
+
+                await view.on_update(updated, { mode: "row" });
+
+                // Expanding or collapsing gives `view` a context of its own.
+                await view.set_depth(0);
+                await view.expand(0);
+                await table.update(partial_change_y);
+                const { delta } = await result;
+                await match_delta(perspective, delta, [
+                    { x: 1, y: 1, z: 1 },
+                    { x: 2, y: 1, z: 1 },
+                ]);
+
+                expect(await view.to_json()).toEqual(await shared.to_json());
+                await shared.delete();
+                await view.delete();
+                await table.delete();
+            });
+
             test.skip("returns changed rows, unique", async function () {
                 // FIXME: the delta doesn't seem to trigger if the
                 // cell is invalidated, only if the actual values are
@@ -1177,6 +1177,127 @@ import * as expressions_common from "./common.js";
             });
         });
 
+        test.describe("Shared expressions", () => {
+            test("Two views with the same expression both update", async () => {
+                const table = await perspective.table(
+                    { x: [1, 2, 3], y: [1.5, 2.5, 3.5] },
+                    { index: "x" }
+                );
+
+                const v1 = await table.view({
+                    columns: ["column"],
+                    expressions: { column: `"x" * "y"` },
+                });
+
+                const v2 = await table.view({
+                    group_by: ["x"],
+                    columns: ["column"],
+                    expressions: { column: `"x" * "y"` },
+                });
+
+                await table.update({ x: [2, 4], y: [10, 0.5] });
+
+                expect(await v1.to_columns()).toEqual({
+                    column: [1.5, 20, 10.5, 2],
+                });
+
+                expect(await v2.to_columns()).toEqual({
+                    __ROW_PATH__: [[], [1], [2], [3], [4]],
+                    column: [34, 1.5, 20, 10.5, 2],
+                });
+
+                await v2.delete();
+                await v1.delete();
+                await table.delete();
+            });
+
+            test("Deleting one view keeps the shared expression for the other", async () => {
+                const table = await perspective.table(
+                    { x: [1, 2, 3], y: [1.5, 2.5, 3.5] },
+                    { index: "x" }
+                );
+
+                const v1 = await table.view({
+                    columns: ["column"],
+                    expressions: { column: `"x" + "y"` },
+                });
+
+                const v2 = await table.view({
+                    columns: ["column"],
+                    expressions: { column: `"x" + "y"` },
+                });
+
+                await v1.delete();
+                await table.update({ x: [2, 4], y: [10, 0.5] });
+                expect(await v2.to_columns()).toEqual({
+                    column: [2.5, 12, 6.5, 4.5],
+                });
+
+                await table.remove([1]);
+                await table.update({ x: [5], y: [1] });
+                expect(await v2.to_columns()).toEqual({
+                    column: [12, 6.5, 4.5, 6],
+                });
+
+                // A new view acquires the expression again and sees the
+                // rows computed while only `v2` held it.
+                const v3 = await table.view({
+                    columns: ["column"],
+                    expressions: { column: `"x" + "y"` },
+                });
+
+                await v2.delete();
+                await table.update({ x: [3], y: [-3] });
+                expect(await v3.to_columns()).toEqual({
+                    column: [12, 0, 4.5, 6],
+                });
+
+                await v3.delete();
+                await table.delete();
+            });
+
+            test("The same expression under different aliases", async () => {
+                const table = await perspective.table(
+                    { x: [1, 2, 3], y: [1.5, 2.5, 3.5] },
+                    { index: "x" }
+                );
+
+                const v1 = await table.view({
+                    columns: ["a", "b"],
+                    expressions: { a: `"y" - "x"`, b: `"y" - "x"` },
+                });
+
+                const v2 = await table.view({
+                    columns: ["c"],
+                    expressions: { c: `"y" - "x"` },
+                });
+
+                expect(await v1.expression_schema()).toEqual({
+                    a: "float",
+                    b: "float",
+                });
+
+                await table.update({ x: [3, 4], y: [10, 8] });
+                expect(await v1.to_columns()).toEqual({
+                    a: [0.5, 0.5, 7, 4],
+                    b: [0.5, 0.5, 7, 4],
+                });
+
+                expect(await v2.to_columns()).toEqual({
+                    c: [0.5, 0.5, 7, 4],
+                });
+
+                await v1.delete();
+                await table.update({ x: [1], y: [0] });
+                expect(await v2.to_columns()).toEqual({
+                    c: [-1, 0.5, 7, 4],
+                });
+
+                await v2.delete();
+                await table.delete();
+            });
+        });
+
         test("Multiple views with the same expression alias should not conflict", async () => {
             const now = new Date();
             const bucketed = new Date(now.getUTCFullYear(), 0, 1).getTime();
@@ -533,6 +533,66 @@ const datetime_data_local = [
                 view.delete();
                 table.delete();
             });
+
+            test("y == 'a' OR y == 'c'", async function () {
+                var table = await perspective.table(data);
+                var view = await table.view({
+                    filter_op: "or",
+                    filter: [
+                        ["y", "==", "a"],
+                        ["y", "==", "c"],
+                    ],
+                });
+                let json = await view.to_json();
+                expect(json).toEqual([rdata[0], rdata[2]]);
+                view.delete();
+                table.delete();
+            });
+
+            test("y != 'a' OR x == 1", async function () {
+                var table = await perspective.table(data);
+                var view = await table.view({
+                    filter_op: "or",
+                    filter: [
+                        ["y", "!=", "a"],
+                        ["x", "==", 1],
+                    ],
+                });
+                let json = await view.to_json();
+                expect(json).toEqual(rdata);
+                view.delete();
+                table.delete();
+            });
+
+            test("y == 'missing' OR x == 4", async function () {
+                var table = await perspective.table(data);
+                var view = await table.view({
+                    filter_op: "or",
+                    filter: [
+                        ["y", "==", "missing"],
+                        ["x", "==", 4],
+                    ],
+                });
+                let json = await view.to_json();
+                expect(json).toEqual([rdata[3]]);
+                view.delete();
+                table.delete();
+            });
+
+            test("y != 'missing' OR x == 4", async function () {
+                var table = await perspective.table(data);
+                var view = await table.view({
+                    filter_op: "or",
+                    filter: [
+                        ["y", "!=", "missing"],
+                        ["x", "==", 4],
+                    ],
+                });
+                let json = await view.to_json();
+                expect(json).toEqual(rdata);
+                view.delete();
+                table.delete();
+            });
         });
 
         test.describe("long strings", function () {
@@ -845,6 +905,40 @@ const datetime_data_local = [
                 table.delete();
             });
 
+            test("x == 'missing'", async function () {
+                var table = await perspective.table([
+                    { x: "b", y: 1 },
+                    { x: null, y: 1 },
+                    { x: "a", y: 2 },
+                ]);
+                var view = await table.view({
+                    filter: [["x", "==", "missing"]],
+                });
+                let result = await view.to_json();
+                expect(result).toEqual([]);
+                view.delete();
+                table.delete();
+            });
+
+            test("x != 'missing'", async function () {
+                var table = await perspective.table([
+                    { x: "b", y: 1 },
+                    { x: null, y: 1 },
+                    { x: "a", y: 2 },
+                ]);
+                var view = await table.view({
+                    filter: [["x", "!=", "missing"]],
+                });
+                let result = await view.to_json();
+                expect(result).toEqual([
+                    { x: "b", y: 1 },
+                    { x: null, y: 1 },
+                    { x: "a", y: 2 },
+                ]);
+                view.delete();
+                table.delete();
+            });
+
             test("x == 'b'", async function () {
                 var table = await perspective.table([
                     { x: "b", y: 1 },
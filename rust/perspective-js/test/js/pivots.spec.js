@@ -1579,6 +1579,320 @@ const std = (nums) => {
             await table.delete();
         });
 
+        test("mean, weighted mean, variance and stddev match a full recompute after many updates and removes", async function () {
+            // One column per aggregate, as expression columns are always
+            // recomputed.
+            const schema = {
+                k: "integer",
+                g: "string",
+                x: "float",
+                x_mean: "float",
+                x_wmean: "float",
+                x_std: "float",
+                w: "float",
+            };
+
+            const config = {
+                group_by: ["g"],
+                columns: ["x", "x_mean", "x_wmean", "x_std"],
+                aggregates: {
+                    x: "var",
+                    x_mean: "mean",
+                    x_wmean: ["weighted mean", "w"],
+                    x_std: "stddev",
+                },
+            };
+
+            const table = await perspective.table(schema, { index: "k" });
+            const view = await table.view(config);
+
+            // Values with a large common offset, which is the worst case for
+            // removing values from a running variance.
+            let seed = 7;
+            const rand = () => {
+                seed = (seed * 16807) % 2147483647;
+                return seed / 2147483647;
+            };
+
+            const rows = new Map();
+            for (let i = 0; i < 600; i++) {
+                const batch = [];
+                for (let j = 0; j < 4; j++) {
+                    const k = Math.floor(rand() * 64);
+                    const x = 1e6 + rand() * 10;
+                    const row = {
+                        k,
+                        g: ["a", "b", "c"][Math.floor(rand() * 3)],
+                        x,
+                        x_mean: x,
+                        x_wmean: x,
+                        x_std: x,
+                        w: 1 + rand(),
+                    };
+
+                    rows.set(k, row);
+                    batch.push(row);
+                }
+
+                await table.update(batch);
+                if (i % 5 === 4) {
+                    const removed = [...rows.keys()].slice(0, 3);
+                    for (const k of removed) {
+                        rows.delete(k);
+                    }
+
+                    await table.remove(removed);
+                }
+            }
+
+            const fresh = await perspective.table(schema, { index: "k" });
+            await fresh.update([...rows.values()]);
+            const fresh_view = await fresh.view(config);
+
+            const result = await view.to_columns();
+            const expected = await fresh_view.to_columns();
+            expect(result.__ROW_PATH__).toEqual(expected.__ROW_PATH__);
+            for (const col of ["x_mean", "x_wmean"]) {
+                for (let i = 0; i < expected[col].length; i++) {
+                    expect(result[col][i]).toBeCloseTo(expected[col][i], 6);
+                }
+            }
+
+            for (const col of ["x", "x_std"]) {
+                for (let i = 0; i < expected[col].length; i++) {
+                    expect(result[col][i]).toBeGreaterThanOrEqual(0);
+                    expect(result[col][i]).toBeCloseTo(expected[col][i], 6);
+                }
+            }
+
+            await fresh_view.delete();
+            await fresh.delete();
+            await view.delete();
+            await table.delete();
+        });
+
+        test("variance of a group emptied by removes is recomputed", async function () {
+            const table = await perspective.table(
+                { k: [1, 2, 3, 4], g: ["a", "a", "b", "b"], x: [1, 2, 3, 5] },
+                { index: "k" }
+            );
+
+            const view = await table.view({
+                group_by: ["g"],
+                columns: ["x"],
+                aggregates: { x: "var" },
+            });
+
+            await table.remove([1, 2]);
+            await table.update([
+                { k: 5, g: "a", x: 10 },
+                { k: 6, g: "a", x: 14 },
+            ]);
+            const result = await view.to_columns();
+            expect(result.__ROW_PATH__).toEqual([[], ["a"], ["b"]]);
+            expect(result.x[1]).toBeCloseTo(4, 10);
+            expect(result.x[2]).toBeCloseTo(1, 10);
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test.describe("indexed aggregates", function () {
+            // One column per aggregate, as a column takes one aggregate.
+            const schema = {
+                k: "integer",
+                g: "string",
+                x_median: "float",
+                x_min: "float",
+                x_max: "float",
+                x_hml: "float",
+                x_distinct: "float",
+                i_median: "integer",
+                s_median: "string",
+                s_distinct: "string",
+            };
+
+            const aggregates = {
+                x_median: "median",
+                x_min: "min",
+                x_max: "max",
+                x_hml: "high minus low",
+                x_distinct: "distinct count",
+                i_median: "median",
+                s_median: "median",
+                s_distinct: "distinct count",
+            };
+
+            const indexed = (aggregates) =>
+                Object.fromEntries(
+                    Object.entries(aggregates).map(([k, v]) => [
+                        k,
+                        [v, "indexed"],
+                    ])
+                );
+
+            test("match unindexed aggregates after many updates and removes", async function () {
+                const table = await perspective.table(schema, { index: "k" });
+                const config = {
+                    group_by: ["g"],
+                    columns: Object.keys(aggregates),
+                };
+
+                const view = await table.view({ ...config, aggregates });
+                const indexed_view = await table.view({
+                    ...config,
+                    aggregates: indexed(aggregates),
+                });
+
+                let seed = 11;
+                const rand = () => {
+                    seed = (seed * 16807) % 2147483647;
+                    return seed / 2147483647;
+                };
+
+                const rows = new Map();
+                for (let i = 0; i < 300; i++) {
+                    const batch = [];
+                    for (let j = 0; j < 4; j++) {
+                        const k = Math.floor(rand() * 48);
+
+                        // Few distinct values, so groups hold duplicates and
+                        // even-sized float medians average two of them.
+                        const x = Math.floor(rand() * 20) / 4;
+                        const row = {
+                            k,
+                            g: ["a", "b", "c"][Math.floor(rand() * 3)],
+                            x_median: x,
+                            x_min: x,
+                            x_max: x,
+                            x_hml: x,
+                            x_distinct: x,
+                            i_median: Math.floor(rand() * 10),
+                            s_median: `s${Math.floor(rand() * 8)}`,
+                            s_distinct: `s${Math.floor(rand() * 8)}`,
+                        };
+
+                        rows.set(k, row);
+                        batch.push(row);
+                    }
+
+                    await table.update(batch);
+                    if (i % 5 === 4) {
+                        const removed = [...rows.keys()].slice(0, 3);
+                        for (const k of removed) {
+                            rows.delete(k);
+                        }
+
+                        await table.remove(removed);
+                    }
+
+                    if (i % 20 === 19) {
+                        expect(await indexed_view.to_columns()).toEqual(
+                            await view.to_columns()
+                        );
+                    }
+                }
+
+                expect(await indexed_view.to_columns()).toEqual(
+                    await view.to_columns()
+                );
+
+                await indexed_view.delete();
+                await view.delete();
+                await table.delete();
+            });
+
+            test("distinct count matches unindexed with NaN and signed zeroes", async function () {
+                // A float column, so that `"x" * 0` keeps the sign of `x`.
+                const table = await perspective.table(
+                    { k: "integer", g: "string", x: "float" },
+                    { index: "k" }
+                );
+
+                await table.update({
+                    k: [1, 2, 3, 4, 5, 6],
+                    g: ["a", "a", "a", "b", "b", "b"],
+                    x: [-4, -1, 4, 9, -9, 1],
+                });
+
+                const config = {
+                    group_by: ["g"],
+                    columns: ["nan", "zero"],
+                    expressions: { nan: 'sqrt("x")', zero: '"x" * 0' },
+                };
+
+                const distinct = {
+                    nan: "distinct count",
+                    zero: "distinct count",
+                };
+
+                const view = await table.view({
+                    ...config,
+                    aggregates: distinct,
+                });
+
+                const indexed_view = await table.view({
+                    ...config,
+                    aggregates: indexed(distinct),
+                });
+
+                // NaN is one value, -0 and 0 are two.
+                const expected = {
+                    __ROW_PATH__: [[], ["a"], ["b"]],
+                    nan: [4, 2, 3],
+                    zero: [2, 2, 2],
+                };
+
+                expect(await view.to_columns()).toEqual(expected);
+                expect(await indexed_view.to_columns()).toEqual(expected);
+
+                await table.update([{ k: 4, x: -16 }]);
+                expected.nan = [3, 2, 2];
+                expect(await view.to_columns()).toEqual(expected);
+                expect(await indexed_view.to_columns()).toEqual(expected);
+
+                await indexed_view.delete();
+                await view.delete();
+                await table.delete();
+            });
+
+            // Unlike the unindexed aggregates, whose result for a group with
+            // NaN depends on the order of its rows, the index sorts NaN
+            // after every number.
+            test("sort NaN after every number", async function () {
+                const table = await perspective.table({
+                    g: ["a", "a", "a", "b", "b"],
+                    x: [-1, 4, 9, 16, 25],
+                });
+
+                const view = await table.view({
+                    group_by: ["g"],
+                    columns: ["min", "max", "median"],
+                    expressions: {
+                        min: 'sqrt("x")',
+                        max: 'sqrt("x")',
+                        median: 'sqrt("x")',
+                    },
+                    aggregates: {
+                        min: ["min", "indexed"],
+                        max: ["max", "indexed"],
+                        median: ["median", "indexed"],
+                    },
+                });
+
+                // NaN is written as null.
+                expect(await view.to_columns()).toEqual({
+                    __ROW_PATH__: [[], ["a"], ["b"]],
+                    min: [2, 2, 4],
+                    max: [null, null, 5],
+                    median: [4, 3, 4.5],
+                });
+
+                await view.delete();
+                await table.delete();
+            });
+        });
+
         test("standard deviation", async function () {
             const table = await perspective.table(float_data);
             const view = await table.view({
@@ -649,6 +649,78 @@ function it_old_behavior(name, capture) {
         });
 
         test.describe("deltas", function () {
+            test("Every subscriber to a view gets the same delta for each port", async function () {
+                const table = await perspective.table(
+                    { x: "integer", y: "string", w: "float" },
+                    { index: "x" }
+                );
+
+                const port_id = await table.make_port();
+                const config = { sort: [["w", "desc"]] };
+                const shared = await table.view(config);
+                const single = await table.view(config);
+
+                // Three subscribers to `shared`, which share one delta, and
+                // one to `single`, which computes its delta on its own.
+                const received = [[], [], [], []];
+                let remaining = received.length * 2;
+                let done;
+                const all_received = new Promise((x) => {
+                    done = x;
+                });
+
+                const subscribed = [shared, shared, shared, single];
+                for (const [idx, view] of subscribed.entries()) {
+                    await view.on_update(
+                        (updated) => {
+                            received[idx].push([
+                                updated.port_id,
+                                new Uint8Array(updated.delta),
+                            ]);
+
+                            if (--remaining === 0) {
+                                done();
+                            }
+                        },
+                        { mode: "row" }
+                    );
+                }
+
+                const n = 20000;
+                const x = Array.from({ length: n }, (_, i) => i);
+                await table.update({
+                    x,
+                    y: x.map((i) => `row ${i}`),
+                    w: x.map((i) => (i * 7) % 101),
+                });
+
+                const updated = x.filter((i) => i % 3 === 0);
+                await table.update(
+                    { x: updated, w: updated.map((i) => -i) },
+                    { port_id }
+                );
+
+                await all_received;
+                expect(received[0].map(([port]) => port)).toEqual([
+                    0,
+                    port_id,
+                ]);
+
+                for (const deltas of received.slice(1)) {
+                    expect(deltas).toEqual(received[0]);
+                }
+
+                const delta_table = await perspective.table(
+                    received[0][1][1].slice().buffer
+                );
+
+                expect(await delta_table.size()).toEqual(updated.length);
+                await delta_table.delete();
+                await single.delete();
+                await shared.delete();
+                await table.delete();
+            });
+
             it_old_behavior(
                 "Deltas should be unique to each port",
                 async function (done) {
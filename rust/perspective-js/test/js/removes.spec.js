@@ -488,3 +488,79 @@ test.describe("Removes", () => {
         }
     }
 });
+
+// String columns drop the strings left behind by removed and overwritten rows
+// once they outnumber the live ones - these tests cross that threshold.
+test.describe("Vocabulary compaction", () => {
+    const make_rows = (start, end, prefix = "s") => {
+        const rows = { key: [], s: [], x: [] };
+        for (let i = start; i < end; i++) {
+            rows.key.push(`k${i}`);
+            rows.s.push(`${prefix}${i}`);
+            rows.x.push(i);
+        }
+
+        return rows;
+    };
+
+    test("String values and keys survive compaction after removes", async () => {
+        const table = await perspective.table(make_rows(0, 3000), {
+            index: "key",
+        });
+
+        const view = await table.view({ sort: [["x", "asc"]] });
+        const filtered = await table.view({
+            filter: [["s", "==", "s2998"]],
+        });
+
+        await table.remove(make_rows(0, 2500).key);
+        expect(await view.to_columns()).toEqual(make_rows(2500, 3000));
+
+        // Updates and removes by string key must find the rows they did
+        // before the compaction.
+        await table.update([{ key: "k2999", s: "updated" }]);
+        await table.remove(["k2500"]);
+        const expected = make_rows(2501, 3000);
+        expected.s[expected.s.length - 1] = "updated";
+        expect(await view.to_columns()).toEqual(expected);
+        expect(await filtered.to_columns()).toEqual(make_rows(2998, 2999));
+
+        await table.update(make_rows(0, 10, "t"));
+        expect(await table.size()).toEqual(509);
+        const json = await view.to_columns();
+        expect(json.s.slice(0, 10)).toEqual(make_rows(0, 10, "t").s);
+        expect(json.s.slice(10)).toEqual(expected.s);
+
+        await filtered.delete();
+        await view.delete();
+        await table.delete();
+    });
+
+    test("Overwritten strings are compacted without changing live values", async () => {
+        const table = await perspective.table(make_rows(0, 1000), {
+            index: "key",
+        });
+
+        const view = await table.view({ sort: [["x", "asc"]] });
+        const grouped = await table.view({
+            group_by: ["s"],
+            columns: ["x"],
+            aggregates: { x: "sum" },
+        });
+
+        for (let round = 0; round < 5; round++) {
+            await table.update(make_rows(0, 1000, `r${round}_`));
+        }
+
+        expect(await view.to_columns()).toEqual(make_rows(0, 1000, "r4_"));
+        const json = await grouped.to_columns();
+        expect(json.x[0]).toEqual((999 * 1000) / 2);
+        expect(json.__ROW_PATH__.flat()).toEqual(
+            expect.arrayContaining(make_rows(0, 1000, "r4_").s)
+        );
+
+        await grouped.delete();
+        await view.delete();
+        await table.delete();
+    });
+});
@@ -32,8 +32,221 @@ const data3 = {
     y: ["a", "a", "a", "a", "b", "b", "b", "b"],
 };
 
+// Deterministic rows of mixed types and nulls, with strings that share a
+// prefix longer than a sort key.
+function make_mixed_data(start, n) {
+    let seed = start + 1;
+    const rand = () => {
+        seed = (seed * 16807) % 2147483647;
+        return seed;
+    };
+
+    const prefix = "a prefix longer than the sort key, ";
+    const data = { idx: [], i: [], f: [], s: [], b: [] };
+    for (let k = 0; k < n; k++) {
+        data.idx.push(start + k);
+        data.i.push(rand() % 5 === 0 ? null : (rand() % 21) - 10);
+        data.f.push(rand() % 5 === 0 ? null : ((rand() % 41) - 20) / 4);
+        data.s.push(
+            rand() % 5 === 0
+                ? null
+                : (rand() % 2 ? prefix : "") +
+                      "abcd".slice(0, 1 + (rand() % 4)) +
+                      String.fromCharCode(97 + (rand() % 3))
+        );
+        data.b.push(rand() % 5 === 0 ? null : rand() % 2 === 0);
+    }
+
+    return data;
+}
+
+// The order a flat view should sort `data` in - nulls first when ascending,
+// and ties in insertion order.
+function reference_sort(data, sort) {
+    return data.idx
+        .map((_, ridx) => ridx)
+        .sort((a, b) => {
+            for (const [col, dir] of sort) {
+                const x = data[col][a];
+                const y = data[col][b];
+                if (x === y) {
+                    continue;
+                }
+
+                const cmp = x === null ? -1 : y === null ? 1 : x < y ? -1 : 1;
+                return dir === "desc" ? -cmp : cmp;
+            }
+
+            return a - b;
+        })
+        .map((ridx) => data.idx[ridx]);
+}
+
+function concat_data(a, b) {
+    const data = {};
+    for (const col of Object.keys(a)) {
+        data[col] = a[col].concat(b[col]);
+    }
+
+    return data;
+}
+
+const MIXED_SCHEMA = {
+    idx: "integer",
+    i: "integer",
+    f: "float",
+    s: "string",
+    b: "boolean",
+};
+
+const MIXED_SORTS = [
+    [["i", "asc"]],
+    [["f", "desc"]],
+    [["s", "asc"]],
+    [["s", "desc"]],
+    [["b", "asc"]],
+    [
+        ["i", "desc"],
+        ["f", "asc"],
+    ],
+    [
+        ["f", "desc"],
+        ["s", "asc"],
+    ],
+    [
+        ["s", "desc"],
+        ["i", "desc"],
+    ],
+    [
+        ["b", "asc"],
+        ["s", "desc"],
+        ["f", "desc"],
+    ],
+    [
+        ["b", "desc"],
+        ["i", "asc"],
+        ["f", "asc"],
+        ["s", "asc"],
+    ],
+];
+
 ((perspective) => {
     test.describe("Sorts", function () {
+        test.describe("Sort keys", () => {
+            test("match a reference order for mixed types, nulls and descending sorts", async function () {
+                const data = make_mixed_data(0, 500);
+                const table = await perspective.table(MIXED_SCHEMA);
+                await table.update(data);
+                for (const sort of MIXED_SORTS) {
+                    const view = await table.view({ sort });
+                    const json = await view.to_columns();
+                    expect(json.idx).toEqual(reference_sort(data, sort));
+                    view.delete();
+                }
+
+                table.delete();
+            });
+
+            test("match a reference order after updates", async function () {
+                const data = make_mixed_data(0, 300);
+                const table = await perspective.table(MIXED_SCHEMA);
+                await table.update(data);
+                const views = [];
+                for (const sort of MIXED_SORTS) {
+                    views.push(await table.view({ sort }));
+                }
+
+                const update = make_mixed_data(300, 300);
+                await table.update(update);
+                const expected = concat_data(data, update);
+                for (let vidx = 0; vidx < views.length; vidx++) {
+                    const json = await views[vidx].to_columns();
+                    expect(json.idx).toEqual(
+                        reference_sort(expected, MIXED_SORTS[vidx])
+                    );
+                    views[vidx].delete();
+                }
+
+                table.delete();
+            });
+
+            test("match a reference order and a new view after inserts, removes and sort key updates", async function () {
+                const table = await perspective.table(MIXED_SCHEMA, {
+                    index: "idx",
+                });
+
+                const rows = new Map();
+                const apply = (data) => {
+                    for (let k = 0; k < data.idx.length; k++) {
+                        const row = {};
+                        for (const col of Object.keys(data)) {
+                            row[col] = data[col][k];
+                        }
+
+                        rows.set(row.idx, row);
+                    }
+                };
+
+                const initial = make_mixed_data(0, 2000);
+                await table.update(initial);
+                apply(initial);
+                const views = [];
+                for (const sort of MIXED_SORTS) {
+                    views.push(await table.view({ sort }));
+                }
+
+                for (let round = 0; round < 5; round++) {
+                    // Rewrite the sort keys of existing rows scattered
+                    // through the index, and add new ones past its end.
+                    const update = make_mixed_data(round * 250, 600);
+                    update.idx = update.idx.map(
+                        (idx) => (idx * 7) % (2000 + round * 300)
+                    );
+
+                    await table.update(update);
+                    apply(update);
+                    const removed = Array.from(rows.keys())
+                        .filter((idx) => idx % 11 === round)
+                        .slice(0, 150);
+
+                    await table.remove(removed);
+                    for (const idx of removed) {
+                        rows.delete(idx);
+                    }
+
+                    // Ties are broken by the index, so the reference sorts
+                    // the rows in index order.
+                    const expected = { idx: [], i: [], f: [], s: [], b: [] };
+                    const idxs = Array.from(rows.keys()).sort((a, b) => a - b);
+                    for (const idx of idxs) {
+                        for (const col of Object.keys(expected)) {
+                            expected[col].push(rows.get(idx)[col]);
+                        }
+                    }
+
+                    for (let vidx = 0; vidx < views.length; vidx++) {
+                        const json = await views[vidx].to_columns();
+                        expect(json.idx).toEqual(
+                            reference_sort(expected, MIXED_SORTS[vidx])
+                        );
+
+                        const fresh = await table.view({
+                            sort: MIXED_SORTS[vidx],
+                        });
+
+                        expect(await fresh.to_columns()).toEqual(json);
+                        await fresh.delete();
+                    }
+                }
+
+                for (const view of views) {
+                    await view.delete();
+                }
+
+                await table.delete();
+            });
+        });
+
         test.describe("With nulls", () => {
             test("asc", async function () {
                 var table = await perspective.table(data2);
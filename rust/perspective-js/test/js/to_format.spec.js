@@ -1112,6 +1112,38 @@ const pivoted_output = [
             table.delete();
         });
 
+        test("arrow output spanning several row chunks", async function () {
+            const n = 150000;
+            const data = { x: [], y: [] };
+            for (let i = 0; i < n; i++) {
+                data.x.push(i);
+                data.y.push(`s${i % 1000}`);
+            }
+
+            let table = await perspective.table(data);
+            let view = await table.view({ sort: [["x", "desc"]] });
+            for (const options of [{}, { compression: "lz4" }]) {
+                let arrow = await view.to_arrow(options);
+                let table2 = await perspective.table(arrow);
+                let view2 = await table2.view();
+                expect(await view2.num_rows()).toEqual(n);
+                let cols = await view2.to_columns({
+                    start_row: 65530,
+                    end_row: 65542,
+                });
+
+                expect(cols.x).toEqual(
+                    Array.from({ length: 12 }, (_, i) => n - 65531 - i)
+                );
+                expect(cols.y).toEqual(cols.x.map((x) => `s${x % 1000}`));
+                view2.delete();
+                table2.delete();
+            }
+
+            view.delete();
+            table.delete();
+        });
+
         test.describe("to_format with index", function () {
             test.describe("0-sided", function () {
                 test("should return correct pkey for unindexed table", async function () {
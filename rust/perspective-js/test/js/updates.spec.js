@@ -1551,6 +1551,113 @@ async function match_delta(perspective, delta, expected) {
             table.delete();
         });
 
+        // Large first loads build the pkey index in parallel partitions.
+        for (const [name, make_key] of [
+            ["dense int", (i) => i],
+            ["sparse int", (i) => i * 20011 - 50000],
+            ["float", (i) => i + 0.5],
+        ]) {
+            test(`{index: 'x'} (${name}) bulk loaded index finds every key`, async function () {
+                const n = 100000;
+                const x = Array.from({ length: n }, (_, i) => make_key(i));
+                const y = Array.from({ length: n }, (_, i) => i);
+                x.push(make_key(7), null);
+                y.push(-7, -1);
+
+                const table = await perspective.table(
+                    { x, y },
+                    { index: "x" }
+                );
+                expect(await table.size()).toEqual(n + 1);
+                await table.update({
+                    x: [make_key(0), make_key(n - 1), make_key(n)],
+                    y: [-2, -3, -4],
+                });
+
+                await table.remove([make_key(1)]);
+                const view = await table.view({
+                    filter: [["y", "<", 0]],
+                });
+
+                const result = await view.to_columns();
+                expect(result).toEqual({
+                    x: [
+                        null,
+                        make_key(0),
+                        make_key(7),
+                        make_key(n - 1),
+                        make_key(n),
+                    ],
+                    y: [-1, -2, -7, -3, -4],
+                });
+
+                expect(await table.size()).toEqual(n + 1);
+                await view.delete();
+                await table.delete();
+            });
+        }
+
+        // Updates and removes that move an int index out of its dense
+        // vector, and through a str index, checked against a plain `Map`.
+        for (const [name, make_key] of [
+            [
+                "mixed int",
+                (i) =>
+                    i % 97 === 0
+                        ? null
+                        : i % 13 === 0
+                        ? -i
+                        : i % 7 === 0
+                        ? i * 10007
+                        : i,
+            ],
+            ["str", (i) => (i % 97 === 0 ? null : `key ${(i * 7919) % 20011}`)],
+        ]) {
+            test(`{index: 'x'} (${name}) keys match a Map after updates and removes`, async function () {
+                const expected = new Map();
+                const table = await perspective.table(
+                    { x: [make_key(1)], y: [0] },
+                    { index: "x" }
+                );
+
+                expected.set(make_key(1), 0);
+                for (let round = 0; round < 10; round++) {
+                    const x = [];
+                    const y = [];
+                    for (let i = 0; i < 4000; i++) {
+                        const key = make_key((round * 1777 + i * 31) % 12000);
+                        x.push(key);
+                        y.push(round * 4000 + i);
+                        expected.set(key, round * 4000 + i);
+                    }
+
+                    await table.update({ x, y });
+                    const removed = x
+                        .filter((key, i) => key !== null && i % 5 === round % 5)
+                        .slice(0, 500);
+
+                    await table.remove(removed);
+                    for (const key of removed) {
+                        expected.delete(key);
+                    }
+                }
+
+                const keys = Array.from(expected.keys()).sort((a, b) =>
+                    a === null ? -1 : b === null ? 1 : a < b ? -1 : a > b ? 1 : 0
+                );
+
+                const view = await table.view();
+                expect(await table.size()).toEqual(keys.length);
+                expect(await view.to_columns()).toEqual({
+                    x: keys,
+                    y: keys.map((key) => expected.get(key)),
+                });
+
+                await view.delete();
+                await table.delete();
+            });
+        }
+
         test("{index: 'x'} (int) with null and 0", async function () {
             const data = {
                 x: [0, 1, null, 2, 3],
@@ -2199,6 +2306,145 @@ async function match_delta(perspective, delta, expected) {
             view.delete();
             table.delete();
         });
+
+        test.describe("across validity words", function () {
+            // Row statuses are packed 64 to a word - these rows sit either
+            // side of the first few word boundaries.
+            const BOUNDARY_ROWS = [
+                0, 1, 62, 63, 64, 65, 126, 127, 128, 129, 191, 192, 199,
+            ];
+
+            const schema = { idx: "integer", x: "float", s: "string" };
+
+            const make_rows = (n) => ({
+                idx: Array.from({ length: n }, (_, i) => i),
+                x: Array.from({ length: n }, (_, i) =>
+                    i % 3 === 0 ? null : i * 0.5
+                ),
+                s: Array.from({ length: n }, (_, i) =>
+                    i % 5 === 0 ? null : `s${i}`
+                ),
+            });
+
+            test("nulls and partial updates keep their neighbours' status", async function () {
+                const table = await perspective.table(schema, {
+                    index: "idx",
+                });
+
+                const expected = make_rows(200);
+                await table.update(expected);
+                const view = await table.view();
+                expect(await view.to_columns()).toEqual(expected);
+
+                // Flip `x` on the boundary rows and leave `s` unset, so that
+                // it keeps its value.
+                await table.update(
+                    BOUNDARY_ROWS.map((idx) => {
+                        const x = expected.x[idx] === null ? -idx : null;
+                        expected.x[idx] = x;
+                        return { idx, x };
+                    })
+                );
+
+                expect(await view.to_columns()).toEqual(expected);
+
+                await table.update(
+                    BOUNDARY_ROWS.map((idx) => {
+                        const s = expected.s[idx] === null ? `t${idx}` : null;
+                        expected.s[idx] = s;
+                        return { idx, s };
+                    })
+                );
+
+                expect(await view.to_columns()).toEqual(expected);
+                view.delete();
+                table.delete();
+            });
+
+            test("removed rows are cleared before they are reused", async function () {
+                const table = await perspective.table(schema, {
+                    index: "idx",
+                });
+
+                const rows = make_rows(200);
+                await table.update(rows);
+                const view = await table.view();
+                await table.remove(BOUNDARY_ROWS);
+                let json = await view.to_columns();
+                expect(json.idx).toEqual(
+                    rows.idx.filter((idx) => !BOUNDARY_ROWS.includes(idx))
+                );
+
+                expect(json.x).toEqual(
+                    rows.x.filter((_, idx) => !BOUNDARY_ROWS.includes(idx))
+                );
+
+                // Re-added rows take the freed slots - `s` is never written,
+                // so it must read as null rather than the removed value.
+                await table.update(
+                    BOUNDARY_ROWS.map((idx) => ({
+                        idx,
+                        x: idx % 2 === 0 ? null : idx,
+                    }))
+                );
+
+                json = await view.to_columns();
+                expect(json.idx).toEqual(rows.idx);
+                for (const idx of BOUNDARY_ROWS) {
+                    expect(json.x[idx]).toEqual(idx % 2 === 0 ? null : idx);
+                    expect(json.s[idx]).toEqual(null);
+                }
+
+                for (const idx of [2, 61, 66, 125, 130, 190, 193]) {
+                    expect(json.x[idx]).toEqual(rows.x[idx]);
+                    expect(json.s[idx]).toEqual(rows.s[idx]);
+                }
+
+                view.delete();
+                table.delete();
+            });
+
+            test("clear resets every status", async function () {
+                const table = await perspective.table(schema, {
+                    index: "idx",
+                });
+
+                await table.update(make_rows(200));
+                const view = await table.view();
+                await table.clear();
+                const rows = {
+                    idx: Array.from({ length: 130 }, (_, i) => i),
+                    x: Array.from({ length: 130 }, (_, i) => i),
+                    s: Array.from({ length: 130 }, (_, i) => `s${i}`),
+                };
+
+                await table.update(rows);
+                expect(await view.to_columns()).toEqual(rows);
+                view.delete();
+                table.delete();
+            });
+
+            test("appended NDJSON batches match a JSON load", async function () {
+                const rows = make_rows(200);
+                const ndjson = rows.idx
+                    .map((idx) =>
+                        JSON.stringify({ idx, x: rows.x[idx], s: rows.s[idx] })
+                    )
+                    .join("\n");
+
+                const table = await perspective.table(schema);
+                await table.update(ndjson, { format: "ndjson" });
+                await table.update(ndjson, { format: "ndjson" });
+                const view = await table.view();
+                const json = await view.to_columns();
+                for (const col of ["idx", "x", "s"]) {
+                    expect(json[col]).toEqual(rows[col].concat(rows[col]));
+                }
+
+                view.delete();
+                table.delete();
+            });
+        });
     });
 
     test.describe("Viewport", function () {
@@ -3372,4 +3618,139 @@ async function match_delta(perspective, delta, expected) {
             await tbl.delete();
         });
     });
+
+    // String columns store vocabulary ids 1 byte wide until the vocabulary
+    // outgrows it, then 2 and 4 bytes - and narrow again when a compaction
+    // shrinks it.
+    test.describe("String vocabulary id widths", function () {
+        const make_rows = (start, end, prefix = "s") => {
+            const rows = { key: [], s: [], x: [] };
+            for (let i = start; i < end; i++) {
+                rows.key.push(`k${i}`);
+                rows.s.push(`${prefix}${i}`);
+                rows.x.push(i);
+            }
+
+            return rows;
+        };
+
+        // Check string pkey updates, filters and an Arrow round trip of
+        // `table`, which holds rows `[start, end)` of `make_rows`.
+        const check_strings = async (table, start, end) => {
+            const view = await table.view({ sort: [["x", "asc"]] });
+            expect(await view.to_columns()).toEqual(make_rows(start, end));
+            for (const i of [start, end - 1]) {
+                const filtered = await table.view({
+                    filter: [["s", "==", `s${i}`]],
+                });
+
+                expect(await filtered.to_columns()).toEqual(
+                    make_rows(i, i + 1)
+                );
+
+                await filtered.delete();
+            }
+
+            const loaded = await perspective.table(await view.to_arrow(), {
+                index: "key",
+            });
+
+            const loaded_view = await loaded.view({ sort: [["x", "asc"]] });
+            expect(await loaded_view.to_columns()).toEqual(
+                make_rows(start, end)
+            );
+
+            await loaded_view.delete();
+            await loaded.delete();
+
+            // Updates by key still find their rows.
+            await table.update([{ key: `k${end - 1}`, x: end - 1 }]);
+            expect(await table.size()).toEqual(end - start);
+            await view.delete();
+        };
+
+        test("Widen past 255 strings in the middle of an update", async function () {
+            const table = await perspective.table(make_rows(0, 200), {
+                index: "key",
+            });
+
+            await table.update(make_rows(200, 400));
+            await check_strings(table, 0, 400);
+            await table.delete();
+        });
+
+        test("Widen past 255 strings in the middle of an Arrow update", async function () {
+            const source = await perspective.table(make_rows(200, 400));
+            const source_view = await source.view();
+            const table = await perspective.table(make_rows(0, 200), {
+                index: "key",
+            });
+
+            await table.update(await source_view.to_arrow());
+            await check_strings(table, 0, 400);
+            await source_view.delete();
+            await source.delete();
+            await table.delete();
+        });
+
+        test("Widen past 65535 strings in the middle of an update", async function () {
+            const table = await perspective.table(make_rows(0, 65000), {
+                index: "key",
+            });
+
+            await table.update(make_rows(65000, 70000));
+            await check_strings(table, 0, 70000);
+            await table.delete();
+        });
+
+        test("Narrow again when removes compact the vocabulary", async function () {
+            const table = await perspective.table(make_rows(0, 1500), {
+                index: "key",
+            });
+
+            await table.remove(make_rows(0, 1400).key);
+            await check_strings(table, 1400, 1500);
+
+            // Growing back past 255 strings widens the narrowed ids again.
+            await table.update(make_rows(1500, 1800));
+            await check_strings(table, 1400, 1800);
+            await table.delete();
+        });
+
+        // Filters look their threshold up without interning it, so views
+        // filtering a string the table has never held must neither widen the
+        // ids under each other nor match the wrong rows.
+        test("Two views filter a new string at the width boundary", async function () {
+            const table = await perspective.table(make_rows(0, 250), {
+                index: "key",
+            });
+
+            const eq_view = await table.view({ filter: [["s", "==", "new"]] });
+            const ne_view = await table.view({
+                filter: [["s", "!=", "new"]],
+                sort: [["x", "asc"]],
+            });
+
+            await table.update(make_rows(250, 254));
+            expect(await eq_view.num_rows()).toEqual(0);
+            expect(await ne_view.to_columns()).toEqual(make_rows(0, 254));
+
+            // Widen past 255 strings in the same update which adds "new".
+            const rows = make_rows(254, 300);
+            rows.key.push("k300");
+            rows.s.push("new");
+            rows.x.push(300);
+            await table.update(rows);
+            expect(await eq_view.to_columns()).toEqual({
+                key: ["k300"],
+                s: ["new"],
+                x: [300],
+            });
+
+            expect(await ne_view.to_columns()).toEqual(make_rows(0, 300));
+            await eq_view.delete();
+            await ne_view.delete();
+            await table.delete();
+        });
+    });
 })(perspective);
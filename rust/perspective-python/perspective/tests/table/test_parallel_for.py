@@ -0,0 +1,174 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import json
+
+import perspective as psp
+
+client = psp.Server().new_local_client()
+Table = client.table
+
+# Runs every `parallel_for` loop on the calling thread, as the single-threaded
+# builds do, so each test can compare the parallel path with the serial one.
+BACKOUT_PARALLEL_FOR = "PSP_BACKOUT_PARALLEL_FOR"
+
+
+def make_pivot_data(start, end, version):
+    return {
+        "id": list(range(start, end)),
+        "a": ["abc"[(i + version) % 3] for i in range(start, end)],
+        "b": ["pqrs"[(i // 3) % 4] for i in range(start, end)],
+        "c": ["mn"[(i // 7 + version) % 2] for i in range(start, end)],
+        "s": [["left", "right"][i % 2] for i in range(start, end)],
+        "v": [(i * version) % 101 + 0.5 for i in range(start, end)],
+    }
+
+
+def make_json_data(n):
+    # Nulls, escapes and non-ASCII strings, so each block writes every kind of
+    # value the serializer handles.
+    return {
+        "x": [None if i % 17 == 0 else i * 7 - 5000 for i in range(n)],
+        "f": [None if i % 13 == 0 else i / 8 for i in range(n)],
+        "s": [
+            None if i % 11 == 0 else 'row "{}"\n\u00e9{}'.format(i, "\\" * (i % 3))
+            for i in range(n)
+        ],
+        "b": [None if i % 19 == 0 else i % 2 == 0 for i in range(n)],
+    }
+
+
+class TestParallelFor(object):
+    def test_ctx2_notify_matches_serial(self, monkeypatch):
+        config = {
+            "group_by": ["a", "b", "c"],
+            "split_by": ["s"],
+            "columns": ["v", "id"],
+            "aggregates": {"v": "median", "id": "distinct count"},
+        }
+
+        parallel = Table(make_pivot_data(0, 50000, 1), index="id")
+        parallel_view = parallel.view(**config)
+        monkeypatch.setenv(BACKOUT_PARALLEL_FOR, "1")
+        serial = Table(make_pivot_data(0, 50000, 1), index="id")
+        serial_view = serial.view(**config)
+        monkeypatch.delenv(BACKOUT_PARALLEL_FOR)
+
+        for version in range(2, 6):
+            # Move rows between groups at every depth, and add and remove
+            # some, so each tree's notify does real work.
+            update = make_pivot_data(version * 5000, version * 5000 + 20000, version)
+            removed = list(range(version * 997, version * 997 + 500))
+            parallel.update(update)
+            parallel.remove(removed)
+            monkeypatch.setenv(BACKOUT_PARALLEL_FOR, "1")
+            serial.update(update)
+            serial.remove(removed)
+            monkeypatch.delenv(BACKOUT_PARALLEL_FOR)
+
+            expected = serial_view.to_columns_string()
+            assert parallel_view.to_columns_string() == expected
+
+            # A new view builds its trees from the table in one notify.
+            fresh = parallel.view(**config)
+            assert fresh.to_columns_string() == expected
+            fresh.delete()
+
+        parallel_view.delete()
+        serial_view.delete()
+        parallel.delete()
+        serial.delete()
+
+    def test_json_blocks_match_serial(self, monkeypatch):
+        # Serialized in blocks of 1024 values, so windows start and end on
+        # both sides of block boundaries.
+        table = Table(make_json_data(5000))
+        windows = [
+            {},
+            {"start_row": 1023, "end_row": 1025},
+            {"start_row": 1024, "end_row": 2048},
+            {"start_row": 1000, "end_row": 3073},
+            {"start_row": 2047, "end_row": 4097, "start_col": 1, "end_col": 3},
+        ]
+
+        configs = [{}, {"group_by": ["x"]}, {"sort": [["s", "desc"]]}]
+        for config in configs:
+            view = table.view(**config)
+            full = view.to_ndjson().splitlines()
+            for window in windows:
+                parallel = [
+                    view.to_columns_string(**window),
+                    view.to_json_string(**window),
+                    view.to_ndjson(**window),
+                ]
+
+                monkeypatch.setenv(BACKOUT_PARALLEL_FOR, "1")
+                serial = [
+                    view.to_columns_string(**window),
+                    view.to_json_string(**window),
+                    view.to_ndjson(**window),
+                ]
+
+                monkeypatch.delenv(BACKOUT_PARALLEL_FOR)
+                assert parallel == serial
+
+                # Rows do not depend on the window they are written in.
+                if "start_col" not in window:
+                    start = window.get("start_row", 0)
+                    end = window.get("end_row", len(full))
+                    assert parallel[2].splitlines() == full[start:end]
+                    assert json.loads(parallel[1]) == [
+                        json.loads(line) for line in full[start:end]
+                    ]
+
+            view.delete()
+
+        table.delete()
+
+    def test_flatten_matches_serial(self, monkeypatch):
+        # Batches over 65536 rows are sorted by key in parallel runs, unless
+        # they are already in key order. Every key appears twice in each
+        # batch, and the later row must win.
+        ordered = {"k": [i // 2 for i in range(200000)], "y": list(range(200000))}
+        shuffled = {
+            "k": [(i * 7919) % 150000 for i in range(300000)],
+            "y": list(range(200000, 500000)),
+        }
+
+        expected = {}
+        for batch in [ordered, shuffled]:
+            for k, y in zip(batch["k"], batch["y"]):
+                expected[k] = y
+
+        tables = []
+        for backout in [False, True]:
+            if backout:
+                monkeypatch.setenv(BACKOUT_PARALLEL_FOR, "1")
+
+            # Only updates after the first are flattened.
+            table = Table({"k": [0], "y": [-1]}, index="k")
+            table.update(ordered)
+            table.update(shuffled)
+            monkeypatch.delenv(BACKOUT_PARALLEL_FOR, raising=False)
+            tables.append(table)
+
+        keys = sorted(expected)
+        views = [table.view() for table in tables]
+        assert views[0].to_columns() == {
+            "k": keys,
+            "y": [expected[k] for k in keys],
+        }
+
+        assert views[0].to_columns_string() == views[1].to_columns_string()
+        for view, table in zip(views, tables):
+            view.delete()
+            table.delete()
@@ -439,7 +439,10 @@ impl PyView {
             .into_pyerr()?;
 
         self.view
-            .on_update(Box::new(callback), OnUpdateOptions { mode })
+            .on_update(Box::new(callback), OnUpdateOptions {
+                mode,
+                ..OnUpdateOptions::default()
+            })
             .await
             .into_pyerr()
     }
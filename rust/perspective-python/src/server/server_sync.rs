@@ -11,10 +11,11 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 use std::sync::Arc;
+use std::time::Duration;
 
 use async_lock::RwLock;
 use perspective_client::Session;
-use perspective_server::{LocalSession, Server, SessionHandler};
+use perspective_server::{LocalSession, Server, SessionHandler, TableUpdatePolicy};
 use pollster::FutureExt;
 use pyo3::exceptions::PyValueError;
 use pyo3::prelude::*;
@@ -79,6 +80,26 @@ impl PySyncServer {
 
         Ok(client)
     }
+
+    pub fn set_table_update_policy(
+        &self,
+        table_id: &str,
+        max_latency_ms: u64,
+        max_batch_rows: u32,
+    ) -> PyResult<()> {
+        let policy = TableUpdatePolicy {
+            max_latency: Duration::from_millis(max_latency_ms),
+            max_batch_rows,
+        };
+
+        self.server.set_table_update_policy(table_id, policy);
+        Ok(())
+    }
+
+    pub fn clear_table_update_policy(&self, table_id: &str) -> PyResult<()> {
+        self.server.clear_table_update_policy(table_id);
+        Ok(())
+    }
 }
 
 impl PySyncSession {
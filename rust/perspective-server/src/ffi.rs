@@ -10,6 +10,8 @@
 // ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
+use std::time::Duration;
+
 #[repr(C, packed)]
 pub struct CppResponse {
     data_ptr: usize,
@@ -27,6 +29,8 @@ extern "C" {
     fn psp_alloc(size: usize) -> *mut u8;
     fn psp_free(ptr: *const u8);
     fn psp_new_server() -> *const u8;
+    fn psp_new_server_with_workers(num_workers: u32) -> *const u8;
+    fn psp_num_workers(server: *const u8) -> u32;
     fn psp_new_session(server: *const u8) -> u32;
     fn psp_delete_server(server: *const u8);
     fn psp_handle_request(
@@ -36,6 +40,19 @@ extern "C" {
         buffer_len: usize,
     ) -> ResponseBatch;
     fn psp_poll(server: *const u8) -> ResponseBatch;
+    fn psp_get_poll_delay(server: *const u8) -> i32;
+    fn psp_set_table_update_policy(
+        server: *const u8,
+        table_id_ptr: *const u8,
+        table_id_len: usize,
+        max_latency_ms: u32,
+        max_batch_rows: u32,
+    );
+    fn psp_clear_table_update_policy(
+        server: *const u8,
+        table_id_ptr: *const u8,
+        table_id_len: usize,
+    );
     fn psp_close_session(server: *const u8, client_id: u32);
 }
 
@@ -114,6 +131,14 @@ impl Server {
         Server(unsafe { psp_new_server() })
     }
 
+    pub fn new_with_workers(num_workers: u32) -> Self {
+        Server(unsafe { psp_new_server_with_workers(num_workers) })
+    }
+
+    pub fn num_workers(&self) -> u32 {
+        unsafe { psp_num_workers(self.0) }
+    }
+
     pub fn new_session(&self) -> u32 {
         unsafe { psp_new_session(self.0) }
     }
@@ -126,6 +151,32 @@ impl Server {
         unsafe { psp_poll(self.0) }
     }
 
+    pub fn poll_delay(&self) -> Option<Duration> {
+        let delay = unsafe { psp_get_poll_delay(self.0) };
+        u64::try_from(delay).ok().map(Duration::from_millis)
+    }
+
+    pub fn set_table_update_policy(
+        &self,
+        table_id: &str,
+        max_latency_ms: u32,
+        max_batch_rows: u32,
+    ) {
+        unsafe {
+            psp_set_table_update_policy(
+                self.0,
+                table_id.as_ptr(),
+                table_id.len(),
+                max_latency_ms,
+                max_batch_rows,
+            )
+        }
+    }
+
+    pub fn clear_table_update_policy(&self, table_id: &str) {
+        unsafe { psp_clear_table_update_policy(self.0, table_id.as_ptr(), table_id.len()) }
+    }
+
     pub fn close_session(&self, session_id: u32) {
         unsafe { psp_close_session(self.0, session_id) }
     }
@@ -19,4 +19,4 @@ mod server;
 
 pub use local_client::LocalClient;
 pub use local_session::LocalSession;
-pub use server::{Server, ServerError, SessionHandler};
+pub use server::{Server, ServerError, SessionHandler, TableUpdatePolicy};
@@ -57,22 +57,7 @@ impl Session<ServerError> for LocalSession {
     }
 
     async fn poll(&self) -> Result<(), ServerError> {
-        let responses = self.server.server.poll();
-        for response in responses.iter_responses() {
-            let cb = self
-                .server
-                .callbacks
-                .read()
-                .await
-                .get(&response.client_id())
-                .cloned();
-
-            if let Some(f) = cb {
-                f(response.msg()).await?;
-            }
-        }
-
-        Ok(())
+        self.server.poll().await
     }
 
     async fn close(mut self) {
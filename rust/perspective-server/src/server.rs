@@ -12,7 +12,9 @@
 
 use std::collections::HashMap;
 use std::error::Error;
+use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::Arc;
+use std::time::Duration;
 
 use async_lock::RwLock;
 use futures::future::BoxFuture;
@@ -42,6 +44,17 @@ pub trait SessionHandler: Send + Sync {
     ) -> impl Future<Output = Result<(), ServerError>> + Send + 'a;
 }
 
+/// How updates to a [`perspective_client::Table`] are coalesced, see
+/// [`Server::set_table_update_policy`].
+#[derive(Clone, Copy, Debug)]
+pub struct TableUpdatePolicy {
+    /// The longest an update waits to be processed.
+    pub max_latency: Duration,
+
+    /// Process the table as soon as this many rows are waiting.
+    pub max_batch_rows: u32,
+}
+
 /// An instance of a Perspective server. Each [`Server`] instance is separate,
 /// and does not share [`perspective_client::Table`] (or other) data with other
 /// [`Server`]s.
@@ -49,6 +62,7 @@ pub trait SessionHandler: Send + Sync {
 pub struct Server {
     pub(crate) server: Arc<ffi::Server>,
     pub(crate) callbacks: Arc<RwLock<HashMap<u32, SessionCallback>>>,
+    is_poll_scheduled: Arc<AtomicBool>,
 }
 
 impl std::fmt::Debug for Server {
@@ -63,11 +77,128 @@ impl Default for Server {
     fn default() -> Self {
         let server = Arc::new(ffi::Server::new());
         let callbacks = Arc::default();
-        Self { server, callbacks }
+        let is_poll_scheduled = Arc::default();
+        Self {
+            server,
+            callbacks,
+            is_poll_scheduled,
+        }
     }
 }
 
 impl Server {
+    /// Create a [`Server`] which runs requests on `num_workers` threads, with
+    /// one serial execution lane per table. Requests on different tables,
+    /// issued concurrently from different threads, then run in parallel.
+    /// With `num_workers == 0` this is the same as [`Server::default`], and
+    /// every request runs on the calling thread.
+    pub fn new_with_workers(num_workers: u32) -> Self {
+        let server = Arc::new(ffi::Server::new_with_workers(num_workers));
+        let callbacks = Arc::default();
+        let is_poll_scheduled = Arc::default();
+        Self {
+            server,
+            callbacks,
+            is_poll_scheduled,
+        }
+    }
+
+    /// The number of worker threads this [`Server`] runs requests on.
+    pub fn num_workers(&self) -> u32 {
+        self.server.num_workers()
+    }
+
+    /// Coalesce updates to the table named `table_id`. Its updates are
+    /// processed together, with one `on_update` notification per
+    /// subscriber, once `policy.max_batch_rows` rows are waiting or the
+    /// oldest has waited `policy.max_latency`. Reads from the table still
+    /// see every update.
+    ///
+    /// Updates which are still waiting after a poll are processed on a
+    /// background thread once due, so `on_update` callbacks for them are
+    /// called from that thread.
+    pub fn set_table_update_policy(&self, table_id: &str, policy: TableUpdatePolicy) {
+        let max_latency_ms = u32::try_from(policy.max_latency.as_millis()).unwrap_or(u32::MAX);
+        self.server
+            .set_table_update_policy(table_id, max_latency_ms, policy.max_batch_rows);
+    }
+
+    /// Process every update to the table named `table_id` as it arrives.
+    pub fn clear_table_update_policy(&self, table_id: &str) {
+        self.server.clear_table_update_policy(table_id);
+    }
+
+    /// How long until the next poll has deferred updates or throttled
+    /// `on_update` notifications to deliver, if it has any.
+    pub fn poll_delay(&self) -> Option<Duration> {
+        self.server.poll_delay()
+    }
+
+    /// Deliver the `on_update` notifications for every processed table to
+    /// their sessions.
+    pub(crate) async fn poll(&self) -> Result<(), ServerError> {
+        let responses = self.server.poll();
+        self.schedule_poll();
+        for response in responses.iter_responses() {
+            let cb = self
+                .callbacks
+                .read()
+                .await
+                .get(&response.client_id())
+                .cloned();
+
+            if let Some(f) = cb {
+                f(response.msg()).await?;
+            }
+        }
+
+        Ok(())
+    }
+
+    /// Poll again from a background thread while deferred updates or
+    /// throttled notifications remain, as no request may arrive to do so.
+    fn schedule_poll(&self) {
+        if self.server.poll_delay().is_none() || self.is_poll_scheduled.swap(true, Ordering::SeqCst)
+        {
+            return;
+        }
+
+        let server = self.clone();
+        std::thread::spawn(move || loop {
+            while let Some(delay) = server.server.poll_delay() {
+                std::thread::sleep(delay);
+                let responses = server.server.poll();
+                futures::executor::block_on(server.deliver(responses));
+            }
+
+            // Work deferred after the last check, but before this thread is
+            // marked finished, would otherwise be left for the next request.
+            server.is_poll_scheduled.store(false, Ordering::SeqCst);
+            if server.server.poll_delay().is_none()
+                || server.is_poll_scheduled.swap(true, Ordering::SeqCst)
+            {
+                break;
+            }
+        });
+    }
+
+    async fn deliver(&self, responses: ffi::ResponseBatch) {
+        for response in responses.iter_responses() {
+            let cb = self
+                .callbacks
+                .read()
+                .await
+                .get(&response.client_id())
+                .cloned();
+
+            if let Some(f) = cb {
+                if let Err(e) = f(response.msg()).await {
+                    tracing::error!("Failed to deliver deferred update: {}", e);
+                }
+            }
+        }
+    }
+
     /// An alternative method for creating a new [`Session`] for this
     /// [`Server`], from a callback closure instead of a via a trait.
     /// See [`Server::new_session`] for details.
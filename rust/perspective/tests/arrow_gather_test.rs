@@ -0,0 +1,143 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+use std::collections::HashMap;
+use std::error::Error;
+
+use perspective_client::config::{
+    Expressions, Filter, FilterTerm, Scalar, Sort, SortDir, ViewConfigUpdate,
+};
+use perspective_client::{TableInitOptions, UpdateData, UpdateOptions, View, ViewWindow};
+use perspective_server::LocalClient;
+
+const BACKOUT_ARROW_GATHER: &str = "PSP_BACKOUT_ARROW_GATHER";
+
+fn make_csv(start: usize, end: usize) -> String {
+    let mut csv = "x,y,z,w\n".to_owned();
+    for i in start..end {
+        // Leave every kind of column null on some rows, and repeat strings
+        // out of order so dictionary order depends on the rows exported.
+        let x = if i % 11 == 0 { "".to_owned() } else { i.to_string() };
+        let y = if i % 7 == 0 { "".to_owned() } else { format!("{}.5", i % 13) };
+        let z = if i % 5 == 0 { "".to_owned() } else { format!("s{}", (i * 7) % 17) };
+        let w = if i % 3 == 0 { "" } else if i % 2 == 0 { "true" } else { "false" };
+        csv.push_str(&format!("{},{},{},{}\n", x, y, z, w));
+    }
+
+    csv
+}
+
+/// Export `view` through the typed column gather and through the data slice,
+/// and check the two Arrow streams are byte for byte the same.
+async fn assert_gather_matches_data_slice(view: &View) -> Result<(), Box<dyn Error>> {
+    let windows = [
+        ViewWindow::default(),
+        ViewWindow {
+            start_row: Some(10.0),
+            end_row: Some(40.0),
+            ..ViewWindow::default()
+        },
+        ViewWindow {
+            start_col: Some(1.0),
+            end_col: Some(3.0),
+            ..ViewWindow::default()
+        },
+        ViewWindow {
+            compression: Some("lz4".to_owned()),
+            ..ViewWindow::default()
+        },
+    ];
+
+    for window in windows {
+        std::env::remove_var(BACKOUT_ARROW_GATHER);
+        let gathered = view.to_arrow(window.clone()).await?;
+        std::env::set_var(BACKOUT_ARROW_GATHER, "1");
+        let sliced = view.to_arrow(window.clone()).await;
+        std::env::remove_var(BACKOUT_ARROW_GATHER);
+        assert_eq!(gathered, sliced?, "{:?}", window);
+    }
+
+    Ok(())
+}
+
+#[tokio::test]
+async fn test_arrow_gather_matches_data_slice() -> Result<(), Box<dyn Error>> {
+    let server = perspective::server::Server::default();
+    let client = LocalClient::new(&server);
+    let table = client
+        .table(
+            UpdateData::Csv(make_csv(0, 100)).into(),
+            TableInitOptions::default(),
+        )
+        .await?;
+
+    table
+        .update(UpdateData::Csv(make_csv(100, 150)), UpdateOptions::default())
+        .await?;
+
+    let configs = [
+        ViewConfigUpdate::default(),
+        ViewConfigUpdate {
+            sort: Some(vec![
+                Sort("z".to_owned(), SortDir::Desc),
+                Sort("y".to_owned(), SortDir::Asc),
+            ]),
+            ..ViewConfigUpdate::default()
+        },
+        ViewConfigUpdate {
+            filter: Some(vec![
+                Filter::new("x", ">", FilterTerm::Scalar(Scalar::Float(20.0))),
+                Filter::new("w", "is not null", FilterTerm::Scalar(Scalar::Null)),
+            ]),
+            ..ViewConfigUpdate::default()
+        },
+        ViewConfigUpdate {
+            expressions: Some(Expressions(HashMap::from([
+                ("xy".to_owned(), "\"x\" + \"y\"".to_owned()),
+                ("lz".to_owned(), "lower(\"z\")".to_owned()),
+            ]))),
+            columns: Some(vec![
+                Some("lz".to_owned()),
+                Some("x".to_owned()),
+                Some("xy".to_owned()),
+                Some("z".to_owned()),
+            ]),
+            sort: Some(vec![Sort("xy".to_owned(), SortDir::Desc)]),
+            ..ViewConfigUpdate::default()
+        },
+        ViewConfigUpdate {
+            columns: Some(vec![Some("z".to_owned())]),
+            sort: Some(vec![Sort("x".to_owned(), SortDir::Asc)]),
+            filter: Some(vec![Filter::new(
+                "z",
+                "in",
+                FilterTerm::Array(vec![
+                    Scalar::String("s3".to_owned()),
+                    Scalar::String("s11".to_owned()),
+                    Scalar::String("s16".to_owned()),
+                ]),
+            )]),
+            ..ViewConfigUpdate::default()
+        },
+    ];
+
+    for config in configs {
+        let view = table.view(Some(config)).await?;
+        assert_gather_matches_data_slice(&view).await?;
+        view.delete().await?;
+    }
+
+    table.delete().await?;
+    client.close().await;
+    Ok(())
+}
@@ -14,6 +14,7 @@
 use std::error::Error;
 use std::sync::Arc;
 
+use perspective_client::config::ViewConfigUpdate;
 use perspective_client::{OnUpdateOptions, TableInitOptions, UpdateData, UpdateOptions};
 use perspective_server::LocalClient;
 use tokio::sync::Mutex;
@@ -61,3 +62,60 @@ async fn test_two_sync_clients_receive_messages_on_update() -> Result<(), Box<dy
     assert!(*result.lock().await);
     Ok(())
 }
+
+#[tokio::test(flavor = "multi_thread", worker_threads = 4)]
+async fn test_worker_lanes_run_concurrent_requests_across_tables() -> Result<(), Box<dyn Error>> {
+    let server = perspective::server::Server::new_with_workers(4);
+    assert_eq!(server.num_workers(), 4);
+
+    let tasks = (0..4).map(|idx| {
+        let server = server.clone();
+        tokio::spawn(async move {
+            let client = LocalClient::new(&server);
+            let table = client
+                .table(
+                    UpdateData::Csv("x,y\n0,a".to_owned()).into(),
+                    TableInitOptions {
+                        name: Some(format!("Table{}", idx)),
+                        index: Some("x".to_owned()),
+                        limit: None,
+                        format: None,
+                    },
+                )
+                .await
+                .unwrap();
+
+            let view = table.view(None).await.unwrap();
+            for row in 1..100 {
+                table
+                    .update(
+                        UpdateData::Csv(format!("x,y\n{},b\n0,c", row)),
+                        UpdateOptions::default(),
+                    )
+                    .await
+                    .unwrap();
+            }
+
+            // A failed view must not leave its lane behind for later
+            // requests on the same table.
+            let bad_config = ViewConfigUpdate {
+                columns: Some(vec![Some("not_a_column".to_owned())]),
+                ..ViewConfigUpdate::default()
+            };
+
+            assert!(table.view(Some(bad_config)).await.is_err());
+            let size = table.size().await.unwrap();
+            let num_rows = view.num_rows().await.unwrap();
+            view.delete().await.unwrap();
+            table.delete().await.unwrap();
+            client.close().await;
+            (size, num_rows)
+        })
+    });
+
+    for task in tasks.collect::<Vec<_>>() {
+        assert_eq!(task.await?, (100, 100));
+    }
+
+    Ok(())
+}
@@ -0,0 +1,129 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+use std::error::Error;
+
+use perspective_client::config::ViewConfigUpdate;
+use perspective_client::{Table, TableInitOptions, UpdateData, UpdateOptions, View, ViewWindow};
+use perspective_server::LocalClient;
+
+const CTX2_LAZY_ROW_TREES: &str = "PSP_CTX2_LAZY_ROW_TREES";
+
+fn make_csv(start: usize, end: usize, version: usize) -> String {
+    let mut csv = "id,a,b,c,s,v\n".to_owned();
+    for i in start..end {
+        let a = ["x", "y", "z"][(i + version) % 3];
+        let b = ["p", "q", "r", "t"][i % 4];
+        let c = ["m", "n"][(i / 4 + version) % 2];
+        let s = ["left", "right"][(i / 3) % 2];
+        csv.push_str(&format!("{},{},{},{},{},{}.5\n", i, a, b, c, s, i * version % 17));
+    }
+
+    csv
+}
+
+async fn assert_same(eager: &View, lazy: &View, step: &str) -> Result<(), Box<dyn Error>> {
+    assert_eq!(eager.num_rows().await?, lazy.num_rows().await?, "{}", step);
+    assert_eq!(
+        eager.to_columns_string(ViewWindow::default()).await?,
+        lazy.to_columns_string(ViewWindow::default()).await?,
+        "{}",
+        step
+    );
+
+    Ok(())
+}
+
+async fn update(table: &Table, version: usize) -> Result<(), Box<dyn Error>> {
+    // Move some rows to other groups, add new ones and remove a few, so every
+    // depth sees inserts, moves and removes.
+    table
+        .update(
+            UpdateData::Csv(make_csv(version * 5, version * 5 + 40, version)),
+            UpdateOptions::default(),
+        )
+        .await?;
+
+    table
+        .remove(UpdateData::JsonRows(format!("[{}, {}]", version * 7, version * 3 + 1)))
+        .await?;
+
+    Ok(())
+}
+
+#[tokio::test]
+async fn test_ctx2_lazy_row_trees_match_eager() -> Result<(), Box<dyn Error>> {
+    let server = perspective::server::Server::default();
+    let client = LocalClient::new(&server);
+    let table = client
+        .table(
+            UpdateData::Csv(make_csv(0, 60, 1)).into(),
+            TableInitOptions {
+                name: None,
+                index: Some("id".to_owned()),
+                limit: None,
+                format: None,
+            },
+        )
+        .await?;
+
+    let config = ViewConfigUpdate {
+        group_by: Some(vec!["a".to_owned(), "b".to_owned(), "c".to_owned()]),
+        split_by: Some(vec!["s".to_owned()]),
+        columns: Some(vec![Some("v".to_owned()), Some("id".to_owned())]),
+        ..ViewConfigUpdate::default()
+    };
+
+    std::env::remove_var(CTX2_LAZY_ROW_TREES);
+    let eager = table.view(Some(config.clone())).await?;
+    std::env::set_var(CTX2_LAZY_ROW_TREES, "1");
+    let lazy = table.view(Some(config)).await;
+    std::env::remove_var(CTX2_LAZY_ROW_TREES);
+    let lazy = lazy?;
+
+    let mut version = 2;
+    update(&table, version).await?;
+    assert_same(&eager, &lazy, "after update").await?;
+
+    for depth in 0..3 {
+        eager.set_depth(depth).await?;
+        lazy.set_depth(depth).await?;
+        assert_same(&eager, &lazy, &format!("set_depth({})", depth)).await?;
+
+        // Open each row at this depth in turn, update while it is open, then
+        // close it again and update while it is closed.
+        let mut row = 1;
+        while row < eager.num_rows().await? {
+            let step = format!("depth {} row {}", depth, row);
+            assert_eq!(eager.expand(row).await?, lazy.expand(row).await?, "{}", step);
+            assert_same(&eager, &lazy, &format!("expand {}", step)).await?;
+
+            version += 1;
+            update(&table, version).await?;
+            assert_same(&eager, &lazy, &format!("update open {}", step)).await?;
+
+            assert_eq!(eager.collapse(row).await?, lazy.collapse(row).await?, "{}", step);
+            assert_same(&eager, &lazy, &format!("collapse {}", step)).await?;
+
+            version += 1;
+            update(&table, version).await?;
+            assert_same(&eager, &lazy, &format!("update closed {}", step)).await?;
+            row += 1;
+        }
+    }
+
+    eager.delete().await?;
+    lazy.delete().await?;
+    table.delete().await?;
+    client.close().await;
+    Ok(())
+}
@@ -0,0 +1,138 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+use std::collections::HashMap;
+use std::error::Error;
+
+use perspective_client::config::{Expressions, Filter, FilterTerm, Scalar, ViewConfigUpdate};
+use perspective_client::{Table, TableInitOptions, UpdateData, UpdateOptions, View, ViewWindow};
+use perspective_server::LocalClient;
+
+const BACKOUT_EXPRESSION_BYTECODE: &str = "PSP_BACKOUT_EXPRESSION_BYTECODE";
+
+const EXPRESSIONS: [(&str, &str); 10] = [
+    ("sum", "\"i\" + \"f\""),
+    ("mixed", "\"i\" * 2 - \"f\" / 4 + 0.25"),
+    ("negate", "-\"i\" + +1.5"),
+    ("nested", "(\"i\" + 1) * (\"f\" - 2) % 7"),
+    ("div", "\"i\" / \"f\""),
+    ("mod", "\"f\" % \"i\""),
+    ("div_zero", "\"i\" / 0"),
+    ("mod_zero", "\"f\" % 0"),
+    ("int_only", "\"i\" * \"i\" - 3"),
+    ("fallback", "abs(\"i\") + sqrt(\"f\" * \"f\")"),
+];
+
+/// Integer column `i` and float column `f`, with nulls and zeroes in both so
+/// the divisions and modulos hit invalid rows.
+fn make_csv(start: i64, end: i64) -> String {
+    let mut csv = "i,f\n".to_owned();
+    for n in start..end {
+        let i = if n % 7 == 0 { "".to_owned() } else { (n % 5 - 2).to_string() };
+        let f = if n % 11 == 0 { "".to_owned() } else { format!("{}.5", n % 4 - 2) };
+        let f = if n % 9 == 0 { "0.0".to_owned() } else { f };
+        csv.push_str(&format!("{},{}\n", i, f));
+    }
+
+    csv
+}
+
+/// The number of rows of `make_csv(0, 300)` with a null `i` or `f`, and with
+/// `f` zero as well when `zero_is_null`.
+fn expected_nulls(zero_is_null: bool) -> u32 {
+    (0..300)
+        .filter(|n| n % 7 == 0 || (n % 9 != 0 && n % 11 == 0) || (zero_is_null && n % 9 == 0))
+        .count() as u32
+}
+
+async fn make_view(client: &LocalClient) -> Result<(Table, View), Box<dyn Error>> {
+    let table = client
+        .table(
+            UpdateData::Csv(make_csv(0, 200)).into(),
+            TableInitOptions::default(),
+        )
+        .await?;
+
+    let expressions = EXPRESSIONS
+        .iter()
+        .map(|(alias, expr)| (alias.to_string(), expr.to_string()))
+        .collect::<HashMap<_, _>>();
+
+    let view = table
+        .view(Some(ViewConfigUpdate {
+            expressions: Some(Expressions(expressions)),
+            ..ViewConfigUpdate::default()
+        }))
+        .await?;
+
+    // Expressions are computed again for rows added after the view.
+    table
+        .update(UpdateData::Csv(make_csv(200, 300)), UpdateOptions::default())
+        .await?;
+
+    Ok((table, view))
+}
+
+async fn count_where(table: &Table, column: &str, op: &str) -> Result<u32, Box<dyn Error>> {
+    let expressions = EXPRESSIONS
+        .iter()
+        .map(|(alias, expr)| (alias.to_string(), expr.to_string()))
+        .collect::<HashMap<_, _>>();
+
+    let view = table
+        .view(Some(ViewConfigUpdate {
+            expressions: Some(Expressions(expressions)),
+            filter: Some(vec![Filter::new(column, op, FilterTerm::Scalar(Scalar::Null))]),
+            ..ViewConfigUpdate::default()
+        }))
+        .await?;
+
+    let num_rows = view.num_rows().await?;
+    view.delete().await?;
+    Ok(num_rows)
+}
+
+#[tokio::test]
+async fn test_expression_bytecode_matches_exprtk() -> Result<(), Box<dyn Error>> {
+    let server = perspective::server::Server::default();
+    let client = LocalClient::new(&server);
+
+    std::env::remove_var(BACKOUT_EXPRESSION_BYTECODE);
+    let (bytecode_table, bytecode_view) = make_view(&client).await?;
+    std::env::set_var(BACKOUT_EXPRESSION_BYTECODE, "1");
+    let exprtk = make_view(&client).await;
+    std::env::remove_var(BACKOUT_EXPRESSION_BYTECODE);
+    let (exprtk_table, exprtk_view) = exprtk?;
+
+    assert_eq!(bytecode_view.schema().await?, exprtk_view.schema().await?);
+
+    assert_eq!(
+        bytecode_view.to_columns_string(ViewWindow::default()).await?,
+        exprtk_view.to_columns_string(ViewWindow::default()).await?
+    );
+
+    // Division and modulo by zero are invalid, not infinite or NaN.
+    for table in [&bytecode_table, &exprtk_table] {
+        assert_eq!(count_where(table, "div_zero", "is not null").await?, 0);
+        assert_eq!(count_where(table, "mod_zero", "is not null").await?, 0);
+        assert_eq!(count_where(table, "sum", "is null").await?, expected_nulls(false));
+        assert_eq!(count_where(table, "div", "is null").await?, expected_nulls(true));
+    }
+
+    for (table, view) in [(bytecode_table, bytecode_view), (exprtk_table, exprtk_view)] {
+        view.delete().await?;
+        table.delete().await?;
+    }
+
+    client.close().await;
+    Ok(())
+}
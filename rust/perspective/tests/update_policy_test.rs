@@ -0,0 +1,179 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+use std::error::Error;
+use std::sync::atomic::{AtomicU32, Ordering};
+use std::sync::Arc;
+use std::time::Duration;
+
+use perspective_client::{
+    OnUpdateMode, OnUpdateOptions, Table, TableInitOptions, UpdateData, UpdateOptions, View,
+};
+use perspective_server::{LocalClient, Server, TableUpdatePolicy};
+
+async fn make_table(client: &LocalClient, name: &str) -> Result<Table, Box<dyn Error>> {
+    let table = client
+        .table(
+            UpdateData::Csv("x,y\n1,a".to_owned()).into(),
+            TableInitOptions {
+                name: Some(name.to_owned()),
+                index: None,
+                limit: None,
+                format: None,
+            },
+        )
+        .await?;
+
+    Ok(table)
+}
+
+async fn count_updates(
+    view: &View,
+    options: OnUpdateOptions,
+) -> Result<Arc<AtomicU32>, Box<dyn Error>> {
+    let count = Arc::new(AtomicU32::new(0));
+    view.on_update(
+        {
+            let count = count.clone();
+            move |_| {
+                let count = count.clone();
+                async move {
+                    count.fetch_add(1, Ordering::SeqCst);
+                }
+            }
+        },
+        options,
+    )
+    .await?;
+
+    Ok(count)
+}
+
+async fn update(table: &Table, row: u32) -> Result<(), Box<dyn Error>> {
+    table
+        .update(
+            UpdateData::Csv(format!("x,y\n{},b", row)),
+            UpdateOptions::default(),
+        )
+        .await?;
+
+    Ok(())
+}
+
+#[tokio::test(flavor = "multi_thread")]
+async fn test_update_policy_coalesces_updates() -> Result<(), Box<dyn Error>> {
+    let server = Server::default();
+    let client = LocalClient::new(&server);
+    let table = make_table(&client, "Table1").await?;
+    let view = table.view(None).await?;
+    let count = count_updates(&view, OnUpdateOptions::default()).await?;
+    server.set_table_update_policy("Table1", TableUpdatePolicy {
+        max_latency: Duration::from_millis(200),
+        max_batch_rows: 1000,
+    });
+
+    for row in 2..7 {
+        update(&table, row).await?;
+    }
+
+    assert_eq!(count.load(Ordering::SeqCst), 0);
+    tokio::time::sleep(Duration::from_millis(600)).await;
+    assert_eq!(count.load(Ordering::SeqCst), 1);
+    assert_eq!(view.num_rows().await?, 6);
+    client.close().await;
+    Ok(())
+}
+
+#[tokio::test(flavor = "multi_thread")]
+async fn test_update_policy_delivers_without_another_request() -> Result<(), Box<dyn Error>> {
+    let server = Server::default();
+    let client = LocalClient::new(&server);
+    let table = make_table(&client, "Table1").await?;
+    let view = table.view(None).await?;
+    let count = count_updates(&view, OnUpdateOptions::default()).await?;
+    server.set_table_update_policy("Table1", TableUpdatePolicy {
+        max_latency: Duration::from_millis(100),
+        max_batch_rows: 1000,
+    });
+
+    // The last update is deferred, and no further request will poll for it.
+    update(&table, 2).await?;
+    tokio::time::sleep(Duration::from_millis(500)).await;
+    assert_eq!(count.load(Ordering::SeqCst), 1);
+    assert!(server.poll_delay().is_none());
+    client.close().await;
+    Ok(())
+}
+
+#[tokio::test(flavor = "multi_thread")]
+async fn test_update_policy_batch_rows_processes_immediately() -> Result<(), Box<dyn Error>> {
+    let server = Server::default();
+    let client = LocalClient::new(&server);
+    let table = make_table(&client, "Table1").await?;
+    let view = table.view(None).await?;
+    let count = count_updates(&view, OnUpdateOptions::default()).await?;
+    server.set_table_update_policy("Table1", TableUpdatePolicy {
+        max_latency: Duration::from_secs(60),
+        max_batch_rows: 2,
+    });
+
+    update(&table, 2).await?;
+    assert_eq!(count.load(Ordering::SeqCst), 0);
+    update(&table, 3).await?;
+    assert_eq!(count.load(Ordering::SeqCst), 1);
+    client.close().await;
+    Ok(())
+}
+
+#[tokio::test(flavor = "multi_thread")]
+async fn test_on_update_throttle_holds_back_and_delivers_trailing() -> Result<(), Box<dyn Error>>
+{
+    let server = Server::default();
+    let client = LocalClient::new(&server);
+    let table = make_table(&client, "Table1").await?;
+    let view = table.view(None).await?;
+    let throttled = count_updates(&view, OnUpdateOptions {
+        throttle: Some(500),
+        ..OnUpdateOptions::default()
+    })
+    .await?;
+
+    let unthrottled = count_updates(&view, OnUpdateOptions::default()).await?;
+    for row in 2..7 {
+        update(&table, row).await?;
+    }
+
+    assert_eq!(unthrottled.load(Ordering::SeqCst), 5);
+    assert_eq!(throttled.load(Ordering::SeqCst), 1);
+    tokio::time::sleep(Duration::from_millis(1000)).await;
+    assert_eq!(throttled.load(Ordering::SeqCst), 2);
+    client.close().await;
+    Ok(())
+}
+
+#[tokio::test]
+async fn test_on_update_throttle_rejects_row_mode() -> Result<(), Box<dyn Error>> {
+    let server = Server::default();
+    let client = LocalClient::new(&server);
+    let table = make_table(&client, "Table1").await?;
+    let view = table.view(None).await?;
+    let result = view
+        .on_update(|_| async {}, OnUpdateOptions {
+            mode: Some(OnUpdateMode::Row),
+            throttle: Some(100),
+        })
+        .await;
+
+    assert!(result.is_err());
+    client.close().await;
+    Ok(())
+}